@@ -43,6 +43,7 @@ The following flags enable optional features (disable with --no-<option name>).
   --muzzle                 complete silence (no non-result output)
   --coverage               support for gcov coverage testing
   --profiling              support for gprof profiling
+  --thread-safe-nodes      allow constructing terms from several threads
   --unit-testing           support for unit testing
   --python2                force Python 2 (deprecated)
   --python-bindings        build Python bindings based on new C++ API
@@ -142,6 +143,7 @@ shared=default
 static_binary=default
 statistics=default
 symfpu=default
+thread_safe_nodes=default
 tracing=default
 tsan=default
 ubsan=default
@@ -303,6 +305,9 @@ do
     --profiling) profiling=ON;;
     --no-profiling) profiling=OFF;;
 
+    --thread-safe-nodes) thread_safe_nodes=ON;;
+    --no-thread-safe-nodes) thread_safe_nodes=OFF;;
+
     --editline) editline=ON;;
     --no-editline) editline=OFF;;
 
@@ -431,6 +436,8 @@ cmake_opts=""
   && cmake_opts="$cmake_opts -DENABLE_VALGRIND=$valgrind"
 [ $profiling != default ] \
   && cmake_opts="$cmake_opts -DENABLE_PROFILING=$profiling"
+[ $thread_safe_nodes != default ] \
+  && cmake_opts="$cmake_opts -DENABLE_THREAD_SAFE_NODES=$thread_safe_nodes"
 [ $editline != default ] \
   && cmake_opts="$cmake_opts -DUSE_EDITLINE=$editline"
 [ $abc != default ] \
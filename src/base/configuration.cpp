@@ -88,6 +88,11 @@ bool Configuration::isCompetitionBuild() {
   return IS_COMPETITION_BUILD;
 }
 
+bool Configuration::isThreadSafeNodesBuild()
+{
+  return IS_THREAD_SAFE_NODES_BUILD;
+}
+
 bool Configuration::isStaticBuild()
 {
 #if defined(CVC4_STATIC_BUILD)
@@ -84,6 +84,12 @@ namespace CVC4 {
 #  define IS_COMPETITION_BUILD false
 #endif /* CVC4_COMPETITION_MODE */
 
+#ifdef CVC4_THREAD_SAFE_NODES
+#  define IS_THREAD_SAFE_NODES_BUILD true
+#else /* CVC4_THREAD_SAFE_NODES */
+#  define IS_THREAD_SAFE_NODES_BUILD false
+#endif /* CVC4_THREAD_SAFE_NODES */
+
 #ifdef CVC4_GMP_IMP
 #  define IS_GMP_BUILD true
 #else /* CVC4_GMP_IMP */
@@ -0,0 +1,179 @@
+/*********************                                                        */
+/*! \file cdtrail.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Context-dependent values and lists backtracked with the trail
+ **
+ ** Counterparts of CDO and CDList that are backtracked with the undo log of
+ ** their Context (see ContextTrail) instead of being ContextObj objects.
+ ** They save a single word per level they are modified at, and popping a
+ ** level does not call any virtual method on them, which makes them cheaper
+ ** for the hot context-dependent data of the theory solvers.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__CONTEXT__CDTRAIL_H
+#define CVC4__CONTEXT__CDTRAIL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "base/check.h"
+#include "context/context.h"
+#include "context/context_trail.h"
+
+namespace CVC4 {
+namespace context {
+
+/**
+ * A context-dependent value, like CDO, for trivially copyable types of at
+ * most 8 bytes.
+ */
+template <class T>
+class CDTrailValue
+{
+ public:
+  /**
+   * Create a CDTrailValue of the given context with the given value.  Like a
+   * CDO, it has that value in the levels below the current one, too.
+   */
+  CDTrailValue(Context* context, const T& data = T())
+      : d_trail(context->getTrail()),
+        d_data(data),
+        d_epoch(d_trail->getEpoch()),
+        d_last(s_none)
+  {
+  }
+
+  /**
+   * Drop the entries of this value from the trail, following the chain of
+   * its saves; this is linear in the number of levels it was saved at.
+   */
+  ~CDTrailValue()
+  {
+    size_t i = d_last;
+    while (i != s_none)
+    {
+      size_t prev = d_trail->getSaved<size_t>(i + 2);
+      d_trail->forget(i, i + 3);
+      i = prev;
+    }
+  }
+
+  CDTrailValue(const CDTrailValue&) = delete;
+  CDTrailValue& operator=(const CDTrailValue&) = delete;
+
+  /**
+   * Set the value, saving the old one the first time it is set at the
+   * current level.
+   */
+  void set(const T& data)
+  {
+    if (d_epoch != d_trail->getEpoch())
+    {
+      size_t index = d_trail->size();
+      d_trail->save(&d_data);
+      d_trail->save(&d_epoch);
+      d_trail->save(&d_last);
+      d_epoch = d_trail->getEpoch();
+      d_last = index;
+    }
+    d_data = data;
+  }
+
+  /** Get the value. */
+  const T& get() const { return d_data; }
+
+  /** For convenience, define operator T() to be the same as get(). */
+  operator T() const { return get(); }
+
+  /** For convenience, define operator= that takes an object of type T. */
+  CDTrailValue& operator=(const T& data)
+  {
+    set(data);
+    return *this;
+  }
+
+ private:
+  /** The undo log of the context */
+  ContextTrail* d_trail;
+  /** The value */
+  T d_data;
+  /** The epoch of the level d_data was last saved at */
+  uint64_t d_epoch;
+  /**
+   * The index in the trail of the last save of d_data, followed by those of
+   * d_epoch and d_last; the old value of d_last links to the previous save.
+   */
+  size_t d_last;
+
+  /** The value of d_last before the first save */
+  static constexpr size_t s_none = static_cast<size_t>(-1);
+}; /* class CDTrailValue */
+
+/**
+ * A context-dependent list, like CDList, whose elements are kept in a
+ * std::vector and whose size is a CDTrailValue.  Only the size is restored
+ * on pop; the elements past the size are destroyed lazily, by the next
+ * push_back().
+ */
+template <class T>
+class CDTrailList
+{
+ public:
+  typedef const T* const_iterator;
+
+  CDTrailList(Context* context) : d_size(context, 0) {}
+
+  /** Return the current size of the list. */
+  size_t size() const { return d_size; }
+
+  /** Return true iff the list is empty. */
+  bool empty() const { return d_size == 0; }
+
+  /** Add an element to the end of the list. */
+  void push_back(const T& data)
+  {
+    size_t size = d_size;
+    if (d_list.size() > size)
+    {
+      d_list.erase(d_list.begin() + size, d_list.end());
+    }
+    d_list.push_back(data);
+    d_size = size + 1;
+  }
+
+  /** Access the ith element of the list. */
+  const T& operator[](size_t i) const
+  {
+    Assert(i < d_size) << "index out of bounds in CDTrailList::operator[]";
+    return d_list[i];
+  }
+
+  /** Return the last element of the list. */
+  const T& back() const
+  {
+    Assert(d_size > 0) << "CDTrailList::back() called on empty list";
+    return d_list[d_size - 1];
+  }
+
+  const_iterator begin() const { return d_list.data(); }
+  const_iterator end() const { return d_list.data() + d_size; }
+
+ private:
+  /** The elements, possibly followed by elements of popped levels */
+  std::vector<T> d_list;
+  /** The size of the list */
+  CDTrailValue<size_t> d_size;
+}; /* class CDTrailList */
+
+}  // namespace context
+}  // namespace CVC4
+
+#endif /* CVC4__CONTEXT__CDTRAIL_H */
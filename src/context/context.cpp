@@ -26,9 +26,13 @@ namespace CVC4 {
 namespace context {
 
 
-Context::Context() : d_pCNOpre(NULL), d_pCNOpost(NULL) {
+Context::Context() : Context(ContextMemoryManager::Config()) {}
+
+Context::Context(const ContextMemoryManager::Config& config)
+    : d_pCNOpre(NULL), d_pCNOpost(NULL)
+{
   // Create new memory manager
-  d_pCMM = new ContextMemoryManager();
+  d_pCMM = new ContextMemoryManager(config);
 
   // Create initial Scope
   d_scopeList.push_back(new(d_pCMM) Scope(this, d_pCMM, 0));
@@ -66,6 +70,9 @@ void Context::push() {
   // Create a new memory region
   d_pCMM->push();
 
+  // Start a new level of the undo log
+  d_trail.push();
+
   // Create a new top Scope
   d_scopeList.push_back(new(d_pCMM) Scope(this, d_pCMM, getLevel()+1));
 }
@@ -89,6 +96,9 @@ void Context::pop() {
   // Restore the previous Scope
   d_scopeList.pop_back();
 
+  // Replay the undo log of the top Scope
+  d_trail.pop();
+
   // Restore all objects in the top Scope
   delete pScope;
 
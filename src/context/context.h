@@ -28,6 +28,7 @@
 #include "base/check.h"
 #include "base/output.h"
 #include "context/context_mm.h"
+#include "context/context_trail.h"
 
 
 namespace CVC4 {
@@ -64,6 +65,10 @@ std::ostream& operator<<(std::ostream&, const Scope&);
  * Memory allocation in Contexts is done with the help of the
  * ContextMemoryManager.  A copy is stored in each Scope object for quick
  * access.
+ *
+ * Small context-dependent values may instead be backtracked with the undo
+ * log of the Context (see ContextTrail), which is replayed before the
+ * ContextObj objects of a Scope are restored.
  */
 class Context {
 
@@ -72,6 +77,12 @@ class Context {
    */
   ContextMemoryManager* d_pCMM;
 
+  /**
+   * The undo log of the context-dependent data using trail-based
+   * backtracking (see cdtrail.h).
+   */
+  ContextTrail d_trail;
+
   /**
    * List of all scopes for this context.
    */
@@ -145,6 +156,12 @@ public:
    */
   Context();
 
+  /**
+   * Constructor: create ContextMemoryManager with the given configuration
+   * and initial Scope
+   */
+  explicit Context(const ContextMemoryManager::Config& config);
+
   /**
    * Destructor: pop all scopes, delete ContextMemoryManager
    */
@@ -170,6 +187,11 @@ public:
    */
   ContextMemoryManager* getCMM() { return d_pCMM; }
 
+  /**
+   * Return the undo log of the context.
+   */
+  ContextTrail* getTrail() { return &d_trail; }
+
   /**
    * Save the current state, create a new Scope
    */
@@ -210,6 +232,10 @@ private:
   UserContext& operator=(const UserContext&) = delete;
 public:
   UserContext() {}
+  explicit UserContext(const ContextMemoryManager::Config& config)
+      : Context(config)
+  {
+  }
 };/* class UserContext */
 
 
@@ -15,12 +15,15 @@
  **/
 
 #include <cstdlib>
-#include <deque>
 #include <limits>
 #include <new>
 #include <ostream>
 #include <vector>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif /* __linux__ */
+
 #ifdef CVC4_VALGRIND
 #include <valgrind/memcheck.h>
 #endif /* CVC4_VALGRIND */
@@ -34,6 +37,101 @@ namespace context {
 
 #ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
 
+ContextMemoryManager::Config::Config()
+    : d_chunkSizeBytes(defaultChunkSizeBytes),
+      d_maxFreeChunks(100),
+      d_hugePages(false)
+{
+}
+
+ContextMemoryManager::Statistics::Statistics()
+    : d_chunksAllocated(0),
+      d_chunksReused(0),
+      d_chunksReleased(0),
+      d_peakChunks(0),
+      d_arenas(0)
+{
+}
+
+size_t ContextMemoryManager::arenaSize() const
+{
+  // Arenas are a multiple of the 2 MiB huge page size holding at least one
+  // chunk
+  const size_t hugePageSize = 2 * 1024 * 1024;
+  return (d_config.d_chunkSizeBytes + hugePageSize - 1) / hugePageSize
+         * hugePageSize;
+}
+
+void ContextMemoryManager::newArena()
+{
+#ifdef __linux__
+  size_t size = arenaSize();
+  void* arena = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  // Explicit huge pages, if the system has reserved some
+  arena = mmap(nullptr,
+               size,
+               PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+               -1,
+               0);
+#endif /* MAP_HUGETLB */
+  if (arena == MAP_FAILED)
+  {
+    // Otherwise fall back to transparent huge pages
+    arena = mmap(nullptr,
+                 size,
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS,
+                 -1,
+                 0);
+    if (arena == MAP_FAILED)
+    {
+      throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(arena, size, MADV_HUGEPAGE);
+#endif /* MADV_HUGEPAGE */
+  }
+  d_arenas.push_back(static_cast<char*>(arena));
+  d_arenaNext = d_arenas.back();
+  d_arenaEnd = d_arenaNext + size;
+  ++d_stats.d_arenas;
+#else  /* __linux__ */
+  Unreachable() << "huge page arenas are only supported on Linux";
+#endif /* __linux__ */
+}
+
+char* ContextMemoryManager::allocateChunk()
+{
+  const size_t chunkSize = d_config.d_chunkSizeBytes;
+  char* chunk;
+  if (d_config.d_hugePages)
+  {
+    if (d_arenaNext == nullptr
+        || static_cast<size_t>(d_arenaEnd - d_arenaNext) < chunkSize)
+    {
+      newArena();
+    }
+    chunk = d_arenaNext;
+    d_arenaNext += chunkSize;
+  }
+  else
+  {
+    chunk = (char*)malloc(chunkSize);
+    if (chunk == NULL)
+    {
+      throw std::bad_alloc();
+    }
+  }
+  ++d_stats.d_chunksAllocated;
+
+#ifdef CVC4_VALGRIND
+  VALGRIND_MAKE_MEM_NOACCESS(chunk, chunkSize);
+#endif /* CVC4_VALGRIND */
+  return chunk;
+}
+
 void ContextMemoryManager::newChunk() {
 
   // Increment index to chunk list
@@ -43,40 +141,51 @@ void ContextMemoryManager::newChunk() {
 
   // Create new chunk if no free chunk available
   if(d_freeChunks.empty()) {
-    d_chunkList.push_back((char*)malloc(chunkSizeBytes));
-    if(d_chunkList.back() == NULL) {
-      throw std::bad_alloc();
-    }
-
-#ifdef CVC4_VALGRIND
-    VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), chunkSizeBytes);
-#endif /* CVC4_VALGRIND */
+    d_chunkList.push_back(allocateChunk());
   }
   // If there is a free chunk, use that
   else {
     d_chunkList.push_back(d_freeChunks.back());
     d_freeChunks.pop_back();
+    ++d_stats.d_chunksReused;
+  }
+  if (d_chunkList.size() > d_stats.d_peakChunks)
+  {
+    d_stats.d_peakChunks = d_chunkList.size();
   }
   // Set up the current chunk pointers
   d_nextFree = d_chunkList.back();
-  d_endChunk = d_nextFree + chunkSizeBytes;
+  d_endChunk = d_nextFree + d_config.d_chunkSizeBytes;
 }
 
+ContextMemoryManager::ContextMemoryManager()
+    : ContextMemoryManager(Config())
+{
+}
 
-ContextMemoryManager::ContextMemoryManager() : d_indexChunkList(0) {
-  // Create initial chunk
-  d_chunkList.push_back((char*)malloc(chunkSizeBytes));
-  d_nextFree = d_chunkList.back();
-  if(d_nextFree == NULL) {
-    throw std::bad_alloc();
-  }
-  d_endChunk = d_nextFree + chunkSizeBytes;
+ContextMemoryManager::ContextMemoryManager(const Config& config)
+    : d_config(config),
+      d_indexChunkList(0),
+      d_levelBytes(0),
+      d_arenaNext(nullptr),
+      d_arenaEnd(nullptr)
+{
+  AlwaysAssert(d_config.d_chunkSizeBytes >= defaultChunkSizeBytes)
+      << "chunk size must be at least " << defaultChunkSizeBytes << " bytes";
+#ifndef __linux__
+  d_config.d_hugePages = false;
+#endif /* __linux__ */
 
 #ifdef CVC4_VALGRIND
   VALGRIND_CREATE_MEMPOOL(this, 0, false);
-  VALGRIND_MAKE_MEM_NOACCESS(d_nextFree, chunkSizeBytes);
   d_allocations.push_back(std::vector<char*>());
 #endif /* CVC4_VALGRIND */
+
+  // Create initial chunk
+  d_chunkList.push_back(allocateChunk());
+  d_stats.d_peakChunks = 1;
+  d_nextFree = d_chunkList.back();
+  d_endChunk = d_nextFree + d_config.d_chunkSizeBytes;
 }
 
 
@@ -85,14 +194,26 @@ ContextMemoryManager::~ContextMemoryManager() {
   VALGRIND_DESTROY_MEMPOOL(this);
 #endif /* CVC4_VALGRIND */
 
+  if (d_config.d_hugePages)
+  {
+#ifdef __linux__
+    // All chunks are part of the arenas
+    for (char* arena : d_arenas)
+    {
+      munmap(arena, arenaSize());
+    }
+#endif /* __linux__ */
+    return;
+  }
+
   // Delete all chunks
-  while(!d_chunkList.empty()) {
-    free(d_chunkList.back());
-    d_chunkList.pop_back();
+  for (char* chunk : d_chunkList)
+  {
+    free(chunk);
   }
-  while(!d_freeChunks.empty()) {
-    free(d_freeChunks.back());
-    d_freeChunks.pop_back();
+  for (char* chunk : d_freeChunks)
+  {
+    free(chunk);
   }
 }
 
@@ -109,6 +230,7 @@ void* ContextMemoryManager::newData(size_t size) {
     AlwaysAssert(d_nextFree <= d_endChunk)
         << "Request is bigger than memory chunk size";
   }
+  d_levelBytes += size;
   Debug("context") << "ContextMemoryManager::newData(" << size
                    << ") returning " << res << " at level "
                    << d_chunkList.size() << std::endl;
@@ -128,9 +250,9 @@ void ContextMemoryManager::push() {
 #endif /* CVC4_VALGRIND */
 
   // Store current state on the stack
-  d_nextFreeStack.push_back(d_nextFree);
-  d_endChunkStack.push_back(d_endChunk);
-  d_indexChunkListStack.push_back(d_indexChunkList);
+  d_regionStack.push_back(
+      Region{d_nextFree, d_endChunk, d_indexChunkList, d_levelBytes});
+  d_levelBytes = 0;
 }
 
 
@@ -143,31 +265,61 @@ void ContextMemoryManager::pop() {
   d_allocations.pop_back();
 #endif /* CVC4_VALGRIND */
 
-  Assert(d_nextFreeStack.size() > 0 && d_endChunkStack.size() > 0);
+  Assert(d_regionStack.size() > 0);
+
+  // Record the bytes allocated at the popped level
+  size_t level = d_regionStack.size();
+  if (d_peakBytes.size() <= level)
+  {
+    d_peakBytes.resize(level + 1, 0);
+  }
+  if (d_levelBytes > d_peakBytes[level])
+  {
+    d_peakBytes[level] = d_levelBytes;
+  }
 
   // Restore state from stack
-  d_nextFree = d_nextFreeStack.back();
-  d_nextFreeStack.pop_back();
-  d_endChunk = d_endChunkStack.back();
-  d_endChunkStack.pop_back();
+  const Region& region = d_regionStack.back();
+  d_nextFree = region.d_nextFree;
+  d_endChunk = region.d_endChunk;
+  d_levelBytes = region.d_levelBytes;
 
   // Free all the new chunks since the last push
-  while(d_indexChunkList > d_indexChunkListStack.back()) {
+  while (d_indexChunkList > region.d_indexChunkList)
+  {
     d_freeChunks.push_back(d_chunkList.back());
 #ifdef CVC4_VALGRIND
-    VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), chunkSizeBytes);
+    VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), d_config.d_chunkSizeBytes);
 #endif /* CVC4_VALGRIND */
     d_chunkList.pop_back();
     --d_indexChunkList;
   }
-  d_indexChunkListStack.pop_back();
+  d_regionStack.pop_back();
 
-  // Delete excess free chunks
-  while(d_freeChunks.size() > maxFreeChunks) {
-    free(d_freeChunks.front());
-    d_freeChunks.pop_front();
+  // Delete excess free chunks, the least recently used first
+  if (d_config.d_maxFreeChunks > 0 && !d_config.d_hugePages
+      && d_freeChunks.size() > d_config.d_maxFreeChunks)
+  {
+    size_t excess = d_freeChunks.size() - d_config.d_maxFreeChunks;
+    for (size_t i = 0; i < excess; ++i)
+    {
+      free(d_freeChunks[i]);
+    }
+    d_freeChunks.erase(d_freeChunks.begin(), d_freeChunks.begin() + excess);
+    d_stats.d_chunksReleased += excess;
+  }
+}
+
+size_t ContextMemoryManager::getPeakBytes(size_t level) const
+{
+  size_t peak = level < d_peakBytes.size() ? d_peakBytes[level] : 0;
+  if (level == d_regionStack.size() && d_levelBytes > peak)
+  {
+    peak = d_levelBytes;
   }
+  return peak;
 }
+
 #else
 
 unsigned ContextMemoryManager::getMaxAllocationSize()
@@ -20,14 +20,20 @@
 #ifndef CVC4__CONTEXT__CONTEXT_MM_H
 #define CVC4__CONTEXT__CONTEXT_MM_H
 
-#ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
-#include <deque>
-#endif
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace CVC4 {
 namespace context {
 
+/**
+ * The default chunk size of both implementations of ContextMemoryManager
+ * below.
+ */
+constexpr size_t defaultContextChunkSizeBytes = 16384;
+
 #ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
 
 /**
@@ -39,19 +45,75 @@ namespace context {
  * stack, and a new current region is created.  A subsequent call to pop
  * releases the new region and restores the top region from the stack.
  *
+ * The chunks released by pop are kept for reuse by later regions, up to a
+ * configurable watermark (see Config), so that search with frequent
+ * backtracking does not keep returning chunks to malloc.
  */
 class ContextMemoryManager {
-
+ public:
   /**
-   * Memory in regions is allocated in chunks.  This is the chunk size
+   * The default chunk size, which is also the maximum allocation size (see
+   * getMaxAllocationSize()).
    */
-  static const unsigned chunkSizeBytes = 16384;
+  static constexpr size_t defaultChunkSizeBytes = defaultContextChunkSizeBytes;
 
-  /**
-   * A list of free chunks is maintained.  This is the maximum number of
-   * free chunks.
-   */
-  static const unsigned maxFreeChunks = 100;
+  /** The configuration of a memory manager. */
+  struct Config
+  {
+    Config();
+    /**
+     * The size of the chunks regions are allocated in.  Must be at least
+     * defaultChunkSizeBytes.
+     */
+    size_t d_chunkSizeBytes;
+    /**
+     * The maximum number of free chunks kept for reuse (100 by default), 0
+     * for no limit.  The free chunks never outnumber the peak number of
+     * chunks in use, so without a limit the memory manager holds on to its
+     * peak footprint.
+     */
+    size_t d_maxFreeChunks;
+    /**
+     * Whether to carve chunks out of large mmap-backed arenas, requesting
+     * huge pages for them (Linux only, ignored elsewhere).  Chunks of
+     * arenas are only returned to the system on destruction, so
+     * d_maxFreeChunks is ignored.
+     */
+    bool d_hugePages;
+  };
+
+  /** Statistics of a memory manager. */
+  struct Statistics
+  {
+    Statistics();
+    /** The number of chunks newly allocated */
+    uint64_t d_chunksAllocated;
+    /** The number of chunks taken from the free chunks */
+    uint64_t d_chunksReused;
+    /** The number of free chunks returned to the system */
+    uint64_t d_chunksReleased;
+    /** The peak number of chunks in use */
+    uint64_t d_peakChunks;
+    /** The number of huge page arenas mapped */
+    uint64_t d_arenas;
+  };
+
+ private:
+  /** A saved region, the state of the current region at a push */
+  struct Region
+  {
+    /** The saved value of d_nextFree */
+    char* d_nextFree;
+    /** The saved value of d_endChunk */
+    char* d_endChunk;
+    /** The saved value of d_indexChunkList */
+    size_t d_indexChunkList;
+    /** The saved value of d_levelBytes */
+    size_t d_levelBytes;
+  };
+
+  /** The configuration of this memory manager */
+  Config d_config;
 
   /**
    * List of all chunks that are currently active
@@ -59,9 +121,9 @@ class ContextMemoryManager {
   std::vector<char*> d_chunkList;
 
   /**
-   * Queue of free chunks (for best cache performance, LIFO order is used)
+   * Stack of free chunks (for best cache performance, LIFO order is used)
    */
-  std::deque<char*> d_freeChunks;
+  std::vector<char*> d_freeChunks;
 
   /**
    * Pointer to the beginning of available memory in the current chunk in
@@ -78,25 +140,33 @@ class ContextMemoryManager {
   /**
    * The index in d_chunkList of the current chunk in the current region
    */
-  unsigned d_indexChunkList;
+  size_t d_indexChunkList;
 
   /**
-   * Part of the stack of saved regions.  This vector stores the saved value
-   * of d_nextFree
+   * The stack of saved regions.
    */
-  std::vector<char*> d_nextFreeStack;
+  std::vector<Region> d_regionStack;
 
-  /**
-   * Part of the stack of saved regions.  This vector stores the saved value
-   * of d_endChunk.
-   */
-  std::vector<char*> d_endChunkStack;
+  /** The number of bytes allocated in the current region */
+  size_t d_levelBytes;
 
   /**
-   * Part of the stack of saved regions.  This vector stores the saved value
-   * of d_indexChunkList
+   * The peak number of bytes allocated per level, not including the current
+   * region (see getPeakBytes()).
    */
-  std::vector<unsigned> d_indexChunkListStack;
+  std::vector<size_t> d_peakBytes;
+
+  /** The huge page arenas, released on destruction */
+  std::vector<char*> d_arenas;
+
+  /** The next unused chunk in the current arena */
+  char* d_arenaNext;
+
+  /** One past the last byte of the current arena */
+  char* d_arenaEnd;
+
+  /** The statistics of this memory manager */
+  Statistics d_stats;
 
   /**
    * Private method to grab a new chunk for the current region.  Uses chunk
@@ -105,6 +175,15 @@ class ContextMemoryManager {
    */
   void newChunk();
 
+  /** Allocate a fresh chunk, from malloc or the current arena. */
+  char* allocateChunk();
+
+  /** The size of the huge page arenas. */
+  size_t arenaSize() const;
+
+  /** Map a new huge page arena and make it the current arena. */
+  void newArena();
+
 #ifdef CVC4_VALGRIND
   /**
    * Vector of allocations for each level. Used for accurately marking
@@ -118,7 +197,7 @@ class ContextMemoryManager {
    * Get the maximum allocation size for this memory manager.
    */
   static unsigned getMaxAllocationSize() {
-    return chunkSizeBytes;
+    return defaultChunkSizeBytes;
   }
 
   /**
@@ -126,6 +205,12 @@ class ContextMemoryManager {
    */
   ContextMemoryManager();
 
+  /**
+   * Constructor - creates an initial region and an empty stack, with the
+   * given configuration
+   */
+  explicit ContextMemoryManager(const Config& config);
+
   /**
    * Destructor - deletes all memory in all regions
    */
@@ -147,6 +232,36 @@ class ContextMemoryManager {
    */
   void pop();
 
+  /** Get the configuration of this memory manager. */
+  const Config& getConfig() const { return d_config; }
+
+  /** Get the statistics of this memory manager. */
+  const Statistics& getStatistics() const { return d_stats; }
+
+  /** Get the current level, i.e., the number of saved regions. */
+  size_t getLevel() const { return d_regionStack.size(); }
+
+  /**
+   * Get the peak number of bytes allocated at the given level, over all the
+   * regions so far at that level.
+   */
+  size_t getPeakBytes(size_t level) const;
+
+  /**
+   * Get the number of levels getPeakBytes() reports on, i.e., one more than
+   * the deepest level so far.
+   */
+  size_t getNumPeakLevels() const
+  {
+    return std::max(d_peakBytes.size(), d_regionStack.size() + 1);
+  }
+
+  /** Get the number of chunks in use. */
+  size_t getNumChunks() const { return d_chunkList.size(); }
+
+  /** Get the number of free chunks kept for reuse. */
+  size_t getNumFreeChunks() const { return d_freeChunks.size(); }
+
 };/* class ContextMemoryManager */
 
 #else /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
@@ -164,7 +279,31 @@ class ContextMemoryManager
  public:
   static unsigned getMaxAllocationSize();
 
+  /** The default chunk size, as in the implementation above. */
+  static constexpr size_t defaultChunkSizeBytes = defaultContextChunkSizeBytes;
+
+  /** The configuration, ignored by this implementation. */
+  struct Config
+  {
+    size_t d_chunkSizeBytes = defaultChunkSizeBytes;
+    size_t d_maxFreeChunks = 100;
+    bool d_hugePages = false;
+  };
+
+  /** The statistics, which stay 0 in this implementation. */
+  struct Statistics
+  {
+    uint64_t d_chunksAllocated = 0;
+    uint64_t d_chunksReused = 0;
+    uint64_t d_chunksReleased = 0;
+    uint64_t d_peakChunks = 0;
+    uint64_t d_arenas = 0;
+  };
+
   ContextMemoryManager() { d_allocations.push_back(std::vector<char*>()); }
+  explicit ContextMemoryManager(const Config& config) : ContextMemoryManager()
+  {
+  }
   ~ContextMemoryManager()
   {
     for (const auto& levelAllocs : d_allocations)
@@ -194,8 +333,15 @@ class ContextMemoryManager
     d_allocations.pop_back();
   }
 
+  const Statistics& getStatistics() const { return d_stats; }
+
+  size_t getPeakBytes(size_t level) const { return 0; }
+
+  size_t getNumPeakLevels() const { return 0; }
+
  private:
   std::vector<std::vector<char*>> d_allocations;
+  Statistics d_stats;
 }; /* ContextMemoryManager */
 
 #endif /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
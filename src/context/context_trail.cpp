@@ -0,0 +1,65 @@
+/*********************                                                        */
+/*! \file context_trail.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Undo log for trail-based backtracking of context-dependent data
+ **
+ ** Undo log for trail-based backtracking of context-dependent data.
+ **/
+
+#include "context/context_trail.h"
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace context {
+
+ContextTrail::ContextTrail() : d_epoch(0), d_nextEpoch(1), d_sink(0) {}
+
+void ContextTrail::push()
+{
+  d_marks.push_back(d_entries.size());
+  d_epochs.push_back(d_epoch);
+  d_epoch = d_nextEpoch++;
+}
+
+void ContextTrail::pop()
+{
+  Assert(!d_marks.empty()) << "Cannot pop the trail below level 0";
+  const Entry* begin = d_entries.data() + d_marks.back();
+  const Entry* e = d_entries.data() + d_entries.size();
+  while (e != begin)
+  {
+    --e;
+    // constant-size copies, compiled to single moves
+    switch (e->d_size)
+    {
+      case 1: std::memcpy(e->d_addr, &e->d_old, 1); break;
+      case 2: std::memcpy(e->d_addr, &e->d_old, 2); break;
+      case 4: std::memcpy(e->d_addr, &e->d_old, 4); break;
+      case 8: std::memcpy(e->d_addr, &e->d_old, 8); break;
+      default: std::memcpy(e->d_addr, &e->d_old, e->d_size); break;
+    }
+  }
+  d_entries.resize(d_marks.back());
+  d_marks.pop_back();
+  d_epoch = d_epochs.back();
+  d_epochs.pop_back();
+}
+
+void ContextTrail::forget(size_t begin, size_t end)
+{
+  Assert(begin <= end && end <= d_entries.size());
+  for (size_t i = begin; i < end; ++i)
+  {
+    d_entries[i].d_addr = &d_sink;
+  }
+}
+
+}  // namespace context
+}  // namespace CVC4
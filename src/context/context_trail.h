@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file context_trail.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Undo log for trail-based backtracking of context-dependent data
+ **
+ ** An undo log of (address, old value) entries, as an alternative to the
+ ** save()/restore() scheme of ContextObj for small context-dependent values.
+ ** Restoring a level replays its entries in a tight loop, instead of calling
+ ** restore() on every object modified at that level.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__CONTEXT__CONTEXT_TRAIL_H
+#define CVC4__CONTEXT__CONTEXT_TRAIL_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace context {
+
+/**
+ * The undo log of a Context.  Context-dependent data using the trail (see
+ * cdtrail.h) calls save() with the address of a word before changing it at
+ * a level; popping the level writes the old values back, in reverse order.
+ *
+ * Each push starts a new epoch, identifying the current level until it is
+ * popped.  Data can remember the epoch of its last save() to save each word
+ * only once per level.
+ *
+ * Data that saved words must outlive the levels it saved them at, or call
+ * forget() on its entries on destruction.  Entries are identified by their
+ * index in the trail, which does not change until their level is popped.
+ */
+class ContextTrail
+{
+ public:
+  ContextTrail();
+
+  /**
+   * Save the current value of *addr, to be restored when the current level is
+   * popped.  T must be trivially copyable and at most 8 bytes.
+   */
+  template <class T>
+  void save(T* addr)
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable values can be trailed");
+    static_assert(sizeof(T) <= sizeof(uint64_t),
+                  "only values of at most 8 bytes can be trailed");
+    Entry e;
+    e.d_addr = addr;
+    e.d_old = 0;
+    std::memcpy(&e.d_old, addr, sizeof(T));
+    e.d_size = sizeof(T);
+    d_entries.push_back(e);
+  }
+
+  /**
+   * Get the old value saved by the entry at the given index, which must have
+   * been saved from a T.
+   */
+  template <class T>
+  T getSaved(size_t index) const
+  {
+    Assert(index < d_entries.size());
+    Assert(d_entries[index].d_size == sizeof(T));
+    T old;
+    std::memcpy(&old, &d_entries[index].d_old, sizeof(T));
+    return old;
+  }
+
+  /** Get the epoch of the current level. */
+  uint64_t getEpoch() const { return d_epoch; }
+
+  /** Get the number of entries in the trail. */
+  size_t size() const { return d_entries.size(); }
+
+  /** Start a new level. */
+  void push();
+
+  /** Restore the words saved at the current level, and pop it. */
+  void pop();
+
+  /**
+   * Drop the entries at the indices in [begin, end), whose words are not to
+   * be restored anymore, e.g. because they are being destroyed.  Their old
+   * values can still be read with getSaved().
+   */
+  void forget(size_t begin, size_t end);
+
+ private:
+  /** An entry of the trail, the old value of a word */
+  struct Entry
+  {
+    /** The address of the word */
+    void* d_addr;
+    /** The old value of the word, in its first d_size bytes */
+    uint64_t d_old;
+    /** The size of the word */
+    uint32_t d_size;
+  };
+
+  /** The entries of all levels */
+  std::vector<Entry> d_entries;
+  /** The size of the trail at the start of each level above level 0 */
+  std::vector<size_t> d_marks;
+  /** The epochs of the levels below the current one */
+  std::vector<uint64_t> d_epochs;
+  /** The epoch of the current level */
+  uint64_t d_epoch;
+  /** The next epoch to start */
+  uint64_t d_nextEpoch;
+  /** The target of forgotten entries */
+  uint64_t d_sink;
+}; /* class ContextTrail */
+
+}  // namespace context
+}  // namespace CVC4
+
+#endif /* CVC4__CONTEXT__CONTEXT_TRAIL_H */
@@ -43,6 +43,9 @@ void AttributeManager::debugHook(int debugFlag) {
 }
 
 void AttributeManager::deleteAllAttributes(NodeValue* nv) {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::recursive_mutex> guard(d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
   Assert(!inGarbageCollection());
   d_bools.erase(nv);
   deleteFromTable(d_ints, nv);
@@ -50,18 +53,36 @@ void AttributeManager::deleteAllAttributes(NodeValue* nv) {
   deleteFromTable(d_nodes, nv);
   deleteFromTable(d_types, nv);
   deleteFromTable(d_strings, nv);
+  d_denseBools.erase(nv);
+  d_denseInts.erase(nv);
+  d_denseTNodes.erase(nv);
+  d_denseNodes.erase(nv);
+  d_denseTypes.erase(nv);
+  d_denseStrings.erase(nv);
 }
 
 void AttributeManager::deleteAllAttributes() {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::recursive_mutex> guard(d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
   d_bools.clear();
   deleteAllFromTable(d_ints);
   deleteAllFromTable(d_tnodes);
   deleteAllFromTable(d_nodes);
   deleteAllFromTable(d_types);
   deleteAllFromTable(d_strings);
+  d_denseBools.clear();
+  d_denseInts.clear();
+  d_denseTNodes.clear();
+  d_denseNodes.clear();
+  d_denseTypes.clear();
+  d_denseStrings.clear();
 }
 
 void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::recursive_mutex> guard(d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
   typedef std::map<uint64_t, std::vector< uint64_t> > AttrToVecMap;
   AttrToVecMap perTableIds;
 
@@ -83,18 +104,23 @@ void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
       break;
     case AttrTableUInt64:
       deleteAttributesFromTable(d_ints, ids);
+      d_denseInts.eraseAttributes(ids);
       break;
     case AttrTableTNode:
       deleteAttributesFromTable(d_tnodes, ids);
+      d_denseTNodes.eraseAttributes(ids);
       break;
     case AttrTableNode:
       deleteAttributesFromTable(d_nodes, ids);
+      d_denseNodes.eraseAttributes(ids);
       break;
     case AttrTableTypeNode:
       deleteAttributesFromTable(d_types, ids);
+      d_denseTypes.eraseAttributes(ids);
       break;
     case AttrTableString:
       deleteAttributesFromTable(d_strings, ids);
+      d_denseStrings.eraseAttributes(ids);
       break;
 
     case AttrTableCDBool:
@@ -24,6 +24,9 @@
 #ifndef CVC4__EXPR__ATTRIBUTE_H
 #define CVC4__EXPR__ATTRIBUTE_H
 
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <mutex>
+#endif /* CVC4_THREAD_SAFE_NODES */
 #include <string>
 #include "expr/attribute_unique_id.h"
 
@@ -46,7 +49,9 @@ namespace attr {
  * domain of an Attribute does not increase a Node's reference count.) To
  * achieve this special relationship with Nodes, Attributes are mapped by hash
  * tables (AttrHash<> and CDAttrHash<>) that live in the AttributeManager. The
- * AttributeManager is owned by the NodeManager.
+ * AttributeManager is owned by the NodeManager. Attributes that are set on
+ * most nodes may instead be stored in tables indexed by node id
+ * (DenseAttrTable<>), see UseDenseStorage.
  *
  * Example:
  *
@@ -103,6 +108,15 @@ class AttributeManager {
 
   bool d_inGarbageCollection;
 
+#ifdef CVC4_THREAD_SAFE_NODES
+  /**
+   * Guards the tables.  Recursive, since setting or deleting a node-valued
+   * attribute may release a node and reclaim zombies, which deletes their
+   * attributes.  Single-threaded builds take no lock at all.
+   */
+  mutable std::recursive_mutex d_mutex;
+#endif /* CVC4_THREAD_SAFE_NODES */
+
   void clearDeleteAllAttributesBuffer();
 
 public:
@@ -111,7 +125,7 @@ public:
   AttributeManager();
 
   // IF YOU ADD ANY TABLES, don't forget to add them also to the
-  // implementation of deleteAllAttributes().
+  // implementation of deleteAllAttributes() and deleteAttributes().
 
   /** Underlying hash table for boolean-valued attributes */
   AttrHash<bool> d_bools;
@@ -126,6 +140,14 @@ public:
   /** Underlying hash table for string-valued attributes */
   AttrHash<std::string> d_strings;
 
+  /** Underlying dense tables for attributes that opted into UseDenseStorage */
+  DenseAttrTable<bool> d_denseBools;
+  DenseAttrTable<uint64_t> d_denseInts;
+  DenseAttrTable<TNode> d_denseTNodes;
+  DenseAttrTable<Node> d_denseNodes;
+  DenseAttrTable<TypeNode> d_denseTypes;
+  DenseAttrTable<std::string> d_denseStrings;
+
   /**
    * Get a particular attribute on a particular node.
    *
@@ -226,7 +248,8 @@ namespace attr {
 
 /**
  * The getTable<> template provides (static) access to the
- * AttributeManager field holding the table.
+ * AttributeManager fields holding the hash table and the dense table
+ * (see UseDenseStorage) for a table value type.
  *
  * The `Enable` template parameter is used to instantiate the template
  * conditionally: If the template substitution of Enable fails (e.g. when using
@@ -247,6 +270,13 @@ struct getTable<bool, false> {
   static inline const table_type& get(const AttributeManager& am) {
     return am.d_bools;
   }
+  typedef DenseAttrTable<bool> dense_table_type;
+  static inline dense_table_type& getDense(AttributeManager& am) {
+    return am.d_denseBools;
+  }
+  static inline const dense_table_type& getDense(const AttributeManager& am) {
+    return am.d_denseBools;
+  }
 };
 
 /** Access the "d_ints" member of AttributeManager. */
@@ -264,6 +294,13 @@ struct getTable<T,
   static inline const table_type& get(const AttributeManager& am) {
     return am.d_ints;
   }
+  typedef DenseAttrTable<uint64_t> dense_table_type;
+  static inline dense_table_type& getDense(AttributeManager& am) {
+    return am.d_denseInts;
+  }
+  static inline const dense_table_type& getDense(const AttributeManager& am) {
+    return am.d_denseInts;
+  }
 };
 
 /** Access the "d_tnodes" member of AttributeManager. */
@@ -277,6 +314,13 @@ struct getTable<TNode, false> {
   static inline const table_type& get(const AttributeManager& am) {
     return am.d_tnodes;
   }
+  typedef DenseAttrTable<TNode> dense_table_type;
+  static inline dense_table_type& getDense(AttributeManager& am) {
+    return am.d_denseTNodes;
+  }
+  static inline const dense_table_type& getDense(const AttributeManager& am) {
+    return am.d_denseTNodes;
+  }
 };
 
 /** Access the "d_nodes" member of AttributeManager. */
@@ -290,6 +334,13 @@ struct getTable<Node, false> {
   static inline const table_type& get(const AttributeManager& am) {
     return am.d_nodes;
   }
+  typedef DenseAttrTable<Node> dense_table_type;
+  static inline dense_table_type& getDense(AttributeManager& am) {
+    return am.d_denseNodes;
+  }
+  static inline const dense_table_type& getDense(const AttributeManager& am) {
+    return am.d_denseNodes;
+  }
 };
 
 /** Access the "d_types" member of AttributeManager. */
@@ -303,6 +354,13 @@ struct getTable<TypeNode, false> {
   static inline const table_type& get(const AttributeManager& am) {
     return am.d_types;
   }
+  typedef DenseAttrTable<TypeNode> dense_table_type;
+  static inline dense_table_type& getDense(AttributeManager& am) {
+    return am.d_denseTypes;
+  }
+  static inline const dense_table_type& getDense(const AttributeManager& am) {
+    return am.d_denseTypes;
+  }
 };
 
 /** Access the "d_strings" member of AttributeManager. */
@@ -316,6 +374,13 @@ struct getTable<std::string, false> {
   static inline const table_type& get(const AttributeManager& am) {
     return am.d_strings;
   }
+  typedef DenseAttrTable<std::string> dense_table_type;
+  static inline dense_table_type& getDense(AttributeManager& am) {
+    return am.d_denseStrings;
+  }
+  static inline const dense_table_type& getDense(const AttributeManager& am) {
+    return am.d_denseStrings;
+  }
 };
 
 }/* CVC4::expr::attr namespace */
@@ -328,11 +393,26 @@ namespace attr {
 template <class AttrKind>
 typename AttrKind::value_type
 AttributeManager::getAttribute(NodeValue* nv, const AttrKind&) const {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::recursive_mutex> guard(d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
   typedef typename AttrKind::value_type value_type;
   typedef KindValueToTableValueMapping<value_type> mapping;
   typedef typename getTable<value_type, AttrKind::context_dependent>::
             table_type table_type;
 
+  if (UseDenseStorage<AttrKind>::value)
+  {
+    typename getTable<value_type, AttrKind::context_dependent>::
+        dense_table_type::data_type v;
+    if (!getTable<value_type, AttrKind::context_dependent>::getDense(*this).get(
+            AttrKind::getId(), nv, v))
+    {
+      return typename AttrKind::value_type();
+    }
+    return mapping::convertBack(v);
+  }
+
   const table_type& ah =
     getTable<value_type, AttrKind::context_dependent>::get(*this);
   typename table_type::const_iterator i =
@@ -376,6 +456,22 @@ struct HasAttribute<true, AttrKind> {
                               AttrKind::context_dependent>::table_type
       table_type;
 
+    if (UseDenseStorage<AttrKind>::value)
+    {
+      typename getTable<value_type, AttrKind::context_dependent>::
+        dense_table_type::data_type v;
+      if (getTable<value_type, AttrKind::context_dependent>::getDense(*am).get(
+              AttrKind::getId(), nv, v))
+      {
+        ret = mapping::convertBack(v);
+      }
+      else
+      {
+        ret = AttrKind::default_value;
+      }
+      return true;
+    }
+
     const table_type& ah =
       getTable<value_type, AttrKind::context_dependent>::get(*am);
     typename table_type::const_iterator i =
@@ -404,6 +500,12 @@ struct HasAttribute<false, AttrKind> {
     typedef typename getTable<value_type, AttrKind::context_dependent>::
               table_type table_type;
 
+    if (UseDenseStorage<AttrKind>::value)
+    {
+      return getTable<value_type, AttrKind::context_dependent>::getDense(*am)
+          .contains(AttrKind::getId(), nv);
+    }
+
     const table_type& ah =
       getTable<value_type, AttrKind::context_dependent>::get(*am);
     typename table_type::const_iterator i =
@@ -424,6 +526,19 @@ struct HasAttribute<false, AttrKind> {
     typedef typename getTable<value_type, AttrKind::context_dependent>::
               table_type table_type;
 
+    if (UseDenseStorage<AttrKind>::value)
+    {
+      typename getTable<value_type, AttrKind::context_dependent>::
+        dense_table_type::data_type v;
+      if (!getTable<value_type, AttrKind::context_dependent>::getDense(*am)
+               .get(AttrKind::getId(), nv, v))
+      {
+        return false;
+      }
+      ret = mapping::convertBack(v);
+      return true;
+    }
+
     const table_type& ah =
       getTable<value_type, AttrKind::context_dependent>::get(*am);
     typename table_type::const_iterator i =
@@ -442,6 +557,9 @@ struct HasAttribute<false, AttrKind> {
 template <class AttrKind>
 bool AttributeManager::hasAttribute(NodeValue* nv,
                                     const AttrKind&) const {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::recursive_mutex> guard(d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
   return HasAttribute<AttrKind::has_default_value, AttrKind>::
            hasAttribute(this, nv);
 }
@@ -450,6 +568,9 @@ template <class AttrKind>
 bool AttributeManager::getAttribute(NodeValue* nv,
                                     const AttrKind&,
                                     typename AttrKind::value_type& ret) const {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::recursive_mutex> guard(d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
   return HasAttribute<AttrKind::has_default_value, AttrKind>::
            getAttribute(this, nv, ret);
 }
@@ -459,11 +580,21 @@ inline void
 AttributeManager::setAttribute(NodeValue* nv,
                                const AttrKind&,
                                const typename AttrKind::value_type& value) {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::recursive_mutex> guard(d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
   typedef typename AttrKind::value_type value_type;
   typedef KindValueToTableValueMapping<value_type> mapping;
   typedef typename getTable<value_type, AttrKind::context_dependent>::
             table_type table_type;
 
+  if (UseDenseStorage<AttrKind>::value)
+  {
+    getTable<value_type, AttrKind::context_dependent>::getDense(*this).set(
+        AttrKind::getId(), nv, mapping::convert(value));
+    return;
+  }
+
   table_type& ah =
       getTable<value_type, AttrKind::context_dependent>::get(*this);
   ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
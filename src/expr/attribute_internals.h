@@ -23,7 +23,10 @@
 #ifndef CVC4__EXPR__ATTRIBUTE_INTERNALS_H
 #define CVC4__EXPR__ATTRIBUTE_INTERNALS_H
 
+#include <memory>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace CVC4 {
 namespace expr {
@@ -365,6 +368,299 @@ public:
 
 }/* CVC4::expr::attr namespace */
 
+// DENSE ATTRIBUTE TABLES ======================================================
+
+namespace attr {
+
+/**
+ * Attribute kinds whose values are stored in a DenseAttrTable instead of an
+ * AttrHash.  An attribute kind opts in by specializing this trait next to its
+ * definition:
+ *
+ * ```
+ * typedef expr::Attribute<expr::attr::TypeTag, TypeNode> TypeAttr;
+ * namespace attr {
+ * template <>
+ * struct UseDenseStorage<TypeAttr> : public std::true_type
+ * {
+ * };
+ * }
+ * ```
+ *
+ * Dense storage pays off for attributes that are queried and set for a large
+ * fraction of all nodes (e.g. the type of a node or the rewrite caches).  For
+ * attributes that are set on a few nodes only, it wastes most of a page per
+ * value, so the hash tables remain the default.
+ */
+template <class AttrKind>
+struct UseDenseStorage : public std::false_type
+{
+};
+
+/** log2 of the number of node ids covered by a page of a DenseAttrTable */
+constexpr uint64_t DENSE_ATTR_PAGE_BITS = 9;
+/** The number of node ids covered by a page of a DenseAttrTable */
+constexpr uint64_t DENSE_ATTR_PAGE_SIZE = uint64_t(1) << DENSE_ATTR_PAGE_BITS;
+
+/**
+ * The values of a page of a DenseAttrTable, i.e. the values of one attribute
+ * kind for DENSE_ATTR_PAGE_SIZE consecutive node ids.
+ */
+template <class value_type>
+class DenseAttrValues
+{
+ public:
+  const value_type& get(uint64_t i) const { return d_values[i]; }
+  void put(uint64_t i, const value_type& v) { d_values[i] = v; }
+  /** Move the value at i out, leaving a default-constructed value. */
+  value_type take(uint64_t i)
+  {
+    value_type v = value_type();
+    std::swap(v, d_values[i]);
+    return v;
+  }
+
+ private:
+  value_type d_values[DENSE_ATTR_PAGE_SIZE];
+};/* class DenseAttrValues<> */
+
+/** Boolean-valued attributes are packed into bitsets. */
+template <>
+class DenseAttrValues<bool>
+{
+ public:
+  DenseAttrValues() : d_bits() {}
+  bool get(uint64_t i) const { return d_bits[i >> 6] & GetBitSet(i & 63); }
+  void put(uint64_t i, bool v)
+  {
+    if (v)
+    {
+      d_bits[i >> 6] |= GetBitSet(i & 63);
+    }
+    else
+    {
+      d_bits[i >> 6] &= ~GetBitSet(i & 63);
+    }
+  }
+  bool take(uint64_t i)
+  {
+    bool v = get(i);
+    put(i, false);
+    return v;
+  }
+
+ private:
+  uint64_t d_bits[DENSE_ATTR_PAGE_SIZE / 64];
+};/* class DenseAttrValues<bool> */
+
+/**
+ * A table of attribute values indexed directly by the (dense) id of the
+ * NodeValue, as an alternative to AttrHash<value_type>.  Each attribute kind
+ * (identified by its id, see LastAttributeId) has its own column, which is a
+ * vector of lazily allocated pages covering DENSE_ATTR_PAGE_SIZE node ids
+ * each.  A page records which of its entries are set, and is released as soon
+ * as the last of them is erased.
+ *
+ * A lookup is two array accesses, instead of hashing a (id, NodeValue*) pair
+ * and probing an unordered_map.
+ */
+template <class value_type>
+class DenseAttrTable
+{
+  struct Page
+  {
+    Page() : d_set(), d_count(0) {}
+    bool isSet(uint64_t i) const
+    {
+      return d_set[i >> 6] & GetBitSet(i & 63);
+    }
+    DenseAttrValues<value_type> d_values;
+    /** Bitset of the entries that have a value */
+    uint64_t d_set[DENSE_ATTR_PAGE_SIZE / 64];
+    /** The number of entries that have a value */
+    uint64_t d_count;
+  };
+  typedef std::vector<std::unique_ptr<Page>> Column;
+  /**
+   * For the node ids of a page, the bitset of the attribute ids set for
+   * them, where id is recorded as bit (id mod 64).
+   */
+  struct MaskPage
+  {
+    MaskPage() : d_mask() {}
+    uint64_t d_mask[DENSE_ATTR_PAGE_SIZE];
+  };
+
+ public:
+  /** The type of the values stored in the table */
+  typedef value_type data_type;
+
+  DenseAttrTable() : d_size(0) {}
+
+  /**
+   * Get the value of attribute id for nv.  Returns false (and leaves ret
+   * unchanged) if it is not set.
+   */
+  bool get(uint64_t id, const NodeValue* nv, value_type& ret) const
+  {
+    const Page* p = getPage(id, nv);
+    const uint64_t i = nv->getId() & (DENSE_ATTR_PAGE_SIZE - 1);
+    if (p == nullptr || !p->isSet(i))
+    {
+      return false;
+    }
+    ret = p->d_values.get(i);
+    return true;
+  }
+
+  /** Is attribute id set for nv? */
+  bool contains(uint64_t id, const NodeValue* nv) const
+  {
+    const Page* p = getPage(id, nv);
+    return p != nullptr
+           && p->isSet(nv->getId() & (DENSE_ATTR_PAGE_SIZE - 1));
+  }
+
+  /** Set attribute id of nv to v. */
+  void set(uint64_t id, const NodeValue* nv, const value_type& v)
+  {
+    if (id >= d_columns.size())
+    {
+      d_columns.resize(id + 1);
+    }
+    Column& c = d_columns[id];
+    const uint64_t page = nv->getId() >> DENSE_ATTR_PAGE_BITS;
+    if (page >= c.size())
+    {
+      c.resize(page + 1);
+    }
+    if (c[page] == nullptr)
+    {
+      c[page].reset(new Page());
+    }
+    Page& p = *c[page];
+    const uint64_t i = nv->getId() & (DENSE_ATTR_PAGE_SIZE - 1);
+    if (!p.isSet(i))
+    {
+      p.d_set[i >> 6] |= GetBitSet(i & 63);
+      ++p.d_count;
+      ++d_size;
+      if (page >= d_masks.size())
+      {
+        d_masks.resize(page + 1);
+      }
+      if (d_masks[page] == nullptr)
+      {
+        d_masks[page].reset(new MaskPage());
+      }
+      d_masks[page]->d_mask[i] |= GetBitSet(id & 63);
+    }
+    p.d_values.put(i, v);
+  }
+
+  /**
+   * Delete all attributes of nv. Only the columns recorded in the mask of
+   * nv are visited, so this does not depend on the number of attributes
+   * stored in the table.
+   */
+  void erase(const NodeValue* nv)
+  {
+    const uint64_t page = nv->getId() >> DENSE_ATTR_PAGE_BITS;
+    const uint64_t i = nv->getId() & (DENSE_ATTR_PAGE_SIZE - 1);
+    if (page >= d_masks.size() || d_masks[page] == nullptr)
+    {
+      return;
+    }
+    uint64_t mask = d_masks[page]->d_mask[i];
+    d_masks[page]->d_mask[i] = 0;
+    for (; mask != 0; mask &= mask - 1)
+    {
+      for (size_t id = __builtin_ctzll(mask); id < d_columns.size(); id += 64)
+      {
+        eraseEntry(id, page, i);
+      }
+    }
+  }
+
+  /** Delete the attributes with the given ids from all nodes. */
+  void eraseAttributes(const std::vector<uint64_t>& ids)
+  {
+    std::vector<Column> dead;
+    for (uint64_t id : ids)
+    {
+      if (id < d_columns.size())
+      {
+        for (const std::unique_ptr<Page>& p : d_columns[id])
+        {
+          d_size -= p == nullptr ? 0 : p->d_count;
+        }
+        dead.emplace_back(std::move(d_columns[id]));
+        d_columns[id].clear();
+      }
+    }
+  }
+
+  /** Delete all attributes from all nodes. */
+  void clear()
+  {
+    std::vector<Column> dead;
+    dead.swap(d_columns);
+    d_masks.clear();
+    d_size = 0;
+  }
+
+  /** Is the table empty? */
+  bool empty() const { return d_size == 0; }
+
+  /** The number of (attribute, node) pairs that have a value */
+  size_t size() const { return d_size; }
+
+ private:
+  /** Delete the value of attribute id, if any, for entry i of page. */
+  void eraseEntry(uint64_t id, uint64_t page, uint64_t i)
+  {
+    Column& c = d_columns[id];
+    if (page >= c.size() || c[page] == nullptr || !c[page]->isSet(i))
+    {
+      return;
+    }
+    // The old value is destroyed only once the table is consistent again,
+    // since dropping a Node may lead to further calls into the table.
+    std::unique_ptr<Page> dead;
+    CVC4_UNUSED value_type old = c[page]->d_values.take(i);
+    c[page]->d_set[i >> 6] &= ~GetBitSet(i & 63);
+    --d_size;
+    if (--c[page]->d_count == 0)
+    {
+      dead = std::move(c[page]);
+    }
+  }
+
+  const Page* getPage(uint64_t id, const NodeValue* nv) const
+  {
+    if (id >= d_columns.size())
+    {
+      return nullptr;
+    }
+    const Column& c = d_columns[id];
+    const uint64_t page = nv->getId() >> DENSE_ATTR_PAGE_BITS;
+    return page < c.size() ? c[page].get() : nullptr;
+  }
+
+  /** The columns, indexed by attribute id */
+  std::vector<Column> d_columns;
+  /**
+   * The masks of the attribute ids set for each node, indexed like the
+   * pages of a column. Bits are not cleared by eraseAttributes(), so a mask
+   * may name columns that no longer hold a value for the node.
+   */
+  std::vector<std::unique_ptr<MaskPage>> d_masks;
+  /** The number of (attribute, node) pairs that have a value */
+  size_t d_size;
+};/* class DenseAttrTable<> */
+
+}/* CVC4::expr::attr namespace */
+
 // ATTRIBUTE IDENTIFIER ASSIGNMENT TEMPLATE ====================================
 
 namespace attr {
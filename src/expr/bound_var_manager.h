@@ -17,10 +17,12 @@
 #ifndef CVC4__EXPR__BOUND_VAR_MANAGER_H
 #define CVC4__EXPR__BOUND_VAR_MANAGER_H
 
+#include <mutex>
 #include <string>
 #include <unordered_set>
 
 #include "expr/node.h"
+#include "expr/node_mutex.h"
 
 namespace CVC4 {
 
@@ -51,11 +53,13 @@ class BoundVarManager
    * n is added to the d_cacheVals set and survives in the lifetime of the
    * current node manager.
    *
-   * Returns the bound variable.
+   * Returns the bound variable. Threads that rewrite concurrently get the
+   * same variable for the same (T, n).
    */
   template <class T>
   Node mkBoundVar(Node n, TypeNode tn)
   {
+    std::lock_guard<expr::NodeMutex> guard(d_mutex);
     T attr;
     if (n.hasAttribute(attr))
     {
@@ -96,6 +100,8 @@ class BoundVarManager
   bool d_keepCacheVals;
   /** The set of cache values we have used */
   std::unordered_set<Node, NodeHashFunction> d_cacheVals;
+  /** Makes looking up and setting the cached variables atomic */
+  expr::NodeMutex d_mutex;
 };
 
 }  // namespace CVC4
@@ -13,6 +13,7 @@
  **/
 #include "expr/dtype.h"
 
+#include <mutex>
 #include <sstream>
 
 #include "expr/dtype_cons.h"
@@ -23,6 +24,8 @@ using namespace CVC4::kind;
 
 namespace CVC4 {
 
+expr::NodeRecursiveMutex DType::s_cacheMutex;
+
 DType::DType(std::string name, bool isCo)
     : d_name(name),
       d_params(),
@@ -307,6 +310,7 @@ void DType::setRecord()
 
 Cardinality DType::getCardinality(TypeNode t) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Trace("datatypes-init") << "DType::getCardinality " << std::endl;
   Assert(isResolved());
   Assert(t.isDatatype() && t.getDType().getTypeNode() == d_self);
@@ -345,6 +349,7 @@ Cardinality DType::computeCardinality(TypeNode t,
 
 bool DType::isRecursiveSingleton(TypeNode t) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Trace("datatypes-init") << "DType::isRecursiveSingleton " << std::endl;
   Assert(isResolved());
   Assert(t.isDatatype() && t.getDType().getTypeNode() == d_self);
@@ -392,6 +397,7 @@ bool DType::isRecursiveSingleton() const
 
 unsigned DType::getNumRecursiveSingletonArgTypes(TypeNode t) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Assert(d_cardRecSingleton.find(t) != d_cardRecSingleton.end());
   Assert(isRecursiveSingleton(t));
   return d_cardUAssume[t].size();
@@ -405,6 +411,7 @@ unsigned DType::getNumRecursiveSingletonArgTypes() const
 
 TypeNode DType::getRecursiveSingletonArgType(TypeNode t, size_t i) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Assert(d_cardRecSingleton.find(t) != d_cardRecSingleton.end());
   Assert(isRecursiveSingleton(t));
   return d_cardUAssume[t][i];
@@ -488,6 +495,7 @@ bool DType::computeCardinalityRecSingleton(
 
 bool DType::isFinite(TypeNode t) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Trace("datatypes-init") << "DType::isFinite " << std::endl;
   Assert(isResolved());
   Assert(t.isDatatype() && t.getDType().getTypeNode() == d_self);
@@ -518,6 +526,7 @@ bool DType::isFinite() const
 
 bool DType::isInterpretedFinite(TypeNode t) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Trace("datatypes-init") << "DType::isInterpretedFinite " << std::endl;
   Assert(isResolved());
   Assert(t.isDatatype() && t.getDType().getTypeNode() == d_self);
@@ -548,6 +557,7 @@ bool DType::isInterpretedFinite() const
 
 bool DType::isWellFounded() const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Assert(isResolved());
   if (d_wellFounded != 0)
   {
@@ -616,6 +626,7 @@ Node DType::mkGroundValue(TypeNode t) const
 
 Node DType::mkGroundTermInternal(TypeNode t, bool isValue) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Trace("datatypes-init") << "DType::mkGroundTerm of type " << t
                           << ", isValue = " << isValue << std::endl;
   // is this already in the cache ?
@@ -719,6 +730,7 @@ void DType::getAlienSubfieldTypes(
 
 bool DType::hasNestedRecursion() const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   if (d_nestedRecursion != 0)
   {
     return d_nestedRecursion == 1;
@@ -861,6 +873,7 @@ const DTypeConstructor& DType::operator[](size_t index) const
 
 Node DType::getSharedSelector(TypeNode dtt, TypeNode t, size_t index) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(s_cacheMutex);
   Assert(isResolved());
   std::map<TypeNode, std::map<TypeNode, std::map<unsigned, Node> > >::iterator
       itd = d_sharedSel.find(dtt);
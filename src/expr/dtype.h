@@ -22,6 +22,7 @@
 #include <vector>
 #include "expr/attribute.h"
 #include "expr/node.h"
+#include "expr/node_mutex.h"
 #include "expr/type_node.h"
 
 namespace CVC4 {
@@ -639,6 +640,12 @@ class DType
   /** cache of shared selectors for this datatype */
   mutable std::map<TypeNode, std::map<TypeNode, std::map<unsigned, Node> > >
       d_sharedSel;
+  /**
+   * Guards the caches above, and those of the constructors, of all datatypes.
+   * Computing a cache may compute the caches of other datatypes, so a single
+   * recursive mutex is used. It does nothing unless nodes are thread-safe.
+   */
+  static expr::NodeRecursiveMutex s_cacheMutex;
 }; /* class DType */
 
 /**
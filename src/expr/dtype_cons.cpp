@@ -13,6 +13,8 @@
  **/
 #include "expr/dtype_cons.h"
 
+#include <mutex>
+
 #include "expr/dtype.h"
 #include "expr/node_manager.h"
 #include "expr/type_matcher.h"
@@ -172,6 +174,7 @@ bool DTypeConstructor::hasFiniteExternalArgType(TypeNode t) const
 std::pair<DTypeConstructor::CardinalityType, bool>
 DTypeConstructor::computeCardinalityInfo(TypeNode t) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(DType::s_cacheMutex);
   std::map<TypeNode, std::pair<CardinalityType, bool> >::iterator it =
       d_cardInfo.find(t);
   if (it != d_cardInfo.end())
@@ -240,6 +243,7 @@ TypeNode DTypeConstructor::getArgType(size_t index) const
 Node DTypeConstructor::getSelectorInternal(TypeNode domainType,
                                            size_t index) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(DType::s_cacheMutex);
   Assert(isResolved());
   Assert(index < getNumArgs());
   if (options::dtSharedSelectors())
@@ -256,6 +260,7 @@ Node DTypeConstructor::getSelectorInternal(TypeNode domainType,
 
 int DTypeConstructor::getSelectorIndexInternal(Node sel) const
 {
+  std::lock_guard<expr::NodeRecursiveMutex> guard(DType::s_cacheMutex);
   Assert(isResolved());
   if (options::dtSharedSelectors())
   {
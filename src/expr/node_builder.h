@@ -77,9 +77,10 @@
  **         decrement them again on destruction.  The existing
  **         NodeManager pool entry is returned.
  **
- **   1(b). A new heap-allocated NodeValue must be constructed and all
- **         settings and children from d_inlineNv copied into it.
- **         This new NodeValue is put into the NodeManager's pool.
+ **   1(b). A new NodeValue must be obtained from the NodeManager's
+ **         NodeValueAllocator and all settings and children from
+ **         d_inlineNv copied into it.  This new NodeValue is put into
+ **         the NodeManager's pool.
  **         The NodeBuilder is marked as "used" and the number of
  **         children in d_inlineNv set to zero so that we don't
  **         decrement child reference counts on destruction (the child
@@ -99,7 +100,10 @@
  **         is repointed to d_inlineNv so that destruction of the
  **         NodeBuilder doesn't cause any problems, and the (old)
  **         value it had is placed into the NodeManager's pool and
- **         returned in a Node wrapper.
+ **         returned in a Node wrapper.  If the number of children is
+ **         small enough for the NodeValueAllocator's size classes, the
+ **         children are moved into a NodeValue from the allocator
+ **         instead, and the heap-allocated d_nv is freed.
  **
  ** NOTE IN 1(b) AND 2(b) THAT we can NOT create Node wrapper
  ** temporary for the NodeValue in the NodeBuilder<>::operator Node()
@@ -850,24 +854,24 @@ void NodeBuilder<nchild_thresh>::decrRefCounts() {
 
 template <unsigned nchild_thresh>
 TypeNode NodeBuilder<nchild_thresh>::constructTypeNode() {
-  return TypeNode(constructNV());
+  return NodeManager::wrapPooled<TypeNode>(constructNV());
 }
 
 template <unsigned nchild_thresh>
 TypeNode NodeBuilder<nchild_thresh>::constructTypeNode() const {
-  return TypeNode(constructNV());
+  return NodeManager::wrapPooled<TypeNode>(constructNV());
 }
 
 template <unsigned nchild_thresh>
 Node NodeBuilder<nchild_thresh>::constructNode() {
-  Node n = Node(constructNV());
+  Node n = NodeManager::wrapPooled<Node>(constructNV());
   maybeCheckType(n);
   return n;
 }
 
 template <unsigned nchild_thresh>
 Node NodeBuilder<nchild_thresh>::constructNode() const {
-  Node n = Node(constructNV());
+  Node n = NodeManager::wrapPooled<Node>(constructNV());
   maybeCheckType(n);
   return n;
 }
@@ -876,14 +880,16 @@ template <unsigned nchild_thresh>
 Node* NodeBuilder<nchild_thresh>::constructNodePtr() {
   // maybeCheckType() can throw an exception. Make sure to call the destructor
   // on the exception branch.
-  std::unique_ptr<Node> np(new Node(constructNV()));
+  std::unique_ptr<Node> np(
+      new Node(NodeManager::wrapPooled<Node>(constructNV())));
   maybeCheckType(*np.get());
   return np.release();
 }
 
 template <unsigned nchild_thresh>
 Node* NodeBuilder<nchild_thresh>::constructNodePtr() const {
-  std::unique_ptr<Node> np(new Node(constructNV()));
+  std::unique_ptr<Node> np(
+      new Node(NodeManager::wrapPooled<Node>(constructNV())));
   maybeCheckType(*np.get());
   return np.release();
 }
@@ -933,17 +939,13 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv = (expr::NodeValue*)
-      std::malloc(sizeof(expr::NodeValue));
-    if(nv == NULL) {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->d_nvAllocator->allocate(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
     nv->d_kind = d_nv->d_kind;
-    nv->d_id = d_nm->next_id++;// FIXME multithreading
-    nv->d_rc = 0;
+    nv->d_id = d_nm->next_id++;
+    nv->d_rc = NodeManager::NEW_NODE_RC;
     setUsed();
     if(Debug.isOn("gc")) {
       Debug("gc") << "creating node value " << nv
@@ -980,6 +982,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
      ** allocated "inline" in this NodeBuilder. **/
 
     // Lookup the expression value in the pool we already have
+    NodeManager::PoolLock lock(d_nm, &d_inlineNv);
     expr::NodeValue* poolNv = d_nm->poolLookup(&d_inlineNv);
     // If something else is there, we reuse it
     if(poolNv != NULL) {
@@ -1011,16 +1014,12 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
        * reference count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv =
+          d_nm->d_nvAllocator->allocate(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
-      nv->d_id = d_nm->next_id++;// FIXME multithreading
-      nv->d_rc = 0;
+      nv->d_id = d_nm->next_id++;
+      nv->d_rc = NodeManager::NEW_NODE_RC;
 
       std::copy(d_inlineNv.d_children,
                 d_inlineNv.d_children + d_inlineNv.d_nchildren,
@@ -1044,6 +1043,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
      ** buffer that was heap-allocated by this NodeBuilder. **/
 
     // Lookup the expression value in the pool we already have (with insert)
+    NodeManager::PoolLock lock(d_nm, d_nv);
     expr::NodeValue* poolNv = d_nm->poolLookup(d_nv);
     // If something else is there, we reuse it
     if(poolNv != NULL) {
@@ -1065,15 +1065,35 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
        * NodeManager's pool. */
 
       /* 2(b). The heap-allocated d_nv is "cropped" to the correct
-       * size (based on the number of children it _actually_ has).
-       * d_nv is repointed to d_inlineNv so that destruction of the
-       * NodeBuilder doesn't cause any problems, and the (old) value
-       * it had is placed into the NodeManager's pool and returned in
-       * a Node wrapper. */
-
-      crop();
-      expr::NodeValue* nv = d_nv;
-      nv->d_id = d_nm->next_id++;// FIXME multithreading
+       * size (based on the number of children it _actually_ has) and
+       * handed over to the NodeManager's allocator.  If it is small
+       * enough to be served by the allocator's size classes, its
+       * children are instead moved into a fresh NodeValue from the
+       * allocator (taking over the child reference counts) and the
+       * heap-allocated buffer is released.  d_nv is repointed to
+       * d_inlineNv so that destruction of the NodeBuilder doesn't
+       * cause any problems, and the new value is placed into the
+       * NodeManager's pool and returned in a Node wrapper. */
+
+      expr::NodeValue* nv;
+      if (d_nv->d_nchildren > expr::NodeValueAllocator::MAX_POOLED_CHILDREN)
+      {
+        crop();
+        nv = d_nv;
+        d_nm->d_nvAllocator->adopt(nv->d_nchildren);
+      }
+      else
+      {
+        nv = d_nm->d_nvAllocator->allocate(d_nv->d_nchildren);
+        nv->d_nchildren = d_nv->d_nchildren;
+        nv->d_kind = d_nv->d_kind;
+        std::copy(d_nv->d_children,
+                  d_nv->d_children + d_nv->d_nchildren,
+                  nv->d_children);
+        free(d_nv);
+      }
+      nv->d_id = d_nm->next_id++;
+      nv->d_rc = NodeManager::NEW_NODE_RC;
       d_nv = &d_inlineNv;
       d_nvMaxChildren = nchild_thresh;
       setUsed();
@@ -1113,17 +1133,13 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv = (expr::NodeValue*)
-      std::malloc(sizeof(expr::NodeValue));
-    if(nv == NULL) {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->d_nvAllocator->allocate(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
     nv->d_kind = d_nv->d_kind;
-    nv->d_id = d_nm->next_id++;// FIXME multithreading
-    nv->d_rc = 0;
+    nv->d_id = d_nm->next_id++;
+    nv->d_rc = NodeManager::NEW_NODE_RC;
     Debug("gc") << "creating node value " << nv
                 << " [" << nv->d_id << "]: " << *nv << "\n";
     return nv;
@@ -1163,6 +1179,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
      ** allocated "inline" in this NodeBuilder. **/
 
     // Lookup the expression value in the pool we already have
+    NodeManager::PoolLock lock(d_nm, &d_inlineNv);
     expr::NodeValue* poolNv = d_nm->poolLookup(const_cast<expr::NodeValue*>(&d_inlineNv));
     // If something else is there, we reuse it
     if(poolNv != NULL) {
@@ -1188,16 +1205,12 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
        * count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv =
+          d_nm->d_nvAllocator->allocate(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
-      nv->d_id = d_nm->next_id++;// FIXME multithreading
-      nv->d_rc = 0;
+      nv->d_id = d_nm->next_id++;
+      nv->d_rc = NodeManager::NEW_NODE_RC;
 
       std::copy(d_inlineNv.d_children,
                 d_inlineNv.d_children + d_inlineNv.d_nchildren,
@@ -1220,6 +1233,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
      ** buffer that was heap-allocated by this NodeBuilder. **/
 
     // Lookup the expression value in the pool we already have (with insert)
+    NodeManager::PoolLock lock(d_nm, d_nv);
     expr::NodeValue* poolNv = d_nm->poolLookup(d_nv);
     // If something else is there, we reuse it
     if(poolNv != NULL) {
@@ -1242,16 +1256,11 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
        * decremented to match at NodeBuilder destruction time. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_nv->d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv = d_nm->d_nvAllocator->allocate(d_nv->d_nchildren);
       nv->d_nchildren = d_nv->d_nchildren;
       nv->d_kind = d_nv->d_kind;
-      nv->d_id = d_nm->next_id++;// FIXME multithreading
-      nv->d_rc = 0;
+      nv->d_id = d_nm->next_id++;
+      nv->d_rc = NodeManager::NEW_NODE_RC;
 
       std::copy(d_nv->d_children,
                 d_nv->d_children + d_nv->d_nchildren,
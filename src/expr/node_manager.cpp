@@ -18,8 +18,12 @@
 #include "expr/node_manager.h"
 
 #include <algorithm>
+#include <chrono>
 #include <stack>
 #include <utility>
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <thread>
+#endif /* CVC4_THREAD_SAFE_NODES */
 
 #include "base/check.h"
 #include "base/listener.h"
@@ -98,14 +102,32 @@ NodeManager::NodeManager(ExprManager* exprManager)
     : d_statisticsRegistry(new StatisticsRegistry()),
       d_skManager(new SkolemManager),
       d_bvManager(new BoundVarManager),
+      d_nvAllocator(new expr::NodeValueAllocator(d_statisticsRegistry)),
       next_id(0),
       d_attrManager(new expr::attr::AttributeManager()),
       d_exprManager(exprManager),
       d_nodeUnderDeletion(NULL),
       d_inReclaimZombies(false),
+      d_zombieThreshold(5000),
+      d_zombieBudget(0),
+      d_reclaimAtSafePointsOnly(false),
+      d_statistics(new Statistics(d_statisticsRegistry)),
       d_abstractValueCount(0),
       d_skolemCounter(0)
 {
+#ifdef CVC4_THREAD_SAFE_NODES
+  d_epoch = 0;
+  d_epochReaders[0] = 0;
+  d_epochReaders[1] = 0;
+  for (size_t i = 0; i < POOL_SHARDS; ++i)
+  {
+    d_poolShards.emplace_back(new PoolShard("expr::NodeValuePool::shard"
+                                            + std::to_string(i)));
+    d_poolShards.back()->d_pool.registerStatistics(d_statisticsRegistry);
+  }
+#else  /* CVC4_THREAD_SAFE_NODES */
+  d_nodeValuePool.registerStatistics(d_statisticsRegistry);
+#endif /* CVC4_THREAD_SAFE_NODES */
   init();
 }
 
@@ -254,18 +276,41 @@ NodeManager::~NodeManager() {
 
   if(Debug.isOn("gc:leaks")) {
     Debug("gc:leaks") << "still in pool:" << endl;
-    for(NodeValuePool::const_iterator i = d_nodeValuePool.begin(),
-          iend = d_nodeValuePool.end();
-        i != iend;
-        ++i) {
-      Debug("gc:leaks") << "  " << *i
-                        << " id=" << (*i)->d_id
-                        << " rc=" << (*i)->d_rc
-                        << " " << **i << endl;
+#ifdef CVC4_THREAD_SAFE_NODES
+    for (const std::unique_ptr<PoolShard>& shard : d_poolShards)
+    {
+      const expr::NodeValuePool& pool = shard->d_pool;
+#else  /* CVC4_THREAD_SAFE_NODES */
+    {
+      const expr::NodeValuePool& pool = d_nodeValuePool;
+#endif /* CVC4_THREAD_SAFE_NODES */
+      for (expr::NodeValuePool::const_iterator i = pool.begin(),
+                                               iend = pool.end();
+           i != iend;
+           ++i)
+      {
+        Debug("gc:leaks") << "  " << *i << " id=" << (*i)->d_id
+                          << " rc=" << (*i)->getRefCount() << " " << **i
+                          << endl;
+      }
     }
     Debug("gc:leaks") << ":end:" << endl;
   }
 
+  d_statistics = nullptr;
+#ifdef CVC4_THREAD_SAFE_NODES
+  for (const std::unique_ptr<PoolShard>& shard : d_poolShards)
+  {
+    shard->d_pool.unregisterStatistics(d_statisticsRegistry);
+  }
+#else  /* CVC4_THREAD_SAFE_NODES */
+  d_nodeValuePool.unregisterStatistics(d_statisticsRegistry);
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+  // release the storage of all node values (this unregisters the allocator
+  // statistics, so it must happen before the registry is deleted)
+  d_nvAllocator = nullptr;
+
   // defensive coding, in case destruction-order issues pop up (they often do)
   delete d_statisticsRegistry;
   d_statisticsRegistry = NULL;
@@ -281,11 +326,81 @@ const DType& NodeManager::getDTypeForIndex(size_t index) const
   return *d_dtypes[index];
 }
 
-void NodeManager::reclaimZombies() {
-  // FIXME multithreading
+NodeManager::Statistics::Statistics(StatisticsRegistry* reg)
+    : d_registry(reg),
+      d_reclaimTime("expr::NodeManager::zombieReclaimTime"),
+      d_reclaimSteps("expr::NodeManager::zombieReclaimSteps", 0),
+      d_reclaimedNodes("expr::NodeManager::zombiesReclaimed", 0),
+      d_maxPauseMicros("expr::NodeManager::zombieReclaimMaxPauseMicros", 0),
+      d_avgPause("expr::NodeManager::zombieReclaimAvgPause")
+{
+  d_registry->registerStat(&d_reclaimTime);
+  d_registry->registerStat(&d_reclaimSteps);
+  d_registry->registerStat(&d_reclaimedNodes);
+  d_registry->registerStat(&d_maxPauseMicros);
+  d_registry->registerStat(&d_avgPause);
+}
+
+NodeManager::Statistics::~Statistics()
+{
+  d_registry->unregisterStat(&d_reclaimTime);
+  d_registry->unregisterStat(&d_reclaimSteps);
+  d_registry->unregisterStat(&d_reclaimedNodes);
+  d_registry->unregisterStat(&d_maxPauseMicros);
+  d_registry->unregisterStat(&d_avgPause);
+}
+
+void NodeManager::setZombieReclaimPolicy(size_t threshold,
+                                         size_t budget,
+                                         bool safePointsOnly)
+{
+  d_zombieThreshold = threshold;
+  d_zombieBudget = budget;
+  d_reclaimAtSafePointsOnly = safePointsOnly;
+}
+
+void NodeManager::reclaimZombiesAtSafePoint()
+{
+  size_t pending;
+  {
+    std::lock_guard<expr::NodeMutex> guard(d_zombieMutex);
+    pending = d_zombies.size();
+  }
+  if (pending > d_zombieThreshold)
+  {
+    reclaimAllZombies();
+  }
+}
+
+void NodeManager::reclaimZombiesIfDue()
+{
+  // if another thread is reclaiming, the zombies are left to it
+  std::unique_lock<expr::NodeRecursiveMutex> reclaiming(d_reclaimMutex,
+                                                        std::try_to_lock);
+  if (reclaiming.owns_lock() && safeToReclaimZombies())
+  {
+    reclaimZombies(d_zombieBudget);
+  }
+}
+
+#ifdef CVC4_THREAD_SAFE_NODES
+void NodeManager::synchronizeEpoch()
+{
+  size_t e = d_epoch.fetch_add(1);
+  while (d_epochReaders[e & 1].load() != 0)
+  {
+    std::this_thread::yield();
+  }
+}
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+void NodeManager::reclaimZombies(size_t budget)
+{
+  std::lock_guard<expr::NodeRecursiveMutex> reclaiming(d_reclaimMutex);
   Assert(!d_attrManager->inGarbageCollection());
 
-  Debug("gc") << "reclaiming " << d_zombies.size() << " zombie(s)!\n";
+  Debug("gc") << "reclaiming " << d_zombies.size() << " zombie(s)"
+              << (budget > 0 ? " incrementally" : "") << "!\n";
 
   // during reclamation, reclaimZombies() is never supposed to be called
   Assert(!d_inReclaimZombies)
@@ -308,14 +423,82 @@ void NodeManager::reclaimZombies() {
   // may be invisible to us (B is leaked) or even invalidate our
   // iterator, causing a crash.  So we need to copy the set away.
 
-  vector<NodeValue*> zombies;
-  zombies.reserve(d_zombies.size());
-  remove_copy_if(d_zombies.begin(),
-                 d_zombies.end(),
-                 back_inserter(zombies),
-                 NodeValueReferenceCountNonZero());
-  d_zombies.clear();
+  //
+  // If we are given a budget, we only copy away (and remove) that many
+  // zombies, and leave the others for a later call.
 
+  TimerStat::CodeTimer reclaimTimer(d_statistics->d_reclaimTime);
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  vector<NodeValue*> zombies;
+  std::unique_lock<expr::NodeMutex> zombieLock(d_zombieMutex);
+  if (budget == 0 || budget >= d_zombies.size())
+  {
+    zombies.reserve(d_zombies.size());
+    remove_copy_if(d_zombies.begin(),
+                   d_zombies.end(),
+                   back_inserter(zombies),
+                   NodeValueReferenceCountNonZero());
+    d_zombies.clear();
+  }
+  else
+  {
+    zombies.reserve(budget);
+    NodeValueIDSet::iterator it = d_zombies.begin();
+    for (size_t i = 0; i < budget; ++i)
+    {
+      if ((*it)->getRefCount() == 0)
+      {
+        zombies.push_back(*it);
+      }
+      it = d_zombies.erase(it);
+    }
+  }
+  zombieLock.unlock();
+
+#ifdef CVC4_THREAD_SAFE_NODES
+  // Other threads may still find a zombie in the pool and resurrect it, so
+  // the zombies that are still dead are first unlinked from the pool, under
+  // the lock of their shard.  A thread may also have dropped the last
+  // reference to one of them and be about to register it as a zombie again
+  // (see releaseLastReference()); after waiting for such threads, the dead
+  // zombies are removed from d_zombies for good.
+  vector<NodeValue*> dead;
+  dead.reserve(zombies.size());
+  for (NodeValue* nv : zombies)
+  {
+    kind::MetaKind mk = nv->getMetaKind();
+    if (mk != kind::metakind::VARIABLE
+        && mk != kind::metakind::NULLARY_OPERATOR)
+    {
+      PoolLock lock(this, nv);
+      if (nv->getRefCount() != 0 || shardOf(nv).d_pool.find(nv) != nv)
+      {
+        continue;
+      }
+      poolRemove(nv);
+    }
+    else if (nv->getRefCount() != 0)
+    {
+      continue;
+    }
+    dead.push_back(nv);
+  }
+  synchronizeEpoch();
+  zombieLock.lock();
+  for (NodeValue* nv : dead)
+  {
+    d_zombies.erase(nv);
+  }
+  zombieLock.unlock();
+  zombies.swap(dead);
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+  // the storage of the reclaimed NodeValues is given back to the allocator
+  // in one batch at the end
+  vector<std::pair<NodeValue*, size_t>> freed;
+  freed.reserve(zombies.size());
 #ifdef _LIBCPP_VERSION
   NodeValue* last = NULL;
 #endif
@@ -333,7 +516,8 @@ void NodeManager::reclaimZombies() {
 #endif
 
     // collect ONLY IF still zero
-    if(nv->d_rc == 0) {
+    if (nv->getRefCount() == 0)
+    {
       if(Debug.isOn("gc")) {
         Debug("gc") << "deleting node value " << nv
                     << " [" << nv->d_id << "]: ";
@@ -341,11 +525,13 @@ void NodeManager::reclaimZombies() {
         Debug("gc") << endl;
       }
 
-      // remove from the pool
+      // remove from the pool (thread-safe builds did so above)
       kind::MetaKind mk = nv->getMetaKind();
+#ifndef CVC4_THREAD_SAFE_NODES
       if(mk != kind::metakind::VARIABLE && mk != kind::metakind::NULLARY_OPERATOR) {
         poolRemove(nv);
       }
+#endif /* CVC4_THREAD_SAFE_NODES */
 
       // whether exit is normal or exceptional, the NVReclaim dtor is
       // called and ensures that d_nodeUnderDeletion is set back to
@@ -380,10 +566,23 @@ void NodeManager::reclaimZombies() {
         // constant, but then, you should probably use a smart-pointer
         // type for a constant payload.)
         kind::metakind::deleteNodeValueConstant(nv);
+        free(nv);
+      }
+      else
+      {
+        freed.emplace_back(nv, nv->d_nchildren);
       }
-      free(nv);
+      ++d_statistics->d_reclaimedNodes;
     }
   }
+  d_nvAllocator->deallocateAll(freed);
+
+  ++d_statistics->d_reclaimSteps;
+  std::chrono::duration<double> pause =
+      std::chrono::steady_clock::now() - start;
+  d_statistics->d_avgPause.addEntry(pause.count());
+  d_statistics->d_maxPauseMicros.maxAssign(
+      std::chrono::duration_cast<std::chrono::microseconds>(pause).count());
 }/* NodeManager::reclaimZombies() */
 
 std::vector<NodeValue*> NodeManager::TopologicalSort(
@@ -823,15 +1022,51 @@ void NodeManager::reclaimAllZombies(){
 
 /** Reclaim zombies while there are more than k nodes in the pool (if possible).*/
 void NodeManager::reclaimZombiesUntil(uint32_t k){
+  std::lock_guard<expr::NodeRecursiveMutex> reclaiming(d_reclaimMutex);
   if(safeToReclaimZombies()){
-    while(poolSize() >= k && !d_zombies.empty()){
+    for (;;)
+    {
+      {
+        std::lock_guard<expr::NodeMutex> guard(d_zombieMutex);
+        if (d_zombies.empty())
+        {
+          break;
+        }
+      }
+      if (poolSize() < k)
+      {
+        break;
+      }
       reclaimZombies();
     }
   }
 }
 
 size_t NodeManager::poolSize() const{
+#ifdef CVC4_THREAD_SAFE_NODES
+  size_t size = 0;
+  for (const std::unique_ptr<PoolShard>& shard : d_poolShards)
+  {
+    std::lock_guard<expr::NodeMutex> guard(shard->d_mutex);
+    size += shard->d_pool.size();
+  }
+  return size;
+#else  /* CVC4_THREAD_SAFE_NODES */
   return d_nodeValuePool.size();
+#endif /* CVC4_THREAD_SAFE_NODES */
+}
+
+void NodeManager::reservePool(size_t n)
+{
+#ifdef CVC4_THREAD_SAFE_NODES
+  for (const std::unique_ptr<PoolShard>& shard : d_poolShards)
+  {
+    std::lock_guard<expr::NodeMutex> guard(shard->d_mutex);
+    shard->d_pool.reserve(n / POOL_SHARDS + 1);
+  }
+#else  /* CVC4_THREAD_SAFE_NODES */
+  d_nodeValuePool.reserve(n);
+#endif /* CVC4_THREAD_SAFE_NODES */
 }
 
 TypeNode NodeManager::mkSort(uint32_t flags) {
@@ -1137,7 +1372,7 @@ Node NodeManager::mkAbstractValue(const TypeNode& type) {
 }
 
 bool NodeManager::safeToReclaimZombies() const{
-  // FIXME multithreading
+  // only called with d_reclaimMutex held
   return !d_inReclaimZombies && !d_attrManager->inGarbageCollection();
 }
 
@@ -28,6 +28,7 @@
 #ifndef CVC4__NODE_MANAGER_H
 #define CVC4__NODE_MANAGER_H
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -35,7 +36,11 @@
 #include "base/check.h"
 #include "expr/kind.h"
 #include "expr/metakind.h"
+#include "expr/node_mutex.h"
 #include "expr/node_value.h"
+#include "expr/node_value_allocator.h"
+#include "expr/node_value_pool.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 
@@ -57,6 +62,7 @@ namespace expr {
   }/* CVC4::expr::attr namespace */
 
   class TypeChecker;
+  class NodeDeserializer;
 }/* CVC4::expr namespace */
 
 /**
@@ -91,6 +97,7 @@ class NodeManager
   friend class expr::NodeValue;
   friend class expr::TypeChecker;
   // friends so they can access mkVar() here, which is private
+  friend class expr::NodeDeserializer;
   friend Expr ExprManager::mkVar(const std::string&, Type);
   friend Expr ExprManager::mkVar(Type);
 
@@ -109,12 +116,9 @@ class NodeManager
  private:
   /** Predicate for use with STL algorithms */
   struct NodeValueReferenceCountNonZero {
-    bool operator()(expr::NodeValue* nv) { return nv->d_rc > 0; }
+    bool operator()(expr::NodeValue* nv) { return nv->getRefCount() > 0; }
   };
 
-  typedef std::unordered_set<expr::NodeValue*,
-                             expr::NodeValuePoolHashFunction,
-                             expr::NodeValuePoolEq> NodeValuePool;
   typedef std::unordered_set<expr::NodeValue*,
                              expr::NodeValueIDHashFunction,
                              expr::NodeValueIDEquality> NodeValueIDSet;
@@ -128,9 +132,45 @@ class NodeManager
   /** The bound variable manager */
   std::unique_ptr<BoundVarManager> d_bvManager;
 
-  NodeValuePool d_nodeValuePool;
+#ifdef CVC4_THREAD_SAFE_NODES
+  /** A part of the pool, with the lock guarding it */
+  struct PoolShard
+  {
+    PoolShard(const std::string& name) : d_pool(name) {}
+    expr::NodeMutex d_mutex;
+    expr::NodeValuePool d_pool;
+  };
+
+  /** The number of parts the pool is split into; a power of two */
+  static constexpr size_t POOL_SHARDS = 16;
 
+  /**
+   * The hash-consed node values of this node manager, split by hash so
+   * that threads constructing different nodes rarely contend.
+   */
+  std::vector<std::unique_ptr<PoolShard>> d_poolShards;
+
+  /** The shard of the pool that nv belongs to */
+  PoolShard& shardOf(const expr::NodeValue* nv) const
+  {
+    return *d_poolShards[nv->poolHash() & (POOL_SHARDS - 1)];
+  }
+#else  /* CVC4_THREAD_SAFE_NODES */
+  /** The hash-consed node values of this node manager */
+  expr::NodeValuePool d_nodeValuePool;
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+  /**
+   * The allocator that owns the storage of all non-constant NodeValues
+   * created by this NodeManager.
+   */
+  std::unique_ptr<expr::NodeValueAllocator> d_nvAllocator;
+
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::atomic<size_t> next_id;
+#else  /* CVC4_THREAD_SAFE_NODES */
   size_t next_id;
+#endif /* CVC4_THREAD_SAFE_NODES */
 
   expr::attr::AttributeManager* d_attrManager;
 
@@ -162,6 +202,96 @@ class NodeManager
    */
   NodeValueIDSet d_zombies;
 
+  /**
+   * The number of zombies that may be pending before markForDeletion()
+   * triggers a reclamation step.
+   */
+  size_t d_zombieThreshold;
+
+  /**
+   * The maximal number of zombies examined by a single reclamation step
+   * triggered from markForDeletion(), or 0 if a step reclaims all pending
+   * zombies.  Zombies created while reclaiming (children whose reference
+   * count drops to zero) are left for later steps.
+   */
+  size_t d_zombieBudget;
+
+  /**
+   * If true, markForDeletion() never reclaims zombies.  They are only
+   * reclaimed at safe points, see reclaimZombiesAtSafePoint().
+   */
+  bool d_reclaimAtSafePointsOnly;
+
+  /** Guards d_zombies and d_maxedOut in thread-safe builds */
+  expr::NodeMutex d_zombieMutex;
+
+  /**
+   * Held while reclaiming zombies, so that only one thread at a time
+   * reclaims (and d_inReclaimZombies and d_nodeUnderDeletion are only
+   * accessed by that thread).
+   */
+  expr::NodeRecursiveMutex d_reclaimMutex;
+
+#ifdef CVC4_THREAD_SAFE_NODES
+  /**
+   * The number of grace periods started so far, see synchronizeEpoch().
+   * Its parity selects the entry of d_epochReaders that threads entering
+   * a critical section register with.
+   */
+  std::atomic<size_t> d_epoch;
+
+  /** The number of threads in a critical section, by epoch parity */
+  std::atomic<size_t> d_epochReaders[2];
+
+  /**
+   * Enter a critical section that a concurrent reclamation waits for
+   * (see synchronizeEpoch()), and return the epoch to pass to exitEpoch().
+   */
+  inline size_t enterEpoch()
+  {
+    for (;;)
+    {
+      size_t e = d_epoch.load();
+      d_epochReaders[e & 1].fetch_add(1);
+      if (d_epoch.load() == e)
+      {
+        return e;
+      }
+      // a grace period started in the meantime, which may not wait for us
+      d_epochReaders[e & 1].fetch_sub(1);
+    }
+  }
+
+  /** Leave the critical section entered in epoch e */
+  inline void exitEpoch(size_t e) { d_epochReaders[e & 1].fetch_sub(1); }
+
+  /**
+   * Wait until all threads that were in a critical section when this was
+   * called have left it.
+   */
+  void synchronizeEpoch();
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+  /** Statistics on the reclamation of zombies */
+  struct Statistics
+  {
+    Statistics(StatisticsRegistry* reg);
+    ~Statistics();
+    /** The registry the statistics are registered with */
+    StatisticsRegistry* d_registry;
+    /** Total time spent reclaiming zombies */
+    TimerStat d_reclaimTime;
+    /** Number of reclamation steps */
+    IntStat d_reclaimSteps;
+    /** Number of node values reclaimed */
+    IntStat d_reclaimedNodes;
+    /** Longest single reclamation step, in microseconds */
+    IntStat d_maxPauseMicros;
+    /** Average duration of a reclamation step, in seconds */
+    AverageStat d_avgPause;
+  };
+  std::unique_ptr<Statistics> d_statistics;
+
   /**
    * NodeValues with maxed out reference counts. These live as long as the
    * NodeManager. They have a custom deallocation procedure at the very end.
@@ -247,6 +377,10 @@ class NodeManager
    * NULL, the caller should fully construct an equivalent one before
    * calling poolInsert().  NON-FULLY-CONSTRUCTED NODEVALUES are not
    * permitted in the pool!
+   *
+   * In thread-safe builds, the caller must hold a PoolLock for nv, and a
+   * NodeValue found is returned with a reference taken on behalf of the
+   * caller (see wrapPooled()).
    */
   inline expr::NodeValue* poolLookup(expr::NodeValue* nv) const;
 
@@ -254,7 +388,7 @@ class NodeManager
    * Insert a NodeValue into the NodeManager's pool.
    *
    * It is an error to insert a NodeValue already in the pool.
-   * Enquire first with poolLookup().
+   * Enquire first with poolLookup(), under the same PoolLock.
    */
   inline void poolInsert(expr::NodeValue* nv);
 
@@ -266,6 +400,56 @@ class NodeManager
    */
   inline void poolRemove(expr::NodeValue* nv);
 
+  /**
+   * Locks the part of the pool that a NodeValue belongs to, for the
+   * duration of a lookup and the insertion that may follow it.  Does
+   * nothing in builds that are not thread-safe.
+   */
+  class PoolLock
+  {
+   public:
+#ifdef CVC4_THREAD_SAFE_NODES
+    PoolLock(const NodeManager* nm, const expr::NodeValue* nv)
+        : d_guard(nm->shardOf(nv).d_mutex)
+    {
+    }
+
+   private:
+    std::lock_guard<expr::NodeMutex> d_guard;
+#else  /* CVC4_THREAD_SAFE_NODES */
+    PoolLock(const NodeManager* nm, const expr::NodeValue* nv) {}
+#endif /* CVC4_THREAD_SAFE_NODES */
+  }; /* class NodeManager::PoolLock */
+
+#ifdef CVC4_THREAD_SAFE_NODES
+  /**
+   * The reference count of a newly created NodeValue.  In thread-safe
+   * builds, it holds a reference on behalf of its creator until it is
+   * wrapped (see wrapPooled()), since another thread may find it in the
+   * pool and drop its own reference to it before that.
+   */
+  static constexpr uint32_t NEW_NODE_RC = 1;
+#else  /* CVC4_THREAD_SAFE_NODES */
+  /** The reference count of a newly created NodeValue */
+  static constexpr uint32_t NEW_NODE_RC = 0;
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+  /**
+   * Wrap a NodeValue that was just found in or created for the pool into a
+   * NodeClass (Node or TypeNode).  In thread-safe builds, the reference
+   * held on behalf of the caller (see poolLookup() and NEW_NODE_RC) is
+   * handed over to the result.
+   */
+  template <class NodeClass>
+  static NodeClass wrapPooled(expr::NodeValue* nv)
+  {
+    NodeClass n(nv);
+#ifdef CVC4_THREAD_SAFE_NODES
+    nv->dec();
+#endif /* CVC4_THREAD_SAFE_NODES */
+    return n;
+  }
+
   /**
    * Determine if nv is currently being deleted by the NodeManager.
    */
@@ -277,7 +461,47 @@ class NodeManager
    * Register a NodeValue as a zombie.
    */
   inline void markForDeletion(expr::NodeValue* nv) {
-    Assert(nv->d_rc == 0);
+    if (__builtin_expect(addZombie(nv), false))
+    {
+      reclaimZombiesIfDue();
+    }
+  }
+
+#ifdef CVC4_THREAD_SAFE_NODES
+  /**
+   * Drop what may be the last reference to nv (see NodeValue::dec()).  The
+   * reference count is decremented from one to zero and nv is registered
+   * as a zombie within a critical section, so that a concurrent
+   * reclamation, which may find nv with a reference count of zero before it
+   * is registered, does not free it in between (see reclaimZombies()).
+   */
+  inline void releaseLastReference(expr::NodeValue* nv)
+  {
+    size_t epoch = enterEpoch();
+    uint32_t rc = 1;
+    if (__atomic_compare_exchange_n(
+            &nv->d_rc, &rc, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+      bool due = addZombie(nv);
+      exitEpoch(epoch);
+      if (__builtin_expect(due, false))
+      {
+        reclaimZombiesIfDue();
+      }
+      return;
+    }
+    exitEpoch(epoch);
+    // another thread took a reference in the meantime
+    nv->dec();
+  }
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+  /**
+   * Add nv to the zombies.  Returns true if enough zombies are pending
+   * that a reclamation step is due.
+   */
+  inline bool addZombie(expr::NodeValue* nv) {
+    Assert(nv->getRefCount() == 0);
 
     // if d_reclaiming is set, make sure we don't call
     // reclaimZombies(), because it's already running.
@@ -297,17 +521,19 @@ class NodeManager
     // on that node while a different `NodeManager` n2 is in scope. When that
     // `Expr` is deleted and the node reaches refcount zero in the `Expr`'s
     // destructor, then `markForDeletion()` will be called on n2.
+    std::lock_guard<expr::NodeMutex> guard(d_zombieMutex);
     Assert(d_zombies.find(nv) == d_zombies.end() || *d_zombies.find(nv) == nv);
 
-    d_zombies.insert(nv);  // FIXME multithreading
-
-    if(safeToReclaimZombies()) {
-      if(d_zombies.size() > 5000) {
-        reclaimZombies();
-      }
-    }
+    d_zombies.insert(nv);
+    return d_zombies.size() > d_zombieThreshold && !d_reclaimAtSafePointsOnly;
   }
 
+  /**
+   * Run a reclamation step after addZombie() returned true, unless it is not
+   * safe, or another thread is reclaiming already.
+   */
+  void reclaimZombiesIfDue();
+
   /**
    * Register a NodeValue as having a maxed out reference count. This NodeValue
    * will live as long as its containing NodeManager.
@@ -318,13 +544,16 @@ class NodeManager
       Debug("gc") << "marking node value " << nv
                   << " [" << nv->d_id << "]: as maxed out" << std::endl;
     }
+    std::lock_guard<expr::NodeMutex> guard(d_zombieMutex);
     d_maxedOut.push_back(nv);
   }
 
   /**
-   * Reclaim all zombies.
+   * Reclaim zombies.  If budget is non-zero, at most budget of the pending
+   * zombies are examined; otherwise, all of them are.  Zombies created
+   * during the reclamation are not examined in the same call.
    */
-  void reclaimZombies();
+  void reclaimZombies(size_t budget = 0);
 
   /**
    * It is safe to collect zombies.
@@ -391,6 +620,27 @@ class NodeManager
   Node mkVar(const TypeNode& type);
   Node* mkVarPtr(const TypeNode& type);
 
+  /**
+   * Create the NodeValue of the node of the given kind with the given
+   * children, which the caller knows all of.  The children are written
+   * directly into a NodeValue of the allocator rather than going through a
+   * NodeBuilder.  For at most MAX_POOLED_CHILDREN children, the node is first
+   * looked up in the pool with a key on the stack, so that a node already in
+   * the pool costs no allocation and no reference count changes.  Iterator
+   * iterates over Nodes or TNodes.  As constructNV() of NodeBuilder, the
+   * result must be wrapped with wrapPooled().
+   */
+  template <class Iterator>
+  expr::NodeValue* mkNodeValue(Kind kind, Iterator begin, size_t nchildren);
+
+  /**
+   * Wrap mkNodeValue() into a Node, type checking it in debug builds.  If a
+   * child is a BUILTIN operator, the node is made with a NodeBuilder, which
+   * handles such children.
+   */
+  template <class Iterator>
+  Node mkNodeDirect(Kind kind, Iterator begin, size_t nchildren);
+
  public:
 
   explicit NodeManager(ExprManager* exprManager);
@@ -1140,9 +1390,34 @@ class NodeManager
   /** Reclaims all zombies (if possible).*/
   void reclaimAllZombies();
 
+  /**
+   * Set when zombies are reclaimed.  A reclamation step is triggered once
+   * more than threshold zombies are pending.  If budget is non-zero, such a
+   * step examines at most budget zombies, which bounds the pause it causes.
+   * If safePointsOnly is true, zombies are reclaimed only when
+   * reclaimZombiesAtSafePoint() is called.
+   */
+  void setZombieReclaimPolicy(size_t threshold,
+                              size_t budget,
+                              bool safePointsOnly);
+
+  /**
+   * Called at a point where no operation on nodes is in progress (e.g. by
+   * SmtEngine between queries).  Reclaims all zombies (if possible) if more
+   * than the threshold set by setZombieReclaimPolicy() are pending.
+   */
+  void reclaimZombiesAtSafePoint();
+
   /** Size of the node pool. */
   size_t poolSize() const;
 
+  /**
+   * Make room in the node pool for n node values, e.g. when the number of
+   * terms of the input is known in advance.  This avoids growing the pool
+   * while the terms are created.
+   */
+  void reservePool(size_t n);
+
   /** Deletes a list of attributes from the NM's AttributeManager.*/
   void deleteAttributes(const std::vector< const expr::attr::AttributeUniqueId* >& ids);
 
@@ -1253,25 +1528,37 @@ inline TypeNode NodeManager::mkTesterType(TypeNode domain) {
 }
 
 inline expr::NodeValue* NodeManager::poolLookup(expr::NodeValue* nv) const {
-  NodeValuePool::const_iterator find = d_nodeValuePool.find(nv);
-  if(find == d_nodeValuePool.end()) {
-    return NULL;
-  } else {
-    return *find;
+#ifdef CVC4_THREAD_SAFE_NODES
+  expr::NodeValue* found = shardOf(nv).d_pool.find(nv);
+  if (found != nullptr)
+  {
+    found->inc();
   }
+  return found;
+#else  /* CVC4_THREAD_SAFE_NODES */
+  return d_nodeValuePool.find(nv);
+#endif /* CVC4_THREAD_SAFE_NODES */
 }
 
 inline void NodeManager::poolInsert(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) == d_nodeValuePool.end())
-      << "NodeValue already in the pool!";
-  d_nodeValuePool.insert(nv);// FIXME multithreading
+#ifdef CVC4_THREAD_SAFE_NODES
+  expr::NodeValuePool& pool = shardOf(nv).d_pool;
+#else  /* CVC4_THREAD_SAFE_NODES */
+  expr::NodeValuePool& pool = d_nodeValuePool;
+#endif /* CVC4_THREAD_SAFE_NODES */
+  Assert(pool.find(nv) == nullptr) << "NodeValue already in the pool!";
+  pool.insert(nv);
 }
 
 inline void NodeManager::poolRemove(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) != d_nodeValuePool.end())
-      << "NodeValue is not in the pool!";
-
-  d_nodeValuePool.erase(nv);// FIXME multithreading
+#ifdef CVC4_THREAD_SAFE_NODES
+  expr::NodeValuePool& pool = shardOf(nv).d_pool;
+#else  /* CVC4_THREAD_SAFE_NODES */
+  expr::NodeValuePool& pool = d_nodeValuePool;
+#endif /* CVC4_THREAD_SAFE_NODES */
+  Assert(pool.find(nv) == nv) << "NodeValue is not in the pool!";
+
+  pool.erase(nv);
 }
 
 inline Expr NodeManager::toExpr(TNode n) {
@@ -1335,69 +1622,59 @@ inline Kind NodeManager::operatorToKind(TNode n) {
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1) {
-  NodeBuilder<1> nb(this, kind);
-  nb << child1;
-  return nb.constructNode();
+  TNode children[] = {child1};
+  return mkNodeDirect(kind, children, 1);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1) {
-  NodeBuilder<1> nb(this, kind);
-  nb << child1;
-  return nb.constructNodePtr();
+  TNode children[] = {child1};
+  return new Node(mkNodeDirect(kind, children, 1));
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2) {
-  NodeBuilder<2> nb(this, kind);
-  nb << child1 << child2;
-  return nb.constructNode();
+  TNode children[] = {child1, child2};
+  return mkNodeDirect(kind, children, 2);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2) {
-  NodeBuilder<2> nb(this, kind);
-  nb << child1 << child2;
-  return nb.constructNodePtr();
+  TNode children[] = {child1, child2};
+  return new Node(mkNodeDirect(kind, children, 2));
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3) {
-  NodeBuilder<3> nb(this, kind);
-  nb << child1 << child2 << child3;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3};
+  return mkNodeDirect(kind, children, 3);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
                                 TNode child3) {
-  NodeBuilder<3> nb(this, kind);
-  nb << child1 << child2 << child3;
-  return nb.constructNodePtr();
+  TNode children[] = {child1, child2, child3};
+  return new Node(mkNodeDirect(kind, children, 3));
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3, TNode child4) {
-  NodeBuilder<4> nb(this, kind);
-  nb << child1 << child2 << child3 << child4;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3, child4};
+  return mkNodeDirect(kind, children, 4);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
                                 TNode child3, TNode child4) {
-  NodeBuilder<4> nb(this, kind);
-  nb << child1 << child2 << child3 << child4;
-  return nb.constructNodePtr();
+  TNode children[] = {child1, child2, child3, child4};
+  return new Node(mkNodeDirect(kind, children, 4));
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3, TNode child4, TNode child5) {
-  NodeBuilder<5> nb(this, kind);
-  nb << child1 << child2 << child3 << child4 << child5;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3, child4, child5};
+  return mkNodeDirect(kind, children, 5);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
                                     TNode child3, TNode child4, TNode child5) {
-  NodeBuilder<5> nb(this, kind);
-  nb << child1 << child2 << child3 << child4 << child5;
-  return nb.constructNodePtr();
+  TNode children[] = {child1, child2, child3, child4, child5};
+  return new Node(mkNodeDirect(kind, children, 5));
 }
 
 // N-ary version
@@ -1405,9 +1682,12 @@ template <bool ref_count>
 inline Node NodeManager::mkNode(Kind kind,
                                 const std::vector<NodeTemplate<ref_count> >&
                                 children) {
-  NodeBuilder<> nb(this, kind);
-  nb.append(children);
-  return nb.constructNode();
+  if (children.empty())
+  {
+    NodeBuilder<> nb(this, kind);
+    return nb.constructNode();
+  }
+  return mkNodeDirect(kind, children.begin(), children.size());
 }
 
 template <bool ref_count>
@@ -1442,9 +1722,12 @@ template <bool ref_count>
 inline Node* NodeManager::mkNodePtr(Kind kind,
                                 const std::vector<NodeTemplate<ref_count> >&
                                 children) {
-  NodeBuilder<> nb(this, kind);
-  nb.append(children);
-  return nb.constructNodePtr();
+  if (children.empty())
+  {
+    NodeBuilder<> nb(this, kind);
+    return nb.constructNodePtr();
+  }
+  return new Node(mkNodeDirect(kind, children.begin(), children.size()));
 }
 
 // for operators
@@ -1638,6 +1921,7 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
 
   nvStack.d_children[0] =
     const_cast<expr::NodeValue*>(reinterpret_cast<const expr::NodeValue*>(&val));
+  PoolLock lock(this, &nvStack);
   expr::NodeValue* nv = poolLookup(&nvStack);
 
 #if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
@@ -1645,7 +1929,7 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
 #endif
 
   if(nv != NULL) {
-    return NodeClass(nv);
+    return wrapPooled<NodeClass>(nv);
   }
 
   nv = (expr::NodeValue*)
@@ -1656,8 +1940,8 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
 
   nv->d_nchildren = 0;
   nv->d_kind = kind::metakind::ConstantMap<T>::kind;
-  nv->d_id = next_id++;// FIXME multithreading
-  nv->d_rc = 0;
+  nv->d_id = next_id++;
+  nv->d_rc = NEW_NODE_RC;
 
   //OwningTheory::mkConst(val);
   new (&nv->d_children) T(val);
@@ -1670,7 +1954,153 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
     Debug("gc") << std::endl;
   }
 
-  return NodeClass(nv);
+  return wrapPooled<NodeClass>(nv);
+}
+
+template <class Iterator>
+expr::NodeValue* NodeManager::mkNodeValue(Kind kind,
+                                          Iterator begin,
+                                          size_t nchildren)
+{
+  Assert(kind::metaKindOf(kind) != kind::metakind::VARIABLE
+         && kind::metaKindOf(kind) != kind::metakind::NULLARY_OPERATOR
+         && kind::metaKindOf(kind) != kind::metakind::CONSTANT)
+      << "Nodes of kind " << kind << " are not made from children";
+#ifdef CVC4_ASSERTIONS
+  // the operator of a parameterized kind does not count towards its arity,
+  // as in NodeBuilder
+  size_t arity = nchildren;
+  if (kind::metaKindOf(kind) == kind::metakind::PARAMETERIZED)
+  {
+    Assert(nchildren > 0)
+        << "Nodes with kind " << kind << " must have an operator";
+    --arity;
+  }
+  Assert(arity >= kind::metakind::getMinArityForKind(kind))
+      << "Nodes with kind " << kind << " must have at least "
+      << kind::metakind::getMinArityForKind(kind)
+      << " children (the one under construction has " << arity << ")";
+  Assert(arity <= kind::metakind::getMaxArityForKind(kind))
+      << "Nodes with kind " << kind << " must have at most "
+      << kind::metakind::getMaxArityForKind(kind)
+      << " children (the one under construction has " << arity << ")";
+#endif /* CVC4_ASSERTIONS */
+
+  expr::NodeValue* nv;
+  if (__builtin_expect(
+          (nchildren <= expr::NodeValueAllocator::MAX_POOLED_CHILDREN), true))
+  {
+    // Look the node up with a key on the stack; the children are not
+    // referenced by the key, so a hit costs no reference count changes
+    NVStorage<expr::NodeValueAllocator::MAX_POOLED_CHILDREN> nvStorage;
+    expr::NodeValue& nvStack = reinterpret_cast<expr::NodeValue&>(nvStorage);
+    nvStack.d_id = 0;
+    nvStack.d_kind = kind;
+    nvStack.d_rc = 0;
+    nvStack.d_nchildren = nchildren;
+
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+
+    Iterator it = begin;
+    for (size_t i = 0; i < nchildren; ++i, ++it)
+    {
+      Assert(!(*it).isNull()) << "Cannot use NULL Node as a child of a Node";
+      nvStack.d_children[i] = (*it).d_nv;
+    }
+
+    PoolLock lock(this, &nvStack);
+    expr::NodeValue* poolNv = poolLookup(&nvStack);
+    if (poolNv != NULL)
+    {
+      return poolNv;
+    }
+
+    // Not in the pool: the children are written into the canonical
+    // NodeValue, which takes a reference to each of them
+    nv = d_nvAllocator->allocate(nchildren);
+    nv->d_nchildren = nchildren;
+    nv->d_kind = kind;
+    for (size_t i = 0; i < nchildren; ++i)
+    {
+      nv->d_children[i] = nvStack.d_children[i];
+      nv->d_children[i]->inc();
+    }
+
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
+#pragma GCC diagnostic pop
+#endif
+
+    nv->d_id = next_id++;
+    nv->d_rc = NEW_NODE_RC;
+    poolInsert(nv);
+  }
+  else
+  {
+    // Too many children for a key on the stack: the NodeValue from the
+    // allocator is the key, and is given back if the node is in the pool
+    nv = d_nvAllocator->allocate(nchildren);
+    nv->d_id = 0;
+    nv->d_kind = kind;
+    nv->d_rc = 0;
+    nv->d_nchildren = nchildren;
+    Iterator it = begin;
+    for (size_t i = 0; i < nchildren; ++i, ++it)
+    {
+      Assert(!(*it).isNull()) << "Cannot use NULL Node as a child of a Node";
+      nv->d_children[i] = (*it).d_nv;
+    }
+
+    PoolLock lock(this, nv);
+    expr::NodeValue* poolNv = poolLookup(nv);
+    if (poolNv != NULL)
+    {
+      d_nvAllocator->deallocate(nv, nchildren);
+      return poolNv;
+    }
+    for (size_t i = 0; i < nchildren; ++i)
+    {
+      nv->d_children[i]->inc();
+    }
+    nv->d_id = next_id++;
+    nv->d_rc = NEW_NODE_RC;
+    poolInsert(nv);
+  }
+  if (Debug.isOn("gc"))
+  {
+    Debug("gc") << "creating node value " << nv << " [" << nv->d_id << "]: ";
+    nv->printAst(Debug("gc"));
+    Debug("gc") << std::endl;
+  }
+  return nv;
+}
+
+template <class Iterator>
+Node NodeManager::mkNodeDirect(Kind kind, Iterator begin, size_t nchildren)
+{
+  Iterator it = begin;
+  for (size_t i = 0; i < nchildren; ++i, ++it)
+  {
+    if (__builtin_expect(((*it).getKind() == kind::BUILTIN), false))
+    {
+      // NodeBuilder converts an operator child into the kind of the node
+      NodeBuilder<> nb(this, kind);
+      it = begin;
+      for (size_t j = 0; j < nchildren; ++j, ++it)
+      {
+        nb << *it;
+      }
+      return nb.constructNode();
+    }
+  }
+  Node n = wrapPooled<Node>(mkNodeValue(kind, begin, nchildren));
+#ifdef CVC4_DEBUG
+  // force an immediate type check, as NodeBuilder does
+  getType(n, true);
+#endif /* CVC4_DEBUG */
+  return n;
 }
 
 }/* CVC4 namespace */
@@ -36,5 +36,18 @@ typedef Attribute<attr::SortArityTag, uint64_t> SortArityAttr;
 typedef expr::Attribute<expr::attr::TypeTag, TypeNode> TypeAttr;
 typedef expr::Attribute<expr::attr::TypeCheckedTag, bool> TypeCheckedAttr;
 
+// The type of (almost) every node is computed and cached, so these are kept
+// in dense tables.
+namespace attr {
+template <>
+struct UseDenseStorage<TypeAttr> : public std::true_type
+{
+};
+template <>
+struct UseDenseStorage<TypeCheckedAttr> : public std::true_type
+{
+};
+}/* CVC4::expr::attr namespace */
+
 }/* CVC4::expr namespace */
 }/* CVC4 namespace */
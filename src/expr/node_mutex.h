@@ -0,0 +1,57 @@
+/*********************                                                        */
+/*! \file node_mutex.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Mutexes of the expression layer
+ **
+ ** Mutexes guarding the shared state of the expression layer (the pool,
+ ** zombies, allocator and attribute tables of a NodeManager).  They are real
+ ** mutexes only in thread-safe builds (CVC4_THREAD_SAFE_NODES); otherwise
+ ** they do nothing and compile away.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_MUTEX_H
+#define CVC4__EXPR__NODE_MUTEX_H
+
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <mutex>
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+namespace CVC4 {
+namespace expr {
+
+#ifdef CVC4_THREAD_SAFE_NODES
+
+typedef std::mutex NodeMutex;
+typedef std::recursive_mutex NodeRecursiveMutex;
+
+#else /* CVC4_THREAD_SAFE_NODES */
+
+/**
+ * A mutex that does nothing, for single-threaded builds.  Meets the Lockable
+ * requirements, so it can be used with std::lock_guard and friends.
+ */
+class NullMutex
+{
+ public:
+  void lock() {}
+  void unlock() {}
+  bool try_lock() { return true; }
+}; /* class NullMutex */
+
+typedef NullMutex NodeMutex;
+typedef NullMutex NodeRecursiveMutex;
+
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_MUTEX_H */
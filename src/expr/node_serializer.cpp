@@ -0,0 +1,915 @@
+/*********************                                                        */
+/*! \file node_serializer.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Binary serialization of node DAGs
+ **
+ ** Binary serialization of node DAGs.
+ **/
+
+#include "expr/node_serializer.h"
+
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "base/exception.h"
+#include "expr/node_manager.h"
+#include "expr/node_manager_attributes.h"
+#include "expr/type_checker.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+#include "util/string.h"
+
+namespace CVC4 {
+namespace expr {
+
+namespace {
+
+/** The magic number a serialization starts with */
+const char MAGIC[8] = {'C', 'V', 'C', '4', 'N', 'D', 'A', 'G'};
+
+/** The version of the format */
+const uint64_t VERSION = 1;
+
+/** The kinds of entries of a serialization */
+enum EntryTag : uint8_t
+{
+  /** A node: its kind and children (including the operator, if any) */
+  ENTRY_NODE,
+  /** A type: its kind and children */
+  ENTRY_TYPE,
+  /** A constant node: its kind and payload */
+  ENTRY_CONSTANT,
+  /** A constant type: its kind and payload */
+  ENTRY_TYPE_CONSTANT,
+  /** A variable: its kind, id, type and name */
+  ENTRY_VARIABLE,
+  /** A nullary operator: its kind and type */
+  ENTRY_NULLARY_OPERATOR,
+  /** An uninterpreted sort or sort constructor: its id, name and arity */
+  ENTRY_SORT,
+  /** An instance of a sort constructor: the constructor and arguments */
+  ENTRY_SORT_INSTANCE
+};
+
+/** Append v to buf as a variable-length (LEB128) unsigned integer */
+void appendUnsigned(std::string& buf, uint64_t v)
+{
+  while (v >= 0x80)
+  {
+    buf.push_back(static_cast<char>((v & 0x7f) | 0x80));
+    v >>= 7;
+  }
+  buf.push_back(static_cast<char>(v));
+}
+
+/**
+ * Writes the entries for node DAGs to a buffer.  Nodes and types share one
+ * index, keyed by their id.
+ *
+ * In canonical mode, variables and sorts are written with their positions in
+ * vars() and sorts() instead of their ids.
+ */
+class NodeDagWriter
+{
+ public:
+  NodeDagWriter(bool canonical = false) : d_canonical(canonical), d_count(0)
+  {
+  }
+
+  /** Write the entries for the DAG of n, and return the index of n */
+  uint64_t write(TNode n);
+
+  /** Write the entries for the DAG of tn, and return the index of tn */
+  uint64_t write(const TypeNode& tn);
+
+  /** The number of entries written */
+  uint64_t count() const { return d_count; }
+
+  /** The entries written */
+  const std::string& buffer() const { return d_buf; }
+
+  /** The variables written, in canonical mode */
+  std::vector<Node>& vars() { return d_vars; }
+
+  /** The uninterpreted sorts written, in canonical mode */
+  std::vector<TypeNode>& sorts() { return d_sorts; }
+
+ private:
+  /** Start a new entry for the node or type of the given id */
+  uint64_t newEntry(uint64_t id, EntryTag tag)
+  {
+    d_buf.push_back(tag);
+    d_index[id] = d_count;
+    return d_count++;
+  }
+
+  /** Write the entry of n, whose children have entries already */
+  void writeEntry(TNode n);
+
+  /** Write the payload of the constant n (a Node or TypeNode) */
+  template <class NodeClass>
+  void writeConstant(const NodeClass& n);
+
+  void writeUnsigned(uint64_t v) { appendUnsigned(d_buf, v); }
+
+  void writeString(const std::string& s)
+  {
+    writeUnsigned(s.size());
+    d_buf.append(s);
+  }
+
+  /** Whether to write in canonical mode */
+  bool d_canonical;
+  /** The variables written, in canonical mode */
+  std::vector<Node> d_vars;
+  /** The uninterpreted sorts written, in canonical mode */
+  std::vector<TypeNode> d_sorts;
+  /** The index of the entries written so far, by node id */
+  std::unordered_map<uint64_t, uint64_t> d_index;
+  /** The number of entries written */
+  uint64_t d_count;
+  /** The entries written */
+  std::string d_buf;
+}; /* class NodeDagWriter */
+
+uint64_t NodeDagWriter::write(TNode root)
+{
+  std::vector<TNode> visit;
+  visit.push_back(root);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    if (d_index.find(cur.getId()) != d_index.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    bool ready = true;
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      TNode op = cur.getOperator();
+      if (d_index.find(op.getId()) == d_index.end())
+      {
+        visit.push_back(op);
+        ready = false;
+      }
+    }
+    for (TNode child : cur)
+    {
+      if (d_index.find(child.getId()) == d_index.end())
+      {
+        visit.push_back(child);
+        ready = false;
+      }
+    }
+    if (ready)
+    {
+      visit.pop_back();
+      writeEntry(cur);
+    }
+  }
+  return d_index[root.getId()];
+}
+
+void NodeDagWriter::writeEntry(TNode n)
+{
+  Kind k = n.getKind();
+  switch (n.getMetaKind())
+  {
+    case kind::metakind::CONSTANT:
+      newEntry(n.getId(), ENTRY_CONSTANT);
+      writeUnsigned(k);
+      writeConstant(n);
+      break;
+    case kind::metakind::VARIABLE:
+    {
+      if (k != kind::VARIABLE && k != kind::SKOLEM && k != kind::BOUND_VARIABLE)
+      {
+        throw Exception("cannot serialize variable of kind "
+                        + kind::kindToString(k));
+      }
+      uint64_t type = write(n.getType());
+      std::string name;
+      bool hasName = n.getAttribute(VarNameAttr(), name);
+      newEntry(n.getId(), ENTRY_VARIABLE);
+      writeUnsigned(k);
+      if (d_canonical)
+      {
+        writeUnsigned(d_vars.size());
+        d_vars.push_back(n);
+      }
+      else
+      {
+        writeUnsigned(n.getId());
+      }
+      writeUnsigned(type);
+      writeUnsigned(hasName);
+      if (hasName)
+      {
+        writeString(name);
+      }
+      break;
+    }
+    case kind::metakind::NULLARY_OPERATOR:
+    {
+      uint64_t type = write(n.getType());
+      newEntry(n.getId(), ENTRY_NULLARY_OPERATOR);
+      writeUnsigned(k);
+      writeUnsigned(type);
+      break;
+    }
+    default:
+    {
+      std::vector<uint64_t> children;
+      if (n.getMetaKind() == kind::metakind::PARAMETERIZED)
+      {
+        children.push_back(d_index[n.getOperator().getId()]);
+      }
+      for (TNode child : n)
+      {
+        children.push_back(d_index[child.getId()]);
+      }
+      newEntry(n.getId(), ENTRY_NODE);
+      writeUnsigned(k);
+      writeUnsigned(children.size());
+      for (uint64_t child : children)
+      {
+        writeUnsigned(child);
+      }
+    }
+  }
+}
+
+uint64_t NodeDagWriter::write(const TypeNode& tn)
+{
+  std::unordered_map<uint64_t, uint64_t>::const_iterator it =
+      d_index.find(tn.getId());
+  if (it != d_index.end())
+  {
+    return it->second;
+  }
+  Kind k = tn.getKind();
+  if (tn.getMetaKind() == kind::metakind::CONSTANT)
+  {
+    uint64_t index = newEntry(tn.getId(), ENTRY_TYPE_CONSTANT);
+    writeUnsigned(k);
+    writeConstant(tn);
+    return index;
+  }
+  if (k == kind::SORT_TYPE)
+  {
+    if (tn.getNumChildren() > 1)
+    {
+      // an instance of a sort constructor, which is the sort type of the
+      // same sort tag
+      std::vector<uint64_t> children;
+      children.push_back(
+          write(NodeManager::currentNM()->mkTypeNode(kind::SORT_TYPE, tn[0])));
+      for (size_t i = 1, n = tn.getNumChildren(); i < n; ++i)
+      {
+        children.push_back(write(tn[i]));
+      }
+      uint64_t index = newEntry(tn.getId(), ENTRY_SORT_INSTANCE);
+      writeUnsigned(children.size() - 1);
+      for (uint64_t child : children)
+      {
+        writeUnsigned(child);
+      }
+      return index;
+    }
+    std::string name;
+    bool hasName = tn.getAttribute(VarNameAttr(), name);
+    uint64_t index = newEntry(tn.getId(), ENTRY_SORT);
+    if (d_canonical)
+    {
+      writeUnsigned(d_sorts.size());
+      d_sorts.push_back(tn);
+    }
+    else
+    {
+      writeUnsigned(tn.getId());
+    }
+    writeUnsigned(tn.isSortConstructor() ? tn.getSortConstructorArity() : 0);
+    writeUnsigned(hasName);
+    if (hasName)
+    {
+      writeString(name);
+    }
+    return index;
+  }
+  if (tn.getMetaKind() != kind::metakind::OPERATOR)
+  {
+    throw Exception("cannot serialize type of kind " + kind::kindToString(k));
+  }
+  std::vector<uint64_t> children;
+  for (size_t i = 0, n = tn.getNumChildren(); i < n; ++i)
+  {
+    children.push_back(write(tn[i]));
+  }
+  uint64_t index = newEntry(tn.getId(), ENTRY_TYPE);
+  writeUnsigned(k);
+  writeUnsigned(children.size());
+  for (uint64_t child : children)
+  {
+    writeUnsigned(child);
+  }
+  return index;
+}
+
+template <class NodeClass>
+void NodeDagWriter::writeConstant(const NodeClass& n)
+{
+  switch (n.getKind())
+  {
+    case kind::BUILTIN:
+      writeUnsigned(n.template getConst<Kind>());
+      break;
+    case kind::TYPE_CONSTANT:
+      writeUnsigned(n.template getConst<TypeConstant>());
+      break;
+    case kind::CONST_BOOLEAN:
+      writeUnsigned(n.template getConst<bool>());
+      break;
+    case kind::CONST_RATIONAL:
+      writeString(n.template getConst<Rational>().toString(16));
+      break;
+    case kind::CONST_BITVECTOR:
+    {
+      const BitVector& bv = n.template getConst<BitVector>();
+      writeUnsigned(bv.getSize());
+      writeString(bv.getValue().toString(16));
+      break;
+    }
+    case kind::CONST_STRING:
+    {
+      const std::vector<unsigned>& vec = n.template getConst<String>().getVec();
+      writeUnsigned(vec.size());
+      for (unsigned c : vec)
+      {
+        writeUnsigned(c);
+      }
+      break;
+    }
+    case kind::BITVECTOR_TYPE:
+      writeUnsigned(n.template getConst<BitVectorSize>());
+      break;
+    case kind::BITVECTOR_EXTRACT_OP:
+    {
+      const BitVectorExtract& op = n.template getConst<BitVectorExtract>();
+      writeUnsigned(op.d_high);
+      writeUnsigned(op.d_low);
+      break;
+    }
+    case kind::BITVECTOR_BITOF_OP:
+      writeUnsigned(n.template getConst<BitVectorBitOf>().d_bitIndex);
+      break;
+    case kind::BITVECTOR_REPEAT_OP:
+      writeUnsigned(n.template getConst<BitVectorRepeat>());
+      break;
+    case kind::BITVECTOR_ZERO_EXTEND_OP:
+      writeUnsigned(n.template getConst<BitVectorZeroExtend>());
+      break;
+    case kind::BITVECTOR_SIGN_EXTEND_OP:
+      writeUnsigned(n.template getConst<BitVectorSignExtend>());
+      break;
+    case kind::BITVECTOR_ROTATE_LEFT_OP:
+      writeUnsigned(n.template getConst<BitVectorRotateLeft>());
+      break;
+    case kind::BITVECTOR_ROTATE_RIGHT_OP:
+      writeUnsigned(n.template getConst<BitVectorRotateRight>());
+      break;
+    case kind::INT_TO_BITVECTOR_OP:
+      writeUnsigned(n.template getConst<IntToBitVector>());
+      break;
+    default:
+      throw Exception("cannot serialize constant of kind "
+                      + kind::kindToString(n.getKind()));
+  }
+}
+
+/** Decodes a serialization in place */
+class NodeDagReader
+{
+ public:
+  NodeDagReader(const char* data, size_t size)
+      : d_pos(data), d_end(data + size)
+  {
+  }
+
+  bool atEnd() const { return d_pos == d_end; }
+
+  uint8_t readByte()
+  {
+    if (d_pos == d_end)
+    {
+      malformed();
+    }
+    return static_cast<uint8_t>(*d_pos++);
+  }
+
+  uint64_t readUnsigned()
+  {
+    uint64_t v = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+      uint8_t b = readByte();
+      v |= static_cast<uint64_t>(b & 0x7f) << shift;
+      if ((b & 0x80) == 0)
+      {
+        return v;
+      }
+    }
+    malformed();
+  }
+
+  /** Read an unsigned value that must be less than bound */
+  uint64_t readUnsigned(uint64_t bound)
+  {
+    uint64_t v = readUnsigned();
+    if (v >= bound)
+    {
+      malformed();
+    }
+    return v;
+  }
+
+  std::string readString()
+  {
+    uint64_t size = readUnsigned();
+    if (size > static_cast<uint64_t>(d_end - d_pos))
+    {
+      malformed();
+    }
+    std::string s(d_pos, size);
+    d_pos += size;
+    return s;
+  }
+
+  /** Check that the next bytes are the given ones, and skip them */
+  void expect(const char* bytes, size_t size)
+  {
+    if (size > static_cast<size_t>(d_end - d_pos)
+        || std::memcmp(d_pos, bytes, size) != 0)
+    {
+      malformed();
+    }
+    d_pos += size;
+  }
+
+  /**
+   * Read a string that is a hexadecimal integer with an optional minus sign,
+   * or a fraction of such an integer and a non-zero hexadecimal integer if
+   * fraction is true.
+   */
+  std::string readHexNumeral(bool fraction)
+  {
+    std::string s = readString();
+    size_t i = (!s.empty() && s[0] == '-') ? 1 : 0;
+    size_t digits = 0;
+    size_t nonZero = 0;
+    bool denominator = false;
+    for (; i < s.size(); ++i)
+    {
+      if (s[i] == '/' && fraction && !denominator && digits > 0)
+      {
+        denominator = true;
+        digits = 0;
+        nonZero = 0;
+      }
+      else if (std::isxdigit(static_cast<unsigned char>(s[i])))
+      {
+        ++digits;
+        nonZero += s[i] != '0' ? 1 : 0;
+      }
+      else
+      {
+        malformed();
+      }
+    }
+    if (digits == 0 || (denominator && nonZero == 0))
+    {
+      malformed();
+    }
+    return s;
+  }
+
+  [[noreturn]] static void malformed()
+  {
+    throw Exception("malformed node serialization");
+  }
+
+ private:
+  const char* d_pos;
+  const char* d_end;
+}; /* class NodeDagReader */
+
+/** Read a kind, which is not a marker like UNDEFINED_KIND or NULL_EXPR */
+Kind readKind(NodeDagReader& r)
+{
+  Kind k = static_cast<Kind>(r.readUnsigned(kind::LAST_KIND));
+  if (k == kind::NULL_EXPR)
+  {
+    NodeDagReader::malformed();
+  }
+  return k;
+}
+
+/** Read the width of a bit-vector, which is positive */
+unsigned readWidth(NodeDagReader& r)
+{
+  unsigned width = r.readUnsigned(UINT32_MAX);
+  if (width == 0)
+  {
+    NodeDagReader::malformed();
+  }
+  return width;
+}
+
+/** Check that a node or type of kind k may have nchildren children */
+void checkArity(Kind k, uint64_t nchildren)
+{
+  if (nchildren < kind::metakind::getMinArityForKind(k)
+      || nchildren > kind::metakind::getMaxArityForKind(k))
+  {
+    NodeDagReader::malformed();
+  }
+}
+
+/** Write the DAGs of nodes to out with the given writer */
+void writeNodes(NodeDagWriter& writer,
+                const std::vector<Node>& nodes,
+                std::ostream& out)
+{
+  std::vector<uint64_t> roots;
+  for (const Node& n : nodes)
+  {
+    // index 0 denotes the null node
+    roots.push_back(n.isNull() ? 0 : writer.write(n) + 1);
+  }
+  std::string header(MAGIC, sizeof(MAGIC));
+  appendUnsigned(header, VERSION);
+  appendUnsigned(header, kind::LAST_KIND);
+  appendUnsigned(header, writer.count());
+  std::string trailer;
+  appendUnsigned(trailer, roots.size());
+  for (uint64_t root : roots)
+  {
+    appendUnsigned(trailer, root);
+  }
+  out << header << writer.buffer() << trailer;
+}
+
+}  // namespace
+
+void serializeNodes(const std::vector<Node>& nodes, std::ostream& out)
+{
+  NodeDagWriter writer;
+  writeNodes(writer, nodes, out);
+}
+
+void serializeNodesCanonical(const std::vector<Node>& nodes,
+                             std::ostream& out,
+                             std::vector<Node>& vars,
+                             std::vector<TypeNode>& sorts)
+{
+  NodeDagWriter writer(true);
+  writeNodes(writer, nodes, out);
+  vars.swap(writer.vars());
+  sorts.swap(writer.sorts());
+}
+
+NodeDeserializer::NodeDeserializer(NodeManager* nm) : d_nm(nm) {}
+
+void NodeDeserializer::bind(const std::vector<Node>& vars,
+                            const std::vector<TypeNode>& sorts)
+{
+  for (size_t i = 0, n = vars.size(); i < n; ++i)
+  {
+    d_vars[i] = vars[i];
+  }
+  for (size_t i = 0, n = sorts.size(); i < n; ++i)
+  {
+    d_sorts[i] = sorts[i];
+  }
+}
+
+std::vector<Node> NodeDeserializer::deserialize(std::istream& in)
+{
+  std::string buf((std::istreambuf_iterator<char>(in)),
+                  std::istreambuf_iterator<char>());
+  return deserialize(buf.data(), buf.size());
+}
+
+std::vector<Node> NodeDeserializer::deserialize(const char* data, size_t size)
+{
+  NodeManagerScope nms(d_nm);
+  NodeDagReader r(data, size);
+  r.expect(MAGIC, sizeof(MAGIC));
+  if (r.readUnsigned() != VERSION
+      || r.readUnsigned() != static_cast<uint64_t>(kind::LAST_KIND))
+  {
+    throw Exception("node serialization of another version of CVC4");
+  }
+  uint64_t count = r.readUnsigned();
+  // an entry takes at least two bytes
+  if (count > size)
+  {
+    NodeDagReader::malformed();
+  }
+  // each entry defines either a node or a type
+  std::vector<Node> nodes;
+  std::vector<TypeNode> types;
+  nodes.reserve(count);
+  types.reserve(count);
+  auto readNode = [&]() {
+    Node n = nodes[r.readUnsigned(nodes.size())];
+    if (n.isNull())
+    {
+      NodeDagReader::malformed();
+    }
+    return n;
+  };
+  auto readType = [&]() {
+    TypeNode tn = types[r.readUnsigned(types.size())];
+    if (tn.isNull())
+    {
+      NodeDagReader::malformed();
+    }
+    return tn;
+  };
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    Node n;
+    TypeNode tn;
+    uint8_t tag = r.readByte();
+    switch (tag)
+    {
+      case ENTRY_NODE:
+      {
+        Kind k = readKind(r);
+        kind::MetaKind mk = kind::metaKindOf(k);
+        uint64_t nchildren = r.readUnsigned(nodes.size() + 1);
+        bool parameterized = mk == kind::metakind::PARAMETERIZED;
+        // the kinds of types have no type rule
+        if ((mk != kind::metakind::OPERATOR && !parameterized)
+            || (parameterized && nchildren == 0)
+            || !TypeChecker::hasTypeRule(k))
+        {
+          NodeDagReader::malformed();
+        }
+        checkArity(k, parameterized ? nchildren - 1 : nchildren);
+        std::vector<Node> children;
+        for (uint64_t j = 0; j < nchildren; ++j)
+        {
+          children.push_back(readNode());
+          // operators are only written as the operator of a parameterized
+          // node
+          if (children.back().getKind() == kind::BUILTIN)
+          {
+            NodeDagReader::malformed();
+          }
+        }
+        if (parameterized)
+        {
+          // the operator is a constant of the operator kind of k, or a
+          // function applied by APPLY_UF
+          Node op = children[0];
+          if (op.isConst() ? NodeManager::operatorToKind(op) != k
+                           : k != kind::APPLY_UF || !op.getType().isFunction())
+          {
+            NodeDagReader::malformed();
+          }
+        }
+        try
+        {
+          n = d_nm->mkNode(k, children);
+          n.getType(true);
+        }
+        catch (const TypeCheckingExceptionPrivate&)
+        {
+          NodeDagReader::malformed();
+        }
+        break;
+      }
+      case ENTRY_TYPE:
+      {
+        Kind k = readKind(r);
+        uint64_t nchildren = r.readUnsigned(types.size() + 1);
+        if (kind::metaKindOf(k) != kind::metakind::OPERATOR
+            || TypeChecker::hasTypeRule(k))
+        {
+          NodeDagReader::malformed();
+        }
+        checkArity(k, nchildren);
+        std::vector<TypeNode> children;
+        for (uint64_t j = 0; j < nchildren; ++j)
+        {
+          children.push_back(readType());
+        }
+        tn = d_nm->mkTypeNode(k, children);
+        break;
+      }
+      case ENTRY_CONSTANT:
+      case ENTRY_TYPE_CONSTANT:
+      {
+        Kind k = readKind(r);
+        bool isType = tag == ENTRY_TYPE_CONSTANT;
+        switch (k)
+        {
+          case kind::BUILTIN:
+          {
+            Kind op = readKind(r);
+            if (kind::metaKindOf(op) != kind::metakind::OPERATOR)
+            {
+              NodeDagReader::malformed();
+            }
+            n = d_nm->operatorOf(op);
+            break;
+          }
+          case kind::TYPE_CONSTANT:
+            tn = d_nm->mkTypeConst(
+                static_cast<TypeConstant>(r.readUnsigned(LAST_TYPE)));
+            break;
+          case kind::CONST_BOOLEAN:
+            n = d_nm->mkConst(r.readUnsigned(2) != 0);
+            break;
+          case kind::CONST_RATIONAL:
+            n = d_nm->mkConst(Rational(r.readHexNumeral(true), 16));
+            break;
+          case kind::CONST_BITVECTOR:
+          {
+            unsigned width = readWidth(r);
+            n = d_nm->mkConst(
+                BitVector(width, Integer(r.readHexNumeral(false), 16)));
+            break;
+          }
+          case kind::CONST_STRING:
+          {
+            std::vector<unsigned> vec(r.readUnsigned(size + 1));
+            for (unsigned& c : vec)
+            {
+              c = r.readUnsigned(UINT32_MAX);
+            }
+            n = d_nm->mkConst(String(vec));
+            break;
+          }
+          case kind::BITVECTOR_TYPE:
+            tn = d_nm->mkBitVectorType(readWidth(r));
+            break;
+          case kind::BITVECTOR_EXTRACT_OP:
+          {
+            unsigned high = r.readUnsigned(UINT32_MAX);
+            unsigned low = r.readUnsigned(UINT32_MAX);
+            n = d_nm->mkConst(BitVectorExtract(high, low));
+            break;
+          }
+          case kind::BITVECTOR_BITOF_OP:
+            n = d_nm->mkConst(BitVectorBitOf(r.readUnsigned(UINT32_MAX)));
+            break;
+          case kind::BITVECTOR_REPEAT_OP:
+            n = d_nm->mkConst(BitVectorRepeat(r.readUnsigned(UINT32_MAX)));
+            break;
+          case kind::BITVECTOR_ZERO_EXTEND_OP:
+            n = d_nm->mkConst(BitVectorZeroExtend(r.readUnsigned(UINT32_MAX)));
+            break;
+          case kind::BITVECTOR_SIGN_EXTEND_OP:
+            n = d_nm->mkConst(BitVectorSignExtend(r.readUnsigned(UINT32_MAX)));
+            break;
+          case kind::BITVECTOR_ROTATE_LEFT_OP:
+            n = d_nm->mkConst(BitVectorRotateLeft(r.readUnsigned(UINT32_MAX)));
+            break;
+          case kind::BITVECTOR_ROTATE_RIGHT_OP:
+            n = d_nm->mkConst(
+                BitVectorRotateRight(r.readUnsigned(UINT32_MAX)));
+            break;
+          case kind::INT_TO_BITVECTOR_OP:
+            n = d_nm->mkConst(IntToBitVector(r.readUnsigned(UINT32_MAX)));
+            break;
+          default: NodeDagReader::malformed();
+        }
+        // the writer decides whether a constant is a type
+        if (isType == tn.isNull())
+        {
+          NodeDagReader::malformed();
+        }
+        break;
+      }
+      case ENTRY_VARIABLE:
+      {
+        Kind k = readKind(r);
+        uint64_t id = r.readUnsigned();
+        TypeNode type = readType();
+        bool hasName = r.readUnsigned(2) != 0;
+        std::string name = hasName ? r.readString() : std::string();
+        Node& var = d_vars[id];
+        if (var.isNull())
+        {
+          switch (k)
+          {
+            case kind::VARIABLE:
+              var = hasName ? d_nm->mkVar(name, type) : d_nm->mkVar(type);
+              break;
+            case kind::SKOLEM:
+              var = d_nm->mkSkolem(name,
+                                   type,
+                                   "is a skolem loaded from a serialization",
+                                   NodeManager::SKOLEM_EXACT_NAME);
+              break;
+            case kind::BOUND_VARIABLE:
+              var = hasName ? d_nm->mkBoundVar(name, type)
+                            : d_nm->mkBoundVar(type);
+              break;
+            default: NodeDagReader::malformed();
+          }
+        }
+        else if (var.getKind() != k || var.getType() != type)
+        {
+          NodeDagReader::malformed();
+        }
+        n = var;
+        break;
+      }
+      case ENTRY_NULLARY_OPERATOR:
+      {
+        Kind k = readKind(r);
+        if (kind::metaKindOf(k) != kind::metakind::NULLARY_OPERATOR)
+        {
+          NodeDagReader::malformed();
+        }
+        n = d_nm->mkNullaryOperator(readType(), k);
+        break;
+      }
+      case ENTRY_SORT:
+      {
+        uint64_t id = r.readUnsigned();
+        uint64_t arity = r.readUnsigned();
+        bool hasName = r.readUnsigned(2) != 0;
+        std::string name = hasName ? r.readString() : std::string();
+        TypeNode& sort = d_sorts[id];
+        if (sort.isNull())
+        {
+          if (arity > 0)
+          {
+            sort = d_nm->mkSortConstructor(name, arity);
+          }
+          else
+          {
+            sort = hasName ? d_nm->mkSort(name) : d_nm->mkSort();
+          }
+        }
+        tn = sort;
+        break;
+      }
+      case ENTRY_SORT_INSTANCE:
+      {
+        uint64_t nargs = r.readUnsigned(types.size() + 1);
+        TypeNode ctor = readType();
+        if (!ctor.isSortConstructor()
+            || ctor.getSortConstructorArity() != nargs)
+        {
+          NodeDagReader::malformed();
+        }
+        std::vector<TypeNode> args;
+        for (uint64_t j = 0; j < nargs; ++j)
+        {
+          args.push_back(readType());
+        }
+        tn = d_nm->mkSort(ctor, args);
+        break;
+      }
+      default: NodeDagReader::malformed();
+    }
+    nodes.push_back(n);
+    types.push_back(tn);
+  }
+  std::vector<Node> roots(r.readUnsigned(size + 1));
+  for (Node& root : roots)
+  {
+    uint64_t index = r.readUnsigned(nodes.size() + 1);
+    if (index > 0)
+    {
+      root = nodes[index - 1];
+      if (root.isNull())
+      {
+        NodeDagReader::malformed();
+      }
+    }
+  }
+  if (!r.atEnd())
+  {
+    NodeDagReader::malformed();
+  }
+  return roots;
+}
+
+}  // namespace expr
+}  // namespace CVC4
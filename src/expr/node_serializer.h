@@ -0,0 +1,109 @@
+/*********************                                                        */
+/*! \file node_serializer.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Binary serialization of node DAGs
+ **
+ ** A compact binary format for node DAGs, for moving terms (e.g. the
+ ** preprocessed assertions) to another node manager, possibly in another
+ ** process, without printing and re-parsing them.
+ **
+ ** The format is a table of entries in topological order, each defining a
+ ** node or a type from the entries before it, so shared subterms are
+ ** written once.  Variables and uninterpreted sorts are written with their
+ ** names and types, and are recreated in the node manager loading them.
+ ** Kinds are written by number, so a serialization can only be loaded by a
+ ** build with the same kinds.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_SERIALIZER_H
+#define CVC4__EXPR__NODE_SERIALIZER_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+
+namespace CVC4 {
+
+class NodeManager;
+
+namespace expr {
+
+/**
+ * Write the DAGs of the given nodes to out.  The node manager of the nodes
+ * must be in scope.
+ *
+ * Only the constants of the core, arithmetic, bit-vector and string theories
+ * are supported; an Exception is thrown for other constants (e.g. datatype
+ * types), and for nodes of other variable kinds than VARIABLE, SKOLEM and
+ * BOUND_VARIABLE.
+ */
+void serializeNodes(const std::vector<Node>& nodes, std::ostream& out);
+
+/**
+ * Write the DAGs of the given nodes to out in canonical form: variables and
+ * uninterpreted sorts are numbered in the order they are first written,
+ * instead of by their ids, so structurally equal nodes (with equally named
+ * variables and sorts) are written the same in every process.  The variables
+ * and sorts written are stored in vars and sorts, by their number, for
+ * NodeDeserializer::bind().
+ */
+void serializeNodesCanonical(const std::vector<Node>& nodes,
+                             std::ostream& out,
+                             std::vector<Node>& vars,
+                             std::vector<TypeNode>& sorts);
+
+/**
+ * Loads node DAGs written by serializeNodes() into a node manager.
+ *
+ * The variables and uninterpreted sorts of a serialization are created
+ * fresh, and remembered (by their id in the node manager that wrote them),
+ * so that loading several serializations of the same node manager with the
+ * same NodeDeserializer yields the same variables.
+ */
+class NodeDeserializer
+{
+ public:
+  NodeDeserializer(NodeManager* nm);
+
+  /**
+   * Load the nodes serialized in the given buffer.  The buffer is decoded in
+   * place, so it may e.g. be a mapped file.  Throws an Exception if the
+   * buffer is not a valid serialization.
+   */
+  std::vector<Node> deserialize(const char* data, size_t size);
+
+  /** Load the nodes serialized in the remainder of the given stream. */
+  std::vector<Node> deserialize(std::istream& in);
+
+  /**
+   * Load the variables and sorts numbered i in later serializations as
+   * vars[i] and sorts[i], e.g. for the variables and sorts returned by
+   * serializeNodesCanonical().
+   */
+  void bind(const std::vector<Node>& vars, const std::vector<TypeNode>& sorts);
+
+ private:
+  /** The node manager the nodes are loaded into */
+  NodeManager* d_nm;
+  /** The variables loaded so far, by their id in the serialization */
+  std::unordered_map<uint64_t, Node> d_vars;
+  /** The uninterpreted sorts loaded so far, by their id in the serialization */
+  std::unordered_map<uint64_t, TypeNode> d_sorts;
+}; /* class NodeDeserializer */
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_SERIALIZER_H */
@@ -179,7 +179,14 @@ class NodeValue
   static constexpr uint32_t MAX_CHILDREN =
       (static_cast<uint32_t>(1) << NBITS_NCHILDREN) - 1;
 
-  uint32_t getRefCount() const { return d_rc; }
+  uint32_t getRefCount() const
+  {
+#ifdef CVC4_THREAD_SAFE_NODES
+    return __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+#else
+    return d_rc;
+#endif
+  }
 
   NodeValue* getOperator() const;
   NodeValue* getChild(int i) const;
@@ -331,11 +338,23 @@ class NodeValue
   /** The ID (0 is reserved for the null value) */
   uint64_t d_id : NBITS_ID;
 
+#ifdef CVC4_THREAD_SAFE_NODES
+  /** Kind of the expression */
+  uint32_t d_kind : NBITS_KIND;
+
+  /**
+   * The expression's reference count.  @see cvc4::Node.  In thread-safe
+   * builds, this is a whole word (still saturating at MAX_RC) so that it can
+   * be updated atomically; d_kind moves into the word of d_id to make room.
+   */
+  uint32_t d_rc;
+#else
   /** The expression's reference count.  @see cvc4::Node. */
   uint32_t d_rc : NBITS_REFCOUNT;
 
   /** Kind of the expression */
   uint32_t d_kind : NBITS_KIND;
+#endif /* CVC4_THREAD_SAFE_NODES */
 
   /** Number of children */
   uint32_t d_nchildren : NBITS_NCHILDREN;
@@ -405,8 +424,13 @@ namespace expr {
 
 inline NodeValue::NodeValue(int) :
   d_id(0),
+#ifdef CVC4_THREAD_SAFE_NODES
+  d_kind(kind::NULL_EXPR),
+  d_rc(MAX_RC),
+#else
   d_rc(MAX_RC),
   d_kind(kind::NULL_EXPR),
+#endif /* CVC4_THREAD_SAFE_NODES */
   d_nchildren(0) {
 }
 
@@ -420,7 +444,25 @@ inline void NodeValue::inc() {
   Assert(!isBeingDeleted())
       << "NodeValue is currently being deleted "
          "and increment is being called on it. Don't Do That!";
-  // FIXME multithreading
+#ifdef CVC4_THREAD_SAFE_NODES
+  uint32_t rc = __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+  do
+  {
+    if (__builtin_expect((rc == MAX_RC), false))
+    {
+      return;
+    }
+  } while (!__atomic_compare_exchange_n(
+      &d_rc, &rc, rc + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  if (__builtin_expect((rc == MAX_RC - 1), false))
+  {
+    Assert(NodeManager::currentNM() != NULL)
+        << "No current NodeManager on incrementing of NodeValue: "
+           "maybe a public CVC4 interface function is missing a "
+           "NodeManagerScope ?";
+    NodeManager::currentNM()->markRefCountMaxedOut(this);
+  }
+#else
   if (__builtin_expect((d_rc < MAX_RC - 1), true)) {
     ++d_rc;
   } else if (__builtin_expect((d_rc == MAX_RC - 1), false)) {
@@ -431,10 +473,36 @@ inline void NodeValue::inc() {
            "NodeManagerScope ?";
     NodeManager::currentNM()->markRefCountMaxedOut(this);
   }
+#endif /* CVC4_THREAD_SAFE_NODES */
 }
 
 inline void NodeValue::dec() {
-  // FIXME multithreading
+#ifdef CVC4_THREAD_SAFE_NODES
+  uint32_t rc = __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+  for (;;)
+  {
+    if (__builtin_expect((rc == MAX_RC), false))
+    {
+      return;
+    }
+    if (__builtin_expect((rc == 1), false))
+    {
+      // possibly the last reference: the NodeManager must turn us into a
+      // zombie atomically w.r.t. concurrent reclamation
+      Assert(NodeManager::currentNM() != NULL)
+          << "No current NodeManager on destruction of NodeValue: "
+             "maybe a public CVC4 interface function is missing a "
+             "NodeManagerScope ?";
+      NodeManager::currentNM()->releaseLastReference(this);
+      return;
+    }
+    if (__atomic_compare_exchange_n(
+            &d_rc, &rc, rc - 1, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    {
+      return;
+    }
+  }
+#else
   if(__builtin_expect( ( d_rc < MAX_RC ), true )) {
     --d_rc;
     if(__builtin_expect( ( d_rc == 0 ), false )) {
@@ -445,6 +513,7 @@ inline void NodeValue::dec() {
       NodeManager::currentNM()->markForDeletion(this);
     }
   }
+#endif /* CVC4_THREAD_SAFE_NODES */
 }
 
 inline NodeValue::nv_iterator NodeValue::nv_begin() {
@@ -0,0 +1,138 @@
+/*********************                                                        */
+/*! \file node_value_allocator.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Size-class slab allocator for NodeValues
+ **
+ ** Size-class slab allocator for NodeValues.
+ **/
+
+#include "expr/node_value_allocator.h"
+
+#include <sstream>
+
+namespace CVC4 {
+namespace expr {
+
+NodeValueAllocator::NodeValueAllocator(StatisticsRegistry* reg)
+    : d_registry(reg), d_fallbackLive(0), d_fallbackBytes(0)
+{
+  for (size_t i = 0; i <= MAX_POOLED_CHILDREN; ++i)
+  {
+    SizeClass& sc = d_classes[i];
+    sc.d_freeList = nullptr;
+    sc.d_nextFree = nullptr;
+    sc.d_endPage = nullptr;
+    sc.d_bytes = 0;
+    sc.d_live = 0;
+    sc.d_free = 0;
+
+    std::stringstream prefix;
+    prefix << "expr::NodeValueAllocator::arity" << i << "::";
+    d_stats.emplace_back(
+        new ReferenceStat<int64_t>(prefix.str() + "bytes", sc.d_bytes));
+    d_stats.emplace_back(
+        new ReferenceStat<int64_t>(prefix.str() + "live", sc.d_live));
+    d_stats.emplace_back(
+        new ReferenceStat<int64_t>(prefix.str() + "free", sc.d_free));
+  }
+  d_stats.emplace_back(new ReferenceStat<int64_t>(
+      "expr::NodeValueAllocator::fallback::bytes", d_fallbackBytes));
+  d_stats.emplace_back(new ReferenceStat<int64_t>(
+      "expr::NodeValueAllocator::fallback::live", d_fallbackLive));
+
+  if (d_registry != nullptr)
+  {
+    for (const std::unique_ptr<ReferenceStat<int64_t>>& s : d_stats)
+    {
+      d_registry->registerStat(s.get());
+    }
+  }
+}
+
+NodeValueAllocator::~NodeValueAllocator()
+{
+  if (d_registry != nullptr)
+  {
+    for (const std::unique_ptr<ReferenceStat<int64_t>>& s : d_stats)
+    {
+      d_registry->unregisterStat(s.get());
+    }
+  }
+  for (char* page : d_pages)
+  {
+    std::free(page);
+  }
+}
+
+void NodeValueAllocator::deallocateAll(
+    const std::vector<std::pair<NodeValue*, size_t>>& nvs)
+{
+  // chain the freed cells of each size class locally first
+  FreeCell* heads[MAX_POOLED_CHILDREN + 1] = {};
+  FreeCell* tails[MAX_POOLED_CHILDREN + 1] = {};
+  int64_t counts[MAX_POOLED_CHILDREN + 1] = {};
+
+  std::lock_guard<NodeMutex> guard(d_mutex);
+  for (const std::pair<NodeValue*, size_t>& p : nvs)
+  {
+    NodeValue* nv = p.first;
+    size_t nchildren = p.second;
+    if (__builtin_expect((nchildren > MAX_POOLED_CHILDREN), false))
+    {
+      --d_fallbackLive;
+      d_fallbackBytes -= sizeOf(nchildren);
+      std::free(nv);
+      continue;
+    }
+    FreeCell* cell = reinterpret_cast<FreeCell*>(nv);
+    cell->d_next = heads[nchildren];
+    heads[nchildren] = cell;
+    if (tails[nchildren] == nullptr)
+    {
+      tails[nchildren] = cell;
+    }
+    ++counts[nchildren];
+  }
+  for (size_t i = 0; i <= MAX_POOLED_CHILDREN; ++i)
+  {
+    if (heads[i] == nullptr)
+    {
+      continue;
+    }
+    SizeClass& sc = d_classes[i];
+    Assert(sc.d_live >= counts[i]);
+    tails[i]->d_next = sc.d_freeList;
+    sc.d_freeList = heads[i];
+    sc.d_live -= counts[i];
+    sc.d_free += counts[i];
+  }
+}
+
+NodeValue* NodeValueAllocator::allocateFromNewPage(size_t nchildren)
+{
+  Assert(nchildren <= MAX_POOLED_CHILDREN);
+  char* page = static_cast<char*>(std::malloc(PAGE_SIZE_BYTES));
+  if (page == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  d_pages.push_back(page);
+
+  // The tail of the previous page of this class (if any) is too small for
+  // another cell and is simply abandoned.
+  SizeClass& sc = d_classes[nchildren];
+  sc.d_bytes += PAGE_SIZE_BYTES;
+  sc.d_nextFree = page + sizeOf(nchildren);
+  sc.d_endPage = page + PAGE_SIZE_BYTES;
+  ++sc.d_live;
+  return reinterpret_cast<NodeValue*>(page);
+}
+
+}  // namespace expr
+}  // namespace CVC4
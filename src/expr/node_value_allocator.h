@@ -0,0 +1,232 @@
+/*********************                                                        */
+/*! \file node_value_allocator.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Size-class slab allocator for NodeValues
+ **
+ ** Size-class slab allocator for NodeValues.  Designed for use by
+ ** NodeManager and NodeBuilder.
+ **/
+
+#include "cvc4_private.h"
+
+// circular dependency
+#include "expr/node_value.h"
+
+#ifndef CVC4__EXPR__NODE_VALUE_ALLOCATOR_H
+#define CVC4__EXPR__NODE_VALUE_ALLOCATOR_H
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "expr/node_mutex.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace expr {
+
+/**
+ * Slab allocator for NodeValues owned by a NodeManager.
+ *
+ * A NodeValue consists of a fixed-size header followed by a variable-length
+ * array of child pointers.  For the common arities (0 up to
+ * MAX_POOLED_CHILDREN), NodeValues are carved out of large pages, with one
+ * size class per arity.  Freed NodeValues are put on an intrusive free list
+ * of their size class and are handed out again before the page is extended,
+ * so reclaiming zombies never returns memory to the system allocator.  The
+ * pages themselves are released when the allocator is destroyed.
+ *
+ * NodeValues with more children fall back to malloc() and free().
+ *
+ * The caller is responsible for passing the same number of children to
+ * deallocate() as was passed to allocate().  NodeValues that were not
+ * obtained from this allocator (e.g., the buffers grown by a NodeBuilder)
+ * must be adopt()ed before being passed to deallocate(); only those with
+ * more than MAX_POOLED_CHILDREN children can be adopted.  CONSTANT
+ * NodeValues have an inlined payload of arbitrary size and are not managed
+ * by this allocator.
+ *
+ * In thread-safe builds (CVC4_THREAD_SAFE_NODES), all operations are
+ * serialized by a mutex.
+ */
+class NodeValueAllocator
+{
+ public:
+  /** The largest number of children served from the slab pages. */
+  static constexpr size_t MAX_POOLED_CHILDREN = 8;
+
+  /** The size (in bytes) of a page from which size classes are carved. */
+  static constexpr size_t PAGE_SIZE_BYTES = 65536;
+
+  /**
+   * Construct an allocator that registers its statistics with the given
+   * registry.
+   */
+  NodeValueAllocator(StatisticsRegistry* reg);
+  ~NodeValueAllocator();
+
+  /**
+   * Allocate uninitialized storage for a NodeValue with nchildren children.
+   * @throws bad_alloc if the allocation fails
+   */
+  inline NodeValue* allocate(size_t nchildren);
+
+  /**
+   * Return the storage for a NodeValue with nchildren children (as passed to
+   * allocate()) to this allocator.
+   */
+  inline void deallocate(NodeValue* nv, size_t nchildren);
+
+  /**
+   * Return the storage for all of the given NodeValues, each with its number
+   * of children (as passed to allocate()), to this allocator, taking the lock
+   * once.  The freed cells of each size class are spliced onto its free list
+   * as one chain.
+   */
+  void deallocateAll(const std::vector<std::pair<NodeValue*, size_t>>& nvs);
+
+  /**
+   * Account for a malloc()ed NodeValue with nchildren children, more than
+   * MAX_POOLED_CHILDREN, so that it may later be passed to deallocate().
+   */
+  inline void adopt(size_t nchildren);
+
+  /** The number of bytes needed for a NodeValue with nchildren children. */
+  static constexpr size_t sizeOf(size_t nchildren)
+  {
+    return sizeof(NodeValue) + sizeof(NodeValue*) * nchildren;
+  }
+
+ private:
+  NodeValueAllocator(const NodeValueAllocator&) = delete;
+  NodeValueAllocator& operator=(const NodeValueAllocator&) = delete;
+
+  /** A free cell, overlaid on the storage of a freed NodeValue. */
+  struct FreeCell
+  {
+    FreeCell* d_next;
+  };
+
+  /** The state of one size class. */
+  struct SizeClass
+  {
+    /** Head of the free list of this class */
+    FreeCell* d_freeList;
+    /** Next never-used cell in the current page of this class */
+    char* d_nextFree;
+    /** One past the last byte of the current page of this class */
+    char* d_endPage;
+
+    /** Number of bytes of pages reserved by this class */
+    int64_t d_bytes;
+    /** Number of NodeValues of this class currently handed out */
+    int64_t d_live;
+    /** Number of NodeValues of this class on the free list */
+    int64_t d_free;
+  };
+
+  /**
+   * Give the size class for nchildren children a new page and return a
+   * cell from it.
+   */
+  NodeValue* allocateFromNewPage(size_t nchildren);
+
+  /** The registry our statistics are registered with */
+  StatisticsRegistry* d_registry;
+
+  /** The size classes, indexed by number of children */
+  SizeClass d_classes[MAX_POOLED_CHILDREN + 1];
+
+  /** All pages reserved by this allocator */
+  std::vector<char*> d_pages;
+
+  /** Number of NodeValues currently allocated by the malloc() fallback */
+  int64_t d_fallbackLive;
+  /** Number of bytes currently allocated by the malloc() fallback */
+  int64_t d_fallbackBytes;
+
+  /** Statistics referring to the counters above */
+  std::vector<std::unique_ptr<ReferenceStat<int64_t>>> d_stats;
+
+  /** Guards all of the above in thread-safe builds */
+  NodeMutex d_mutex;
+}; /* class NodeValueAllocator */
+
+inline NodeValue* NodeValueAllocator::allocate(size_t nchildren)
+{
+  std::lock_guard<NodeMutex> guard(d_mutex);
+  if (__builtin_expect((nchildren > MAX_POOLED_CHILDREN), false))
+  {
+    const size_t bytes = sizeOf(nchildren);
+    NodeValue* nv = static_cast<NodeValue*>(std::malloc(bytes));
+    if (nv == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    ++d_fallbackLive;
+    d_fallbackBytes += bytes;
+    return nv;
+  }
+
+  SizeClass& sc = d_classes[nchildren];
+  if (sc.d_freeList != nullptr)
+  {
+    FreeCell* cell = sc.d_freeList;
+    sc.d_freeList = cell->d_next;
+    --sc.d_free;
+    ++sc.d_live;
+    return reinterpret_cast<NodeValue*>(cell);
+  }
+  if (static_cast<size_t>(sc.d_endPage - sc.d_nextFree) >= sizeOf(nchildren))
+  {
+    NodeValue* nv = reinterpret_cast<NodeValue*>(sc.d_nextFree);
+    sc.d_nextFree += sizeOf(nchildren);
+    ++sc.d_live;
+    return nv;
+  }
+  return allocateFromNewPage(nchildren);
+}
+
+inline void NodeValueAllocator::deallocate(NodeValue* nv, size_t nchildren)
+{
+  std::lock_guard<NodeMutex> guard(d_mutex);
+  if (__builtin_expect((nchildren > MAX_POOLED_CHILDREN), false))
+  {
+    --d_fallbackLive;
+    d_fallbackBytes -= sizeOf(nchildren);
+    std::free(nv);
+    return;
+  }
+
+  SizeClass& sc = d_classes[nchildren];
+  Assert(sc.d_live > 0);
+  FreeCell* cell = reinterpret_cast<FreeCell*>(nv);
+  cell->d_next = sc.d_freeList;
+  sc.d_freeList = cell;
+  --sc.d_live;
+  ++sc.d_free;
+}
+
+inline void NodeValueAllocator::adopt(size_t nchildren)
+{
+  Assert(nchildren > MAX_POOLED_CHILDREN);
+  std::lock_guard<NodeMutex> guard(d_mutex);
+  ++d_fallbackLive;
+  d_fallbackBytes += sizeOf(nchildren);
+}
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_VALUE_ALLOCATOR_H */
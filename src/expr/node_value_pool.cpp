@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file node_value_pool.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Open-addressing hash-consing table for NodeValues
+ **
+ ** Open-addressing hash-consing table for NodeValues.
+ **/
+
+#include "expr/node_value_pool.h"
+
+namespace CVC4 {
+namespace expr {
+
+namespace {
+
+/** The number of elements a table with the given number of slots may hold */
+size_t maxSizeFor(size_t capacity) { return capacity / 5 * 4; }
+
+}  // namespace
+
+NodeValuePool::NodeValuePool(const std::string& name)
+    : d_bits(0),
+      d_mask(0),
+      d_size(0),
+      d_maxSize(0),
+      d_lookups(0),
+      d_probeLengths(name + "::probeLength"),
+      d_rehashes(name + "::rehashes", 0),
+      d_capacity(name + "::capacity", 0)
+{
+  rehash(MIN_BITS);
+}
+
+void NodeValuePool::reserve(size_t n)
+{
+  uint32_t bits = d_bits;
+  while (maxSizeFor(size_t(1) << bits) < n)
+  {
+    ++bits;
+  }
+  if (bits > d_bits)
+  {
+    rehash(bits);
+  }
+}
+
+void NodeValuePool::rehash(uint32_t bits)
+{
+  AlwaysAssert(bits < 32) << "NodeValuePool cannot grow any further";
+  std::vector<Slot> old(size_t(1) << bits, Slot{nullptr, 0, 0});
+  d_slots.swap(old);
+  d_bits = bits;
+  d_mask = d_slots.size() - 1;
+  d_maxSize = maxSizeFor(d_slots.size());
+  for (const Slot& s : old)
+  {
+    if (s.d_dist != 0)
+    {
+      insertInternal(s.d_nv, s.d_hash);
+    }
+  }
+  if (!old.empty())
+  {
+    ++d_rehashes;
+  }
+  d_capacity.setData(d_slots.size());
+}
+
+void NodeValuePool::registerStatistics(StatisticsRegistry* reg)
+{
+  reg->registerStat(&d_probeLengths);
+  reg->registerStat(&d_rehashes);
+  reg->registerStat(&d_capacity);
+}
+
+void NodeValuePool::unregisterStatistics(StatisticsRegistry* reg)
+{
+  reg->unregisterStat(&d_probeLengths);
+  reg->unregisterStat(&d_rehashes);
+  reg->unregisterStat(&d_capacity);
+}
+
+}  // namespace expr
+}  // namespace CVC4
@@ -0,0 +1,297 @@
+/*********************                                                        */
+/*! \file node_value_pool.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Open-addressing hash-consing table for NodeValues
+ **
+ ** Open-addressing hash-consing table for NodeValues.  Designed for use by
+ ** NodeManager.
+ **/
+
+#include "cvc4_private.h"
+
+// circular dependency
+#include "expr/node_value.h"
+
+#ifndef CVC4__EXPR__NODE_VALUE_POOL_H
+#define CVC4__EXPR__NODE_VALUE_POOL_H
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/check.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace expr {
+
+/**
+ * The set of hash-consed NodeValues of a NodeManager.
+ *
+ * This is an open-addressing hash table with Robin Hood linear probing and
+ * backward-shift deletion.  Each slot stores the NodeValue pointer next to
+ * (32 bits of) its hash and its distance from its home slot, so that most
+ * mismatches during a lookup are decided without touching the NodeValue
+ * itself, and a lookup for a NodeValue that is not in the table stops as
+ * soon as it meets a slot that is closer to its home than the probe.
+ *
+ * Lookups compare NodeValues structurally (see NodeValuePoolEq), and may be
+ * given a NodeValue that is not fully constructed (see
+ * NodeManager::poolLookup()).  Removal compares pointers.
+ */
+class NodeValuePool
+{
+  /** A slot of the table. */
+  struct Slot
+  {
+    /** The NodeValue in this slot, or nullptr if the slot is empty */
+    NodeValue* d_nv;
+    /** The hash of d_nv, see hashOf() */
+    uint32_t d_hash;
+    /** One plus the distance from the home slot of d_nv, 0 if empty */
+    uint32_t d_dist;
+  };
+
+ public:
+  /** Iterator over the NodeValues in the table, in unspecified order. */
+  class const_iterator
+  {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = NodeValue*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = NodeValue* const*;
+    using reference = NodeValue* const&;
+
+    const_iterator(const Slot* slot, const Slot* end) : d_slot(slot), d_end(end)
+    {
+      skipEmpty();
+    }
+    reference operator*() const { return d_slot->d_nv; }
+    const_iterator& operator++()
+    {
+      ++d_slot;
+      skipEmpty();
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const
+    {
+      return d_slot == other.d_slot;
+    }
+    bool operator!=(const const_iterator& other) const
+    {
+      return d_slot != other.d_slot;
+    }
+
+   private:
+    void skipEmpty()
+    {
+      while (d_slot != d_end && d_slot->d_dist == 0)
+      {
+        ++d_slot;
+      }
+    }
+    const Slot* d_slot;
+    const Slot* d_end;
+  }; /* class NodeValuePool::const_iterator */
+
+  /**
+   * Create an empty table.  The names of its statistics are prefixed with
+   * name, so that several tables can be registered with the same registry.
+   */
+  NodeValuePool(const std::string& name = "expr::NodeValuePool");
+
+  /**
+   * Look up a NodeValue that is structurally equal to nv.  Returns nullptr
+   * if there is none.
+   */
+  inline NodeValue* find(const NodeValue* nv) const;
+
+  /**
+   * Insert nv.  It is an error to insert a NodeValue that is structurally
+   * equal to one already in the table.
+   */
+  inline void insert(NodeValue* nv);
+
+  /** Remove nv, which must be in the table. */
+  inline void erase(NodeValue* nv);
+
+  /** The number of NodeValues in the table */
+  size_t size() const { return d_size; }
+
+  /**
+   * Make room for n NodeValues, so that the table is not grown until it
+   * holds more than n NodeValues.
+   */
+  void reserve(size_t n);
+
+  const_iterator begin() const
+  {
+    return const_iterator(d_slots.data(), d_slots.data() + d_slots.size());
+  }
+  const_iterator end() const
+  {
+    return const_iterator(d_slots.data() + d_slots.size(),
+                          d_slots.data() + d_slots.size());
+  }
+
+  /** Register the statistics of this table with the given registry */
+  void registerStatistics(StatisticsRegistry* reg);
+  /** Unregister the statistics of this table from the given registry */
+  void unregisterStatistics(StatisticsRegistry* reg);
+
+ private:
+  /** The number of slots of a new table */
+  static constexpr uint32_t MIN_BITS = 10;
+
+  /**
+   * The hash of nv used in this table.  The pool hash of a NodeValue is
+   * scrambled (by Fibonacci hashing), since constants and small terms often
+   * have hashes that differ only in a few low bits.
+   */
+  static uint32_t hashOf(const NodeValue* nv)
+  {
+    return static_cast<uint32_t>(
+        (static_cast<uint64_t>(nv->poolHash()) * 0x9e3779b97f4a7c15ull)
+        >> 32);
+  }
+
+  /** The home slot of a NodeValue with hash h */
+  size_t homeOf(uint32_t h) const { return h >> (32 - d_bits); }
+
+  /**
+   * The lookups of which the probe length is recorded are one in
+   * PROBE_SAMPLE_MASK + 1, since the histogram is too costly to update on
+   * every lookup.
+   */
+  static constexpr uint32_t PROBE_SAMPLE_MASK = 63;
+
+  /** Record dist in d_probeLengths if this lookup is sampled. */
+  void sampleProbeLength(uint32_t dist) const
+  {
+#ifdef CVC4_STATISTICS_ON
+    if (__builtin_expect(((++d_lookups & PROBE_SAMPLE_MASK) == 0), false))
+    {
+      d_probeLengths << dist;
+    }
+#endif /* CVC4_STATISTICS_ON */
+  }
+
+  /** Insert nv with hash h, which must not be in the table. */
+  inline void insertInternal(NodeValue* nv, uint32_t h);
+
+  /** Rehash into a table with 2^bits slots */
+  void rehash(uint32_t bits);
+
+  /** The slots, 2^d_bits many */
+  std::vector<Slot> d_slots;
+  /** log2 of the number of slots */
+  uint32_t d_bits;
+  /** d_slots.size() - 1 */
+  size_t d_mask;
+  /** The number of NodeValues in the table */
+  size_t d_size;
+  /** The number of NodeValues beyond which the table is grown */
+  size_t d_maxSize;
+
+  /** The number of lookups, for sampling the probe lengths */
+  mutable uint32_t d_lookups;
+  /** Number of slots inspected by a sample of the lookups */
+  mutable IntegralHistogramStat<uint32_t> d_probeLengths;
+  /** Number of times the table was grown */
+  IntStat d_rehashes;
+  /** Current number of slots */
+  BackedStat<uint64_t> d_capacity;
+}; /* class NodeValuePool */
+
+inline NodeValue* NodeValuePool::find(const NodeValue* nv) const
+{
+  const uint32_t h = hashOf(nv);
+  size_t i = homeOf(h);
+  NodeValuePoolEq eq;
+  for (uint32_t dist = 1;; ++dist)
+  {
+    const Slot& s = d_slots[i];
+    // since the table is kept in Robin Hood order, nv would have displaced
+    // a slot that is closer to its home than we are
+    if (s.d_dist < dist)
+    {
+      sampleProbeLength(dist);
+      return nullptr;
+    }
+    if (s.d_hash == h && eq(s.d_nv, nv))
+    {
+      sampleProbeLength(dist);
+      return s.d_nv;
+    }
+    i = (i + 1) & d_mask;
+  }
+}
+
+inline void NodeValuePool::insert(NodeValue* nv)
+{
+  Assert(find(nv) == nullptr);
+  if (__builtin_expect((d_size >= d_maxSize), false))
+  {
+    rehash(d_bits + 1);
+  }
+  insertInternal(nv, hashOf(nv));
+  ++d_size;
+}
+
+inline void NodeValuePool::insertInternal(NodeValue* nv, uint32_t h)
+{
+  Slot carry = {nv, h, 1};
+  size_t i = homeOf(h);
+  for (;;)
+  {
+    Slot& s = d_slots[i];
+    if (s.d_dist == 0)
+    {
+      s = carry;
+      return;
+    }
+    if (s.d_dist < carry.d_dist)
+    {
+      std::swap(s, carry);
+    }
+    i = (i + 1) & d_mask;
+    ++carry.d_dist;
+  }
+}
+
+inline void NodeValuePool::erase(NodeValue* nv)
+{
+  const uint32_t h = hashOf(nv);
+  size_t i = homeOf(h);
+  while (d_slots[i].d_nv != nv)
+  {
+    Assert(d_slots[i].d_dist != 0) << "NodeValue not in the pool";
+    i = (i + 1) & d_mask;
+  }
+  // shift the following slots of the same cluster back by one
+  size_t next = (i + 1) & d_mask;
+  while (d_slots[next].d_dist > 1)
+  {
+    d_slots[i] = d_slots[next];
+    --d_slots[i].d_dist;
+    i = next;
+    next = (next + 1) & d_mask;
+  }
+  d_slots[i].d_nv = nullptr;
+  d_slots[i].d_hash = 0;
+  d_slots[i].d_dist = 0;
+  --d_size;
+}
+
+}  // namespace expr
+}  // namespace CVC4
+
+#endif /* CVC4__EXPR__NODE_VALUE_POOL_H */
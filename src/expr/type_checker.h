@@ -31,6 +31,9 @@ public:
                              TNode n,
                              bool check = false);
 
+ /** Whether computeType() handles the nodes of kind k */
+ static bool hasTypeRule(Kind k);
+
  static bool computeIsConst(NodeManager* nodeManager, TNode n);
 
 };/* class TypeChecker */
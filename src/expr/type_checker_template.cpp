@@ -55,6 +55,20 @@ ${typerules}
 
 }/* TypeChecker::computeType */
 
+bool TypeChecker::hasTypeRule(Kind k)
+{
+  switch (k)
+  {
+  case kind::VARIABLE:
+  case kind::SKOLEM:
+  case kind::BUILTIN:
+${typerule_kinds}
+    return true;
+
+  default: return false;
+  }
+}/* TypeChecker::hasTypeRule */
+
 bool TypeChecker::computeIsConst(NodeManager* nodeManager, TNode n)
 {
   Assert(n.getMetaKind() == kind::metakind::OPERATOR
@@ -30,6 +30,7 @@
 #include "main/command_executor.h"
 #include "main/interactive_shell.h"
 #include "main/main.h"
+#include "main/portfolio.h"
 #include "main/signal_handlers.h"
 #include "main/time_limit.h"
 #include "options/options.h"
@@ -98,8 +99,6 @@ int runCvc4(int argc, char* argv[], Options& opts) {
   // Parse the options
   vector<string> filenames = Options::parseOptions(&opts, argc, argv);
 
-  auto limit = install_time_limit(opts);
-
   string progNameStr = opts.getBinaryName();
   progName = &progNameStr;
 
@@ -129,6 +128,26 @@ int runCvc4(int argc, char* argv[], Options& opts) {
   // If no file supplied we will read from standard input
   const bool inputFromStdin = filenames.empty() || filenames[0] == "-";
 
+  // In portfolio mode, the rest is done by the workers, each with its own
+  // time limit
+  if (opts.getPortfolioJobs() > 1)
+  {
+    if (inputFromStdin)
+    {
+      throw OptionException("--portfolio needs an input file");
+    }
+    int returnValue = 0;
+    if (!portfolio::start(opts, opts.getPortfolioJobs(), returnValue))
+    {
+      delete pTotalTime;
+      pTotalTime = nullptr;
+      signal_handlers::cleanup();
+      return returnValue;
+    }
+  }
+
+  auto limit = install_time_limit(opts);
+
   // if we're reading from stdin on a TTY, default to interactive mode
   if(!opts.wasSetByUserInteractive()) {
     opts.setInteractive(inputFromStdin && isatty(fileno(stdin)));
@@ -195,6 +214,16 @@ int runCvc4(int argc, char* argv[], Options& opts) {
     ReferenceStat<std::string> s_statFilename("filename", filenameStr);
     RegisterStatistic statFilenameReg(&pExecutor->getStatisticsRegistry(),
                                       &s_statFilename);
+
+    // Portfolio configuration statistics
+    ReferenceStat<std::string> s_statPortfolio("driver::portfolioConfiguration",
+                                               portfolio::getConfiguration());
+    std::unique_ptr<RegisterStatistic> statPortfolioReg;
+    if (portfolio::isWorker())
+    {
+      statPortfolioReg.reset(new RegisterStatistic(
+          &pExecutor->getStatisticsRegistry(), &s_statPortfolio));
+    }
     // notify SmtEngine that we are starting to parse
     pExecutor->getSmtEngine()->notifyStartParsing(filenameStr);
 
@@ -464,6 +493,11 @@ int runCvc4(int argc, char* argv[], Options& opts) {
       // there was some kind of error
       returnValue = 1;
     }
+    if (portfolio::isWorker())
+    {
+      // tell the parent whether to stop the other workers
+      returnValue = portfolio::exitCode(result, returnValue);
+    }
 
 #ifdef CVC4_COMPETITION_MODE
     opts.flushOut();
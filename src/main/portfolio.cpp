@@ -0,0 +1,352 @@
+/*********************                                                        */
+/*! \file portfolio.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Portfolio solving with differently configured processes.
+ **
+ ** The workers are processes rather than threads: the options, the node
+ ** manager and the statistics are per thread at best, and a process is
+ ** cancelled simply by killing it, without waiting for it to check its
+ ** resource manager.
+ **/
+
+#include "main/portfolio.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifndef __WIN32__
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif /* ! __WIN32__ */
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif /* __linux__ */
+
+#include "base/exception.h"
+#include "base/output.h"
+#include "options/option_exception.h"
+
+namespace CVC4 {
+namespace main {
+namespace portfolio {
+
+namespace {
+
+/** The exit code of a worker with a definitive result */
+const int DEFINITIVE_EXIT_CODE = 10;
+
+/** An option setting, by the name of its command-line option */
+typedef std::pair<const char*, const char*> Setting;
+
+/**
+ * The configurations of the workers, which should be complementary on the
+ * common logics.  Worker i uses the configuration i modulo their number, and
+ * workers other than the first one also use i as their random seeds.
+ */
+const std::vector<std::vector<Setting>> s_configurations = {
+    // the default configuration
+    {},
+    // decisions by the justification heuristic
+    {{"decision", "justification"}},
+    // random decisions, more frequent restarts
+    {{"random-freq", "0.02"}, {"restart-int-base", "10"}},
+    // simplex with the sum of infeasibilities and another pivot rule
+    {{"use-soi", "true"}, {"error-selection-rule", "sum"}},
+    // arithmetic propagation by bounds inference only
+    {{"arith-prop", "bi"}, {"simplex-check-period", "50"}},
+    // enumerative instantiation when E-matching saturates
+    {{"full-saturate-quant", "true"}},
+    // no E-matching, model-based instantiation only
+    {{"e-matching", "false"}, {"mbqi", "fmc"}},
+    // justification only to stop early, enumerative instantiation
+    {{"decision", "justification-stoponly"}, {"full-saturate-quant", "true"}},
+};
+
+/** Whether this process is a worker */
+bool s_isWorker = false;
+
+/** The description of the configuration of this worker */
+std::string s_configuration;
+
+#ifndef __WIN32__
+
+/** A worker, as seen from the parent */
+struct Worker
+{
+  /** The process */
+  pid_t d_pid;
+  /** The read ends of the pipes of its standard output and error */
+  int d_out;
+  int d_err;
+  /** Its standard output and error so far */
+  std::string d_outBuf;
+  std::string d_errBuf;
+  /** Whether it has exited, and its status */
+  bool d_exited;
+  int d_status;
+};
+
+/** Get the description of configuration i. */
+std::string describe(unsigned i)
+{
+  std::stringstream ss;
+  ss << i << ":";
+  if (i > 0)
+  {
+    ss << " seed=" << i;
+  }
+  for (const Setting& s : s_configurations[i % s_configurations.size()])
+  {
+    ss << " " << s.first << "=" << s.second;
+  }
+  return ss.str();
+}
+
+/** Apply configuration i to opts. */
+void configure(Options& opts, unsigned i)
+{
+  if (i > 0)
+  {
+    std::string seed = std::to_string(i);
+    opts.setOption("seed", seed);
+    opts.setOption("random-seed", seed);
+  }
+  for (const Setting& s : s_configurations[i % s_configurations.size()])
+  {
+    opts.setOption(s.first, s.second);
+  }
+}
+
+/** Write all of buf to fd. */
+void writeAll(int fd, const std::string& buf)
+{
+  size_t written = 0;
+  while (written < buf.size())
+  {
+    ssize_t w = write(fd, buf.data() + written, buf.size() - written);
+    if (w < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (w <= 0)
+    {
+      return;
+    }
+    written += w;
+  }
+}
+
+/**
+ * Read what is available from the pipe *fd into buf, closing the pipe and
+ * setting *fd to -1 at its end.
+ */
+void readPipe(int* fd, std::string& buf)
+{
+  char chunk[4096];
+  ssize_t r = read(*fd, chunk, sizeof(chunk));
+  if (r < 0 && errno == EINTR)
+  {
+    return;
+  }
+  if (r <= 0)
+  {
+    close(*fd);
+    *fd = -1;
+    return;
+  }
+  buf.append(chunk, r);
+}
+
+#endif /* ! __WIN32__ */
+
+}  // namespace
+
+bool start(Options& opts, unsigned n, int& returnValue)
+{
+#ifdef __WIN32__
+  throw OptionException("--portfolio is not supported on Windows");
+#else  /* __WIN32__ */
+  // don't let the workers inherit buffered output
+  opts.flushOut();
+  opts.flushErr();
+
+  std::vector<Worker> workers(n);
+  for (unsigned i = 0; i < n; ++i)
+  {
+    int out[2], err[2];
+    if (pipe(out) != 0 || pipe(err) != 0)
+    {
+      throw Exception(std::string("pipe() failure: ") + strerror(errno));
+    }
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      throw Exception(std::string("fork() failure: ") + strerror(errno));
+    }
+    if (pid == 0)
+    {
+#ifdef __linux__
+      // don't outlive the parent, e.g. when it runs out of time
+      prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif /* __linux__ */
+      for (unsigned j = 0; j < i; ++j)
+      {
+        close(workers[j].d_out);
+        close(workers[j].d_err);
+      }
+      close(out[0]);
+      close(err[0]);
+      dup2(out[1], STDOUT_FILENO);
+      dup2(err[1], STDERR_FILENO);
+      close(out[1]);
+      close(err[1]);
+      s_isWorker = true;
+      s_configuration = describe(i);
+      configure(opts, i);
+      return true;
+    }
+    close(out[1]);
+    close(err[1]);
+    Worker& w = workers[i];
+    w.d_pid = pid;
+    w.d_out = out[0];
+    w.d_err = err[0];
+    w.d_exited = false;
+    w.d_status = 0;
+  }
+
+  // collect the output of the workers until one has a definitive result, or
+  // all of them have exited
+  Worker* winner = nullptr;
+  size_t running = n;
+  while (winner == nullptr && running > 0)
+  {
+    std::vector<pollfd> fds;
+    std::vector<std::pair<Worker*, bool>> owners;
+    for (Worker& w : workers)
+    {
+      if (w.d_out >= 0)
+      {
+        fds.push_back({w.d_out, POLLIN, 0});
+        owners.emplace_back(&w, true);
+      }
+      if (w.d_err >= 0)
+      {
+        fds.push_back({w.d_err, POLLIN, 0});
+        owners.emplace_back(&w, false);
+      }
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      throw Exception(std::string("poll() failure: ") + strerror(errno));
+    }
+    for (size_t i = 0; i < fds.size(); ++i)
+    {
+      if (fds[i].revents == 0)
+      {
+        continue;
+      }
+      Worker* w = owners[i].first;
+      if (owners[i].second)
+      {
+        readPipe(&w->d_out, w->d_outBuf);
+      }
+      else
+      {
+        readPipe(&w->d_err, w->d_errBuf);
+      }
+      if (w->d_out < 0 && w->d_err < 0 && !w->d_exited)
+      {
+        // the worker is exiting
+        while (waitpid(w->d_pid, &w->d_status, 0) < 0 && errno == EINTR)
+        {
+        }
+        w->d_exited = true;
+        --running;
+        if (winner == nullptr && WIFEXITED(w->d_status)
+            && WEXITSTATUS(w->d_status) == DEFINITIVE_EXIT_CODE)
+        {
+          winner = w;
+        }
+      }
+    }
+  }
+
+  // cancel the other workers
+  for (Worker& w : workers)
+  {
+    if (!w.d_exited)
+    {
+      kill(w.d_pid, SIGKILL);
+      while (waitpid(w.d_pid, &w.d_status, 0) < 0 && errno == EINTR)
+      {
+      }
+      w.d_exited = true;
+    }
+    if (w.d_out >= 0)
+    {
+      close(w.d_out);
+    }
+    if (w.d_err >= 0)
+    {
+      close(w.d_err);
+    }
+  }
+
+  Worker* reported = winner == nullptr ? &workers[0] : winner;
+  writeAll(STDOUT_FILENO, reported->d_outBuf);
+  writeAll(STDERR_FILENO, reported->d_errBuf);
+  if (winner != nullptr)
+  {
+    Notice() << "portfolio: configuration "
+             << describe(winner - workers.data()) << " won"
+             << std::endl;
+    returnValue = 0;
+  }
+  else
+  {
+    Notice() << "portfolio: no configuration had a definitive result"
+             << std::endl;
+    returnValue = WIFEXITED(reported->d_status)
+                      ? WEXITSTATUS(reported->d_status)
+                      : 1;
+  }
+  return false;
+#endif /* __WIN32__ */
+}
+
+bool isWorker() { return s_isWorker; }
+
+const std::string& getConfiguration() { return s_configuration; }
+
+int exitCode(const api::Result& result, int returnValue)
+{
+  if (returnValue == 0
+      && (result.isSat() || result.isUnsat() || result.isEntailed()
+          || result.isNotEntailed()))
+  {
+    return DEFINITIVE_EXIT_CODE;
+  }
+  return returnValue;
+}
+
+}  // namespace portfolio
+}  // namespace main
+}  // namespace CVC4
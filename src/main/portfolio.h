@@ -0,0 +1,59 @@
+/*********************                                                        */
+/*! \file portfolio.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Portfolio solving with differently configured processes.
+ **
+ ** Implementation of the --portfolio option: the driver forks workers, each
+ ** solving the input with a different configuration, and reports the output
+ ** of the first one with a definitive result.
+ **/
+
+#ifndef CVC4__MAIN__PORTFOLIO_H
+#define CVC4__MAIN__PORTFOLIO_H
+
+#include <string>
+
+#include "api/cvc4cpp.h"
+#include "options/options.h"
+
+namespace CVC4 {
+namespace main {
+namespace portfolio {
+
+/**
+ * Forks n workers.  In each worker, applies the configuration of the worker
+ * to opts, redirects the standard output and error to the parent and
+ * returns true: the worker then solves the input like the driver would
+ * without --portfolio.
+ *
+ * In the parent, waits for the first worker to exit with a definitive result
+ * (see exitCode()), kills the other ones, prints the output of the winner and
+ * returns false, setting returnValue to the value the driver is to return.
+ * If no worker has a definitive result, the output of the worker with the
+ * default configuration is printed.
+ */
+bool start(Options& opts, unsigned n, int& returnValue);
+
+/** Return true if this process is a worker of a portfolio. */
+bool isWorker();
+
+/** Get the description of the configuration of this worker. */
+const std::string& getConfiguration();
+
+/**
+ * Get the exit code of a worker whose last result is result, given the
+ * value the driver returns otherwise.
+ */
+int exitCode(const api::Result& result, int returnValue);
+
+}  // namespace portfolio
+}  // namespace main
+}  // namespace CVC4
+
+#endif /* CVC4__MAIN__PORTFOLIO_H */
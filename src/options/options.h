@@ -164,6 +164,7 @@ public:
   bool getLanguageHelp() const;
   bool getMemoryMap() const;
   bool getParseOnly() const;
+  unsigned getPortfolioJobs() const;
   bool getProduceModels() const;
   bool getSegvSpin() const;
   bool getSemanticChecks() const;
@@ -28,6 +28,7 @@
 #include "base/exception.h"
 #include "base/modal_exception.h"
 #include "base/output.h"
+#include "context/context_mm.h"
 #include "lib/strtok_r.h"
 #include "options/base_options.h"
 #include "options/bv_options.h"
@@ -311,6 +312,18 @@ void OptionsHandler::setDefaultDagThreshPredicate(std::string option, int dag) {
   }
 }
 
+// smt/options_handlers.h
+void OptionsHandler::checkContextChunkSize(std::string option, uint64_t size)
+{
+  if (size < context::ContextMemoryManager::defaultChunkSizeBytes)
+  {
+    std::stringstream ss;
+    ss << "option `" << option << "' requires at least "
+       << context::ContextMemoryManager::defaultChunkSizeBytes << " bytes";
+    throw OptionException(ss.str());
+  }
+}
+
 // main/options_handlers.h
 
 static void print_config (const char * str, std::string config) {
@@ -371,6 +384,8 @@ void OptionsHandler::showConfiguration(std::string option) {
   print_config_cond("ubsan", Configuration::isUbsanBuild());
   print_config_cond("tsan", Configuration::isTsanBuild());
   print_config_cond("competition", Configuration::isCompetitionBuild());
+  print_config_cond("thread-safe-nodes",
+                    Configuration::isThreadSafeNodesBuild());
   
   std::cout << std::endl;
   
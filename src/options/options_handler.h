@@ -97,6 +97,9 @@ public:
   void setDefaultExprDepthPredicate(std::string option, int depth);
   void setDefaultDagThreshPredicate(std::string option, int dag);
 
+  /* smt/options_handlers.h */
+  void checkContextChunkSize(std::string option, uint64_t size);
+
   /* main/options_handlers.h */
   void copyright(std::string option);
   void showConfiguration(std::string option);
@@ -112,6 +112,10 @@ bool Options::getParseOnly() const{
   return (*this)[options::parseOnly];
 }
 
+unsigned Options::getPortfolioJobs() const{
+  return (*this)[options::portfolioJobs];
+}
+
 bool Options::getProduceModels() const{
   return (*this)[options::produceModels];
 }
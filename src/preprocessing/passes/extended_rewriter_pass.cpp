@@ -28,16 +28,12 @@ namespace passes {
 ExtRewPre::ExtRewPre(PreprocessingPassContext* preprocContext)
     : PreprocessingPass(preprocContext, "ext-rew-pre"){};
 
-PreprocessingPassResult ExtRewPre::applyInternal(
-    AssertionPipeline* assertionsToPreprocess)
+Node ExtRewPre::applyToAssertion(TNode assertion)
 {
+  // the results of the extended rewriter are cached in attributes, so an
+  // instance per assertion shares them
   theory::quantifiers::ExtendedRewriter extr(options::extRewPrepAgg());
-  for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
-  {
-    assertionsToPreprocess->replace(
-        i, extr.extendedRewrite((*assertionsToPreprocess)[i]));
-  }
-  return PreprocessingPassResult::NO_CONFLICT;
+  return extr.extendedRewrite(assertion);
 }
 
 
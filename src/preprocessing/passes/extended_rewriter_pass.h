@@ -30,9 +30,10 @@ class ExtRewPre : public PreprocessingPass
  public:
   ExtRewPre(PreprocessingPassContext* preprocContext);
 
+  bool isPerAssertion() const override { return true; }
+
  protected:
-  PreprocessingPassResult applyInternal(
-      AssertionPipeline* assertionsToPreprocess) override;
+  Node applyToAssertion(TNode assertion) override;
 };
 
 }  // namespace passes
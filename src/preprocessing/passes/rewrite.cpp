@@ -30,14 +30,9 @@ Rewrite::Rewrite(PreprocessingPassContext* preprocContext)
     : PreprocessingPass(preprocContext, "rewrite"){};
 
 
-PreprocessingPassResult Rewrite::applyInternal(
-  AssertionPipeline* assertionsToPreprocess)
+Node Rewrite::applyToAssertion(TNode assertion)
 {
-  for (unsigned i = 0; i < assertionsToPreprocess->size(); ++i) {
-    assertionsToPreprocess->replace(i, Rewriter::rewrite((*assertionsToPreprocess)[i]));
-  }
-
-  return PreprocessingPassResult::NO_CONFLICT;
+  return Rewriter::rewrite(assertion);
 }
 
 
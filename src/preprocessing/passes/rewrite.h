@@ -30,9 +30,10 @@ class Rewrite : public PreprocessingPass
  public:
   Rewrite(PreprocessingPassContext* preprocContext);
 
+  bool isPerAssertion() const override { return true; }
+
  protected:
-  PreprocessingPassResult applyInternal(
-      AssertionPipeline* assertionsToPreprocess) override;
+  Node applyToAssertion(TNode assertion) override;
 };
 
 }  // namespace passes
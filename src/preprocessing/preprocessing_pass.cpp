@@ -16,29 +16,134 @@
 
 #include "preprocessing/preprocessing_pass.h"
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+#include "options/smt_options.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "preprocessing/preprocessing_pass_context.h"
 #include "printer/printer.h"
 #include "smt/dump.h"
 #include "smt/output_manager.h"
+#include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
 #include "smt/smt_statistics_registry.h"
 
 namespace CVC4 {
 namespace preprocessing {
 
+namespace {
+/**
+ * The minimal number of assertions per worker thread, below which starting a
+ * thread costs more than it saves.
+ */
+const size_t s_minAssertionsPerThread = 64;
+}  // namespace
+
 PreprocessingPassResult PreprocessingPass::apply(
     AssertionPipeline* assertionsToPreprocess) {
-  TimerStat::CodeTimer codeTimer(d_timer);
-  Trace("preprocessing") << "PRE " << d_name << std::endl;
-  Chat() << d_name << "..." << std::endl;
-  dumpAssertions(("pre-" + d_name).c_str(), *assertionsToPreprocess);
-  PreprocessingPassResult result = applyInternal(assertionsToPreprocess);
-  dumpAssertions(("post-" + d_name).c_str(), *assertionsToPreprocess);
-  Trace("preprocessing") << "POST " << d_name << std::endl;
+  // measuring the assertions for the profiler is not part of the time of the
+  // pass
+  PreprocessingProfiler* profiler = d_preprocContext->getProfiler();
+  if (profiler != nullptr)
+  {
+    profiler->beginPass(d_name, *assertionsToPreprocess);
+  }
+  PreprocessingPassResult result;
+  {
+    TimerStat::CodeTimer codeTimer(d_timer);
+    Trace("preprocessing") << "PRE " << d_name << std::endl;
+    Chat() << d_name << "..." << std::endl;
+    dumpAssertions(("pre-" + d_name).c_str(), *assertionsToPreprocess);
+    result = applyInternal(assertionsToPreprocess);
+    dumpAssertions(("post-" + d_name).c_str(), *assertionsToPreprocess);
+    Trace("preprocessing") << "POST " << d_name << std::endl;
+  }
+  if (profiler != nullptr)
+  {
+    profiler->endPass(*assertionsToPreprocess);
+  }
   return result;
 }
 
+PreprocessingPassResult PreprocessingPass::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  Assert(isPerAssertion()) << "pass " << d_name << " has no applyInternal";
+  size_t size = assertionsToPreprocess->size();
+  size_t numThreads = std::min<size_t>(options::ppThreads(),
+                                       size / s_minAssertionsPerThread);
+  if (numThreads <= 1)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      assertionsToPreprocess->replace(
+          i, applyToAssertion((*assertionsToPreprocess)[i]));
+    }
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+
+  Trace("preprocessing") << d_name << " on " << numThreads << " threads"
+                         << std::endl;
+  // Each worker simplifies a contiguous slice of the assertions into results.
+  // The pipeline is only read until all workers are done. Workers charge
+  // their rewrite steps to the resource manager as they go. As in the
+  // sequential loop above, reaching a limit only notifies the listeners of
+  // the resource manager, and all assertions are simplified.
+  SmtEngine* smt = d_preprocContext->getSmt();
+  size_t sliceSize = (size + numThreads - 1) / numThreads;
+  std::vector<Node> results(size);
+  std::vector<std::exception_ptr> errors(numThreads);
+  auto work = [&](size_t t) {
+    smt::SmtScope scope(smt);
+    try
+    {
+      for (size_t i = t * sliceSize, end = std::min(size, i + sliceSize);
+           i < end;
+           ++i)
+      {
+        results[i] = applyToAssertion((*assertionsToPreprocess)[i]);
+      }
+    }
+    catch (...)
+    {
+      errors[t] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < numThreads; ++t)
+  {
+    workers.emplace_back(work, t);
+  }
+  work(0);
+  for (std::thread& w : workers)
+  {
+    w.join();
+  }
+  for (const std::exception_ptr& e : errors)
+  {
+    if (e != nullptr)
+    {
+      std::rethrow_exception(e);
+    }
+  }
+
+  // replace the assertions in order, so that the pipeline is the same as
+  // after a sequential run
+  for (size_t i = 0; i < size; ++i)
+  {
+    assertionsToPreprocess->replace(i, results[i]);
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+Node PreprocessingPass::applyToAssertion(TNode assertion)
+{
+  Unreachable() << "pass " << d_name << " is not per-assertion";
+  return Node::null();
+}
+
 void PreprocessingPass::dumpAssertions(const char* key,
                                        const AssertionPipeline& assertionList) {
   if (Dump.isOn("assertions") && Dump.isOn(std::string("assertions:") + key))
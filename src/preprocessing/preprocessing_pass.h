@@ -24,6 +24,11 @@
  **
  ** Optionally, preprocessing passes can overwrite the initInteral() method to
  ** do work that only needs to be done once.
+ **
+ ** Passes that simplify each assertion independently of the others can instead
+ ** return true from isPerAssertion() and implement applyToAssertion(). The
+ ** assertions are then simplified by --pp-threads worker threads, each on a
+ ** slice of the pipeline, and the results are written back in order.
  **/
 
 #include "cvc4_private.h"
@@ -33,6 +38,7 @@
 
 #include <string>
 
+#include "expr/node.h"
 #include "util/statistics_registry.h"
 
 namespace CVC4 {
@@ -56,6 +62,12 @@ class PreprocessingPass {
                     const std::string& name);
   virtual ~PreprocessingPass();
 
+  /**
+   * Whether this pass replaces each assertion by applyToAssertion() of it.
+   * The assertions of such passes may be simplified in parallel.
+   */
+  virtual bool isPerAssertion() const { return false; }
+
  protected:
   /*
    * Method for dumping assertions within a pass. Also called before and after
@@ -64,10 +76,18 @@ class PreprocessingPass {
   void dumpAssertions(const char* key, const AssertionPipeline& assertionList);
 
   /*
-   * Abstract method that each pass implements to do the actual preprocessing.
+   * Method that each pass implements to do the actual preprocessing. The
+   * default, for per-assertion passes, replaces each assertion by
+   * applyToAssertion() of it.
    */
   virtual PreprocessingPassResult applyInternal(
-      AssertionPipeline* assertionsToPreprocess) = 0;
+      AssertionPipeline* assertionsToPreprocess);
+
+  /**
+   * Simplifies a single assertion, for passes that are per-assertion. It may
+   * be called concurrently from several threads, with the SmtEngine in scope.
+   */
+  virtual Node applyToAssertion(TNode assertion);
 
   /* Context for Preprocessing Passes that initializes necessary variables */
   PreprocessingPassContext* d_preprocContext;
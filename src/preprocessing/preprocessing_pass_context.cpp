@@ -17,6 +17,7 @@
 #include "preprocessing/preprocessing_pass_context.h"
 
 #include "expr/node_algorithm.h"
+#include "options/smt_options.h"
 
 namespace CVC4 {
 namespace preprocessing {
@@ -32,6 +33,10 @@ PreprocessingPassContext::PreprocessingPassContext(
       d_pnm(pnm),
       d_symsInAssertions(smt->getUserContext())
 {
+  if (!options::ppProfile().empty())
+  {
+    d_profiler.reset(new PreprocessingProfiler(options::ppProfile()));
+  }
 }
 
 theory::TrustSubstitutionMap&
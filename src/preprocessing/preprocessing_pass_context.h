@@ -21,7 +21,10 @@
 #ifndef CVC4__PREPROCESSING__PREPROCESSING_PASS_CONTEXT_H
 #define CVC4__PREPROCESSING__PREPROCESSING_PASS_CONTEXT_H
 
+#include <memory>
+
 #include "context/cdhashset.h"
+#include "preprocessing/preprocessing_profiler.h"
 #include "smt/smt_engine.h"
 #include "theory/trust_substitutions.h"
 #include "util/resource_manager.h"
@@ -82,6 +85,9 @@ class PreprocessingPassContext
   /** The the proof node manager associated with this context, if it exists */
   ProofNodeManager* getProofNodeManager();
 
+  /** The profiler of the passes, if --pp-profile is set, or nullptr */
+  PreprocessingProfiler* getProfiler() { return d_profiler.get(); }
+
  private:
   /** Pointer to the SmtEngine that this context was created in. */
   SmtEngine* d_smt;
@@ -102,6 +108,8 @@ class PreprocessingPassContext
    * assertion in the current user context.
    */
   context::CDHashSet<Node, NodeHashFunction> d_symsInAssertions;
+  /** The profiler of the passes, if any */
+  std::unique_ptr<PreprocessingProfiler> d_profiler;
 
 };  // class PreprocessingPassContext
 
@@ -0,0 +1,189 @@
+/*********************                                                        */
+/*! \file preprocessing_profiler.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A profiler of the preprocessing passes
+ **
+ ** A profiler of the preprocessing passes.
+ **/
+
+#include "preprocessing/preprocessing_profiler.h"
+
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+#include <sys/resource.h>
+#endif
+
+#include "base/check.h"
+#include "base/output.h"
+#include "preprocessing/assertion_pipeline.h"
+
+namespace CVC4 {
+namespace preprocessing {
+
+PreprocessingProfiler::PreprocessingProfiler(const std::string& filename)
+    : d_filename(filename), d_round(0)
+{
+}
+
+void PreprocessingProfiler::beginPass(const std::string& name,
+                                      const AssertionPipeline& assertions)
+{
+  Invocation inv;
+  inv.d_round = d_round;
+  inv.d_pass = name;
+  inv.d_depth = d_open.size();
+  inv.d_before = measure(assertions);
+  inv.d_wallTimeMs = 0;
+  inv.d_peakMemoryDeltaKb = 0;
+  d_open.push_back(inv);
+  // taken last, so that measuring is not part of the pass
+  d_openPeakMemoryKb.push_back(peakMemoryKb());
+  d_openStart.push_back(std::chrono::steady_clock::now());
+}
+
+void PreprocessingProfiler::endPass(const AssertionPipeline& assertions)
+{
+  Assert(!d_open.empty());
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - d_openStart.back();
+  Invocation inv = d_open.back();
+  inv.d_wallTimeMs = elapsed.count();
+  inv.d_peakMemoryDeltaKb = peakMemoryKb() - d_openPeakMemoryKb.back();
+  inv.d_after = measure(assertions);
+  d_open.pop_back();
+  d_openStart.pop_back();
+  d_openPeakMemoryKb.pop_back();
+  d_invocations.push_back(inv);
+}
+
+void PreprocessingProfiler::endRound()
+{
+  // drop the invocations interrupted by an exception
+  d_open.clear();
+  d_openStart.clear();
+  d_openPeakMemoryKb.clear();
+  ++d_round;
+  std::ofstream out(d_filename);
+  if (!out)
+  {
+    Warning() << "cannot write the preprocessing profile to " << d_filename
+              << std::endl;
+    return;
+  }
+  write(out);
+}
+
+void PreprocessingProfiler::write(std::ostream& out) const
+{
+  out << "{ \"passes\": [";
+  for (size_t i = 0, size = d_invocations.size(); i < size; ++i)
+  {
+    const Invocation& inv = d_invocations[i];
+    out << (i == 0 ? "\n" : ",\n");
+    out << "  { \"round\": " << inv.d_round << ", \"pass\": \"";
+    // pass names are identifiers, but do not write invalid JSON regardless
+    for (char c : inv.d_pass)
+    {
+      if (c == '"' || c == '\\')
+      {
+        out << '\\';
+      }
+      out << c;
+    }
+    out << "\", \"depth\": " << inv.d_depth << ",\n    \"before\": ";
+    writeSize(out, inv.d_before);
+    out << ",\n    \"after\": ";
+    writeSize(out, inv.d_after);
+    out << ",\n    \"wallTimeMs\": " << inv.d_wallTimeMs
+        << ", \"peakMemoryDeltaKb\": " << inv.d_peakMemoryDeltaKb << " }";
+  }
+  out << " ] }" << std::endl;
+}
+
+PreprocessingProfiler::ProblemSize PreprocessingProfiler::measure(
+    const AssertionPipeline& assertions)
+{
+  static constexpr uint64_t s_maxTreeSize =
+      std::numeric_limits<uint64_t>::max();
+  ProblemSize size;
+  size.d_assertions = assertions.size();
+  // the tree size of each visited subterm, computed bottom-up
+  std::unordered_map<TNode, uint64_t, TNodeHashFunction> treeSize;
+  std::unordered_set<Kind, kind::KindHashFunction> kinds;
+  std::vector<TNode> visit;
+  for (const Node& a : assertions)
+  {
+    visit.push_back(a);
+    while (!visit.empty())
+    {
+      TNode cur = visit.back();
+      auto it = treeSize.find(cur);
+      if (it == treeSize.end())
+      {
+        // children first
+        treeSize[cur] = 0;
+        visit.insert(visit.end(), cur.begin(), cur.end());
+        continue;
+      }
+      visit.pop_back();
+      if (it->second != 0)
+      {
+        continue;
+      }
+      uint64_t ts = 1;
+      for (TNode c : cur)
+      {
+        uint64_t cts = treeSize[c];
+        ts = cts > s_maxTreeSize - ts ? s_maxTreeSize : ts + cts;
+      }
+      it->second = ts;
+      kinds.insert(cur.getKind());
+    }
+    uint64_t ats = treeSize[a];
+    size.d_treeSize = ats > s_maxTreeSize - size.d_treeSize
+                          ? s_maxTreeSize
+                          : size.d_treeSize + ats;
+  }
+  size.d_dagSize = treeSize.size();
+  size.d_kinds = kinds.size();
+  return size;
+}
+
+void PreprocessingProfiler::writeSize(std::ostream& out,
+                                      const ProblemSize& size)
+{
+  out << "{ \"assertions\": " << size.d_assertions
+      << ", \"dagSize\": " << size.d_dagSize
+      << ", \"treeSize\": " << size.d_treeSize
+      << ", \"kinds\": " << size.d_kinds << " }";
+}
+
+int64_t PreprocessingProfiler::peakMemoryKb()
+{
+#if !defined(_MSC_VER) && !defined(__MINGW32__)
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) == 0)
+  {
+    // in kilobytes on Linux, in bytes on macOS
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024;
+#else
+    return ru.ru_maxrss;
+#endif
+  }
+#endif
+  return 0;
+}
+
+}  // namespace preprocessing
+}  // namespace CVC4
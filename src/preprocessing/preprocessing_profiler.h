@@ -0,0 +1,125 @@
+/*********************                                                        */
+/*! \file preprocessing_profiler.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A profiler of the preprocessing passes
+ **
+ ** A profiler recording what each invocation of a preprocessing pass did to
+ ** the size of the problem, and how long it took, written as JSON.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PREPROCESSING_PROFILER_H
+#define CVC4__PREPROCESSING__PREPROCESSING_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace CVC4 {
+namespace preprocessing {
+
+class AssertionPipeline;
+
+/**
+ * Records, for each invocation of a preprocessing pass, the size of the
+ * assertions before and after it, its wall time and the growth of the peak
+ * memory of the process during it. Invocations are numbered by the round of
+ * preprocessing (one per check-sat) they belong to. Passes invoked by other
+ * passes are recorded with their nesting depth.
+ *
+ * The profile is written with write(), as a JSON object of the form
+ *
+ *   { "passes": [
+ *     { "round": 0, "pass": "rewrite", "depth": 0,
+ *       "before": { "assertions": 2, "dagSize": 7, "treeSize": 9,
+ *                   "kinds": 4 },
+ *       "after": { ... },
+ *       "wallTimeMs": 0.125, "peakMemoryDeltaKb": 0 },
+ *     ... ] }
+ *
+ * Tree sizes saturate at the maximal 64-bit unsigned integer.
+ */
+class PreprocessingProfiler
+{
+ public:
+  /** Create a profiler writing to the given file */
+  PreprocessingProfiler(const std::string& filename);
+
+  /** Called when the given pass is about to be applied to the assertions */
+  void beginPass(const std::string& name, const AssertionPipeline& assertions);
+
+  /** Called when the innermost pass begun is done with the assertions */
+  void endPass(const AssertionPipeline& assertions);
+
+  /**
+   * Called when a round of preprocessing is done. Writes the profile recorded
+   * so far, so that it is complete even if the solver is interrupted later.
+   */
+  void endRound();
+
+  /** Write the profile recorded so far to the given stream */
+  void write(std::ostream& out) const;
+
+ private:
+  /** The size of a list of assertions */
+  struct ProblemSize
+  {
+    /** The number of assertions */
+    uint64_t d_assertions = 0;
+    /** The number of distinct subterms */
+    uint64_t d_dagSize = 0;
+    /** The number of subterms, counted once per occurrence */
+    uint64_t d_treeSize = 0;
+    /** The number of distinct kinds of the subterms */
+    uint64_t d_kinds = 0;
+  };
+  /** A pass invocation */
+  struct Invocation
+  {
+    /** The round of preprocessing */
+    uint64_t d_round;
+    /** The name of the pass */
+    std::string d_pass;
+    /** The number of enclosing pass invocations */
+    uint64_t d_depth;
+    /** The size of the assertions before and after the pass */
+    ProblemSize d_before;
+    ProblemSize d_after;
+    /** The wall time of the pass, in milliseconds */
+    double d_wallTimeMs;
+    /** The growth of the peak memory of the process, in kilobytes */
+    int64_t d_peakMemoryDeltaKb;
+  };
+  /** Computes the size of the given assertions */
+  static ProblemSize measure(const AssertionPipeline& assertions);
+  /** Writes the given size as a JSON object */
+  static void writeSize(std::ostream& out, const ProblemSize& size);
+  /** The peak resident memory of the process so far, in kilobytes */
+  static int64_t peakMemoryKb();
+
+  /** The file to write the profile to */
+  std::string d_filename;
+  /** The current round */
+  uint64_t d_round;
+  /** The invocations done */
+  std::vector<Invocation> d_invocations;
+  /** The invocations begun and not done yet, innermost last */
+  std::vector<Invocation> d_open;
+  /** The start time and peak memory of the invocations in d_open */
+  std::vector<std::chrono::steady_clock::time_point> d_openStart;
+  std::vector<int64_t> d_openPeakMemoryKb;
+}; /* class PreprocessingProfiler */
+
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PREPROCESSING_PROFILER_H */
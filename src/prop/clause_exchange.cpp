@@ -0,0 +1,116 @@
+/*********************                                                        */
+/*! \file clause_exchange.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A channel for sharing learned clauses between SAT solvers
+ **
+ ** A channel for sharing learned clauses between the SAT solvers of SmtEngine
+ ** instances of the same process.
+ **/
+
+#include "prop/clause_exchange.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace prop {
+
+std::shared_ptr<ClauseExchange> ClauseExchange::get(const std::string& name)
+{
+  static std::mutex s_mutex;
+  static std::map<std::string, std::weak_ptr<ClauseExchange>> s_exchanges;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  std::weak_ptr<ClauseExchange>& weak = s_exchanges[name];
+  std::shared_ptr<ClauseExchange> exchange = weak.lock();
+  if (exchange == nullptr)
+  {
+    exchange = std::make_shared<ClauseExchange>();
+    weak = exchange;
+  }
+  return exchange;
+}
+
+namespace {
+/** The cursor of an unregistered participant */
+const size_t s_unregistered = std::numeric_limits<size_t>::max();
+}  // namespace
+
+size_t ClauseExchange::registerParticipant()
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  // a new participant imports the clauses still in the pool
+  d_imported.push_back(d_trimmed);
+  return d_imported.size() - 1;
+}
+
+void ClauseExchange::unregisterParticipant(size_t id)
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  Assert(id < d_imported.size());
+  d_imported[id] = s_unregistered;
+  trim();
+}
+
+void ClauseExchange::exportClause(size_t id, const Clause& clause)
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  Assert(id < d_imported.size() && d_imported[id] != s_unregistered);
+  size_t end = d_trimmed + d_clauses.size();
+  d_clauses.emplace_back(id, clause);
+  // the exporter never imports its own clause
+  if (d_imported[id] == end)
+  {
+    ++d_imported[id];
+    trim();
+  }
+}
+
+void ClauseExchange::importClauses(size_t id, std::vector<Clause>& clauses)
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  Assert(id < d_imported.size() && d_imported[id] != s_unregistered);
+  Assert(d_imported[id] >= d_trimmed);
+  for (size_t i = d_imported[id] - d_trimmed, size = d_clauses.size();
+       i < size;
+       ++i)
+  {
+    if (d_clauses[i].first != id)
+    {
+      clauses.push_back(d_clauses[i].second);
+    }
+  }
+  d_imported[id] = d_trimmed + d_clauses.size();
+  trim();
+}
+
+size_t ClauseExchange::size() const
+{
+  std::lock_guard<std::mutex> lock(d_mutex);
+  return d_clauses.size();
+}
+
+void ClauseExchange::trim()
+{
+  size_t lowest = *std::min_element(d_imported.begin(), d_imported.end());
+  if (lowest == s_unregistered)
+  {
+    // no participant left to import the clauses
+    lowest = d_trimmed + d_clauses.size();
+  }
+  Assert(lowest >= d_trimmed);
+  d_clauses.erase(d_clauses.begin(),
+                  d_clauses.begin() + (lowest - d_trimmed));
+  d_trimmed = lowest;
+}
+
+}  // namespace prop
+}  // namespace CVC4
@@ -0,0 +1,105 @@
+/*********************                                                        */
+/*! \file clause_exchange.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A channel for sharing learned clauses between SAT solvers
+ **
+ ** A channel for sharing learned clauses between the SAT solvers of SmtEngine
+ ** instances of the same process.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PROP__CLAUSE_EXCHANGE_H
+#define CVC4__PROP__CLAUSE_EXCHANGE_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace prop {
+
+/**
+ * A pool of clauses shared by participants, typically the SAT solvers of
+ * several SmtEngine instances racing on the same assertions.  The clauses
+ * are over nodes rather than SAT literals, since each solver numbers its
+ * variables differently: a literal is an atom or the negation of one.
+ *
+ * Clauses are appended to the pool, and each participant imports the
+ * clauses exported by the other participants since its last import.  The
+ * clauses imported by every participant are removed from the pool, so a
+ * participant registered late only gets the clauses still in the pool.
+ *
+ * The participants must share the node manager.  The pool is synchronized,
+ * but participants running in different threads also need nodes to be
+ * thread-safe (CVC4_THREAD_SAFE_NODES).
+ */
+class ClauseExchange
+{
+ public:
+  /** A clause, as the nodes of its literals */
+  typedef std::vector<Node> Clause;
+
+  /**
+   * Get the exchange with the given name, creating it if it does not exist.
+   * An exchange exists as long as a participant holds it.
+   */
+  static std::shared_ptr<ClauseExchange> get(const std::string& name);
+
+  /** Register a participant, returning its identifier. */
+  size_t registerParticipant();
+
+  /**
+   * Unregister participant id, which imports no more clauses.  Its exported
+   * clauses stay in the pool for the other participants.
+   */
+  void unregisterParticipant(size_t id);
+
+  /** Export a clause from participant id. */
+  void exportClause(size_t id, const Clause& clause);
+
+  /**
+   * Add to clauses the clauses exported by the other participants since the
+   * last import of participant id.
+   */
+  void importClauses(size_t id, std::vector<Clause>& clauses);
+
+  /** Get the number of clauses in the pool. */
+  size_t size() const;
+
+ private:
+  /**
+   * Remove the clauses imported by all participants from the front of the
+   * pool.  The caller holds d_mutex.
+   */
+  void trim();
+
+  /** Protects the members below */
+  mutable std::mutex d_mutex;
+  /** The clauses, with the participants that exported them */
+  std::deque<std::pair<size_t, Clause>> d_clauses;
+  /** The number of clauses removed from the front of d_clauses */
+  size_t d_trimmed = 0;
+  /**
+   * The number of clauses exported so far that each participant has
+   * imported, counting the removed clauses, or none for an unregistered
+   * participant.
+   */
+  std::vector<size_t> d_imported;
+}; /* class ClauseExchange */
+
+}  // namespace prop
+}  // namespace CVC4
+
+#endif /* CVC4__PROP__CLAUSE_EXCHANGE_H */
@@ -34,6 +34,7 @@
 #include "smt/smt_engine.h"
 #include "printer/printer.h"
 #include "smt/smt_engine_scope.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/theory.h"
 #include "theory/theory_engine.h"
 
@@ -49,7 +50,9 @@ CnfStream::CnfStream(SatSolver* satSolver,
                      std::string name)
     : d_satSolver(satSolver),
       d_outMgr(outMgr),
+      d_context(context),
       d_booleanVariables(context),
+      d_polarities(context),
       d_notifyFormulas(context),
       d_nodeToLiteralMap(context),
       d_literalToNodeMap(context),
@@ -58,10 +61,103 @@ CnfStream::CnfStream(SatSolver* satSolver,
       d_name(name),
       d_cnfProof(nullptr),
       d_removable(false),
-      d_resourceManager(rm)
+      d_resourceManager(rm),
+      d_polarityEncoding(false),
+      d_persistent(false),
+      d_persistentScope(false),
+      d_numClauses(0),
+      d_definitionStart(0)
 {
 }
 
+CnfStream::Statistics::Statistics()
+    : d_clauses("prop::cnf::clauses", 0),
+      d_literals("prop::cnf::literals", 0),
+      d_polarityUpgrades("prop::cnf::polarityUpgrades", 0),
+      d_persistentDefinitions("prop::cnf::persistentDefinitions", 0),
+      d_persistentClauses("prop::cnf::persistentClauses", 0),
+      d_scopedClauses("prop::cnf::scopedClauses", 0),
+      d_reusedDefinitions("prop::cnf::reusedDefinitions", 0),
+      d_reusedClauses("prop::cnf::reusedClauses", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_clauses);
+  smtStatisticsRegistry()->registerStat(&d_literals);
+  smtStatisticsRegistry()->registerStat(&d_polarityUpgrades);
+  smtStatisticsRegistry()->registerStat(&d_persistentDefinitions);
+  smtStatisticsRegistry()->registerStat(&d_persistentClauses);
+  smtStatisticsRegistry()->registerStat(&d_scopedClauses);
+  smtStatisticsRegistry()->registerStat(&d_reusedDefinitions);
+  smtStatisticsRegistry()->registerStat(&d_reusedClauses);
+}
+
+CnfStream::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_clauses);
+  smtStatisticsRegistry()->unregisterStat(&d_literals);
+  smtStatisticsRegistry()->unregisterStat(&d_polarityUpgrades);
+  smtStatisticsRegistry()->unregisterStat(&d_persistentDefinitions);
+  smtStatisticsRegistry()->unregisterStat(&d_persistentClauses);
+  smtStatisticsRegistry()->unregisterStat(&d_scopedClauses);
+  smtStatisticsRegistry()->unregisterStat(&d_reusedDefinitions);
+  smtStatisticsRegistry()->unregisterStat(&d_reusedClauses);
+}
+
+void CnfStream::registerStatistics()
+{
+  Assert(d_statistics == nullptr);
+  d_statistics.reset(new Statistics());
+}
+
+void CnfStream::enablePersistentDefinitions()
+{
+  Assert(d_nodeToLiteralMap.empty());
+  Assert(d_statistics != nullptr);
+  Assert(!d_polarityEncoding);
+  d_persistent = true;
+}
+
+void CnfStream::enablePolarityEncoding()
+{
+  Assert(d_nodeToLiteralMap.empty());
+  Assert(d_statistics != nullptr);
+  Assert(!d_persistent);
+  d_polarityEncoding = true;
+}
+
+/** Returns true if node is converted by one of the Tseitin handlers */
+static bool isDefinition(TNode node)
+{
+  switch (node.getKind())
+  {
+    case kind::XOR:
+    case kind::ITE:
+    case kind::IMPLIES:
+    case kind::OR:
+    case kind::AND: return true;
+    case kind::EQUAL: return node[0].getType().isBoolean();
+    default: return false;
+  }
+}
+
+bool CnfStream::canPersist(TNode node) const
+{
+  Assert(d_persistentScope);
+  if (!isDefinition(node))
+  {
+    return true;
+  }
+  for (TNode child : node)
+  {
+    TNode atom = child.getKind() == kind::NOT ? child[0] : child;
+    if (atom.getKind() != kind::CONST_BOOLEAN
+        && d_persistentNodes.find(atom) == d_persistentNodes.end())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool CnfStream::assertClause(TNode node, SatClause& c)
 {
   Trace("cnf") << "Inserting into stream " << c << " node = " << node << "\n";
@@ -86,6 +182,12 @@ bool CnfStream::assertClause(TNode node, SatClause& c)
     }
   }
 
+  ++d_numClauses;
+  if (d_statistics)
+  {
+    ++d_statistics->d_clauses;
+    d_statistics->d_literals += c.size();
+  }
   ClauseId clauseId = d_satSolver->addClause(c, d_removable);
 
   if (d_cnfProof && clauseId != ClauseIdUndef)
@@ -151,6 +253,12 @@ void CnfStream::ensureLiteral(TNode n)
   Trace("cnf") << "ensureLiteral(" << n << ")\n";
   if (hasLiteral(n))
   {
+    if (d_polarityEncoding)
+    {
+      // the literal must be equivalent to n
+      d_removable = false;
+      toCNF(n);
+    }
     ensureMappingForLiteral(n);
     return;
   }
@@ -209,6 +317,7 @@ SatLiteral CnfStream::newLiteral(TNode node, bool isTheoryAtom, bool preRegister
 
   // Get the literal for this node
   SatLiteral lit;
+  bool persistent = false;
   if (!hasLiteral(node)) {
     Trace("cnf") << d_name << "::newLiteral: node already registered\n";
     // If no literal, we'll make one
@@ -222,9 +331,22 @@ SatLiteral CnfStream::newLiteral(TNode node, bool isTheoryAtom, bool preRegister
     } else {
       Trace("cnf") << d_name << "::newLiteral: new var\n";
       lit = SatLiteral(d_satSolver->newVar(isTheoryAtom, preRegister, canEliminate));
+      persistent = d_persistentScope && canPersist(node);
+    }
+    if (persistent)
+    {
+      d_satSolver->makePersistent(lit.getSatVariable());
+      d_nodeToLiteralMap.insertAtContextLevelZero(node, lit);
+      d_nodeToLiteralMap.insertAtContextLevelZero(node.notNode(), ~lit);
+      PersistentDefinition& def = d_persistentNodes[node];
+      def.d_level = d_context->getLevel();
+      def.d_numClauses = 0;
+    }
+    else
+    {
+      d_nodeToLiteralMap.insert(node, lit);
+      d_nodeToLiteralMap.insert(node.notNode(), ~lit);
     }
-    d_nodeToLiteralMap.insert(node, lit);
-    d_nodeToLiteralMap.insert(node.notNode(), ~lit);
   } else {
     lit = getLiteral(node);
   }
@@ -233,8 +355,28 @@ SatLiteral CnfStream::newLiteral(TNode node, bool isTheoryAtom, bool preRegister
   if (isTheoryAtom || d_flitPolicy == FormulaLitPolicy::TRACK
       || (Dump.isOn("clauses")))
   {
-    d_literalToNodeMap.insert_safe(lit, node);
-    d_literalToNodeMap.insert_safe(~lit, node.notNode());
+    if (persistent)
+    {
+      d_literalToNodeMap.insertAtContextLevelZero(lit, node);
+      d_literalToNodeMap.insertAtContextLevelZero(~lit, node.notNode());
+    }
+    else
+    {
+      d_literalToNodeMap.insert_safe(lit, node);
+      d_literalToNodeMap.insert_safe(~lit, node.notNode());
+    }
+  }
+
+  if (d_persistent && isDefinition(node))
+  {
+    // the clauses of the definition are asserted next by the caller, they are
+    // kept at level zero if they are over persistent literals only
+    d_definitionStart = d_numClauses;
+    if (persistent)
+    {
+      d_removable = true;
+      ++d_statistics->d_persistentDefinitions;
+    }
   }
 
   // If a theory literal, we pre-register it
@@ -272,6 +414,9 @@ void CnfStream::getBooleanVariables(std::vector<TNode>& outputVariables) const {
   for (it = d_booleanVariables.begin(); it != d_booleanVariables.end(); ++ it) {
     outputVariables.push_back(*it);
   }
+  outputVariables.insert(outputVariables.end(),
+                         d_persistentBooleanVariables.begin(),
+                         d_persistentBooleanVariables.end());
 }
 
 bool CnfStream::isNotifyFormula(TNode node) const
@@ -297,7 +442,14 @@ SatLiteral CnfStream::convertAtom(TNode node)
   // Is this a variable add it to the list
   if (node.isVar() && node.getKind() != kind::BOOLEAN_TERM_VARIABLE)
   {
-    d_booleanVariables.push_back(node);
+    if (d_persistentScope)
+    {
+      d_persistentBooleanVariables.push_back(node);
+    }
+    else
+    {
+      d_booleanVariables.push_back(node);
+    }
   }
   else
   {
@@ -324,9 +476,8 @@ SatLiteral CnfStream::getLiteral(TNode node) {
   return literal;
 }
 
-SatLiteral CnfStream::handleXor(TNode xorNode)
+SatLiteral CnfStream::handleXor(TNode xorNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(xorNode)) << "Atom already mapped!";
   Assert(xorNode.getKind() == kind::XOR) << "Expecting an XOR expression!";
   Assert(xorNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -335,19 +486,24 @@ SatLiteral CnfStream::handleXor(TNode xorNode)
   SatLiteral a = toCNF(xorNode[0]);
   SatLiteral b = toCNF(xorNode[1]);
 
-  SatLiteral xorLit = newLiteral(xorNode);
+  SatLiteral xorLit = definitionLiteral(xorNode);
 
-  assertClause(xorNode.negate(), a, b, ~xorLit);
-  assertClause(xorNode.negate(), ~a, ~b, ~xorLit);
-  assertClause(xorNode, a, ~b, xorLit);
-  assertClause(xorNode, ~a, b, xorLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(xorNode.negate(), a, b, ~xorLit);
+    assertClause(xorNode.negate(), ~a, ~b, ~xorLit);
+  }
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(xorNode, a, ~b, xorLit);
+    assertClause(xorNode, ~a, b, xorLit);
+  }
 
   return xorLit;
 }
 
-SatLiteral CnfStream::handleOr(TNode orNode)
+SatLiteral CnfStream::handleOr(TNode orNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(orNode)) << "Atom already mapped!";
   Assert(orNode.getKind() == kind::OR) << "Expecting an OR expression!";
   Assert(orNode.getNumChildren() > 1) << "Expecting more then 1 child!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -361,32 +517,39 @@ SatLiteral CnfStream::handleOr(TNode orNode)
   TNode::const_iterator node_it_end = orNode.end();
   SatClause clause(n_children + 1);
   for(int i = 0; node_it != node_it_end; ++node_it, ++i) {
-    clause[i] = toCNF(*node_it);
+    clause[i] = toCNF(*node_it, false, polarity);
   }
 
   // Get the literal for this node
-  SatLiteral orLit = newLiteral(orNode);
+  SatLiteral orLit = definitionLiteral(orNode);
 
   // lit <- (a_1 | a_2 | a_3 | ... | a_n)
   // lit | ~(a_1 | a_2 | a_3 | ... | a_n)
   // (lit | ~a_1) & (lit | ~a_2) & (lit & ~a_3) & ... & (lit & ~a_n)
-  for(unsigned i = 0; i < n_children; ++i) {
-    assertClause(orNode, orLit, ~clause[i]);
+  if (polarity & POLARITY_NEG)
+  {
+    for (unsigned i = 0; i < n_children; ++i)
+    {
+      assertClause(orNode, orLit, ~clause[i]);
+    }
   }
 
   // lit -> (a_1 | a_2 | a_3 | ... | a_n)
   // ~lit | a_1 | a_2 | a_3 | ... | a_n
-  clause[n_children] = ~orLit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  assertClause(orNode.negate(), clause);
+  if (polarity & POLARITY_POS)
+  {
+    clause[n_children] = ~orLit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    assertClause(orNode.negate(), clause);
+  }
 
   // Return the literal
   return orLit;
 }
 
-SatLiteral CnfStream::handleAnd(TNode andNode)
+SatLiteral CnfStream::handleAnd(TNode andNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(andNode)) << "Atom already mapped!";
   Assert(andNode.getKind() == kind::AND) << "Expecting an AND expression!";
   Assert(andNode.getNumChildren() > 1) << "Expecting more than 1 child!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -400,32 +563,39 @@ SatLiteral CnfStream::handleAnd(TNode andNode)
   TNode::const_iterator node_it_end = andNode.end();
   SatClause clause(n_children + 1);
   for(int i = 0; node_it != node_it_end; ++node_it, ++i) {
-    clause[i] = ~toCNF(*node_it);
+    clause[i] = ~toCNF(*node_it, false, polarity);
   }
 
   // Get the literal for this node
-  SatLiteral andLit = newLiteral(andNode);
+  SatLiteral andLit = definitionLiteral(andNode);
 
   // lit -> (a_1 & a_2 & a_3 & ... & a_n)
   // ~lit | (a_1 & a_2 & a_3 & ... & a_n)
   // (~lit | a_1) & (~lit | a_2) & ... & (~lit | a_n)
-  for(unsigned i = 0; i < n_children; ++i) {
-    assertClause(andNode.negate(), ~andLit, ~clause[i]);
+  if (polarity & POLARITY_POS)
+  {
+    for (unsigned i = 0; i < n_children; ++i)
+    {
+      assertClause(andNode.negate(), ~andLit, ~clause[i]);
+    }
   }
 
   // lit <- (a_1 & a_2 & a_3 & ... a_n)
   // lit | ~(a_1 & a_2 & a_3 & ... & a_n)
   // lit | ~a_1 | ~a_2 | ~a_3 | ... | ~a_n
-  clause[n_children] = andLit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  assertClause(andNode, clause);
+  if (polarity & POLARITY_NEG)
+  {
+    clause[n_children] = andLit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    assertClause(andNode, clause);
+  }
 
   return andLit;
 }
 
-SatLiteral CnfStream::handleImplies(TNode impliesNode)
+SatLiteral CnfStream::handleImplies(TNode impliesNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(impliesNode)) << "Atom already mapped!";
   Assert(impliesNode.getKind() == kind::IMPLIES)
       << "Expecting an IMPLIES expression!";
   Assert(impliesNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
@@ -433,27 +603,32 @@ SatLiteral CnfStream::handleImplies(TNode impliesNode)
   Trace("cnf") << "handleImplies(" << impliesNode << ")\n";
 
   // Convert the children to cnf
-  SatLiteral a = toCNF(impliesNode[0]);
-  SatLiteral b = toCNF(impliesNode[1]);
+  SatLiteral a = toCNF(impliesNode[0], false, flipPolarity(polarity));
+  SatLiteral b = toCNF(impliesNode[1], false, polarity);
 
-  SatLiteral impliesLit = newLiteral(impliesNode);
+  SatLiteral impliesLit = definitionLiteral(impliesNode);
 
   // lit -> (a->b)
   // ~lit | ~ a | b
-  assertClause(impliesNode.negate(), ~impliesLit, ~a, b);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(impliesNode.negate(), ~impliesLit, ~a, b);
+  }
 
   // (a->b) -> lit
   // ~(~a | b) | lit
   // (a | l) & (~b | l)
-  assertClause(impliesNode, a, impliesLit);
-  assertClause(impliesNode, ~b, impliesLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(impliesNode, a, impliesLit);
+    assertClause(impliesNode, ~b, impliesLit);
+  }
 
   return impliesLit;
 }
 
-SatLiteral CnfStream::handleIff(TNode iffNode)
+SatLiteral CnfStream::handleIff(TNode iffNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(iffNode)) << "Atom already mapped!";
   Assert(iffNode.getKind() == kind::EQUAL) << "Expecting an EQUAL expression!";
   Assert(iffNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -464,28 +639,33 @@ SatLiteral CnfStream::handleIff(TNode iffNode)
   SatLiteral b = toCNF(iffNode[1]);
 
   // Get the now literal
-  SatLiteral iffLit = newLiteral(iffNode);
+  SatLiteral iffLit = definitionLiteral(iffNode);
 
   // lit -> ((a-> b) & (b->a))
   // ~lit | ((~a | b) & (~b | a))
   // (~a | b | ~lit) & (~b | a | ~lit)
-  assertClause(iffNode.negate(), ~a, b, ~iffLit);
-  assertClause(iffNode.negate(), a, ~b, ~iffLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(iffNode.negate(), ~a, b, ~iffLit);
+    assertClause(iffNode.negate(), a, ~b, ~iffLit);
+  }
 
   // (a<->b) -> lit
   // ~((a & b) | (~a & ~b)) | lit
   // (~(a & b)) & (~(~a & ~b)) | lit
   // ((~a | ~b) & (a | b)) | lit
   // (~a | ~b | lit) & (a | b | lit)
-  assertClause(iffNode, ~a, ~b, iffLit);
-  assertClause(iffNode, a, b, iffLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(iffNode, ~a, ~b, iffLit);
+    assertClause(iffNode, a, b, iffLit);
+  }
 
   return iffLit;
 }
 
-SatLiteral CnfStream::handleIte(TNode iteNode)
+SatLiteral CnfStream::handleIte(TNode iteNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(iteNode)) << "Atom already mapped!";
   Assert(iteNode.getKind() == kind::ITE);
   Assert(iteNode.getNumChildren() == 3);
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -493,10 +673,10 @@ SatLiteral CnfStream::handleIte(TNode iteNode)
                << iteNode[2] << ")\n";
 
   SatLiteral condLit = toCNF(iteNode[0]);
-  SatLiteral thenLit = toCNF(iteNode[1]);
-  SatLiteral elseLit = toCNF(iteNode[2]);
+  SatLiteral thenLit = toCNF(iteNode[1], false, polarity);
+  SatLiteral elseLit = toCNF(iteNode[2], false, polarity);
 
-  SatLiteral iteLit = newLiteral(iteNode);
+  SatLiteral iteLit = definitionLiteral(iteNode);
 
   // If ITE is true then one of the branches is true and the condition
   // implies which one
@@ -504,9 +684,12 @@ SatLiteral CnfStream::handleIte(TNode iteNode)
   // lit -> (t | e) & (b -> t) & (!b -> e)
   // lit -> (t | e) & (!b | t) & (b | e)
   // (!lit | t | e) & (!lit | !b | t) & (!lit | b | e)
-  assertClause(iteNode.negate(), ~iteLit, thenLit, elseLit);
-  assertClause(iteNode.negate(), ~iteLit, ~condLit, thenLit);
-  assertClause(iteNode.negate(), ~iteLit, condLit, elseLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(iteNode.negate(), ~iteLit, thenLit, elseLit);
+    assertClause(iteNode.negate(), ~iteLit, ~condLit, thenLit);
+    assertClause(iteNode.negate(), ~iteLit, condLit, elseLit);
+  }
 
   // If ITE is false then one of the branches is false and the condition
   // implies which one
@@ -514,45 +697,111 @@ SatLiteral CnfStream::handleIte(TNode iteNode)
   // !lit -> (!t | !e) & (b -> !t) & (!b -> !e)
   // !lit -> (!t | !e) & (!b | !t) & (b | !e)
   // (lit | !t | !e) & (lit | !b | !t) & (lit | b | !e)
-  assertClause(iteNode, iteLit, ~thenLit, ~elseLit);
-  assertClause(iteNode, iteLit, ~condLit, ~thenLit);
-  assertClause(iteNode, iteLit, condLit, ~elseLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(iteNode, iteLit, ~thenLit, ~elseLit);
+    assertClause(iteNode, iteLit, ~condLit, ~thenLit);
+    assertClause(iteNode, iteLit, condLit, ~elseLit);
+  }
 
   return iteLit;
 }
 
-SatLiteral CnfStream::toCNF(TNode node, bool negated)
+SatLiteral CnfStream::toCNF(TNode node, bool negated, uint8_t polarity)
 {
   Trace("cnf") << "toCNF(" << node
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   SatLiteral nodeLit;
   Node negatedNode = node.notNode();
 
+  if (d_polarityEncoding && node.getKind() == kind::NOT)
+  {
+    return toCNF(node[0], !negated, polarity);
+  }
+  // The polarities node is needed in: all of them unless encoding by polarity,
+  // and for formulas that are notified since their literals are asserted
+  if (!d_polarityEncoding || d_flitPolicy == FormulaLitPolicy::TRACK_AND_NOTIFY)
+  {
+    polarity = POLARITY_BOTH;
+  }
+  else if (negated)
+  {
+    polarity = flipPolarity(polarity);
+  }
+
   // If the non-negated node has already been translated, get the translation
   if(hasLiteral(node)) {
     Trace("cnf") << "toCNF(): already translated\n";
     nodeLit = getLiteral(node);
+    if (d_persistent)
+    {
+      std::unordered_map<Node, PersistentDefinition, NodeHashFunction>::iterator
+          it = d_persistentNodes.find(node);
+      // a definition whose user level was popped is used again
+      if (it != d_persistentNodes.end()
+          && it->second.d_level > d_context->getLevel())
+      {
+        it->second.d_level = d_context->getLevel();
+        if (isDefinition(node))
+        {
+          ++d_statistics->d_reusedDefinitions;
+          d_statistics->d_reusedClauses += it->second.d_numClauses;
+        }
+      }
+    }
+    if (d_polarityEncoding && isDefinition(node))
+    {
+      // add the clauses of the polarities the definition is missing
+      PolarityMap::const_iterator it = d_polarities.find(node);
+      uint8_t encoded = it == d_polarities.end() ? POLARITY_BOTH : (*it).second;
+      uint8_t missing = polarity & ~encoded;
+      if (missing != 0)
+      {
+        Trace("cnf") << "toCNF(): adding polarity " << int(missing) << "\n";
+        bool removable = d_removable;
+        d_removable = false;
+        ++d_statistics->d_polarityUpgrades;
+        handleDefinition(node, missing);
+        d_polarities.insert(node, encoded | missing);
+        d_removable = removable;
+      }
+    }
     // Return the (maybe negated) literal
     return !negated ? nodeLit : ~nodeLit;
   }
   // Handle each Boolean operator case
-  switch (node.getKind())
+  bool removable = d_removable;
+  if (node.getKind() == kind::NOT)
   {
-    case kind::NOT: nodeLit = ~toCNF(node[0]); break;
-    case kind::XOR: nodeLit = handleXor(node); break;
-    case kind::ITE: nodeLit = handleIte(node); break;
-    case kind::IMPLIES: nodeLit = handleImplies(node); break;
-    case kind::OR: nodeLit = handleOr(node); break;
-    case kind::AND: nodeLit = handleAnd(node); break;
-    case kind::EQUAL:
-      nodeLit =
-          node[0].getType().isBoolean() ? handleIff(node) : convertAtom(node);
-      break;
-    default:
+    nodeLit = ~toCNF(node[0]);
+  }
+  else if (isDefinition(node))
+  {
+    nodeLit = handleDefinition(node, polarity);
+    if (d_polarityEncoding)
     {
-      nodeLit = convertAtom(node);
+      d_polarities.insert(node, polarity);
     }
-    break;
+  }
+  else
+  {
+    nodeLit = convertAtom(node);
+  }
+  if (d_persistent && isDefinition(node))
+  {
+    size_t numClauses = d_numClauses - d_definitionStart;
+    std::unordered_map<Node, PersistentDefinition, NodeHashFunction>::iterator
+        it = d_persistentNodes.find(node);
+    if (it != d_persistentNodes.end())
+    {
+      it->second.d_numClauses = numClauses;
+      d_statistics->d_persistentClauses += numClauses;
+    }
+    else
+    {
+      d_statistics->d_scopedClauses += numClauses;
+    }
+    d_removable = removable;
   }
   // Return the (maybe negated) literal
   Trace("cnf") << "toCNF(): resulting literal: "
@@ -560,6 +809,26 @@ SatLiteral CnfStream::toCNF(TNode node, bool negated)
   return !negated ? nodeLit : ~nodeLit;
 }
 
+SatLiteral CnfStream::handleDefinition(TNode node, uint8_t polarity)
+{
+  switch (node.getKind())
+  {
+    case kind::XOR: return handleXor(node, polarity);
+    case kind::ITE: return handleIte(node, polarity);
+    case kind::IMPLIES: return handleImplies(node, polarity);
+    case kind::OR: return handleOr(node, polarity);
+    case kind::AND: return handleAnd(node, polarity);
+    case kind::EQUAL: return handleIff(node, polarity);
+    default: Unreachable() << "Not a definition: " << node;
+  }
+}
+
+SatLiteral CnfStream::definitionLiteral(TNode node)
+{
+  // the literal exists if the clauses of another polarity are added
+  return hasLiteral(node) ? getLiteral(node) : newLiteral(node);
+}
+
 void CnfStream::convertAndAssertAnd(TNode node, bool negated)
 {
   Assert(node.getKind() == kind::AND);
@@ -578,7 +847,7 @@ void CnfStream::convertAndAssertAnd(TNode node, bool negated)
     TNode::const_iterator disjunct = node.begin();
     for(int i = 0; i < nChildren; ++ disjunct, ++ i) {
       Assert(disjunct != node.end());
-      clause[i] = toCNF(*disjunct, true);
+      clause[i] = toCNF(*disjunct, true, POLARITY_POS);
     }
     Assert(disjunct == node.end());
     assertClause(node.negate(), clause);
@@ -597,7 +866,7 @@ void CnfStream::convertAndAssertOr(TNode node, bool negated)
     TNode::const_iterator disjunct = node.begin();
     for(int i = 0; i < nChildren; ++ disjunct, ++ i) {
       Assert(disjunct != node.end());
-      clause[i] = toCNF(*disjunct, false);
+      clause[i] = toCNF(*disjunct, false, POLARITY_POS);
     }
     Assert(disjunct == node.end());
     assertClause(node, clause);
@@ -685,8 +954,8 @@ void CnfStream::convertAndAssertImplies(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   if (!negated) {
     // p => q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral p = toCNF(node[0], false, POLARITY_NEG);
+    SatLiteral q = toCNF(node[1], false, POLARITY_POS);
     // Construct the clause ~p || q
     SatClause clause(2);
     clause[0] = ~p;
@@ -706,8 +975,8 @@ void CnfStream::convertAndAssertIte(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   // ITE(p, q, r)
   SatLiteral p = toCNF(node[0], false);
-  SatLiteral q = toCNF(node[1], negated);
-  SatLiteral r = toCNF(node[2], negated);
+  SatLiteral q = toCNF(node[1], negated, POLARITY_POS);
+  SatLiteral r = toCNF(node[2], negated, POLARITY_POS);
   // Construct the clauses:
   // (p => q) and (!p => r)
   //
@@ -739,6 +1008,9 @@ void CnfStream::convertAndAssert(TNode node,
                << ", negated = " << (negated ? "true" : "false")
                << ", removable = " << (removable ? "true" : "false") << ")\n";
   d_removable = removable;
+  // lemmas may be asserted while converting, when atoms are preregistered
+  bool persistentScope = d_persistentScope;
+  d_persistentScope = d_persistent && input && !removable;
 
   if (d_cnfProof)
   {
@@ -750,6 +1022,7 @@ void CnfStream::convertAndAssert(TNode node,
   {
     d_cnfProof->popCurrentAssertion();
   }
+  d_persistentScope = persistentScope;
 }
 
 void CnfStream::convertAndAssert(TNode node, bool negated)
@@ -781,7 +1054,7 @@ void CnfStream::convertAndAssert(TNode node, bool negated)
         nnode = node.negate();
       }
       // Atoms
-      assertClause(nnode, toCNF(node, negated));
+      assertClause(nnode, toCNF(node, negated, POLARITY_POS));
   }
     break;
   }
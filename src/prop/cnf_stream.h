@@ -25,6 +25,11 @@
 #ifndef CVC4__PROP__CNF_STREAM_H
 #define CVC4__PROP__CNF_STREAM_H
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "context/cdinsert_hashmap.h"
 #include "context/cdlist.h"
@@ -33,6 +38,7 @@
 #include "prop/proof_cnf_stream.h"
 #include "prop/registrar.h"
 #include "prop/sat_solver_types.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 
@@ -166,7 +172,60 @@ class CnfStream {
 
   void setProof(CnfProof* proof);
 
+  /**
+   * Keep the Tseitin definitions introduced for input assertions across user
+   * levels (see --incremental-cnf).  When a user level is popped, the
+   * definitions of its formulas are not removed from the SAT solver, so they
+   * do not need to be converted again when the formulas are asserted in a
+   * later user level.  A definition is kept if all the formulas it is over
+   * are atoms or kept definitions, and is asserted with clauses over
+   * persistent SAT variables (see SatSolver::makePersistent), which the SAT
+   * solver keeps at user level zero.
+   *
+   * This must be called before anything is converted.
+   */
+  void enablePersistentDefinitions();
+
+  /**
+   * Encode the formulas by polarity (Plaisted-Greenbaum, see
+   * --cnf-polarity): the literal of a subformula that only occurs positively
+   * implies it, and a subformula that only occurs negatively implies its
+   * literal, instead of both being equivalent.  When a subformula is used
+   * again in another polarity, the clauses it is missing are added.  The
+   * literals requested by ensureLiteral() and the literals of notified
+   * formulas are always equivalent to their formulas.
+   *
+   * This must be called before anything is converted, and excludes
+   * enablePersistentDefinitions().
+   */
+  void enablePolarityEncoding();
+
+  /**
+   * Register the statistics of this CNF stream (clauses and literals asserted,
+   * definitions).  Required by the two methods above.
+   */
+  void registerStatistics();
+
  protected:
+  /**
+   * The polarities a formula is encoded in, as a bit mask: in the positive
+   * polarity its literal implies it, in the negative polarity it implies its
+   * literal.
+   */
+  enum Polarity : uint8_t
+  {
+    POLARITY_POS = 1,
+    POLARITY_NEG = 2,
+    POLARITY_BOTH = 3,
+  };
+
+  /** Returns the opposite polarities of the given ones */
+  static uint8_t flipPolarity(uint8_t polarity)
+  {
+    return ((polarity & POLARITY_POS) ? POLARITY_NEG : 0)
+           | ((polarity & POLARITY_NEG) ? POLARITY_POS : 0);
+  }
+
   /**
    * Same as above, except that uses the saved d_removable flag. It calls the
    * dedicated converter for the possible formula kinds.
@@ -190,20 +249,30 @@ class CnfStream {
    *
    * @param node the formula to transform
    * @param negated whether the literal is negated
+   * @param polarity the polarities the returned literal is used in, which
+   * only matters when encoding by polarity
    * @return the literal representing the root of the formula
    */
-  SatLiteral toCNF(TNode node, bool negated = false);
+  SatLiteral toCNF(TNode node,
+                   bool negated = false,
+                   uint8_t polarity = POLARITY_BOTH);
 
   /** Specific clausifiers, based on the formula kinds, that clausify a formula,
    * by calling toCNF into each of the formula's children under the respective
-   * kind, and introduce a literal definitionally equal to it. */
+   * kind, and introduce a literal definitionally equal to it, in the given
+   * polarities. If the formula already has a literal, only the clauses of the
+   * given polarities are added. */
   SatLiteral handleNot(TNode node);
-  SatLiteral handleXor(TNode node);
-  SatLiteral handleImplies(TNode node);
-  SatLiteral handleIff(TNode node);
-  SatLiteral handleIte(TNode node);
-  SatLiteral handleAnd(TNode node);
-  SatLiteral handleOr(TNode node);
+  SatLiteral handleXor(TNode node, uint8_t polarity);
+  SatLiteral handleImplies(TNode node, uint8_t polarity);
+  SatLiteral handleIff(TNode node, uint8_t polarity);
+  SatLiteral handleIte(TNode node, uint8_t polarity);
+  SatLiteral handleAnd(TNode node, uint8_t polarity);
+  SatLiteral handleOr(TNode node, uint8_t polarity);
+  /** Calls the clausifier of the kind of node */
+  SatLiteral handleDefinition(TNode node, uint8_t polarity);
+  /** Returns the literal of node, making a new one if it has none */
+  SatLiteral definitionLiteral(TNode node);
 
   /** Stores the literal of the given node in d_literalToNodeMap.
    *
@@ -218,9 +287,16 @@ class CnfStream {
   /** Reference to the output manager of the smt engine */
   OutputManager* d_outMgr;
 
+  /** The context that the CNF respects */
+  context::Context* d_context;
+
   /** Boolean variables that we translated */
   context::CDList<TNode> d_booleanVariables;
 
+  typedef context::CDHashMap<Node, uint8_t, NodeHashFunction> PolarityMap;
+  /** The polarities the formulas were encoded in, when encoding by polarity */
+  PolarityMap d_polarities;
+
   /** Formulas that we translated that we are notifying */
   context::CDHashSet<Node, NodeHashFunction> d_notifyFormulas;
 
@@ -315,6 +391,70 @@ class CnfStream {
 
   /** Pointer to resource manager for associated SmtEngine */
   ResourceManager* d_resourceManager;
+
+  /**
+   * Returns true if the node, which is converted in the scope of an input
+   * assertion, can be given a persistent literal.  This is the case for atoms
+   * and for formulas whose children have persistent literals.
+   */
+  bool canPersist(TNode node) const;
+
+  /** A definition kept across user levels */
+  struct PersistentDefinition
+  {
+    /** The lowest user level the definition was used at since created */
+    int d_level;
+    /** The number of clauses of the definition */
+    size_t d_numClauses;
+  };
+
+  /** Whether formulas are encoded by polarity */
+  bool d_polarityEncoding;
+
+  /** Whether definitions are kept across user levels */
+  bool d_persistent;
+
+  /** Whether we are converting an input assertion with d_persistent */
+  bool d_persistentScope;
+
+  /** The nodes with persistent literals, atoms included */
+  std::unordered_map<Node, PersistentDefinition, NodeHashFunction>
+      d_persistentNodes;
+
+  /** The Boolean variables with persistent literals */
+  std::vector<TNode> d_persistentBooleanVariables;
+
+  /** The number of clauses asserted so far */
+  size_t d_numClauses;
+
+  /** The value of d_numClauses when the last definition got its literal */
+  size_t d_definitionStart;
+
+  /** Statistics of the CNF stream */
+  struct Statistics
+  {
+    /** Clauses asserted */
+    IntStat d_clauses;
+    /** Literals of the clauses asserted */
+    IntStat d_literals;
+    /** Subformulas used in a polarity they were not encoded in */
+    IntStat d_polarityUpgrades;
+    /** Definitions kept across user levels */
+    IntStat d_persistentDefinitions;
+    /** Clauses of the definitions kept across user levels */
+    IntStat d_persistentClauses;
+    /** Definitional clauses removed on pops, re-added if needed again */
+    IntStat d_scopedClauses;
+    /** Definitions used again after their user level was popped */
+    IntStat d_reusedDefinitions;
+    /** Clauses of the definitions used again, which were not re-added */
+    IntStat d_reusedClauses;
+    Statistics();
+    ~Statistics();
+  };
+
+  /** Set by registerStatistics() */
+  std::unique_ptr<Statistics> d_statistics;
 }; /* class CnfStream */
 
 }  // namespace prop
@@ -37,6 +37,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "proof/sat_proof_implementation.h"
 #include "prop/minisat/minisat.h"
 #include "prop/minisat/mtl/Sort.h"
+#include "prop/minisat/utils/System.h"
 #include "prop/theory_proxy.h"
 
 using namespace CVC4::prop;
@@ -158,7 +159,11 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy,
       assertionLevel(0),
       d_pfManager(nullptr),
       d_enable_incremental(enableIncremental),
-      minisat_busy(false)
+      clause_level_override(-1),
+      minisat_busy(false),
+      // probing derives units without recording their proofs
+      use_probing(options::minisatProbe() && !options::unsatCores() && !pnm),
+      probe_next(0)
       // Parameters (user settable):
       //
       ,
@@ -202,7 +207,9 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy,
       clauses_literals(0),
       learnts_literals(0),
       max_literals(0),
-      tot_literals(0)
+      tot_literals(0),
+      failed_literals(0),
+      probe_time(0)
 
       ,
       ok(true),
@@ -263,19 +270,44 @@ Solver::~Solver()
 //
 Var Solver::newVar(bool sign, bool dvar, bool isTheoryAtom, bool preRegister, bool canErase)
 {
-    int v = nVars();
-
-    watches  .init(mkLit(v, false));
-    watches  .init(mkLit(v, true ));
-    assigns  .push(l_Undef);
-    vardata  .push(VarData(CRef_Undef, -1, -1, assertionLevel, -1));
-    activity .push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
-    seen     .push(0);
-    polarity .push(sign);
-    decision .push();
-    trail    .capacity(v+1);
-    // push whether it corresponds to a theory atom
-    theory.push(isTheoryAtom);
+    int v;
+    if (free_vars.size() > 0)
+    {
+      // reuse the slot of a variable disabled by a pop
+      v = free_vars.last();
+      free_vars.pop();
+      reused_vars.push(VarIntroInfo(v, assertionLevel));
+      Assert(value(v) == l_Undef);
+      // the watches of its clauses are removed lazily
+      watches.clean(mkLit(v, false));
+      watches.clean(mkLit(v, true));
+      Assert(watches[mkLit(v, false)].size() == 0
+             && watches[mkLit(v, true)].size() == 0);
+      vardata[v] = VarData(CRef_Undef, -1, -1, assertionLevel, -1);
+      activity[v] = rnd_init_act ? drand(random_seed) * 0.00001 : 0;
+      if (order_heap.inHeap(v))
+      {
+        order_heap.update(v);
+      }
+      polarity[v] = sign;
+      theory[v] = isTheoryAtom;
+      Debug("minisat") << "reused var " << v << std::endl;
+    }
+    else
+    {
+      v = nVars();
+      watches  .init(mkLit(v, false));
+      watches  .init(mkLit(v, true ));
+      assigns  .push(l_Undef);
+      vardata  .push(VarData(CRef_Undef, -1, -1, assertionLevel, -1));
+      activity .push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
+      seen     .push(0);
+      polarity .push(sign);
+      decision .push();
+      trail    .capacity(v+1);
+      // push whether it corresponds to a theory atom
+      theory.push(isTheoryAtom);
+    }
 
     setDecisionVar(v, dvar);
 
@@ -292,6 +324,32 @@ Var Solver::newVar(bool sign, bool dvar, bool isTheoryAtom, bool preRegister, bo
     return v;
 }
 
+void Solver::makePersistent(Var v)
+{
+  Assert(d_enable_incremental);
+  Assert(!minisat_busy);
+  Assert(intro_level(v) == assertionLevel);
+  vardata[v].d_intro_level = 0;
+  // if the variable was registered, it must be registered again when the user
+  // level it was registered at is popped
+  if (variables_to_register.size() > 0
+      && variables_to_register.last().d_var == v)
+  {
+    persistent_to_register.push(VarIntroInfo(v, assertionLevel));
+  }
+}
+
+void Solver::freeVar(Var v)
+{
+  Assert(value(v) == l_Undef);
+  setDecisionVar(v, false);
+  theory[v] = false;
+  // like the persistent variable it lies below, a free slot is never removed
+  // by a pop
+  vardata[v].d_intro_level = 0;
+  free_vars.push(v);
+}
+
 void Solver::resizeVars(int newSize) {
   Assert(d_enable_incremental);
   Assert(decisionLevel() == 0);
@@ -311,6 +369,10 @@ void Solver::resizeVars(int newSize) {
     decision.shrink(shrinkSize);
     theory.shrink(shrinkSize);
   }
+  if (probe_next >= nVars())
+  {
+    probe_next = 0;
+  }
 
   if (Debug.isOn("minisat::pop")) {
     for (int i = 0; i < trail.size(); ++ i) {
@@ -503,6 +565,11 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
     // Fit to size
     ps.shrink(i - j);
 
+    if (clause_level_override >= 0)
+    {
+      clauseLevel = clause_level_override;
+    }
+
     // If we are in solve_ or propagate
     if (minisat_busy)
     {
@@ -515,6 +582,7 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
       lemmas.push();
       ps.copyTo(lemmas.last());
       lemmas_removable.push(removable);
+      lemmas_level.push(clause_level_override);
       if (options::unsatCores() && !isProofEnabled())
       {
         // Store the expression being converted to CNF until
@@ -1692,6 +1760,11 @@ lbool Solver::search(int nof_conflicts)
       // Analyze the conflict
       learnt_clause.clear();
       int max_level = analyze(confl, learnt_clause, backtrack_level);
+      // only share the clauses that do not depend on the push/pop scopes
+      if (max_level == 0 && d_proxy->isSharingClauses())
+      {
+        exportLearnt(learnt_clause);
+      }
       cancelUntil(backtrack_level);
 
       // Assert the conflict clause and the asserting literal
@@ -1797,6 +1870,18 @@ lbool Solver::search(int nof_conflicts)
         // [mdeters] notify theory engine of restarts for deferred
         // theory processing
         d_proxy->notifyRestart();
+        if (d_proxy->isSharingClauses())
+        {
+          importClauses();
+        }
+        if (use_probing && !probe())
+        {
+          return l_False;
+        }
+        if (!inprocess())
+        {
+          return l_False;
+        }
         return l_Undef;
       }
 
@@ -1899,6 +1984,100 @@ static double luby(double y, int x){
     return pow(y, seq);
 }
 
+void Solver::exportLearnt(const vec<Lit>& learnt)
+{
+  if (learnt.size() > static_cast<int>(options::shareClausesMaxSize()))
+  {
+    return;
+  }
+  // the number of distinct decision levels of the literals (LBD)
+  std::unordered_set<int> levels;
+  for (int i = 0; i < learnt.size(); ++i)
+  {
+    levels.insert(level(var(learnt[i])));
+  }
+  if (levels.size() > options::shareClausesMaxLbd())
+  {
+    return;
+  }
+  CVC4::prop::SatClause clause;
+  for (int i = 0; i < learnt.size(); ++i)
+  {
+    clause.push_back(MinisatSatSolver::toSatLiteral(learnt[i]));
+  }
+  d_proxy->exportClause(clause);
+}
+
+bool Solver::probe()
+{
+  Assert(decisionLevel() == 0);
+  double start = ::Minisat::cpuTime();
+  // propagate the level 0 assignments first
+  if (propagateBool() != CRef_Undef)
+  {
+    probe_time += ::Minisat::cpuTime() - start;
+    return ok = false;
+  }
+  // Probe both literals of up to the given number of unassigned decision
+  // variables. If propagating a literal by the clauses alone is conflicting,
+  // its negation holds at the current user level.
+  // variables may have been removed by a pop since the last round
+  if (probe_next >= nVars())
+  {
+    probe_next = 0;
+  }
+  int limit = std::min<int>(options::minisatProbeLimit(), nVars());
+  for (int i = 0; i < limit && withinBudget(ResourceManager::Resource::SatConflictStep); ++i)
+  {
+    Var v = probe_next;
+    probe_next = (probe_next + 1) % nVars();
+    if (!decision[v] || value(v) != l_Undef)
+    {
+      continue;
+    }
+    for (int s = 0; s < 2; ++s)
+    {
+      Lit p = mkLit(v, s == 1);
+      newDecisionLevel();
+      uncheckedEnqueue(p);
+      CRef confl = propagateBool();
+      cancelUntil(0);
+      if (confl != CRef_Undef)
+      {
+        Debug("minisat::probe") << "failed literal " << p << std::endl;
+        ++failed_literals;
+        uncheckedEnqueue(~p);
+        if (propagateBool() != CRef_Undef)
+        {
+          probe_time += ::Minisat::cpuTime() - start;
+          return ok = false;
+        }
+        break;
+      }
+    }
+  }
+  probe_time += ::Minisat::cpuTime() - start;
+  return true;
+}
+
+void Solver::importClauses()
+{
+  std::vector<CVC4::prop::SatClause> clauses;
+  d_proxy->importClauses(clauses);
+  for (const CVC4::prop::SatClause& clause : clauses)
+  {
+    vec<Lit> ps;
+    for (const CVC4::prop::SatLiteral& lit : clause)
+    {
+      ps.push(MinisatSatSolver::toMinisatLit(lit));
+    }
+    // while searching, the clauses are queued as lemmas, added on the next
+    // propagation
+    ClauseId id = ClauseIdUndef;
+    addClause(ps, true, id);
+  }
+}
+
 // NOTE: assumptions passed in member-variable 'assumptions'.
 lbool Solver::solve_()
 {
@@ -1929,6 +2108,11 @@ lbool Solver::solve_()
         printf("===============================================================================\n");
     }
 
+    if (use_probing && !probe())
+    {
+      status = l_False;
+    }
+
     // Search:
     int curr_restarts = 0;
     while (status == l_Undef){
@@ -2173,14 +2357,53 @@ void Solver::pop()
 
   Debug("minisat") << "MINISAT POP assertionLevel is " << assertionLevel
                    << ", trail.size is " << trail.size() << "\n";
-  // Pop the created variables
-  resizeVars(assigns_lim.last());
+  // Pop the created variables. The persistent variables are kept, and the
+  // variables created before them are disabled instead of removed, and their
+  // slots are reused by the next variables created. The reused slots lie
+  // below the variables of this level, and are freed again here.
+  while (reused_vars.size() > 0 && reused_vars.last().d_level > assertionLevel)
+  {
+    Var v = reused_vars.last().d_var;
+    reused_vars.pop();
+    if (intro_level(v) > assertionLevel)
+    {
+      freeVar(v);
+    }
+  }
+  int newSize = assigns_lim.last();
+  int keptSize = newSize;
+  for (Var v = newSize; v < nVars(); ++v)
+  {
+    if (intro_level(v) <= assertionLevel)
+    {
+      keptSize = v + 1;
+    }
+  }
+  for (Var v = newSize; v < keptSize; ++v)
+  {
+    if (intro_level(v) > assertionLevel)
+    {
+      freeVar(v);
+    }
+  }
+  resizeVars(keptSize);
   assigns_lim.pop();
   variables_to_register.clear();
 
   // Pop the OK
   ok = trail_ok.last();
   trail_ok.pop();
+
+  // Register again the persistent variables whose registration was popped
+  for (int i = 0; i < persistent_to_register.size(); ++i)
+  {
+    if (persistent_to_register[i].d_level > assertionLevel)
+    {
+      persistent_to_register[i].d_level = assertionLevel;
+      d_proxy->variableNotify(
+          MinisatSatSolver::toSatVariable(persistent_to_register[i].d_var));
+    }
+  }
 }
 
 CRef Solver::updateLemmas() {
@@ -2268,6 +2491,10 @@ CRef Solver::updateLemmas() {
           clauseLevel = std::max(clauseLevel, intro_level(var(lemma[k])));
         }
       }
+      if (lemmas_level[j] >= 0)
+      {
+        clauseLevel = lemmas_level[j];
+      }
 
       lemma_ref = ca.alloc(clauseLevel, lemma, removable);
       if (options::unsatCores() && !isProofEnabled())
@@ -2286,6 +2513,10 @@ CRef Solver::updateLemmas() {
         clauses_persistent.push(lemma_ref);
       }
       attachClause(lemma_ref);
+      if (!removable)
+      {
+        persistentLemmaAdded(lemma_ref);
+      }
     }
 
     // If the lemma is propagating enqueue its literal (or set the conflict)
@@ -2335,6 +2566,7 @@ CRef Solver::updateLemmas() {
   lemmas.clear();
   lemmas_cnf_assertion.clear();
   lemmas_removable.clear();
+  lemmas_level.clear();
 
   if (conflict != CRef_Undef) {
     theoryConflict = true;
@@ -105,6 +105,19 @@ public:
   /** Is the lemma removable */
   vec<bool> lemmas_removable;
 
+  /**
+   * The user level of the lemma, or -1 if it is computed when the lemma is
+   * added
+   */
+  vec<int> lemmas_level;
+
+  /**
+   * If not -1, the user level of the clauses added instead of the current one,
+   * e.g. for the clauses of a variable eliminated at user level zero and used
+   * again at a higher level
+   */
+  int clause_level_override;
+
   /** Nodes being converted to CNF */
   std::vector<CVC4::Node> lemmas_cnf_assertion;
 
@@ -125,11 +138,38 @@ public:
     VarIntroInfo(Var var, int level) : d_var(var), d_level(level) {}
   };
 
+  /** Whether to probe for failed literals before the search and at restarts */
+  bool use_probing;
+
+  /** The variable to probe next, probing goes round-robin over the variables */
+  Var probe_next;
+
   /** Variables to re-register with theory solvers on backtracks */
   vec<VarIntroInfo> variables_to_register;
 
+  /**
+   * Persistent variables to re-register with theory solvers on user pops,
+   * with the user level they were last registered at
+   */
+  vec<VarIntroInfo> persistent_to_register;
+
+  /**
+   * The scoped variables disabled by a pop because a persistent variable was
+   * created after them, whose slots are reused by newVar
+   */
+  vec<Var> free_vars;
+
+  /**
+   * The slots of free_vars reused by newVar, with the user level they were
+   * reused at, to be freed again when that level is popped
+   */
+  vec<VarIntroInfo> reused_vars;
+
+  /** Disable v, which must be unassigned and in no clause, and free its slot */
+  virtual void freeVar(Var v);
+
   /** Keep only newSize variables */
-  void resizeVars(int newSize);
+  virtual void resizeVars(int newSize);
 
 public:
 
@@ -150,6 +190,13 @@ public:
             bool preRegister = false,
             bool canErase = true);  // Add a new variable with parameters
                                     // specifying variable mode.
+ /**
+  * Keep variable v, created at the current user level outside of the search,
+  * when that level is popped (see CnfStream::enablePersistentDefinitions).
+  * The clauses over persistent variables added as removable are kept at level
+  * zero, and v is registered again with the theories on pops if needed.
+  */
+ void makePersistent(Var v);
  Var trueVar() const { return varTrue; }
  Var falseVar() const { return varFalse; }
 
@@ -310,6 +357,8 @@ public:
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, resources_consumed;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t failed_literals;  // Literals found false by probing
+    double   probe_time;       // Time spent probing, in seconds
 
 protected:
 
@@ -440,6 +489,11 @@ protected:
     void     propagateTheory  ();                                                      // Perform Theory propagation.
     void     theoryCheck      (CVC4::theory::Theory::Effort effort);                   // Perform a theory satisfiability check. Adds lemmas.
     CRef     updateLemmas     ();                                                      // Add the lemmas, backtraking if necessary and return a conflict if there is one
+    void     exportLearnt     (const vec<Lit>& learnt);                                // Share a learnt clause if it is short and has few decision levels
+    void     importClauses    ();                                                      // Add the clauses shared by the other solvers as lemmas
+    bool     probe            ();                                                      // Failed literal probing at level 0. Returns false on conflict
+    virtual bool inprocess    () { return true; }                                      // Simplify the clauses at a restart, at level 0. Returns false on conflict
+    virtual void persistentLemmaAdded(CRef cr) {}                                      // Called when a non-removable lemma is attached during the search
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
     int      analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
@@ -462,7 +516,7 @@ protected:
     //
     void     attachClause     (CRef cr);               // Attach a clause to watcher lists.
     void     detachClause     (CRef cr, bool strict = false); // Detach a clause to watcher lists.
-    void     removeClause     (CRef cr);               // Detach and free a clause.
+    virtual void removeClause (CRef cr);               // Detach and free a clause.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 
@@ -169,6 +169,11 @@ SatVariable MinisatSatSolver::newVar(bool isTheoryAtom, bool preRegister, bool c
   return d_minisat->newVar(true, true, isTheoryAtom, preRegister, canErase);
 }
 
+void MinisatSatSolver::makePersistent(SatVariable var)
+{
+  d_minisat->makePersistent(var);
+}
+
 SatValue MinisatSatSolver::solve(unsigned long& resource) {
   Trace("limit") << "SatSolver::solve(): have limit of " << resource << " conflicts" << std::endl;
   setupOptions();
@@ -263,7 +268,12 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
     d_statClausesLiterals("sat::clauses_literals"),
     d_statLearntsLiterals("sat::learnts_literals"),
     d_statMaxLiterals("sat::max_literals"),
-    d_statTotLiterals("sat::tot_literals")
+    d_statTotLiterals("sat::tot_literals"),
+    d_statFailedLiterals("sat::failed_literals"),
+    d_statEliminatedVars("sat::eliminated_vars"),
+    d_statRestoredVars("sat::restored_vars"),
+    d_statSimpTime("sat::simp_time"),
+    d_statProbeTime("sat::probe_time")
 {
   d_registry->registerStat(&d_statStarts);
   d_registry->registerStat(&d_statDecisions);
@@ -274,6 +284,11 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
   d_registry->registerStat(&d_statLearntsLiterals);
   d_registry->registerStat(&d_statMaxLiterals);
   d_registry->registerStat(&d_statTotLiterals);
+  d_registry->registerStat(&d_statFailedLiterals);
+  d_registry->registerStat(&d_statEliminatedVars);
+  d_registry->registerStat(&d_statRestoredVars);
+  d_registry->registerStat(&d_statSimpTime);
+  d_registry->registerStat(&d_statProbeTime);
 }
 
 MinisatSatSolver::Statistics::~Statistics() {
@@ -286,6 +301,11 @@ MinisatSatSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_statLearntsLiterals);
   d_registry->unregisterStat(&d_statMaxLiterals);
   d_registry->unregisterStat(&d_statTotLiterals);
+  d_registry->unregisterStat(&d_statFailedLiterals);
+  d_registry->unregisterStat(&d_statEliminatedVars);
+  d_registry->unregisterStat(&d_statRestoredVars);
+  d_registry->unregisterStat(&d_statSimpTime);
+  d_registry->unregisterStat(&d_statProbeTime);
 }
 
 void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* minisat){
@@ -298,6 +318,11 @@ void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* minisat){
   d_statLearntsLiterals.setData(minisat->learnts_literals);
   d_statMaxLiterals.setData(minisat->max_literals);
   d_statTotLiterals.setData(minisat->tot_literals);
+  d_statFailedLiterals.setData(minisat->failed_literals);
+  d_statEliminatedVars.setData(minisat->eliminated_vars);
+  d_statRestoredVars.setData(minisat->restored_vars);
+  d_statSimpTime.setData(minisat->simp_time);
+  d_statProbeTime.setData(minisat->probe_time);
 }
 
 } /* namespace CVC4::prop */
@@ -52,6 +52,7 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
   SatVariable newVar(bool isTheoryAtom,
                      bool preRegister,
                      bool canErase) override;
+  void makePersistent(SatVariable var) override;
   SatVariable trueVar() override { return d_minisat->trueVar(); }
   SatVariable falseVar() override { return d_minisat->falseVar(); }
 
@@ -108,7 +109,10 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
     ReferenceStat<uint64_t> d_statRndDecisions, d_statPropagations;
     ReferenceStat<uint64_t> d_statConflicts, d_statClausesLiterals;
     ReferenceStat<uint64_t> d_statLearntsLiterals,  d_statMaxLiterals;
-    ReferenceStat<uint64_t> d_statTotLiterals;
+    ReferenceStat<uint64_t> d_statTotLiterals, d_statFailedLiterals;
+    ReferenceStat<int> d_statEliminatedVars;
+    ReferenceStat<int> d_statRestoredVars;
+    ReferenceStat<double> d_statSimpTime, d_statProbeTime;
   public:
     Statistics(StatisticsRegistry* registry);
     ~Statistics();
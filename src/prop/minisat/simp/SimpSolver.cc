@@ -21,6 +21,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "prop/minisat/simp/SimpSolver.h"
 
 #include "base/check.h"
+#include "options/decision_options.h"
 #include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/clause_id.h"
@@ -61,26 +62,29 @@ SimpSolver::SimpSolver(CVC4::prop::TheoryProxy* proxy,
       use_asymm(opt_use_asymm),
       // make sure this is not enabled if unsat cores or proofs are on
       use_rcheck(opt_use_rcheck && !options::unsatCores() && !pnm),
-      use_elim(options::minisatUseElim() && !enableIncremental),
+      use_elim(options::minisatUseElim()),
       merges(0),
       asymm_lits(0),
       eliminated_vars(0),
+      restored_vars(0),
+      simp_time(0),
       elimorder(1),
-      use_simplification(!enableIncremental && !options::unsatCores()
-                         && !pnm)  // TODO: turn off simplifications if
-                                   // proofs are on initially
+      // In incremental mode, the simplifications are done at user level zero
+      // only, and eliminated variables are restored when they are used again.
+      // There they are off unless asked for.  The decision engine may decide
+      // on any variable, so they need the internal decision strategy.
+      use_simplification(
+          !options::unsatCores() && !pnm
+          && options::decisionMode() == options::DecisionMode::INTERNAL
+          && (!options::incrementalSolving()
+              || options::minisatElimIncremental()))
       ,
       occurs(ClauseDeleted(ca)),
       elim_heap(ElimLt(n_occ)),
       bwdsub_assigns(0),
-      n_touched(0)
+      n_touched(0),
+      restarts_since_simp(0)
 {
-    if(options::minisatUseElim() &&
-       options::minisatUseElim.wasSetByUser() &&
-       enableIncremental) {
-        WarningOnce() << "Incremental mode incompatible with --minisat-elim" << std::endl;
-    }
-
     vec<Lit> dummy(1,lit_Undef);
     ca.extra_clause_field = true; // NOTE: must happen before allocating the dummy clause below.
     bwdsub_tmpunit        = ca.alloc(0, dummy);
@@ -90,6 +94,7 @@ SimpSolver::SimpSolver(CVC4::prop::TheoryProxy* proxy,
     for (int i = frozen.size(); i < vardata.size(); ++ i) {
       frozen    .push(1);
       eliminated.push(0);
+      restore_start.push(-1);
       if (use_simplification){
           n_occ     .push(0);
           n_occ     .push(0);
@@ -109,9 +114,21 @@ SimpSolver::~SimpSolver()
 Var SimpSolver::newVar(bool sign, bool dvar, bool isTheoryAtom, bool preRegister, bool canErase) {
     Var v = Solver::newVar(sign, dvar, isTheoryAtom, preRegister, canErase);
 
-    if (use_simplification){
-        frozen    .push((char)(!canErase));
+    if (use_simplification && v < frozen.size()){
+        // the reused slot of a variable freed by a pop, which is in no clause
+        Assert(n_occ[toInt(mkLit(v))] == 0 && n_occ[toInt(~mkLit(v))] == 0);
+        frozen    [v] = (char)(!canErase || isTheoryAtom);
+        eliminated[v] = (char)false;
+        restore_start[v] = -1;
+        touched   [v] = 0;
+        if (!elim_heap.inHeap(v)) elim_heap.insert(v);
+    }
+    else if (use_simplification){
+        // theory atoms are asserted to the theories and must never be
+        // eliminated, whatever the caller claims
+        frozen    .push((char)(!canErase || isTheoryAtom));
         eliminated.push((char)false);
+        restore_start.push(-1);
         n_occ     .push(0);
         n_occ     .push(0);
         occurs    .init(v);
@@ -133,23 +150,33 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
     vec<Var> extra_frozen;
     lbool    result = l_True;
 
-    do_simp &= use_simplification;
+    // The clauses of user levels above zero are removed by pops, they must
+    // not replace the clauses of level zero
+    do_simp &= use_simplification && assertionLevel == 0;
 
-    if (do_simp){
-        // Assumptions must be temporarily frozen to run variable elimination:
+    if (use_simplification){
+        // Assumptions must be temporarily frozen to run variable elimination,
+        // before the search and at restarts:
         for (int i = 0; i < assumptions.size(); i++){
             Var v = var(assumptions[i]);
 
-            // If an assumption has been eliminated, remember it.
-            Assert(!isEliminated(v));
+            // An assumption eliminated by an earlier call is used again
+            if (isEliminated(v))
+                restoreVar(v);
 
             if (!frozen[v]){
                 // Freeze and store.
                 setFrozen(v, true);
                 extra_frozen.push(v);
             } }
+        if (!ok)
+            result = l_False;
+    }
 
+    if (do_simp && result == l_True){
+        double start = ::Minisat::cpuTime();
         result = lbool(eliminate(turn_off_simp));
+        simp_time += ::Minisat::cpuTime() - start;
     }
 
     if (result == l_True)
@@ -160,10 +187,9 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
     if (result == l_True)
         extendModel();
 
-    if (do_simp)
-        // Unfreeze the assumptions that were frozen:
-        for (int i = 0; i < extra_frozen.size(); i++)
-            setFrozen(extra_frozen[i], false);
+    // Unfreeze the assumptions that were frozen:
+    for (int i = 0; i < extra_frozen.size(); i++)
+        setFrozen(extra_frozen[i], false);
 
     return result;
 }
@@ -172,11 +198,14 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
 
 bool SimpSolver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
 {
-#ifdef CVC4_ASSERTIONS
-    if (use_simplification) {
-      for (int i = 0; i < ps.size(); i++) Assert(!isEliminated(var(ps[i])));
+    if (use_simplification && ok) {
+      // A clause over an eliminated variable (e.g. a lemma reusing a Tseitin
+      // variable, or a clause added after a pop) needs the clauses of that
+      // variable again.
+      for (int i = 0; i < ps.size(); i++)
+        if (isEliminated(var(ps[i])))
+          restoreVar(var(ps[i]));
     }
-#endif
 
     int nclauses = clauses_persistent.size();
 
@@ -186,37 +215,51 @@ bool SimpSolver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
     if (!Solver::addClause_(ps, removable, id))
         return false;
 
-    if (use_simplification && clauses_persistent.size() == nclauses + 1){
-        CRef          cr = clauses_persistent.last();
-        const Clause& c  = ca[cr];
-
-        // NOTE: the clause is added to the queue immediately and then
-        // again during 'gatherTouchedClauses()'. If nothing happens
-        // in between, it will only be checked once. Otherwise, it may
-        // be checked twice unnecessarily. This is an unfortunate
-        // consequence of how backward subsumption is used to mimic
-        // forward subsumption.
-        subsumption_queue.insert(cr);
-        for (int i = 0; i < c.size(); i++){
-            occurs[var(c[i])].push(cr);
-            n_occ[toInt(c[i])]++;
-            touched[var(c[i])] = 1;
-            n_touched++;
-            if (elim_heap.inHeap(var(c[i])))
-                elim_heap.increase(var(c[i]));
-        }
-    }
+    if (use_simplification && clauses_persistent.size() == nclauses + 1)
+        registerClause(clauses_persistent.last());
 
     return true;
 }
 
 
+void SimpSolver::registerClause(CRef cr)
+{
+    const Clause& c = ca[cr];
+    Assert(!c.removable());
+
+    // NOTE: the clause is added to the queue immediately and then
+    // again during 'gatherTouchedClauses()'. If nothing happens
+    // in between, it will only be checked once. Otherwise, it may
+    // be checked twice unnecessarily. This is an unfortunate
+    // consequence of how backward subsumption is used to mimic
+    // forward subsumption.
+    subsumption_queue.insert(cr);
+    for (int i = 0; i < c.size(); i++){
+        occurs[var(c[i])].push(cr);
+        n_occ[toInt(c[i])]++;
+        touched[var(c[i])] = 1;
+        n_touched++;
+        if (elim_heap.inHeap(var(c[i])))
+            elim_heap.increase(var(c[i]));
+    }
+}
+
+
+void SimpSolver::persistentLemmaAdded(CRef cr)
+{
+    if (use_simplification)
+        registerClause(cr);
+}
+
+
 void SimpSolver::removeClause(CRef cr)
 {
     const Clause& c = ca[cr];
     Debug("minisat") << "SimpSolver::removeClause(" << c << ")" << std::endl;
 
-    if (use_simplification)
+    // only the problem clauses and the non-removable lemmas are in the
+    // occurrence lists
+    if (use_simplification && !c.removable())
         for (int i = 0; i < c.size(); i++){
             n_occ[toInt(c[i])]--;
             updateElimHeap(var(c[i]));
@@ -551,6 +594,17 @@ bool SimpSolver::eliminateVar(Var v)
               || (clause_lim != -1 && clause_size > clause_lim)))
         return true;
 
+  // Keep all the clauses of v, in case v is used again:
+  restore_start[v] = restore_clauses.size();
+  restore_clauses.push(decision[v]);
+  restore_clauses.push(cls.size());
+  for (int i = 0; i < cls.size(); i++)
+  {
+    const Clause& c = ca[cls[i]];
+    restore_clauses.push(c.size());
+    for (int j = 0; j < c.size(); j++) restore_clauses.push(toInt(c[j]));
+  }
+
   // Delete and store old clauses:
   eliminated[v] = true;
   setDecisionVar(v, false);
@@ -630,6 +684,140 @@ bool SimpSolver::substitute(Var v, Lit x)
 }
 
 
+void SimpSolver::restoreVar(Var v)
+{
+  Assert(use_simplification);
+  Assert(isEliminated(v));
+  Assert(restore_start[v] >= 0);
+  Debug("minisat::elim") << "restoring eliminated variable " << v << std::endl;
+
+  eliminated[v] = false;
+  // don't eliminate it again, it may be used again
+  frozen[v] = true;
+  restored_vars++;
+  removeElimClauses(v);
+
+  int pos = restore_start[v];
+  restore_start[v] = -1;
+  setDecisionVar(v, restore_clauses[pos] != 0);
+  int nclauses = restore_clauses[pos + 1];
+  pos += 2;
+
+  // The clauses were at user level zero, and stay there whatever the current
+  // level is. The ones over other eliminated variables restore them in turn.
+  int saved_level = clause_level_override;
+  clause_level_override = 0;
+  vec<Lit> c;
+  for (int i = 0; i < nclauses && ok; i++)
+  {
+    int size = restore_clauses[pos++];
+    c.clear();
+    for (int j = 0; j < size; j++) c.push(toLit(restore_clauses[pos++]));
+    ClauseId id = ClauseIdUndef;
+    addClause_(c, false, id);
+  }
+  clause_level_override = saved_level;
+}
+
+
+void SimpSolver::removeElimClauses(Var v)
+{
+  // The chunks of 'elimclauses' are stored as the literals followed by their
+  // number, the literal of the eliminated variable first. Find the chunks
+  // from the last one, and keep those not of v.
+  vec<int> ends;
+  for (int i = elimclauses.size() - 1; i > 0; i -= elimclauses[i] + 1)
+    ends.push(i);
+
+  int j = 0;
+  for (int k = ends.size() - 1; k >= 0; k--)
+  {
+    int end = ends[k];
+    int start = end - elimclauses[end];
+    if (var(toLit(elimclauses[start])) == v) continue;
+    for (int i = start; i <= end; i++) elimclauses[j++] = elimclauses[i];
+  }
+  elimclauses.shrink(elimclauses.size() - j);
+}
+
+
+void SimpSolver::removeEliminatedLearnts()
+{
+  int i, j;
+  for (i = j = 0; i < clauses_removable.size(); i++)
+  {
+    const Clause& c = ca[clauses_removable[i]];
+    bool elim = false;
+    for (int k = 0; k < c.size() && !elim; k++) elim = isEliminated(var(c[k]));
+    if (elim)
+    {
+      Assert(!locked(c));
+      removeClause(clauses_removable[i]);
+    }
+    else
+    {
+      clauses_removable[j++] = clauses_removable[i];
+    }
+  }
+  clauses_removable.shrink(i - j);
+}
+
+
+bool SimpSolver::inprocess()
+{
+  // the lemmas not added yet may be over variables about to be eliminated
+  if (!use_simplification || assertionLevel > 0 || lemmas.size() > 0
+      || options::minisatElimRestarts() == 0
+      || ++restarts_since_simp < options::minisatElimRestarts())
+  {
+    return true;
+  }
+  restarts_since_simp = 0;
+  Assert(decisionLevel() == 0);
+
+  // at level 0 the clauses found are added directly, not as lemmas
+  bool busy = minisat_busy;
+  minisat_busy = false;
+  double start = ::Minisat::cpuTime();
+  bool res = eliminate();
+  simp_time += ::Minisat::cpuTime() - start;
+  minisat_busy = busy;
+  return res;
+}
+
+
+void SimpSolver::freeVar(Var v)
+{
+  Solver::freeVar(v);
+  // a free slot must not be eliminated, its elimination clauses would assign
+  // the variable reusing it when extending the model
+  if (use_simplification) frozen[v] = 1;
+}
+
+
+void SimpSolver::resizeVars(int newSize)
+{
+  Solver::resizeVars(newSize);
+  if (!use_simplification || frozen.size() <= nVars()) return;
+
+  // The clauses of the removed variables were removed already
+  int shrinkSize = frozen.size() - nVars();
+  frozen       .shrink(shrinkSize);
+  eliminated   .shrink(shrinkSize);
+  restore_start.shrink(shrinkSize);
+  touched      .shrink(shrinkSize);
+  n_occ        .shrink(2 * shrinkSize);
+  occurs       .resizeTo(nVars() - 1);
+
+  vec<Var> vs;
+  for (int i = 0; i < elim_heap.size(); i++)
+    if (elim_heap[i] < nVars()) vs.push(elim_heap[i]);
+  elim_heap.build(vs);
+
+  bwdsub_assigns = std::min(bwdsub_assigns, trail.size());
+}
+
+
 void SimpSolver::extendModel()
 {
     int i, j;
@@ -654,6 +842,8 @@ bool SimpSolver::eliminate(bool turn_off_elim)
     else if (!use_simplification)
         return true;
 
+    int eliminated_before = eliminated_vars;
+
     // Main simplification loop:
     //
     while (n_touched > 0 || bwdsub_assigns < trail.size() || elim_heap.size() > 0){
@@ -682,7 +872,10 @@ bool SimpSolver::eliminate(bool turn_off_elim)
 
             if (asynch_interrupt) break;
 
-            if (isEliminated(elim) || value(elim) != l_Undef) continue;
+            // variables created above user level zero are removed by pops
+            if (isEliminated(elim) || value(elim) != l_Undef
+                || intro_level(elim) > 0)
+              continue;
 
             if (verbosity >= 2 && cnt % 100 == 0)
                 printf("elimination left: %10d\r", elim_heap.size());
@@ -707,6 +900,10 @@ bool SimpSolver::eliminate(bool turn_off_elim)
     }
  cleanup:
 
+    // Learnt clauses may be over the variables just eliminated
+    if (eliminated_vars > eliminated_before)
+        removeEliminatedLearnts();
+
     // If no more simplification is needed, free all simplification-related data structures:
     if (turn_off_elim){
         touched  .clear(true);
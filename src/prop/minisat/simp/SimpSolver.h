@@ -127,6 +127,8 @@ class SimpSolver : public Solver {
     int     merges;
     int     asymm_lits;
     int     eliminated_vars;
+    int     restored_vars;     // Eliminated variables used again by a new clause or assumption
+    double  simp_time;         // Time spent in variable elimination and subsumption, in seconds
 
  protected:
 
@@ -171,6 +173,9 @@ class SimpSolver : public Solver {
     vec<char>           eliminated;
     int                 bwdsub_assigns;
     int                 n_touched;
+    vec<uint32_t>       restore_clauses;    // All the clauses of the eliminated variables, to add them again (see 'restoreVar()')
+    vec<int>            restore_start;      // Where the clauses of each eliminated variable start in 'restore_clauses'
+    unsigned            restarts_since_simp;
 
     // Temporaries:
     //
@@ -189,7 +194,15 @@ class SimpSolver : public Solver {
     bool          eliminateVar             (Var v);
     void          extendModel              ();
 
-    void          removeClause             (CRef cr);
+    void          removeClause             (CRef cr) override;
+    void          registerClause           (CRef cr);
+    void          restoreVar               (Var v);
+    void          removeElimClauses        (Var v);
+    void          removeEliminatedLearnts  ();
+    bool          inprocess                () override;
+    void          persistentLemmaAdded     (CRef cr) override;
+    void          freeVar                  (Var v) override;
+    void          resizeVars               (int newSize) override;
     bool          strengthenClause         (CRef cr, Lit l);
     void          cleanUpClauses           ();
     bool          implied                  (const vec<Lit>& c);
@@ -27,6 +27,7 @@
 #include "options/decision_options.h"
 #include "options/main_options.h"
 #include "options/options.h"
+#include "options/prop_options.h"
 #include "options/proof_options.h"
 #include "options/smt_options.h"
 #include "proof/proof_manager.h"
@@ -105,6 +106,15 @@ PropEngine::PropEngine(TheoryEngine* te,
                               &d_outMgr,
                               rm,
                               FormulaLitPolicy::TRACK);
+  d_cnfStream->registerStatistics();
+  if (options::incrementalCnf())
+  {
+    d_cnfStream->enablePersistentDefinitions();
+  }
+  if (options::cnfPolarity())
+  {
+    d_cnfStream->enablePolarityEncoding();
+  }
 
   // connect theory proxy
   d_theoryProxy->finishInit(d_cnfStream);
@@ -62,6 +62,17 @@ public:
    */
   virtual SatVariable newVar(bool isTheoryAtom, bool preRegister, bool canErase) = 0;
 
+  /**
+   * Keep the given variable, and the clauses over persistent variables that
+   * are added as removable, when the user level it was created at is popped.
+   * The variable must have been created at the current user level, outside
+   * of the search.
+   */
+  virtual void makePersistent(SatVariable var)
+  {
+    Unimplemented() << "Persistent variables not implemented";
+  }
+
   /** Create a new (or return an existing) boolean variable representing the constant true */
   virtual SatVariable trueVar() = 0;
 
@@ -19,6 +19,7 @@
 #include "context/context.h"
 #include "decision/decision_engine.h"
 #include "options/decision_options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/cnf_proof.h"
 #include "prop/cnf_stream.h"
@@ -42,12 +43,30 @@ TheoryProxy::TheoryProxy(PropEngine* propEngine,
       d_decisionEngine(decisionEngine),
       d_theoryEngine(theoryEngine),
       d_queue(context),
-      d_tpp(*theoryEngine, userContext, pnm)
+      d_tpp(*theoryEngine, userContext, pnm),
+      d_exchangeId(0),
+      d_exported("prop::sharing::exported", 0),
+      d_imported("prop::sharing::imported", 0),
+      d_dropped("prop::sharing::dropped", 0)
 {
+  if (!options::shareClauses().empty())
+  {
+    d_exchange = ClauseExchange::get(options::shareClauses());
+    d_exchangeId = d_exchange->registerParticipant();
+    smtStatisticsRegistry()->registerStat(&d_exported);
+    smtStatisticsRegistry()->registerStat(&d_imported);
+    smtStatisticsRegistry()->registerStat(&d_dropped);
+  }
 }
 
 TheoryProxy::~TheoryProxy() {
-  /* nothing to do for now */
+  if (d_exchange != nullptr)
+  {
+    d_exchange->unregisterParticipant(d_exchangeId);
+    smtStatisticsRegistry()->unregisterStat(&d_exported);
+    smtStatisticsRegistry()->unregisterStat(&d_imported);
+    smtStatisticsRegistry()->unregisterStat(&d_dropped);
+  }
 }
 
 void TheoryProxy::finishInit(CnfStream* cnfStream) { d_cnfStream = cnfStream; }
@@ -151,6 +170,56 @@ void TheoryProxy::notifyRestart() {
   d_theoryEngine->notifyRestart();
 }
 
+void TheoryProxy::exportClause(const SatClause& clause)
+{
+  Assert(d_exchange != nullptr);
+  const CnfStream::LiteralToNodeMap& nodes = d_cnfStream->getNodeCache();
+  ClauseExchange::Clause c;
+  for (const SatLiteral& lit : clause)
+  {
+    CnfStream::LiteralToNodeMap::const_iterator it = nodes.find(lit);
+    if (it == nodes.end())
+    {
+      return;
+    }
+    c.push_back((*it).second);
+  }
+  Trace("prop-share") << "TheoryProxy::exportClause: " << c << std::endl;
+  d_exchange->exportClause(d_exchangeId, c);
+  ++d_exported;
+}
+
+void TheoryProxy::importClauses(std::vector<SatClause>& clauses)
+{
+  Assert(d_exchange != nullptr);
+  std::vector<ClauseExchange::Clause> imported;
+  d_exchange->importClauses(d_exchangeId, imported);
+  for (const ClauseExchange::Clause& c : imported)
+  {
+    SatClause clause;
+    for (const Node& n : c)
+    {
+      bool negated = n.getKind() == kind::NOT;
+      TNode atom = negated ? n[0] : n;
+      if (!d_cnfStream->hasLiteral(atom))
+      {
+        break;
+      }
+      SatLiteral lit = d_cnfStream->getLiteral(atom);
+      clause.push_back(negated ? ~lit : lit);
+    }
+    if (clause.size() < c.size())
+    {
+      // an atom that we have not seen, e.g. of a lemma
+      ++d_dropped;
+      continue;
+    }
+    Trace("prop-share") << "TheoryProxy::importClauses: " << c << std::endl;
+    clauses.push_back(clause);
+    ++d_imported;
+  }
+}
+
 void TheoryProxy::spendResource(ResourceManager::Resource r)
 {
   d_theoryEngine->spendResource(r);
@@ -23,16 +23,20 @@
 // Optional blocks below will be unconditionally included
 #define CVC4_USE_MINISAT
 
+#include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "context/cdqueue.h"
 #include "expr/node.h"
+#include "prop/clause_exchange.h"
 #include "prop/registrar.h"
 #include "prop/sat_solver_types.h"
 #include "theory/theory.h"
 #include "theory/theory_preprocessor.h"
 #include "theory/trust_node.h"
 #include "util/resource_manager.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 
@@ -85,6 +89,21 @@ class TheoryProxy : public Registrar
 
   void notifyRestart();
 
+  /** Return true if learned clauses are shared, see ClauseExchange. */
+  bool isSharingClauses() const { return d_exchange != nullptr; }
+
+  /**
+   * Export a learned clause to the other solvers sharing clauses.  The clause
+   * must only depend on the assertions at user level 0.
+   */
+  void exportClause(const SatClause& clause);
+
+  /**
+   * Add to clauses the clauses exported by the other solvers sharing clauses.
+   * Clauses over atoms without literals here are dropped.
+   */
+  void importClauses(std::vector<SatClause>& clauses);
+
   void spendResource(ResourceManager::Resource r);
 
   bool isDecisionEngineDone();
@@ -153,6 +172,17 @@ class TheoryProxy : public Registrar
 
   /** The theory preprocessor */
   theory::TheoryPreprocessor d_tpp;
+
+  /** The exchange of learned clauses, if clauses are shared */
+  std::shared_ptr<ClauseExchange> d_exchange;
+  /** Our identifier in the exchange */
+  size_t d_exchangeId;
+  /** The number of exported clauses */
+  IntStat d_exported;
+  /** The number of imported clauses */
+  IntStat d_imported;
+  /** The number of clauses dropped on import */
+  IntStat d_dropped;
 }; /* class TheoryProxy */
 
 }/* CVC4::prop namespace */
@@ -19,6 +19,7 @@
 #include "expr/node.h"
 #include "expr/term_conversion_proof_generator.h"
 #include "options/base_options.h"
+#include "options/smt_options.h"
 #include "printer/printer.h"
 #include "smt/dump_manager.h"
 #include "smt/smt_engine_stats.h"
@@ -29,9 +30,29 @@ using namespace CVC4::smt;
 
 namespace CVC4 {
 
-Env::Env(NodeManager* nm)
-    : d_context(new context::Context()),
-      d_userContext(new context::UserContext()),
+namespace {
+
+/**
+ * Returns the memory configuration of the contexts given by the options
+ * optr, or the default one if optr is null.
+ */
+context::ContextMemoryManager::Config mkContextConfig(const Options* optr)
+{
+  context::ContextMemoryManager::Config config;
+  if (optr != nullptr)
+  {
+    config.d_chunkSizeBytes = (*optr)[options::contextChunkSize];
+    config.d_maxFreeChunks = (*optr)[options::contextMaxFreeChunks];
+    config.d_hugePages = (*optr)[options::contextHugePages];
+  }
+  return config;
+}
+
+}  // namespace
+
+Env::Env(NodeManager* nm, const Options* optr)
+    : d_context(new context::Context(mkContextConfig(optr))),
+      d_userContext(new context::UserContext(mkContextConfig(optr))),
       d_nodeManager(nm),
       d_proofNodeManager(nullptr),
       d_rewriter(new theory::Rewriter()),
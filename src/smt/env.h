@@ -58,9 +58,10 @@ class Env
 
  public:
   /**
-   * Construct an Env with the given node manager.
+   * Construct an Env with the given node manager. The memory of its contexts
+   * is configured by the context options of optr, if non-null.
    */
-  Env(NodeManager* nm);
+  Env(NodeManager* nm, const Options* optr);
   /** Destruct the env.  */
   ~Env();
 
@@ -96,6 +96,11 @@ bool Preprocessor::process(Assertions& as)
   // mark that we've processed assertions
   d_assertionsProcessed = true;
 
+  if (d_ppContext->getProfiler() != nullptr)
+  {
+    d_ppContext->getProfiler()->endRound();
+  }
+
   return noConflict;
 }
 
@@ -775,7 +775,10 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
   if (!options::arithStandardCheckVarOrderPivots.wasSetByUser())
   {
     int16_t varOrderPivots = -1;
-    if (logic.isPure(THEORY_ARITH) && !logic.isQuantified())
+    // the double precision simplex only runs once the pivot limited pass of
+    // the exact simplex gives up, so it needs a limit
+    if ((logic.isPure(THEORY_ARITH) && !logic.isQuantified())
+        || options::floatSimplex())
     {
       varOrderPivots = 200;
     }
@@ -783,6 +786,13 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
                  << varOrderPivots << std::endl;
     options::arithStandardCheckVarOrderPivots.set(varOrderPivots);
   }
+  if (options::floatSimplex()
+      && options::arithStandardCheckVarOrderPivots() < 0)
+  {
+    throw OptionException(
+        "--float-simplex requires a non-negative "
+        "--standard-effort-variable-order-pivots");
+  }
   if (logic.isPure(THEORY_ARITH) && !logic.areRealsUsed())
   {
     if (!options::nlExtTangentPlanesInterleave.wasSetByUser())
@@ -1259,6 +1269,93 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     options::quantDynamicSplit.set(options::QuantDSplitMode::NONE);
   }
 
+  if (!options::shareClauses().empty())
+  {
+    // imported clauses have no proofs
+    if (options::unsatCores() || options::proof())
+    {
+      if (options::shareClauses.wasSetByUser())
+      {
+        throw OptionException(
+            "--share-clauses is not supported with unsat cores or proofs");
+      }
+      options::shareClauses.set("");
+    }
+    // imported clauses may contain variables eliminated here
+    else if (options::minisatUseElim.wasSetByUser()
+             && options::minisatUseElim())
+    {
+      throw OptionException(
+          "--share-clauses requires --no-minisat-elimination");
+    }
+    else
+    {
+      options::minisatUseElim.set(false);
+    }
+  }
+
+  if (options::incrementalCnf())
+  {
+    // the definitions are only kept across user levels
+    if (!options::incrementalSolving())
+    {
+      options::incrementalCnf.set(false);
+    }
+    // the proofs of the clauses are removed when popping
+    else if (options::unsatCores() || options::proof())
+    {
+      if (options::incrementalCnf.wasSetByUser())
+      {
+        throw OptionException(
+            "--incremental-cnf is not supported with unsat cores or proofs");
+      }
+      options::incrementalCnf.set(false);
+    }
+  }
+
+  if (options::cnfPolarity())
+  {
+    // the clauses are tracked to the assertions assuming a full encoding, and
+    // the definitions kept across user levels are encoded in both polarities
+    if (options::unsatCores() || options::proof() || options::incrementalCnf())
+    {
+      if (options::cnfPolarity.wasSetByUser())
+      {
+        throw OptionException(
+            "--cnf-polarity is not supported with unsat cores, proofs or "
+            "--incremental-cnf");
+      }
+      options::cnfPolarity.set(false);
+    }
+  }
+
+  if (options::minisatProbe() && (options::unsatCores() || options::proof()))
+  {
+    // the units found by probing are not justified in the SAT proof
+    if (options::minisatProbe.wasSetByUser())
+    {
+      throw OptionException(
+          "--minisat-probe is not supported with unsat cores or proofs");
+    }
+    options::minisatProbe.set(false);
+  }
+
+  if (options::ppThreads() > 1)
+  {
+#ifndef CVC4_THREAD_SAFE_NODES
+    throw OptionException(
+        "--pp-threads requires a build with thread-safe nodes (configure "
+        "with --thread-safe-nodes)");
+#endif /* CVC4_THREAD_SAFE_NODES */
+    // neither the rewrite proofs nor the persistent rewrite cache are
+    // thread-safe
+    if (options::proof() || !options::rewriteCacheFile().empty())
+    {
+      throw OptionException(
+          "--pp-threads is not supported with proofs or --rewrite-cache-file");
+    }
+  }
+
   // until bugs 371,431 are fixed
   if (!options::minisatUseElim.wasSetByUser())
   {
@@ -25,6 +25,7 @@
 #include "expr/bound_var_manager.h"
 #include "expr/node.h"
 #include "options/base_options.h"
+#include "options/expr_options.h"
 #include "options/language.h"
 #include "options/main_options.h"
 #include "options/printer_options.h"
@@ -82,7 +83,7 @@ using namespace CVC4::theory;
 namespace CVC4 {
 
 SmtEngine::SmtEngine(NodeManager* nm, Options* optr)
-    : d_env(new Env(nm)),
+    : d_env(new Env(nm, optr)),
       d_state(new SmtEngineState(getContext(), getUserContext(), *this)),
       d_absValues(new AbstractValues(getNodeManager())),
       d_asserts(new Assertions(getUserContext(), *d_absValues.get())),
@@ -135,7 +136,7 @@ SmtEngine::SmtEngine(NodeManager* nm, Options* optr)
   // listen to resource out
   getResourceManager()->registerListener(d_routListener.get());
   // make statistics
-  d_stats.reset(new SmtEngineStatistics());
+  d_stats.reset(new SmtEngineStatistics(getContext(), getUserContext()));
   // reset the preprocessor
   d_pp.reset(new smt::Preprocessor(
       *this, getUserContext(), *d_absValues.get(), *d_stats));
@@ -217,11 +218,30 @@ void SmtEngine::finishInit()
   // set the random seed
   Random::getRandom().setSeed(options::seed());
 
+  // set when unreferenced nodes are garbage collected
+  getNodeManager()->setZombieReclaimPolicy(options::zombieReclaimThreshold(),
+                                           options::zombieReclaimBudget(),
+                                           options::zombieReclaimSafePoints());
+  if (options::expectedTerms() > 0)
+  {
+    getNodeManager()->reservePool(options::expectedTerms());
+  }
+
   // Call finish init on the options manager. This inializes the resource
   // manager based on the options, and sets up the best default options
   // based on our heuristics.
   d_optm->finishInit(d_env->d_logic, d_isInternalSubsolver);
 
+  // share the results of rewriting with other processes, if asked to. This
+  // is done once the options are final, since they are part of the
+  // fingerprint of the cache.
+  if (!options::rewriteCacheFile().empty())
+  {
+    getRewriter()->openPersistentCache(
+        options::rewriteCacheFile(),
+        options::rewriteCacheMaxSize() * 1024 * 1024);
+  }
+
   ProofNodeManager* pnm = nullptr;
   if (options::proof())
   {
@@ -948,6 +968,10 @@ Result SmtEngine::checkSatInternal(const std::vector<Node>& assumptions,
     SmtScope smts(this);
     finishInit();
 
+    // no nodes are under construction between queries, so this is a safe
+    // point for collecting the garbage left by previous ones
+    getNodeManager()->reclaimZombiesAtSafePoint();
+
     Trace("smt") << "SmtEngine::"
                  << (isEntailmentCheck ? "checkEntailed" : "checkSat") << "("
                  << assumptions << ")" << endl;
@@ -1943,6 +1967,14 @@ void SmtEngine::setOption(const std::string& key, const std::string& value)
     throw OptionException("bad value for :" + key);
   }
 
+  if (key == "context-chunk-size" || key == "context-max-free-chunks"
+      || key == "context-huge-pages")
+  {
+    // the contexts are created along with this SmtEngine
+    throw OptionException("option `" + key
+                          + "' can only be set when the solver is created");
+  }
+
   std::string optionarg = value;
   getOptions().setOption(key, optionarg);
 }
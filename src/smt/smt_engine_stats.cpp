@@ -14,12 +14,82 @@
 
 #include "smt/smt_engine_stats.h"
 
+#include <vector>
+
+#include "context/context.h"
+#include "util/safe_print.h"
+
 #include "smt/smt_statistics_registry.h"
 
 namespace CVC4 {
 namespace smt {
 
-SmtEngineStatistics::SmtEngineStatistics()
+void ContextPeakBytesStat::flushInformation(std::ostream& out) const
+{
+  out << "[";
+  for (size_t level = 0, n = d_cmm.getNumPeakLevels(); level < n; ++level)
+  {
+    out << (level > 0 ? ", " : "") << d_cmm.getPeakBytes(level);
+  }
+  out << "]";
+}
+
+void ContextPeakBytesStat::safeFlushInformation(int fd) const
+{
+  safe_print(fd, "[");
+  for (size_t level = 0, n = d_cmm.getNumPeakLevels(); level < n; ++level)
+  {
+    if (level > 0)
+    {
+      safe_print(fd, ", ");
+    }
+    safe_print<uint64_t>(fd, d_cmm.getPeakBytes(level));
+  }
+  safe_print(fd, "]");
+}
+
+SExpr ContextPeakBytesStat::getValue() const
+{
+  std::vector<SExpr> peaks;
+  for (size_t level = 0, n = d_cmm.getNumPeakLevels(); level < n; ++level)
+  {
+    peaks.emplace_back(Integer(d_cmm.getPeakBytes(level)));
+  }
+  return SExpr(peaks);
+}
+
+ContextMemoryStatistics::ContextMemoryStatistics(
+    const std::string& prefix, const context::ContextMemoryManager& cmm)
+    : d_chunksAllocated(prefix + "chunksAllocated",
+                        cmm.getStatistics().d_chunksAllocated),
+      d_chunksReused(prefix + "chunksReused",
+                     cmm.getStatistics().d_chunksReused),
+      d_chunksReleased(prefix + "chunksReleased",
+                       cmm.getStatistics().d_chunksReleased),
+      d_peakChunks(prefix + "peakChunks", cmm.getStatistics().d_peakChunks),
+      d_arenas(prefix + "arenas", cmm.getStatistics().d_arenas),
+      d_peakBytes(prefix + "peakBytes", cmm)
+{
+  smtStatisticsRegistry()->registerStat(&d_chunksAllocated);
+  smtStatisticsRegistry()->registerStat(&d_chunksReused);
+  smtStatisticsRegistry()->registerStat(&d_chunksReleased);
+  smtStatisticsRegistry()->registerStat(&d_peakChunks);
+  smtStatisticsRegistry()->registerStat(&d_arenas);
+  smtStatisticsRegistry()->registerStat(&d_peakBytes);
+}
+
+ContextMemoryStatistics::~ContextMemoryStatistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_chunksAllocated);
+  smtStatisticsRegistry()->unregisterStat(&d_chunksReused);
+  smtStatisticsRegistry()->unregisterStat(&d_chunksReleased);
+  smtStatisticsRegistry()->unregisterStat(&d_peakChunks);
+  smtStatisticsRegistry()->unregisterStat(&d_arenas);
+  smtStatisticsRegistry()->unregisterStat(&d_peakBytes);
+}
+
+SmtEngineStatistics::SmtEngineStatistics(context::Context* c,
+                                         context::UserContext* u)
     : d_definitionExpansionTime("smt::SmtEngine::definitionExpansionTime"),
       d_numConstantProps("smt::SmtEngine::numConstantProps", 0),
       d_cnfConversionTime("smt::SmtEngine::cnfConversionTime"),
@@ -30,7 +100,9 @@ SmtEngineStatistics::SmtEngineStatistics()
       d_solveTime("smt::SmtEngine::solveTime"),
       d_pushPopTime("smt::SmtEngine::pushPopTime"),
       d_processAssertionsTime("smt::SmtEngine::processAssertionsTime"),
-      d_simplifiedToFalse("smt::SmtEngine::simplifiedToFalse", 0)
+      d_simplifiedToFalse("smt::SmtEngine::simplifiedToFalse", 0),
+      d_contextMemory("context::sat::", *c->getCMM()),
+      d_userContextMemory("context::user::", *u->getCMM())
 {
   smtStatisticsRegistry()->registerStat(&d_definitionExpansionTime);
   smtStatisticsRegistry()->registerStat(&d_numConstantProps);
@@ -17,14 +17,63 @@
 #ifndef CVC4__SMT__SMT_ENGINE_STATS_H
 #define CVC4__SMT__SMT_ENGINE_STATS_H
 
+#include <string>
+
 #include "util/statistics_registry.h"
 
 namespace CVC4 {
+
+namespace context {
+class Context;
+class ContextMemoryManager;
+class UserContext;
+}  // namespace context
+
 namespace smt {
 
+/**
+ * The peak number of bytes allocated per level by the memory manager of a
+ * context (see ContextMemoryManager::getPeakBytes()), as a list by level.
+ */
+class ContextPeakBytesStat : public Stat
+{
+ public:
+  ContextPeakBytesStat(const std::string& name,
+                       const context::ContextMemoryManager& cmm)
+      : Stat(name), d_cmm(cmm)
+  {
+  }
+  void flushInformation(std::ostream& out) const override;
+  void safeFlushInformation(int fd) const override;
+  SExpr getValue() const override;
+
+ private:
+  const context::ContextMemoryManager& d_cmm;
+}; /* class ContextPeakBytesStat */
+
+/** The statistics of the memory manager of a context. */
+struct ContextMemoryStatistics
+{
+  ContextMemoryStatistics(const std::string& prefix,
+                          const context::ContextMemoryManager& cmm);
+  ~ContextMemoryStatistics();
+  /** number of chunks newly allocated */
+  ReferenceStat<uint64_t> d_chunksAllocated;
+  /** number of chunks taken from the free chunks */
+  ReferenceStat<uint64_t> d_chunksReused;
+  /** number of free chunks returned to the system */
+  ReferenceStat<uint64_t> d_chunksReleased;
+  /** peak number of chunks in use */
+  ReferenceStat<uint64_t> d_peakChunks;
+  /** number of huge page arenas mapped */
+  ReferenceStat<uint64_t> d_arenas;
+  /** peak number of bytes allocated per level */
+  ContextPeakBytesStat d_peakBytes;
+}; /* struct ContextMemoryStatistics */
+
 struct SmtEngineStatistics
 {
-  SmtEngineStatistics();
+  SmtEngineStatistics(context::Context* c, context::UserContext* u);
   ~SmtEngineStatistics();
   /** time spent in definition-expansion */
   TimerStat d_definitionExpansionTime;
@@ -49,6 +98,11 @@ struct SmtEngineStatistics
 
   /** Has something simplified to false? */
   IntStat d_simplifiedToFalse;
+
+  /** memory of the SAT context */
+  ContextMemoryStatistics d_contextMemory;
+  /** memory of the user context */
+  ContextMemoryStatistics d_userContextMemory;
 }; /* struct SmtEngineStatistics */
 
 }  // namespace smt
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <ostream>
+#include <utility>
 
 #include "base/check.h"
 #include "base/exception.h"
@@ -54,6 +55,8 @@ public:
   DeltaRational(const CVC4::Rational& base) : c(base), k(0,1) {}
   DeltaRational(const CVC4::Rational& base, const CVC4::Rational& coeff) :
     c(base), k(coeff) {}
+  DeltaRational(CVC4::Rational&& base, CVC4::Rational&& coeff) :
+    c(std::move(base)), k(std::move(coeff)) {}
 
   const CVC4::Rational& getInfinitesimalPart() const {
     return k;
@@ -99,15 +102,11 @@ public:
   }
 
   DeltaRational operator+(const DeltaRational& other) const{
-    CVC4::Rational tmpC = c+other.c;
-    CVC4::Rational tmpK = k+other.k;
-    return DeltaRational(tmpC, tmpK);
+    return DeltaRational(c + other.c, k + other.k);
   }
 
   DeltaRational operator*(const Rational& a) const{
-    CVC4::Rational tmpC = a*c;
-    CVC4::Rational tmpK = a*k;
-    return DeltaRational(tmpC, tmpK);
+    return DeltaRational(a * c, a * k);
   }
 
 
@@ -129,8 +128,7 @@ public:
 
 
   DeltaRational operator-(const DeltaRational& a) const{
-    CVC4::Rational negOne(CVC4::Integer(-1));
-    return *(this) + (a * negOne);
+    return DeltaRational(c - a.c, k - a.k);
   }
 
   DeltaRational operator-() const{
@@ -138,15 +136,11 @@ public:
   }
 
   DeltaRational operator/(const Rational& a) const{
-    CVC4::Rational tmpC = c/a;
-    CVC4::Rational tmpK = k/a;
-    return DeltaRational(tmpC, tmpK);
+    return DeltaRational(c / a, k / a);
   }
 
   DeltaRational operator/(const Integer& a) const{
-    CVC4::Rational tmpC = c/a;
-    CVC4::Rational tmpK = k/a;
-    return DeltaRational(tmpC, tmpK);
+    return DeltaRational(c / a, k / a);
   }
 
   /**
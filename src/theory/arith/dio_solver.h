@@ -20,6 +20,7 @@
 #ifndef CVC4__THEORY__ARITH__DIO_SOLVER_H
 #define CVC4__THEORY__ARITH__DIO_SOLVER_H
 
+#include <deque>
 #include <unordered_map>
 #include <utility>
 #include <vector>
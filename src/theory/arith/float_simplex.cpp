@@ -0,0 +1,476 @@
+/*********************                                                        */
+/*! \file float_simplex.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A double precision simplex over a copy of the tableau.
+ **
+ ** A double precision simplex over a copy of the tableau.
+ **/
+
+#include "theory/arith/float_simplex.h"
+
+#include <cmath>
+#include <limits>
+
+#include "base/output.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/tableau.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+/** Relative tolerance on the bounds. */
+const double s_feasTol = 1e-9;
+/** Smallest magnitude of a coefficient that is pivoted on. */
+const double s_pivotTol = 1e-9;
+/** Coefficients smaller than this are dropped while pivoting. */
+const double s_dropTol = 1e-12;
+/** Steps of zero length before switching to Bland's rule. */
+const uint32_t s_degenerateLimit = 50;
+/** Pivots between recomputations of the basic values. */
+const uint32_t s_refreshPeriod = 100;
+
+const double s_inf = numeric_limits<double>::infinity();
+
+/** The feasibility tolerance of a bound, 0 for missing (infinite) bounds. */
+double tolerance(double bound)
+{
+  return std::isinf(bound) ? 0.0 : s_feasTol * max(1.0, fabs(bound));
+}
+
+}  // namespace
+
+ApproxFloat::ApproxFloat(const ArithVariables& vars,
+                         const Tableau& tableau,
+                         TreeLog& l,
+                         ApproximateStatistics& s)
+    : ApproximateSimplex(vars, l, s), d_currentStamp(0), d_pivots(0)
+{
+  ArithVar n = d_vars.getNumberOfVariables();
+  d_cols.resize(n);
+  d_rowOf.assign(n, -1);
+  d_value.assign(n, 0.0);
+  d_lb.assign(n, -s_inf);
+  d_ub.assign(n, s_inf);
+  d_pos.assign(n, -1);
+
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    d_value[v] = d_vars.getAssignment(v).approx(SMALL_FIXED_DELTA);
+    if (d_vars.hasLowerBound(v))
+    {
+      d_lb[v] = d_vars.getLowerBound(v).approx(SMALL_FIXED_DELTA);
+    }
+    if (d_vars.hasUpperBound(v))
+    {
+      d_ub[v] = d_vars.getUpperBound(v).approx(SMALL_FIXED_DELTA);
+    }
+  }
+
+  for (Tableau::BasicIterator bi = tableau.beginBasic(),
+                              bi_end = tableau.endBasic();
+       bi != bi_end;
+       ++bi)
+  {
+    ArithVar b = *bi;
+    uint32_t r = d_rows.size();
+    d_rows.push_back(Row());
+    Row& row = d_rows.back();
+    row.d_basic = b;
+    d_rowOf[b] = r;
+    for (Tableau::RowIterator ri = tableau.basicRowIterator(b); !ri.atEnd();
+         ++ri)
+    {
+      const Tableau::Entry& entry = *ri;
+      ArithVar v = entry.getColVar();
+      if (v != b)
+      {
+        row.d_entries.push_back(
+            make_pair(v, entry.getCoefficient().getDouble()));
+        d_cols[v].push_back(r);
+      }
+    }
+  }
+  d_stamp.assign(d_rows.size(), 0);
+  computeBasicValues();
+}
+
+int ApproxFloat::violation(ArithVar v) const
+{
+  double x = d_value[v];
+  if (x < d_lb[v] - tolerance(d_lb[v]))
+  {
+    return -1;
+  }
+  if (x > d_ub[v] + tolerance(d_ub[v]))
+  {
+    return 1;
+  }
+  return 0;
+}
+
+void ApproxFloat::computeBasicValues()
+{
+  for (const Row& row : d_rows)
+  {
+    double x = 0.0;
+    for (const pair<ArithVar, double>& e : row.d_entries)
+    {
+      x += e.second * d_value[e.first];
+    }
+    d_value[row.d_basic] = x;
+  }
+}
+
+double ApproxFloat::sumInfeasibilities(bool mip) const
+{
+  double sum = 0.0;
+  for (const Row& row : d_rows)
+  {
+    ArithVar b = row.d_basic;
+    int s = violation(b);
+    if (s < 0)
+    {
+      sum += d_lb[b] - d_value[b];
+    }
+    else if (s > 0)
+    {
+      sum += d_value[b] - d_ub[b];
+    }
+  }
+  return sum;
+}
+
+void ApproxFloat::collectColumn(ArithVar v)
+{
+  // rows are stamped so that each is visited once
+  ++d_currentStamp;
+  d_colEntries.clear();
+  vector<uint32_t>& col = d_cols[v];
+  size_t keep = 0;
+  for (size_t i = 0, N = col.size(); i < N; ++i)
+  {
+    uint32_t r = col[i];
+    if (d_stamp[r] == d_currentStamp)
+    {
+      continue;
+    }
+    d_stamp[r] = d_currentStamp;
+    for (const pair<ArithVar, double>& e : d_rows[r].d_entries)
+    {
+      if (e.first == v)
+      {
+        d_colEntries.push_back(make_pair(r, e.second));
+        col[keep++] = r;
+        break;
+      }
+    }
+  }
+  col.resize(keep);
+}
+
+void ApproxFloat::pivot(uint32_t r, ArithVar v)
+{
+  Row& prow = d_rows[r];
+  ArithVar leaving = prow.d_basic;
+
+  // solve the row for v:
+  //  leaving = a*v + sum c_k x_k  ==>  v = leaving/a - sum (c_k/a) x_k
+  double a = 0.0;
+  for (const pair<ArithVar, double>& e : prow.d_entries)
+  {
+    if (e.first == v)
+    {
+      a = e.second;
+      break;
+    }
+  }
+  Assert(fabs(a) >= s_pivotTol);
+  RowEntries solved;
+  solved.reserve(prow.d_entries.size());
+  solved.push_back(make_pair(leaving, 1.0 / a));
+  for (const pair<ArithVar, double>& e : prow.d_entries)
+  {
+    if (e.first != v)
+    {
+      solved.push_back(make_pair(e.first, -e.second / a));
+    }
+  }
+  prow.d_basic = v;
+  prow.d_entries = solved;
+  d_rowOf[v] = r;
+  d_rowOf[leaving] = -1;
+  d_cols[leaving].push_back(r);
+
+  // substitute the solved row for v in the other rows containing v
+  for (const pair<uint32_t, double>& ce : d_colEntries)
+  {
+    uint32_t i = ce.first;
+    if (i == r)
+    {
+      continue;
+    }
+    double mult = ce.second;
+    RowEntries& entries = d_rows[i].d_entries;
+    for (size_t k = 0, N = entries.size(); k < N; ++k)
+    {
+      d_pos[entries[k].first] = k;
+    }
+    for (const pair<ArithVar, double>& e : solved)
+    {
+      int64_t pos = d_pos[e.first];
+      if (pos >= 0)
+      {
+        entries[pos].second += mult * e.second;
+      }
+      else
+      {
+        d_pos[e.first] = entries.size();
+        entries.push_back(make_pair(e.first, mult * e.second));
+        d_cols[e.first].push_back(i);
+      }
+    }
+    size_t keep = 0;
+    for (size_t k = 0, N = entries.size(); k < N; ++k)
+    {
+      d_pos[entries[k].first] = -1;
+      if (entries[k].first != v && fabs(entries[k].second) >= s_dropTol)
+      {
+        entries[keep++] = entries[k];
+      }
+    }
+    entries.resize(keep);
+  }
+  d_cols[v].clear();
+}
+
+LinResult ApproxFloat::solveRelaxation()
+{
+  d_pivots = 0;
+  uint32_t degenerate = 0;
+  vector<double> cost(d_value.size(), 0.0);
+  vector<ArithVar> touched;
+
+  while (true)
+  {
+    // the gradient of the sum of infeasibilities of the basic variables with
+    // respect to the nonbasic variables
+    for (ArithVar v : touched)
+    {
+      cost[v] = 0.0;
+    }
+    touched.clear();
+    bool infeasible = false;
+    for (const Row& row : d_rows)
+    {
+      int s = violation(row.d_basic);
+      if (s == 0)
+      {
+        continue;
+      }
+      infeasible = true;
+      for (const pair<ArithVar, double>& e : row.d_entries)
+      {
+        if (cost[e.first] == 0.0)
+        {
+          touched.push_back(e.first);
+        }
+        cost[e.first] += s * e.second;
+      }
+    }
+    if (!infeasible)
+    {
+      Debug("arith::float") << "float simplex feasible after " << d_pivots
+                            << " pivots" << endl;
+      return LinFeasible;
+    }
+    if (d_pivots >= (uint32_t)d_pivotLimit)
+    {
+      return LinExhausted;
+    }
+
+    // select the entering variable: Dantzig's rule, or Bland's rule on
+    // long runs of degenerate steps
+    bool bland = degenerate >= s_degenerateLimit;
+    ArithVar entering = ARITHVAR_SENTINEL;
+    int dir = 0;
+    double best = 0.0;
+    for (ArithVar v : touched)
+    {
+      double c = cost[v];
+      if (d_rowOf[v] >= 0 || fabs(c) <= s_feasTol)
+      {
+        continue;
+      }
+      int vdir = 0;
+      if (c < 0 && d_value[v] < d_ub[v] - tolerance(d_ub[v]))
+      {
+        vdir = 1;
+      }
+      else if (c > 0 && d_value[v] > d_lb[v] + tolerance(d_lb[v]))
+      {
+        vdir = -1;
+      }
+      if (vdir == 0)
+      {
+        continue;
+      }
+      if (bland ? (entering == ARITHVAR_SENTINEL || v < entering)
+                : fabs(c) > best)
+      {
+        entering = v;
+        dir = vdir;
+        best = fabs(c);
+      }
+    }
+    if (entering == ARITHVAR_SENTINEL)
+    {
+      // no nonbasic variable can reduce the infeasibility
+      Debug("arith::float") << "float simplex infeasible after " << d_pivots
+                            << " pivots" << endl;
+      return LinInfeasible;
+    }
+
+    // ratio test: the longest step along which the sum of infeasibilities is
+    // linear, bounded by the entering variable's own bound
+    double step =
+        dir > 0 ? d_ub[entering] - d_value[entering]
+                : d_value[entering] - d_lb[entering];
+    int64_t leavingRow = -1;
+    double leavingValue = 0.0;
+    collectColumn(entering);
+    for (const pair<uint32_t, double>& ce : d_colEntries)
+    {
+      double rate = ce.second * dir;
+      if (fabs(ce.second) < s_pivotTol)
+      {
+        continue;
+      }
+      ArithVar b = d_rows[ce.first].d_basic;
+      double x = d_value[b];
+      int s = violation(b);
+      double target;
+      if (rate > 0)
+      {
+        // increasing: stops at the lower bound if below it, else at the upper
+        target = s < 0 ? d_lb[b] : (s == 0 ? d_ub[b] : s_inf);
+      }
+      else
+      {
+        target = s > 0 ? d_ub[b] : (s == 0 ? d_lb[b] : -s_inf);
+      }
+      if (std::isinf(target))
+      {
+        continue;
+      }
+      double limit = max(0.0, (target - x) / rate);
+      if (limit < step
+          || (bland && limit == step && leavingRow >= 0
+              && b < d_rows[leavingRow].d_basic))
+      {
+        step = limit;
+        leavingRow = ce.first;
+        leavingValue = target;
+      }
+    }
+    if (std::isinf(step))
+    {
+      return LinUnknown;
+    }
+
+    // take the step
+    d_value[entering] += dir * step;
+    for (const pair<uint32_t, double>& ce : d_colEntries)
+    {
+      d_value[d_rows[ce.first].d_basic] += ce.second * dir * step;
+    }
+    if (leavingRow < 0)
+    {
+      // the entering variable moved to its other bound, no pivot is needed
+      d_value[entering] = dir > 0 ? d_ub[entering] : d_lb[entering];
+    }
+    else
+    {
+      d_value[d_rows[leavingRow].d_basic] = leavingValue;
+      pivot(leavingRow, entering);
+    }
+    ++d_pivots;
+    degenerate = step <= s_feasTol ? degenerate + 1 : 0;
+    if (d_pivots % s_refreshPeriod == 0)
+    {
+      computeBasicValues();
+    }
+  }
+}
+
+DeltaRational ApproxFloat::estimate(ArithVar v, double x) const
+{
+  if (d_vars.hasLowerBound(v) && roughlyEqual(x, d_lb[v]))
+  {
+    return d_vars.getLowerBound(v);
+  }
+  if (d_vars.hasUpperBound(v) && roughlyEqual(x, d_ub[v]))
+  {
+    return d_vars.getUpperBound(v);
+  }
+  const DeltaRational& current = d_vars.getAssignment(v);
+  if (roughlyEqual(x, current.approx(SMALL_FIXED_DELTA)))
+  {
+    return current;
+  }
+  double rounded = round(x);
+  if (roughlyEqual(x, rounded))
+  {
+    x = rounded;
+  }
+  DeltaRational proposal = current;
+  if (Maybe<Rational> maybe_new = estimateWithCFE(x))
+  {
+    proposal = maybe_new.value();
+  }
+  if (d_vars.strictlyLessThanLowerBound(v, proposal))
+  {
+    return d_vars.getLowerBound(v);
+  }
+  if (d_vars.strictlyGreaterThanUpperBound(v, proposal))
+  {
+    return d_vars.getUpperBound(v);
+  }
+  return proposal;
+}
+
+ApproximateSimplex::Solution ApproxFloat::extractRelaxation() const
+{
+  Solution sol;
+  for (const Row& row : d_rows)
+  {
+    sol.newBasis.add(row.d_basic);
+  }
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    sol.newValues.set(v, estimate(v, d_value[v]));
+  }
+  return sol;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,144 @@
+/*********************                                                        */
+/*! \file float_simplex.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A double precision simplex over a copy of the tableau.
+ **
+ ** ApproxFloat copies the rows of the exact Tableau, and the bounds and
+ ** assignment of ArithVariables, into doubles. It then searches for a
+ ** feasible basis, starting from the current one, by minimizing the sum of
+ ** infeasibilities with a bounded variable primal simplex. Nothing it
+ ** computes is trusted: the basis it reaches is handed back as an
+ ** ApproximateSimplex::Solution, which AttemptSolutionSDP imports into the
+ ** exact tableau, and the exact simplex repairs it from there.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "theory/arith/approx_simplex.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class Tableau;
+
+class ApproxFloat : public ApproximateSimplex
+{
+ public:
+  ApproxFloat(const ArithVariables& vars,
+              const Tableau& tableau,
+              TreeLog& l,
+              ApproximateStatistics& s);
+  ~ApproxFloat() {}
+
+  /**
+   * Runs the double precision simplex for at most the pivot limit.
+   * Returns LinFeasible or LinInfeasible if it reached a basis that looks
+   * feasible or infeasible up to the tolerances, and LinExhausted if it ran
+   * out of pivots.
+   */
+  LinResult solveRelaxation() override;
+
+  /**
+   * Returns the basis reached by solveRelaxation(). Values of the nonbasic
+   * variables are snapped to their exact bounds, or otherwise estimated as
+   * rationals within their bounds.
+   */
+  Solution extractRelaxation() const override;
+
+  /** The number of pivots made by the last solveRelaxation(). */
+  uint32_t getPivots() const { return d_pivots; }
+
+  ArithRatPairVec heuristicOptCoeffs() const override
+  {
+    return ArithRatPairVec();
+  }
+  void setOptCoeffs(const ArithRatPairVec& ref) override {}
+
+  MipResult solveMIP(bool al) override { return MipUnknown; }
+  Solution extractMIP() const override { return Solution(); }
+
+  void tryCut(int nid, CutInfo& cut) override {}
+
+  std::vector<const CutInfo*> getValidCuts(const NodeLog& node) override
+  {
+    return std::vector<const CutInfo*>();
+  }
+
+  ArithVar getBranchVar(const NodeLog& nl) const override
+  {
+    return ARITHVAR_SENTINEL;
+  }
+
+  double sumInfeasibilities(bool mip) const override;
+
+ private:
+  typedef std::vector<std::pair<ArithVar, double> > RowEntries;
+
+  /** A row of the copy: d_basic = sum of the d_entries. */
+  struct Row
+  {
+    ArithVar d_basic;
+    RowEntries d_entries;
+  };
+
+  /**
+   * Returns -1 if v is below its lower bound, 1 if it is above its upper
+   * bound, and 0 otherwise, up to the feasibility tolerance.
+   */
+  int violation(ArithVar v) const;
+
+  /** Recomputes the values of the basic variables from their rows. */
+  void computeBasicValues();
+
+  /**
+   * Collects into d_colEntries the rows in which v has a coefficient, and
+   * their coefficients, and drops stale rows from d_cols[v].
+   */
+  void collectColumn(ArithVar v);
+
+  /**
+   * Pivots the basic variable of row r out of the basis, and v into it.
+   * d_colEntries must hold the column of v.
+   */
+  void pivot(uint32_t r, ArithVar v);
+
+  /** Estimates the value x of v as a rational, within the bounds of v. */
+  DeltaRational estimate(ArithVar v, double x) const;
+
+  /** The rows, in the order of the exact tableau. */
+  std::vector<Row> d_rows;
+  /** For each variable, the rows it may have a coefficient in. */
+  std::vector<std::vector<uint32_t> > d_cols;
+  /** For each variable, its row if it is basic and -1 otherwise. */
+  std::vector<int64_t> d_rowOf;
+
+  /** The values and bounds of the variables, with infinite missing bounds. */
+  std::vector<double> d_value;
+  std::vector<double> d_lb;
+  std::vector<double> d_ub;
+
+  /** Scratch space for pivoting and for the ratio test. */
+  std::vector<std::pair<uint32_t, double> > d_colEntries;
+  std::vector<int64_t> d_pos;
+  std::vector<uint32_t> d_stamp;
+  uint32_t d_currentStamp;
+
+  /** The pivots made by the last solveRelaxation(). */
+  uint32_t d_pivots;
+}; /* class ApproxFloat */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,250 @@
+/*********************                                                        */
+/*! \file gomory_cuts.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Gomory mixed integer cuts from the rows of the exact tableau, and
+ ** a pool that keeps them for reuse.
+ **/
+
+#include "theory/arith/gomory_cuts.h"
+
+#include <cmath>
+
+#include "base/output.h"
+#include "theory/arith/constraint.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/tableau.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+GomoryCutGenerator::GomoryCutGenerator(const ArithVariables& vars,
+                                       const Tableau& tableau)
+    : d_vars(vars), d_tableau(tableau)
+{
+}
+
+bool GomoryCutGenerator::derive(ArithVar b, GomoryCut& cut) const
+{
+  Assert(d_tableau.isBasic(b));
+  Assert(d_vars.isInteger(b));
+
+  const DeltaRational& beta = d_vars.getAssignment(b);
+  if (!beta.infinitesimalIsZero() || beta.isIntegral())
+  {
+    return false;
+  }
+  // 0 < f0 < 1
+  const Rational f0 = beta.getNoninfinitesimalPart().floor_frac();
+  const Rational oneMinusF0 = Rational(1) - f0;
+
+  // The row is b = sum_j a_j x_j over the nonbasic x_j. Each x_j is at a
+  // bound, so it is either l_j + s_j or u_j - s_j for some s_j >= 0, and
+  //   b + sum_j alpha_j s_j = beta
+  // where alpha_j is -a_j at a lower bound and a_j at an upper bound.
+  // The Gomory mixed integer cut of this row is sum_j gamma_j s_j >= 1.
+  cut.d_basic = b;
+  cut.d_lhs.purge();
+  cut.d_rhs = Rational(1);
+  cut.d_explanation.clear();
+  double normSquared = 0.0;
+
+  for (Tableau::RowIterator i = d_tableau.basicRowIterator(b); !i.atEnd();
+       ++i)
+  {
+    const Tableau::Entry& entry = *i;
+    ArithVar x = entry.getColVar();
+    if (x == b)
+    {
+      continue;
+    }
+    const Rational& a = entry.getCoefficient();
+
+    bool atLower = d_vars.hasLowerBound(x)
+                   && d_vars.cmpAssignmentLowerBound(x) == 0;
+    bool atUpper = !atLower && d_vars.hasUpperBound(x)
+                   && d_vars.cmpAssignmentUpperBound(x) == 0;
+    if (!atLower && !atUpper)
+    {
+      Debug("arith::gomory") << "gomory: " << x << " is not at a bound" << endl;
+      return false;
+    }
+    const DeltaRational& bound =
+        atLower ? d_vars.getLowerBound(x) : d_vars.getUpperBound(x);
+    if (!bound.infinitesimalIsZero())
+    {
+      return false;
+    }
+    const Rational& boundValue = bound.getNoninfinitesimalPart();
+
+    Rational alpha = atLower ? -a : a;
+    Rational gamma;
+    if (d_vars.isInteger(x) && boundValue.isIntegral())
+    {
+      Rational fj = alpha.floor_frac();
+      if (fj.isZero())
+      {
+        continue;
+      }
+      gamma = (fj <= f0) ? fj / f0 : (Rational(1) - fj) / oneMinusF0;
+    }
+    else
+    {
+      gamma = (alpha.sgn() >= 0) ? alpha / f0 : -alpha / oneMinusF0;
+    }
+    Assert(gamma.sgn() > 0);
+
+    // gamma * s_j is gamma * x_j - gamma * l_j, or gamma * u_j - gamma * x_j
+    if (atLower)
+    {
+      cut.d_lhs.set(x, gamma);
+      cut.d_rhs += gamma * boundValue;
+      cut.d_explanation.push_back(d_vars.getLowerBoundConstraint(x));
+    }
+    else
+    {
+      cut.d_lhs.set(x, -gamma);
+      cut.d_rhs -= gamma * boundValue;
+      cut.d_explanation.push_back(d_vars.getUpperBoundConstraint(x));
+    }
+    double g = gamma.getDouble();
+    normSquared += g * g;
+  }
+
+  if (cut.d_lhs.empty())
+  {
+    // The row alone is infeasible over the integers. The simplex and the
+    // branches find this more cheaply than a lemma 0 >= 1.
+    return false;
+  }
+  // The assignment is at distance 1 from the cut, in the gamma-weighted
+  // space of the s_j.
+  cut.d_score = 1.0 / std::sqrt(normSquared);
+  return true;
+}
+
+CutPool::CutPool(context::Context* satContext, uint32_t maxAge)
+    : d_cuts(), d_maxAge(maxAge), d_sent(satContext)
+{
+}
+
+void CutPool::add(const GomoryCut& cut, TrustNode lemma, uint32_t userLevel)
+{
+  if (d_cuts.size() >= s_maxSize)
+  {
+    size_t weakest = 0;
+    for (size_t i = 1, N = d_cuts.size(); i < N; ++i)
+    {
+      if (d_cuts[i].d_cut.d_score < d_cuts[weakest].d_cut.d_score)
+      {
+        weakest = i;
+      }
+    }
+    drop(weakest);
+  }
+  Entry e;
+  e.d_cut = cut;
+  e.d_lemma = lemma;
+  e.d_userLevel = userLevel;
+  e.d_age = 0;
+  d_cuts.push_back(e);
+  d_sent.insert(lemma.getNode());
+}
+
+bool CutPool::violated(const ArithVariables& vars, const GomoryCut& cut)
+{
+  DeltaRational sum(0);
+  for (DenseMap<Rational>::const_iterator i = cut.d_lhs.begin(),
+                                          i_end = cut.d_lhs.end();
+       i != i_end;
+       ++i)
+  {
+    ArithVar x = *i;
+    sum = sum + vars.getAssignment(x) * cut.d_lhs[x];
+  }
+  return sum < DeltaRational(cut.d_rhs);
+}
+
+uint32_t CutPool::collect(const ArithVariables& vars,
+                          uint32_t userLevel,
+                          std::vector<TrustNode>& out)
+{
+  uint32_t dropped = 0;
+  size_t i = 0;
+  while (i < d_cuts.size())
+  {
+    Entry& e = d_cuts[i];
+    if (e.d_userLevel > userLevel)
+    {
+      drop(i);
+      ++dropped;
+      continue;
+    }
+
+    bool boundsHold = true;
+    for (ConstraintCP c : e.d_cut.d_explanation)
+    {
+      if (!c->isTrue())
+      {
+        boundsHold = false;
+        break;
+      }
+    }
+    if (boundsHold && violated(vars, e.d_cut))
+    {
+      // the SAT solver still holds the lemma if it was sent on this branch
+      e.d_age = 0;
+      if (!d_sent.contains(e.d_lemma.getNode()))
+      {
+        d_sent.insert(e.d_lemma.getNode());
+        out.push_back(e.d_lemma);
+      }
+    }
+    else if (++e.d_age > d_maxAge)
+    {
+      drop(i);
+      ++dropped;
+      continue;
+    }
+    ++i;
+  }
+  return dropped;
+}
+
+void CutPool::removeVariable(ArithVar v)
+{
+  size_t i = 0;
+  while (i < d_cuts.size())
+  {
+    if (d_cuts[i].d_cut.d_lhs.isKey(v))
+    {
+      drop(i);
+    }
+    else
+    {
+      ++i;
+    }
+  }
+}
+
+void CutPool::drop(size_t i)
+{
+  Assert(i < d_cuts.size());
+  if (i + 1 < d_cuts.size())
+  {
+    d_cuts[i] = d_cuts.back();
+  }
+  d_cuts.pop_back();
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,148 @@
+/*********************                                                        */
+/*! \file gomory_cuts.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Gomory mixed integer cuts from the rows of the exact tableau, and
+ ** a pool that keeps them for reuse.
+ **
+ ** GomoryCutGenerator reads the row of an integer basic variable whose value
+ ** is fractional. If every nonbasic variable on the row sits at one of its
+ ** bounds, the row and those bounds imply a Gomory mixed integer cut that the
+ ** current assignment violates. The cut is returned over ArithVars, together
+ ** with the bound constraints it depends on, so it can be sent out as the
+ ** lemma (and bounds) => cut.
+ **
+ ** CutPool remembers the cuts that were sent out. Cut lemmas are removable,
+ ** so the SAT solver may drop them; when the bounds of a pooled cut hold
+ ** again and the assignment violates it again, the cut is handed back
+ ** instead of being derived anew. Which cuts were handed out is tracked in
+ ** the SAT context: a cut is handed out at most once per branch, and again
+ ** after the SAT solver backtracks above the point where it was handed out.
+ ** Cuts that go unused for too long are dropped from the pool.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <vector>
+
+#include "context/cdhashset.h"
+#include "context/context.h"
+#include "expr/node.h"
+#include "theory/arith/arithvar.h"
+#include "theory/arith/constraint_forward.h"
+#include "theory/trust_node.h"
+#include "util/dense_map.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class ArithVariables;
+class Tableau;
+
+/** The cut sum_v d_lhs[v] * v >= d_rhs, derived from the row of d_basic. */
+struct GomoryCut
+{
+  ArithVar d_basic;
+  DenseMap<Rational> d_lhs;
+  Rational d_rhs;
+  /** The bound constraints that, with the tableau, imply the cut. */
+  ConstraintCPVec d_explanation;
+  /**
+   * The distance from the current assignment to the cut, in the space of
+   * the distances of the nonbasic variables to their bounds. Higher is
+   * stronger.
+   */
+  double d_score;
+
+  GomoryCut() : d_basic(ARITHVAR_SENTINEL), d_rhs(), d_score(0.0) {}
+};
+
+class GomoryCutGenerator
+{
+ public:
+  GomoryCutGenerator(const ArithVariables& vars, const Tableau& tableau);
+
+  /**
+   * Derives into cut the Gomory mixed integer cut of the row of the basic
+   * integer variable b. Returns false if there is none: the value of b is
+   * integral or not a rational, or a nonbasic variable on the row is not at
+   * a bound without an infinitesimal.
+   */
+  bool derive(ArithVar b, GomoryCut& cut) const;
+
+ private:
+  const ArithVariables& d_vars;
+  const Tableau& d_tableau;
+}; /* class GomoryCutGenerator */
+
+class CutPool
+{
+ public:
+  /**
+   * Which cuts were sent out is tracked in satContext. Cuts unused for more
+   * than maxAge calls to collect are dropped.
+   */
+  CutPool(context::Context* satContext, uint32_t maxAge);
+
+  /**
+   * Adds the lemma of cut, sent out while the user context was at
+   * userLevel. The lemma counts as sent in the current SAT context.
+   */
+  void add(const GomoryCut& cut, TrustNode lemma, uint32_t userLevel);
+
+  /**
+   * Pushes onto out the lemmas of the pooled cuts whose bounds all hold,
+   * that the current assignment violates, and that were not sent since the
+   * SAT context was last popped below the point where they were sent. Those
+   * lemmas then count as sent. The other cuts age. Cuts
+   * added above userLevel, and cuts older than the maximum age, are
+   * dropped. Returns the number of cuts dropped.
+   */
+  uint32_t collect(const ArithVariables& vars,
+                   uint32_t userLevel,
+                   std::vector<TrustNode>& out);
+
+  /** Drops every cut that mentions v. Must be called when v is released. */
+  void removeVariable(ArithVar v);
+
+  /** Returns true if lemma was sent out in the current SAT context. */
+  bool wasSent(TNode lemma) const { return d_sent.contains(lemma); }
+
+  size_t size() const { return d_cuts.size(); }
+
+ private:
+  struct Entry
+  {
+    GomoryCut d_cut;
+    TrustNode d_lemma;
+    uint32_t d_userLevel;
+    uint32_t d_age;
+  };
+
+  /** Returns true if the current assignment violates cut. */
+  static bool violated(const ArithVariables& vars, const GomoryCut& cut);
+
+  /** Drops the cut at position i, by moving the last one there. */
+  void drop(size_t i);
+
+  std::vector<Entry> d_cuts;
+  uint32_t d_maxAge;
+  /** The lemmas sent out in the current SAT context. */
+  context::CDHashSet<Node, NodeHashFunction> d_sent;
+
+  /** Beyond this many cuts, adding a cut drops the weakest one. */
+  static const size_t s_maxSize = 512;
+}; /* class CutPool */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
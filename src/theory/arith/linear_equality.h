@@ -254,6 +254,9 @@ public:
    */
   void pivotAndUpdate(ArithVar x_i, ArithVar x_j, const DeltaRational& v);
 
+  /** The number of pivots made so far, as counted by the statistics. */
+  int64_t getPivotCount() const { return d_statistics.d_statPivots.getData(); }
+
   ArithVariables& getVariables() const{ return d_variables; }
   Tableau& getTableau() const{ return d_tableau; }
 
@@ -207,6 +207,11 @@ public:
   uint32_t size() const{ return d_size; }
   uint32_t capacity() const{ return d_entries.capacity(); }
 
+  /** Every EntryID handed out so far is less than idBound(). */
+  uint32_t idBound() const{ return d_entries.size(); }
+
+  void reserve(uint32_t n){ d_entries.reserve(n); }
+
 
 private:
   bool inBounds(EntryID id) const{
@@ -395,6 +400,11 @@ protected:
   uint32_t d_entriesInUse;
   MatrixEntryVector<T> d_entries;
 
+  /* The number of entries added since the last repack(). */
+  uint32_t d_entriesSinceRepack;
+  /* Small matrices are not worth repacking. */
+  static constexpr uint32_t s_minRepackEntries = 1024;
+
   std::vector<RowIndex> d_pool;
 
   T d_zero;
@@ -410,6 +420,7 @@ public:
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
+    d_entriesSinceRepack(0),
     d_zero(0)
   {}
 
@@ -420,6 +431,7 @@ public:
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
+    d_entriesSinceRepack(0),
     d_zero(zero)
   {}
 
@@ -430,6 +442,7 @@ public:
     d_rowInMergeBuffer(m.d_rowInMergeBuffer),
     d_entriesInUse(m.d_entriesInUse),
     d_entries(m.d_entries),
+    d_entriesSinceRepack(m.d_entriesSinceRepack),
     d_zero(m.d_zero)
   {
     d_columns.clear();
@@ -449,6 +462,7 @@ public:
     d_rowInMergeBuffer = (m.d_rowInMergeBuffer);
     d_entriesInUse = (m.d_entriesInUse);
     d_entries = (m.d_entries);
+    d_entriesSinceRepack = (m.d_entriesSinceRepack);
     d_zero = (m.d_zero);
     d_columns.clear();
     for(typename ColumnTable::const_iterator c=m.d_columns.begin(), cend = m.d_columns.end(); c!=cend; ++c){
@@ -479,6 +493,7 @@ protected:
     Assert(newEntry.getCoefficient() != 0);
 
     ++d_entriesInUse;
+    ++d_entriesSinceRepack;
 
     d_rows[row].insert(newId);
     d_columns[col].insert(newId);
@@ -587,6 +602,78 @@ public:
   }
 
 
+  /**
+   * Moves the entries so that the entries of each row are contiguous and
+   * laid out in the order the row is traversed, the rows following each
+   * other by RowIndex. The order in which every row and column is traversed
+   * is unchanged, but the EntryIDs are not: no EntryID may be held across
+   * a call. The merge buffer must be empty.
+   */
+  void repack(){
+    Assert(d_mergeBuffer.empty());
+    Assert(d_rowInMergeBuffer == ROW_INDEX_SENTINEL);
+
+    MatrixEntryVector<T> packed;
+    packed.reserve(d_entriesInUse);
+    // moved : old EntryID |-> new EntryID
+    std::vector<EntryID> moved(d_entries.idBound(), ENTRYID_SENTINEL);
+
+    for(RowIndex r = 0; r < d_rows.size(); ++r){
+      EntryID head = ENTRYID_SENTINEL;
+      EntryID prev = ENTRYID_SENTINEL;
+      RowIterator i = getRow(r).begin(), i_end = getRow(r).end();
+      for(; i != i_end; ++i){
+        const Entry& entry = *i;
+        EntryID id = packed.newEntry();
+        Entry& copy = packed.get(id);
+        copy = Entry(entry.getRowIndex(), entry.getColVar(),
+                     entry.getCoefficient());
+        if(prev == ENTRYID_SENTINEL){
+          head = id;
+        }else{
+          copy.setPrevRowEntryID(prev);
+          packed.get(prev).setNextRowEntryID(id);
+        }
+        moved[i.getID()] = id;
+        prev = id;
+      }
+      d_rows[r] = RowVectorT(head, getRowLength(r), &d_entries);
+    }
+
+    for(ArithVar v = 0; v < d_columns.size(); ++v){
+      EntryID head = ENTRYID_SENTINEL;
+      EntryID prev = ENTRYID_SENTINEL;
+      ColIterator i = getColumn(v).begin(), i_end = getColumn(v).end();
+      for(; i != i_end; ++i){
+        EntryID id = moved[i.getID()];
+        Assert(id != ENTRYID_SENTINEL);
+        if(prev == ENTRYID_SENTINEL){
+          head = id;
+        }else{
+          packed.get(id).setPrevColEntryID(prev);
+          packed.get(prev).setNextColEntryID(id);
+        }
+        prev = id;
+      }
+      d_columns[v] = ColumnVectorT(head, getColLength(v), &d_entries);
+    }
+
+    Assert(packed.size() == d_entriesInUse);
+    d_entries = std::move(packed);
+    d_entriesSinceRepack = 0;
+  }
+
+  /**
+   * Returns true if at least half of the entries in use were added since the
+   * last repack(), and so may be far from the rest of their rows.
+   * Repacking only then keeps the cost of repack() amortized over the
+   * additions.
+   */
+  bool shouldRepack() const {
+    return d_entriesSinceRepack >= s_minRepackEntries &&
+      2 * d_entriesSinceRepack >= d_entriesInUse;
+  }
+
   void loadRowIntoBuffer(RowIndex rid){
     Assert(d_mergeBuffer.empty());
     Assert(d_rowInMergeBuffer == ROW_INDEX_SENTINEL);
@@ -16,6 +16,7 @@
  **/
 
 #include "base/output.h"
+#include "options/arith_options.h"
 #include "theory/arith/tableau.h"
 
 using namespace std;
@@ -23,6 +24,10 @@ namespace CVC4 {
 namespace theory {
 namespace arith {
 
+Tableau::Tableau()
+  : Matrix<Rational>(Rational(0)),
+    d_repack(options::tableauLayout() == options::TableauLayout::PACKED)
+{}
 
 void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallback& cb){
   Assert(isBasic(oldBasic));
@@ -62,6 +67,10 @@ void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallb
   Assert(!isBasic(oldBasic));
   Assert(isBasic(newBasic));
   Assert(getColLength(newBasic) == 1);
+
+  if(d_repack && shouldRepack()){
+    repack();
+  }
 }
 
 /**
@@ -48,9 +48,12 @@ private:
   typedef DenseMap<ArithVar> RowIndexToBasicMap;
   RowIndexToBasicMap d_rowIndex2basic;
 
+  // True if the entries are repacked row by row after pivots (see repack()).
+  bool d_repack;
+
 public:
 
-  Tableau() : Matrix<Rational>(Rational(0)) {}
+  Tableau();
 
   typedef Matrix<Rational>::ColIterator ColIterator;
   typedef Matrix<Rational>::RowIterator RowIterator;
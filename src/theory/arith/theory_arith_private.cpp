@@ -17,8 +17,10 @@
 
 #include "theory/arith/theory_arith_private.h"
 
+#include <algorithm>
 #include <map>
 #include <queue>
+#include <unordered_set>
 #include <vector>
 
 #include "base/output.h"
@@ -53,6 +55,7 @@
 #include "theory/arith/cut_log.h"
 #include "theory/arith/delta_rational.h"
 #include "theory/arith/dio_solver.h"
+#include "theory/arith/float_simplex.h"
 #include "theory/arith/linear_equality.h"
 #include "theory/arith/matrix.h"
 #include "theory/arith/nl/nonlinear_extension.h"
@@ -82,6 +85,7 @@ namespace arith {
 
 static Node toSumNode(const ArithVariables& vars, const DenseMap<Rational>& sum);
 static bool complexityBelow(const DenseMap<Rational>& row, uint32_t cap);
+Node flattenImplication(Node imp);
 
 TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
                                        context::Context* c,
@@ -155,6 +159,7 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
       d_fullCheckCounter(0),
       d_cutCount(c, 0),
       d_cutInContext(c),
+      d_cutPool(c, options::arithCutPoolAge()),
       d_likelyIntegerInfeasible(c, false),
       d_guessedCoeffSet(c, false),
       d_guessedCoeffs(),
@@ -169,6 +174,8 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
       d_solveIntAttempts(0u),
       d_newFacts(false),
       d_previousStatus(Result::SAT_UNKNOWN),
+      d_warmStartValues(),
+      d_firstRelaxation(false),
       d_statistics()
 {
   ProofChecker* pc = pnm != nullptr ? pnm->getChecker() : nullptr;
@@ -331,6 +338,25 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_mipProofsAttempted("theory::arith::z::mip::proofs::attempted", 0)
   , d_mipProofsSuccessful("theory::arith::z::mip::proofs::successful", 0)
   , d_numBranchesFailed("theory::arith::z::mip::branch::proof::failed", 0)
+  , d_floatCalls("theory::arith::float::calls", 0)
+  , d_floatFeasible("theory::arith::float::feasible", 0)
+  , d_floatInfeasible("theory::arith::float::infeasible", 0)
+  , d_floatExhausted("theory::arith::float::exhausted", 0)
+  , d_floatPivots("theory::arith::float::pivots", 0)
+  , d_floatRepairs("theory::arith::float::repairs", 0)
+  , d_floatTimer("theory::arith::float::timer")
+  , d_gomoryRounds("theory::arith::gomory::rounds", 0)
+  , d_gomoryRows("theory::arith::gomory::rows", 0)
+  , d_gomoryCuts("theory::arith::gomory::cuts", 0)
+  , d_gomoryRejected("theory::arith::gomory::rejected", 0)
+  , d_gomoryReused("theory::arith::gomory::reused", 0)
+  , d_gomoryDropped("theory::arith::gomory::dropped", 0)
+  , d_gomoryScore("theory::arith::gomory::score")
+  , d_gomoryTimer("theory::arith::gomory::timer")
+  , d_warmStarts("theory::arith::warmStart::calls", 0)
+  , d_warmStartSat("theory::arith::warmStart::sat", 0)
+  , d_warmStartUnsat("theory::arith::warmStart::unsat", 0)
+  , d_firstRelaxationPivots("theory::arith::firstRelaxationPivots")
 {
   smtStatisticsRegistry()->registerStat(&d_statAssertUpperConflicts);
   smtStatisticsRegistry()->registerStat(&d_statAssertLowerConflicts);
@@ -422,6 +448,26 @@ TheoryArithPrivate::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_mipProofsAttempted);
   smtStatisticsRegistry()->registerStat(&d_mipProofsSuccessful);
   smtStatisticsRegistry()->registerStat(&d_numBranchesFailed);
+
+  smtStatisticsRegistry()->registerStat(&d_floatCalls);
+  smtStatisticsRegistry()->registerStat(&d_floatFeasible);
+  smtStatisticsRegistry()->registerStat(&d_floatInfeasible);
+  smtStatisticsRegistry()->registerStat(&d_floatExhausted);
+  smtStatisticsRegistry()->registerStat(&d_floatPivots);
+  smtStatisticsRegistry()->registerStat(&d_floatRepairs);
+  smtStatisticsRegistry()->registerStat(&d_floatTimer);
+  smtStatisticsRegistry()->registerStat(&d_gomoryRounds);
+  smtStatisticsRegistry()->registerStat(&d_gomoryRows);
+  smtStatisticsRegistry()->registerStat(&d_gomoryCuts);
+  smtStatisticsRegistry()->registerStat(&d_gomoryRejected);
+  smtStatisticsRegistry()->registerStat(&d_gomoryReused);
+  smtStatisticsRegistry()->registerStat(&d_gomoryDropped);
+  smtStatisticsRegistry()->registerStat(&d_gomoryScore);
+  smtStatisticsRegistry()->registerStat(&d_gomoryTimer);
+  smtStatisticsRegistry()->registerStat(&d_warmStarts);
+  smtStatisticsRegistry()->registerStat(&d_warmStartSat);
+  smtStatisticsRegistry()->registerStat(&d_warmStartUnsat);
+  smtStatisticsRegistry()->registerStat(&d_firstRelaxationPivots);
 }
 
 TheoryArithPrivate::Statistics::~Statistics(){
@@ -516,6 +562,26 @@ TheoryArithPrivate::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_mipProofsAttempted);
   smtStatisticsRegistry()->unregisterStat(&d_mipProofsSuccessful);
   smtStatisticsRegistry()->unregisterStat(&d_numBranchesFailed);
+
+  smtStatisticsRegistry()->unregisterStat(&d_floatCalls);
+  smtStatisticsRegistry()->unregisterStat(&d_floatFeasible);
+  smtStatisticsRegistry()->unregisterStat(&d_floatInfeasible);
+  smtStatisticsRegistry()->unregisterStat(&d_floatExhausted);
+  smtStatisticsRegistry()->unregisterStat(&d_floatPivots);
+  smtStatisticsRegistry()->unregisterStat(&d_floatRepairs);
+  smtStatisticsRegistry()->unregisterStat(&d_floatTimer);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryRounds);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryRows);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryCuts);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryRejected);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryReused);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryDropped);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryScore);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryTimer);
+  smtStatisticsRegistry()->unregisterStat(&d_warmStarts);
+  smtStatisticsRegistry()->unregisterStat(&d_warmStartSat);
+  smtStatisticsRegistry()->unregisterStat(&d_warmStartUnsat);
+  smtStatisticsRegistry()->unregisterStat(&d_firstRelaxationPivots);
 }
 
 bool complexityBelow(const DenseMap<Rational>& row, uint32_t cap){
@@ -1465,6 +1531,11 @@ void TheoryArithPrivate::releaseArithVar(ArithVar v){
 
   d_constraintDatabase.removeVariable(v);
   d_partialModel.releaseArithVar(v);
+  if (d_warmStartValues.isKey(v))
+  {
+    d_warmStartValues.remove(v);
+  }
+  d_cutPool.removeVariable(v);
 }
 
 ArithVar TheoryArithPrivate::requestArithVar(TNode x, bool aux, bool internal){
@@ -1652,6 +1723,101 @@ TrustNode TheoryArithPrivate::dioCutting()
   }
 }
 
+bool TheoryArithPrivate::gomoryCutting()
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_gomoryTimer);
+  ++d_statistics.d_gomoryRounds;
+  uint32_t userLevel = d_containing.getUserContext()->getLevel();
+
+  std::vector<TrustNode> lemmas;
+  d_statistics.d_gomoryDropped +=
+      d_cutPool.collect(d_partialModel, userLevel, lemmas);
+  d_statistics.d_gomoryReused += lemmas.size();
+
+  GomoryCutGenerator generator(d_partialModel, d_tableau);
+  std::vector<GomoryCut> cuts;
+  for (Tableau::BasicIterator i = d_tableau.beginBasic(),
+                              i_end = d_tableau.endBasic();
+       i != i_end;
+       ++i)
+  {
+    ArithVar b = *i;
+    if (!isInteger(b) || d_partialModel.getAssignment(b).isIntegral())
+    {
+      continue;
+    }
+    ++d_statistics.d_gomoryRows;
+    cuts.push_back(GomoryCut());
+    if (!generator.derive(b, cuts.back())
+        || !complexityBelow(cuts.back().d_lhs, options::lemmaRejectCutSize()))
+    {
+      ++d_statistics.d_gomoryRejected;
+      cuts.pop_back();
+    }
+  }
+
+  // Strongest first. Ties go to the lower basic variable, so that the cuts
+  // do not depend on the order of the basic variables.
+  std::vector<size_t> order(cuts.size());
+  for (size_t k = 0; k < order.size(); ++k)
+  {
+    order[k] = k;
+  }
+  std::sort(order.begin(), order.end(), [&cuts](size_t a, size_t b) {
+    if (cuts[a].d_score != cuts[b].d_score)
+    {
+      return cuts[a].d_score > cuts[b].d_score;
+    }
+    return cuts[a].d_basic < cuts[b].d_basic;
+  });
+
+  NodeManager* nm = NodeManager::currentNM();
+  size_t added = 0;
+  for (size_t k = 0;
+       k < order.size() && added < options::arithGomoryCutsPerRound();
+       ++k)
+  {
+    const GomoryCut& cut = cuts[order[k]];
+    Node sum = toSumNode(d_partialModel, cut.d_lhs);
+    if (sum.isNull())
+    {
+      ++d_statistics.d_gomoryRejected;
+      continue;
+    }
+    Node cutLiteral = Rewriter::rewrite(
+        nm->mkNode(kind::GEQ, sum, mkRationalNode(cut.d_rhs)));
+    if (cutLiteral.isConst() && cutLiteral.getConst<bool>())
+    {
+      ++d_statistics.d_gomoryRejected;
+      continue;
+    }
+    // the cut is sent as a removable lemma, which has to be a clause
+    Node clause = flattenImplication(
+        Constraint::externalExplainByAssertions(cut.d_explanation)
+            .impNode(cutLiteral));
+    if (d_cutPool.wasSent(clause))
+    {
+      continue;
+    }
+    // TODO (project #37): justify
+    TrustNode lemma = TrustNode::mkTrustLemma(clause, nullptr);
+    Debug("arith::gomory") << "gomory cut on " << cut.d_basic << " score "
+                           << cut.d_score << ": " << clause << endl;
+    d_cutPool.add(cut, lemma, userLevel);
+    lemmas.push_back(lemma);
+    ++added;
+    ++d_statistics.d_gomoryCuts;
+    d_statistics.d_gomoryScore.addEntry(cut.d_score);
+  }
+
+  for (const TrustNode& lemma : lemmas)
+  {
+    Debug("arith::lemma") << "gomory cut " << lemma << endl;
+    (d_containing.d_out)->trustedLemma(lemma, LemmaProperty::REMOVABLE);
+  }
+  return !lemmas.empty();
+}
+
 Node TheoryArithPrivate::callDioSolver(){
   while(!d_constantIntegerVariables.empty()){
     ArithVar v = d_constantIntegerVariables.front();
@@ -3077,6 +3243,113 @@ void TheoryArithPrivate::importSolution(const ApproximateSimplex::Solution& solu
   }
 }
 
+void TheoryArithPrivate::solveFloatRelaxation()
+{
+  ++d_statistics.d_floatCalls;
+  ApproxFloat approxSolver(
+      d_partialModel, d_tableau, getTreeLog(), getApproxStats());
+  approxSolver.setPivotLimit(std::min<unsigned>(
+      options::floatSimplexPivots(), std::numeric_limits<int>::max()));
+
+  LinResult res;
+  {
+    TimerStat::CodeTimer codeTimer(d_statistics.d_floatTimer);
+    res = approxSolver.solveRelaxation();
+  }
+  d_statistics.d_floatPivots += approxSolver.getPivots();
+  Debug("arith::float") << "solveFloatRelaxation() " << res << " after "
+                        << approxSolver.getPivots() << " pivots" << endl;
+
+  // Only the basis is taken from the double precision simplex. The exact
+  // simplex checks it, and keeps pivoting from it, before any conflict or
+  // model is reported.
+  Result::Sat expected;
+  switch (res)
+  {
+    case LinFeasible:
+      ++d_statistics.d_floatFeasible;
+      expected = Result::SAT;
+      break;
+    case LinInfeasible:
+      ++d_statistics.d_floatInfeasible;
+      expected = Result::UNSAT;
+      break;
+    case LinExhausted: ++d_statistics.d_floatExhausted; return;
+    default: return;
+  }
+  importSolution(approxSolver.extractRelaxation());
+  if (d_qflraStatus != expected)
+  {
+    ++d_statistics.d_floatRepairs;
+  }
+}
+
+void TheoryArithPrivate::saveWarmStart()
+{
+  for (ArithVariables::var_iterator vi = d_partialModel.var_begin(),
+                                    vi_end = d_partialModel.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    d_warmStartValues.set(v, d_partialModel.getAssignment(v));
+  }
+}
+
+Result::Sat TheoryArithPrivate::warmStart()
+{
+  // Keep the current basis: only the values of the nonbasic variables are
+  // restored, clipped to their current bounds, which AttemptSolutionSDP does
+  // without pivoting.
+  ApproximateSimplex::Solution solution;
+  for (ArithVariables::var_iterator vi = d_partialModel.var_begin(),
+                                    vi_end = d_partialModel.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    if (d_tableau.isBasic(v))
+    {
+      solution.newBasis.add(v);
+    }
+    else if (d_warmStartValues.isKey(v))
+    {
+      // Bounds asserted since the value was saved take precedence: a
+      // nonbasic variable must never be moved outside of its bounds.
+      const DeltaRational& saved = d_warmStartValues[v];
+      if (d_partialModel.strictlyLessThanLowerBound(v, saved))
+      {
+        solution.newValues.set(v, d_partialModel.getLowerBound(v));
+      }
+      else if (d_partialModel.strictlyGreaterThanUpperBound(v, saved))
+      {
+        solution.newValues.set(v, d_partialModel.getUpperBound(v));
+      }
+      else
+      {
+        solution.newValues.set(v, saved);
+      }
+    }
+  }
+  if (solution.newValues.empty())
+  {
+    return Result::SAT_UNKNOWN;
+  }
+
+  ++d_statistics.d_warmStarts;
+  Result::Sat res = d_attemptSolSimplex.attempt(solution);
+  Debug("arith::warmStart") << "warmStart() " << res << endl;
+  if (res == Result::SAT)
+  {
+    ++d_statistics.d_warmStartSat;
+  }
+  else if (res == Result::UNSAT)
+  {
+    ++d_statistics.d_warmStartUnsat;
+  }
+  return res;
+}
+
 bool TheoryArithPrivate::solveRelaxationOrPanic(Theory::Effort effortLevel){
   // if at this point the linear relaxation is still unknown,
   //  attempt to branch an integer variable as a last ditch effort on full check
@@ -3125,8 +3398,23 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
     << " " << safeToCallApprox()
     << endl;
 
-  bool noPivotLimitPass1 = noPivotLimit && !useApprox;
-  d_qflraStatus = simplex.findModel(noPivotLimitPass1);
+  // the double precision simplex takes over from a pivot limited pass1
+  bool useFloat = options::floatSimplex() && !useApprox;
+
+  bool noPivotLimitPass1 = noPivotLimit && !useApprox && !useFloat;
+
+  bool firstRelaxation = d_firstRelaxation;
+  int64_t pivotsBefore = d_linEq.getPivotCount();
+  d_firstRelaxation = false;
+  Result::Sat warmStatus = Result::SAT_UNKNOWN;
+  if (firstRelaxation && options::arithWarmStart()
+      && !d_warmStartValues.empty())
+  {
+    warmStatus = warmStart();
+  }
+  d_qflraStatus = warmStatus != Result::SAT_UNKNOWN
+                      ? warmStatus
+                      : simplex.findModel(noPivotLimitPass1);
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation()" << " pass1 " << d_qflraStatus << endl;
@@ -3193,8 +3481,19 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
 
   }
 
+  if (d_qflraStatus == Result::SAT_UNKNOWN && useFloat && safeToCallApprox())
+  {
+    solveFloatRelaxation();
+  }
+
   bool emmittedConflictOrSplit = solveRelaxationOrPanic(effortLevel);
 
+  if (firstRelaxation)
+  {
+    d_statistics.d_firstRelaxationPivots.addEntry(d_linEq.getPivotCount()
+                                                  - pivotsBefore);
+  }
+
   // TODO Save zeroes with no conflicts
   d_linEq.stopTrackingBoundCounts();
   d_partialModel.startQueueingBoundCounts();
@@ -3474,6 +3773,10 @@ bool TheoryArithPrivate::postCheck(Theory::Effort effortLevel)
                        << d_qflraStatus << endl;
     d_partialModel.commitAssignmentChanges();
     d_unknownsInARow = 0;
+    if (options::arithWarmStart() && Theory::fullEffort(effortLevel))
+    {
+      saveWarmStart();
+    }
     if(Debug.isOn("arith::consistency")){
       Assert(entireStateIsConsistent("sat comit"));
     }
@@ -3674,6 +3977,19 @@ bool TheoryArithPrivate::postCheck(Theory::Effort effortLevel)
       }
     }
 
+    // Cuts do not replace the branch: branch and bound still guarantees
+    // progress, and the cuts tighten the relaxation it works on.
+    bool emittedCuts = false;
+    if (!emmittedConflictOrSplit && options::arithGomoryCuts()
+        && !proofsEnabled())
+    {
+      emittedCuts = gomoryCutting();
+      if (emittedCuts)
+      {
+        d_cutCount = d_cutCount + 1;
+      }
+    }
+
     if(!emmittedConflictOrSplit) {
       TrustNode possibleLemma = roundRobinBranch();
       if (!possibleLemma.getNode().isNull())
@@ -3686,6 +4002,7 @@ bool TheoryArithPrivate::postCheck(Theory::Effort effortLevel)
         outputTrustedLemma(possibleLemma);
       }
     }
+    emmittedConflictOrSplit = emmittedConflictOrSplit || emittedCuts;
 
     if(options::maxCutsInContext() <= d_cutCount){
       if(d_diosolver.hasMoreDecompositionLemmas()){
@@ -4367,6 +4684,7 @@ void TheoryArithPrivate::presolve(){
   TimerStat::CodeTimer codeTimer(d_statistics.d_presolveTime);
 
   d_statistics.d_initialTableauSize.setData(d_tableau.size());
+  d_firstRelaxation = true;
 
   if(Debug.isOn("paranoid:check_tableau")){ d_linEq.debugCheckTableau(); }
 
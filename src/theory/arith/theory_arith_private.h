@@ -38,6 +38,7 @@
 #include "theory/arith/dual_simplex.h"
 #include "theory/arith/error_set.h"
 #include "theory/arith/fc_simplex.h"
+#include "theory/arith/gomory_cuts.h"
 #include "theory/arith/infer_bounds.h"
 #include "theory/arith/linear_equality.h"
 #include "theory/arith/matrix.h"
@@ -241,6 +242,13 @@ private:
    */
   TrustNode dioCutting();
 
+  /**
+   * Sends out, as removable lemmas, the pooled Gomory cuts that apply again,
+   * and the strongest new Gomory cuts of the rows of fractional integer
+   * basic variables. Returns true if a lemma was sent out.
+   */
+  bool gomoryCutting();
+
   Comparison mkIntegerEqualityFromAssignment(ArithVar v);
 
   /**
@@ -381,6 +389,25 @@ private:
 
   bool solveRealRelaxation(Theory::Effort effortLevel);
 
+  /**
+   * Searches for a basis with the double precision simplex (ApproxFloat),
+   * and imports it into the exact tableau. Sets d_qflraStatus.
+   */
+  void solveFloatRelaxation();
+
+  /**
+   * Saves the assignment of every variable, as the assignment the next
+   * check-sat call starts from if options::arithWarmStart() is set.
+   */
+  void saveWarmStart();
+
+  /**
+   * Sets every nonbasic variable that has a value saved by saveWarmStart()
+   * back to that value, and updates the basic variables. Returns SAT or UNSAT
+   * if this already decides the real relaxation, and SAT_UNKNOWN otherwise.
+   */
+  Result::Sat warmStart();
+
   /* Returns true if this is heuristically a good time to try
    * to solve the integers.
    */
@@ -721,6 +748,9 @@ private:
   context::CDO<unsigned> d_cutCount;
   context::CDHashSet<ArithVar, std::hash<ArithVar> > d_cutInContext;
 
+  /** The Gomory cuts sent out so far, kept for reuse. */
+  CutPool d_cutPool;
+
   context::CDO<bool> d_likelyIntegerInfeasible;
 
 
@@ -776,6 +806,16 @@ private:
   Result::Sat d_previousStatus;
   //---------------- end during check
 
+  //---------------- warm start
+  /**
+   * The assignment at the last full effort check at which the real
+   * relaxation was satisfiable. Released variables are removed.
+   */
+  DenseMap<DeltaRational> d_warmStartValues;
+  /** Whether no real relaxation was solved yet in this check-sat call. */
+  bool d_firstRelaxation;
+  //---------------- end warm start
+
   /** These fields are designed to be accessible to TheoryArith methods. */
   class Statistics {
   public:
@@ -870,7 +910,42 @@ private:
 
     IntStat d_numBranchesFailed;
 
-
+    /** Calls to, and results of, the double precision simplex. */
+    IntStat d_floatCalls;
+    IntStat d_floatFeasible;
+    IntStat d_floatInfeasible;
+    IntStat d_floatExhausted;
+    /** Pivots made by the double precision simplex. */
+    IntStat d_floatPivots;
+    /**
+     * Imported bases on which the exact simplex did not confirm the result
+     * of the double precision simplex, and so has to keep searching.
+     */
+    IntStat d_floatRepairs;
+    TimerStat d_floatTimer;
+
+    /**
+     * Full effort checks that looked for Gomory cuts, rows they came from,
+     * and what came of them.
+     */
+    IntStat d_gomoryRounds;
+    IntStat d_gomoryRows;
+    IntStat d_gomoryCuts;
+    IntStat d_gomoryRejected;
+    IntStat d_gomoryReused;
+    IntStat d_gomoryDropped;
+    AverageStat d_gomoryScore;
+    TimerStat d_gomoryTimer;
+
+    /** Warm starts, and the ones that decided the relaxation alone. */
+    IntStat d_warmStarts;
+    IntStat d_warmStartSat;
+    IntStat d_warmStartUnsat;
+    /**
+     * Pivots made by the first real relaxation of each check-sat call, with
+     * or without a warm start.
+     */
+    AverageStat d_firstRelaxationPivots;
 
     Statistics();
     ~Statistics();
@@ -0,0 +1,467 @@
+/*********************                                                        */
+/*! \file persistent_rewrite_cache.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A rewrite cache persisting across processes in a file
+ **
+ ** A rewrite cache persisting across processes in a file.
+ **/
+
+#include "theory/persistent_rewrite_cache.h"
+
+#include <fcntl.h>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
+#include "base/check.h"
+#include "base/configuration.h"
+#include "base/exception.h"
+#include "expr/kind.h"
+#include "expr/node_manager.h"
+#include "expr/node_serializer.h"
+#include "options/options.h"
+#include "smt/smt_statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+namespace {
+
+/** The magic number the file starts with */
+const char MAGIC[8] = {'C', 'V', 'C', '4', 'R', 'W', 'C', '2'};
+
+/** The header of the file */
+struct FileHeader
+{
+  char d_magic[sizeof(MAGIC)];
+  /** See PersistentRewriteCache::fingerprint() */
+  uint64_t d_fingerprint;
+};
+
+/**
+ * The header of an entry in the file, followed by the key and the value.
+ * Integers are in the byte order of the machine.
+ */
+struct RecordHeader
+{
+  /** The hash of the key and theory */
+  uint64_t d_hash;
+  /** The theory */
+  uint32_t d_theory;
+  /** The size of the key */
+  uint32_t d_keySize;
+  /** The size of the value */
+  uint32_t d_valueSize;
+  /** A checksum of the key and value, to detect torn writes */
+  uint32_t d_checksum;
+};
+
+/** 64-bit FNV-1a hash of size bytes at data, continuing from h */
+uint64_t fnv1a(const char* data,
+               size_t size,
+               uint64_t h = 14695981039346656037u)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    h ^= static_cast<uint8_t>(data[i]);
+    h *= 1099511628211u;
+  }
+  return h;
+}
+
+uint32_t checksum(const char* key,
+                  size_t keySize,
+                  const char* value,
+                  size_t valueSize)
+{
+  return static_cast<uint32_t>(fnv1a(value, valueSize, fnv1a(key, keySize)));
+}
+
+}  // namespace
+
+const char* const PersistentRewriteCache::s_ignoredOptions[] = {
+    // the cache itself
+    "rewrite-cache-file",
+    "rewrite-cache-max-size",
+    // output
+    "diagnostic-output-channel",
+    "dump",
+    "dump-instantiations",
+    "dump-models",
+    "dump-proofs",
+    "dump-to",
+    "dump-unsat-cores",
+    "dump-unsat-cores-full",
+    "output-language",
+    "pp-profile",
+    "print-success",
+    "regular-output-channel",
+    "statistics",
+    "stats-every-query",
+    "stats-hide-zeros",
+    "verbosity",
+    // interaction
+    "help",
+    "interactive",
+    "interactive-mode",
+    "interactive-prompt",
+    "segv-spin",
+    "version",
+    // limits, see also isIgnoredOption()
+    "reproducible-resource-limit",
+    "rlimit",
+    "tlimit",
+    "tlimit-per",
+    nullptr};
+
+bool PersistentRewriteCache::isIgnoredOption(const std::string& name)
+{
+  // the weights of resources
+  const std::string step = "-step";
+  if (name.size() > step.size()
+      && name.compare(name.size() - step.size(), step.size(), step) == 0)
+  {
+    return true;
+  }
+  for (const char* const* opt = s_ignoredOptions; *opt != nullptr; ++opt)
+  {
+    if (name == *opt)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+PersistentRewriteCache::PersistentRewriteCache(const std::string& filename,
+                                               uint64_t maxSize)
+    : d_fd(-1),
+      d_map(nullptr),
+      d_mapSize(0),
+      d_fileSize(0),
+      d_maxSize(maxSize),
+      d_fingerprint(fingerprint()),
+      d_hits("theory::rewriteCache::hits", 0),
+      d_misses("theory::rewriteCache::misses", 0),
+      d_stores("theory::rewriteCache::stores", 0),
+      d_rejected("theory::rewriteCache::rejected", 0),
+      d_bytes("theory::rewriteCache::bytes", 0)
+{
+#ifdef _WIN32
+  throw Exception("the persistent rewrite cache is not supported on Windows");
+#else  /* _WIN32 */
+  d_fd = open(filename.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (d_fd < 0)
+  {
+    throw Exception("cannot open rewrite cache " + filename + ": "
+                    + std::strerror(errno));
+  }
+  struct stat st;
+  if (fstat(d_fd, &st) != 0)
+  {
+    close(d_fd);
+    throw Exception("cannot open rewrite cache " + filename + ": "
+                    + std::strerror(errno));
+  }
+  d_fileSize = st.st_size;
+  if (d_fileSize == 0)
+  {
+    FileHeader header;
+    std::memcpy(header.d_magic, MAGIC, sizeof(MAGIC));
+    header.d_fingerprint = d_fingerprint;
+    if (write(d_fd, &header, sizeof(header)) == sizeof(header))
+    {
+      d_fileSize = sizeof(header);
+    }
+    else
+    {
+      d_maxSize = 0;
+    }
+  }
+  else
+  {
+    void* map = mmap(nullptr, d_fileSize, PROT_READ, MAP_SHARED, d_fd, 0);
+    if (map == MAP_FAILED)
+    {
+      close(d_fd);
+      throw Exception("cannot map rewrite cache " + filename + ": "
+                      + std::strerror(errno));
+    }
+    d_map = static_cast<char*>(map);
+    d_mapSize = d_fileSize;
+    indexFile();
+  }
+#endif /* _WIN32 */
+  d_bytes.setData(d_fileSize);
+  smtStatisticsRegistry()->registerStat(&d_hits);
+  smtStatisticsRegistry()->registerStat(&d_misses);
+  smtStatisticsRegistry()->registerStat(&d_stores);
+  smtStatisticsRegistry()->registerStat(&d_rejected);
+  smtStatisticsRegistry()->registerStat(&d_bytes);
+}
+
+PersistentRewriteCache::~PersistentRewriteCache()
+{
+  flush();
+  smtStatisticsRegistry()->unregisterStat(&d_hits);
+  smtStatisticsRegistry()->unregisterStat(&d_misses);
+  smtStatisticsRegistry()->unregisterStat(&d_stores);
+  smtStatisticsRegistry()->unregisterStat(&d_rejected);
+  smtStatisticsRegistry()->unregisterStat(&d_bytes);
+#ifndef _WIN32
+  if (d_map != nullptr)
+  {
+    munmap(d_map, d_mapSize);
+  }
+  close(d_fd);
+#endif /* _WIN32 */
+}
+
+void PersistentRewriteCache::indexFile()
+{
+  FileHeader fileHeader;
+  if (d_mapSize < sizeof(fileHeader))
+  {
+    d_maxSize = 0;
+    return;
+  }
+  std::memcpy(&fileHeader, d_map, sizeof(fileHeader));
+  if (std::memcmp(fileHeader.d_magic, MAGIC, sizeof(MAGIC)) != 0
+      || fileHeader.d_fingerprint != d_fingerprint)
+  {
+    // not a rewrite cache of this build and options, don't add to it either
+    Trace("rewrite-cache") << "rewrite cache: fingerprint mismatch, ignoring "
+                              "the file"
+                           << std::endl;
+    d_maxSize = 0;
+    return;
+  }
+  uint64_t pos = sizeof(fileHeader);
+  while (d_mapSize - pos >= sizeof(RecordHeader))
+  {
+    RecordHeader header;
+    std::memcpy(&header, d_map + pos, sizeof(header));
+    pos += sizeof(header);
+    uint64_t size =
+        static_cast<uint64_t>(header.d_keySize) + header.d_valueSize;
+    if (size > d_mapSize - pos)
+    {
+      // a torn write at the end of the file
+      break;
+    }
+    Entry e;
+    e.d_theory = header.d_theory;
+    e.d_key = d_map + pos;
+    e.d_keySize = header.d_keySize;
+    e.d_value = e.d_key + e.d_keySize;
+    e.d_valueSize = header.d_valueSize;
+    pos += size;
+    if (checksum(e.d_key, e.d_keySize, e.d_value, e.d_valueSize)
+        != header.d_checksum)
+    {
+      // a torn write, with other entries written after it
+      continue;
+    }
+    d_index.emplace(header.d_hash, e);
+  }
+}
+
+void PersistentRewriteCache::flush()
+{
+  if (d_buffer.empty())
+  {
+    return;
+  }
+#ifndef _WIN32
+  // a single write of whole records, so that processes sharing the file
+  // never interleave parts of records
+  if (write(d_fd, d_buffer.data(), d_buffer.size())
+      == static_cast<ssize_t>(d_buffer.size()))
+  {
+    d_fileSize += d_buffer.size();
+    d_bytes.setData(d_fileSize);
+  }
+#endif /* _WIN32 */
+  d_buffer.clear();
+}
+
+uint64_t PersistentRewriteCache::fingerprint()
+{
+  std::ostringstream fp;
+  fp << Configuration::getVersionString() << ' ' << Configuration::getGitId();
+  // the serialization refers to kinds and type constants by number
+  for (unsigned k = 0; k < kind::LAST_KIND; ++k)
+  {
+    fp << ' ' << static_cast<Kind>(k);
+  }
+  for (unsigned t = 0; t < LAST_TYPE; ++t)
+  {
+    fp << ' ' << static_cast<TypeConstant>(t);
+  }
+  // all options but those that cannot change a rewrite, by their current
+  // value
+  for (const std::vector<std::string>& opt : Options::current()->getOptions())
+  {
+    Assert(opt.size() == 2);
+    // the long name, without its argument
+    std::string name = opt[0].substr(0, opt[0].find('='));
+    if (!isIgnoredOption(name))
+    {
+      fp << ' ' << name << '=' << opt[1];
+    }
+  }
+  std::string s = fp.str();
+  return fnv1a(s.data(), s.size());
+}
+
+bool PersistentRewriteCache::computeKey(TNode n,
+                                        std::string& key,
+                                        std::vector<Node>& vars,
+                                        std::vector<TypeNode>& sorts)
+{
+  std::ostringstream out;
+  try
+  {
+    expr::serializeNodesCanonical({n}, out, vars, sorts);
+  }
+  catch (const Exception& e)
+  {
+    // n contains something that cannot be serialized
+    return false;
+  }
+  key = out.str();
+  return true;
+}
+
+uint64_t PersistentRewriteCache::hash(TheoryId tid, const std::string& key)
+{
+  uint32_t theory = tid;
+  return fnv1a(key.data(),
+               key.size(),
+               fnv1a(reinterpret_cast<const char*>(&theory), sizeof(theory)));
+}
+
+const PersistentRewriteCache::Entry* PersistentRewriteCache::find(
+    TheoryId tid, const std::string& key, uint64_t h) const
+{
+  auto range = d_index.equal_range(h);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    const Entry& e = it->second;
+    if (e.d_theory == static_cast<uint32_t>(tid) && e.d_keySize == key.size()
+        && std::memcmp(e.d_key, key.data(), key.size()) == 0)
+    {
+      return &e;
+    }
+  }
+  return nullptr;
+}
+
+Node PersistentRewriteCache::lookup(TheoryId tid, TNode n)
+{
+  std::string key;
+  std::vector<Node> vars;
+  std::vector<TypeNode> sorts;
+  if (!computeKey(n, key, vars, sorts))
+  {
+    ++d_rejected;
+    return Node::null();
+  }
+  const Entry* e = find(tid, key, hash(tid, key));
+  if (e != nullptr)
+  {
+    // load the value with the variables and sorts of n
+    expr::NodeDeserializer d(NodeManager::currentNM());
+    d.bind(vars, sorts);
+    try
+    {
+      std::vector<Node> nodes = d.deserialize(e->d_value, e->d_valueSize);
+      if (nodes.size() == 2 && nodes[0] == n && !nodes[1].isNull())
+      {
+        ++d_hits;
+        return nodes[1];
+      }
+    }
+    catch (const Exception& ex)
+    {
+      // an unreadable entry, e.g. of another version of CVC4; the
+      // deserializer validates its input and reports every malformed value
+      // by an Exception
+    }
+  }
+  ++d_misses;
+  return Node::null();
+}
+
+void PersistentRewriteCache::store(TheoryId tid, TNode n, TNode rewritten)
+{
+  std::string key;
+  std::vector<Node> vars;
+  std::vector<TypeNode> sorts;
+  if (!computeKey(n, key, vars, sorts))
+  {
+    ++d_rejected;
+    return;
+  }
+  uint64_t h = hash(tid, key);
+  if (find(tid, key, h) != nullptr)
+  {
+    return;
+  }
+  std::ostringstream out;
+  std::vector<Node> valueVars;
+  std::vector<TypeNode> valueSorts;
+  try
+  {
+    expr::serializeNodesCanonical(
+        {n, rewritten}, out, valueVars, valueSorts);
+  }
+  catch (const Exception& e)
+  {
+    ++d_rejected;
+    return;
+  }
+  // the rewritten term must not introduce variables or sorts, which would be
+  // loaded as fresh ones
+  std::string value = out.str();
+  if (valueVars.size() != vars.size() || valueSorts.size() != sorts.size()
+      || d_fileSize + d_buffer.size() + sizeof(RecordHeader) + key.size()
+                 + value.size()
+             > d_maxSize)
+  {
+    ++d_rejected;
+    return;
+  }
+
+  RecordHeader header;
+  header.d_hash = h;
+  header.d_theory = tid;
+  header.d_keySize = key.size();
+  header.d_valueSize = value.size();
+  header.d_checksum =
+      checksum(key.data(), key.size(), value.data(), value.size());
+  d_buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  d_buffer += key;
+  d_buffer += value;
+  ++d_stores;
+  if (d_buffer.size() >= s_bufferSize)
+  {
+    flush();
+  }
+}
+
+}  // namespace theory
+}  // namespace CVC4
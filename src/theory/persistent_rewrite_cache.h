@@ -0,0 +1,165 @@
+/*********************                                                        */
+/*! \file persistent_rewrite_cache.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A rewrite cache persisting across processes in a file
+ **
+ ** A rewrite cache persisting across processes in a file, so that terms
+ ** submitted again and again (e.g. a library of background axioms) are
+ ** rewritten only once.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__PERSISTENT_REWRITE_CACHE_H
+#define CVC4__THEORY__PERSISTENT_REWRITE_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+#include "theory/theory_id.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+
+/**
+ * A rewrite cache backed by a file, shared by all the processes using the
+ * same file.
+ *
+ * Entries are keyed by the canonical serialization of the term (see
+ * expr::serializeNodesCanonical()) and the theory rewriting it, and store the
+ * serialization of the rewritten term.  Variables and uninterpreted sorts are
+ * matched by name, so only rewritten terms over the variables and sorts of
+ * the original term are stored.
+ *
+ * The file is an append-only log of entries, which is memory-mapped when the
+ * cache is opened.  Entries added later by this process are buffered and
+ * appended to the file in batches; they are not looked up again by this
+ * process, whose rewriter caches them already.  Entries are not added once
+ * the file reaches its size cap.  Unreadable entries (e.g. a torn write) are
+ * ignored.
+ *
+ * The file starts with a fingerprint of the kind table of this build and of
+ * the values of the options (see fingerprint()).  A file with another
+ * fingerprint is neither read nor added to, since its entries may not be
+ * rewrites in this configuration.
+ *
+ * Every option is part of the fingerprint, except those listed in
+ * s_ignoredOptions, which cannot change what a rewriter returns (e.g. the
+ * verbosity and the time limit).  An option missing from that list only
+ * makes the cache miss more often.
+ */
+class PersistentRewriteCache
+{
+ public:
+  /**
+   * Open (or create) the cache in the given file, which grows to at most
+   * maxSize bytes.  Throws an Exception if the file cannot be opened.
+   */
+  PersistentRewriteCache(const std::string& filename, uint64_t maxSize);
+  ~PersistentRewriteCache();
+
+  /**
+   * Get the rewritten form of n by the given theory, or the null node if it
+   * is not in the cache.
+   */
+  Node lookup(TheoryId tid, TNode n);
+
+  /** Store that n is rewritten to rewritten by the given theory. */
+  void store(TheoryId tid, TNode n, TNode rewritten);
+
+ private:
+  /** An entry in the file or in memory */
+  struct Entry
+  {
+    /** The theory of the entry */
+    uint32_t d_theory;
+    /** The key, a canonical serialization of the original term */
+    const char* d_key;
+    uint32_t d_keySize;
+    /** The value, a canonical serialization of the original and the
+     * rewritten term */
+    const char* d_value;
+    uint32_t d_valueSize;
+  };
+
+  /** Index the entries of the mapped file */
+  void indexFile();
+
+  /** Append the buffered entries to the file */
+  void flush();
+
+  /**
+   * The fingerprint of this build and of the current values of the options
+   * the rewriters may depend on.
+   */
+  static uint64_t fingerprint();
+
+  /**
+   * The long names of the options that do not change what the rewriters
+   * return, terminated by nullptr.
+   */
+  static const char* const s_ignoredOptions[];
+
+  /**
+   * Return true if the option with the given long name is left out of the
+   * fingerprint.
+   */
+  static bool isIgnoredOption(const std::string& name);
+
+  /**
+   * Compute the key of n, and the variables and sorts in it.  Returns false
+   * if n cannot be serialized.
+   */
+  static bool computeKey(TNode n,
+                         std::string& key,
+                         std::vector<Node>& vars,
+                         std::vector<TypeNode>& sorts);
+
+  /** The stable hash of a key and a theory */
+  static uint64_t hash(TheoryId tid, const std::string& key);
+
+  /** Find the entry for the given key, or nullptr if there is none */
+  const Entry* find(TheoryId tid, const std::string& key, uint64_t h) const;
+
+  /** The file descriptor of the file, open for appending */
+  int d_fd;
+  /** The mapping of the file, as of when the cache was opened */
+  char* d_map;
+  /** The size of the mapping */
+  uint64_t d_mapSize;
+  /** The size of the file */
+  uint64_t d_fileSize;
+  /** The size cap of the file */
+  uint64_t d_maxSize;
+  /** The fingerprint the file must start with */
+  uint64_t d_fingerprint;
+  /** The entries of the file, by the hash of their key and theory */
+  std::unordered_multimap<uint64_t, Entry> d_index;
+  /** The records of the entries added by this process, not yet written */
+  std::string d_buffer;
+  /** The size from which d_buffer is written to the file */
+  static const size_t s_bufferSize = 1 << 16;
+
+  /** Statistics */
+  IntStat d_hits;
+  IntStat d_misses;
+  IntStat d_stores;
+  IntStat d_rejected;
+  IntStat d_bytes;
+}; /* class PersistentRewriteCache */
+
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__PERSISTENT_REWRITE_CACHE_H */
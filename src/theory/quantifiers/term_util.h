@@ -41,6 +41,24 @@ typedef expr::Attribute<TermDepthAttributeId, uint64_t> TermDepthAttribute;
 struct ContainsUConstAttributeId {};
 typedef expr::Attribute<ContainsUConstAttributeId, uint64_t> ContainsUConstAttribute;
 
+}  // namespace theory
+
+// These are computed for every subterm of the quantified formulas.
+namespace expr {
+namespace attr {
+template <>
+struct UseDenseStorage<theory::InstConstantAttribute> : public std::true_type
+{
+};
+template <>
+struct UseDenseStorage<theory::TermDepthAttribute> : public std::true_type
+{
+};
+}  // namespace attr
+}  // namespace expr
+
+namespace theory {
+
 /**
  * for quantifier instantiation level.
  */
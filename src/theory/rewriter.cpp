@@ -17,12 +17,15 @@
 
 #include "theory/rewriter.h"
 
+#include <unordered_set>
+
 #include "expr/term_conversion_proof_generator.h"
 #include "options/theory_options.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/builtin/proof_checker.h"
+#include "theory/persistent_rewrite_cache.h"
 #include "theory/rewriter_tables.h"
 #include "theory/theory.h"
 #include "util/resource_manager.h"
@@ -52,6 +55,14 @@ static TheoryId theoryOf(TNode node) {
   return kindToTheoryId(node.getKind());
 }
 
+#ifdef CVC4_ASSERTIONS
+/**
+ * The nodes this thread is fully rewriting after a change of theory, to catch
+ * rewrite loops.
+ */
+thread_local std::unordered_set<TNode, TNodeHashFunction> s_rewriteStack;
+#endif /* CVC4_ASSERTIONS */
+
 /**
  * TheoryEngine::rewrite() keeps a stack of things that are being pre-
  * and post-rewritten.  Each element of the stack is a
@@ -92,6 +103,8 @@ struct RewriteStackElement {
   NodeBuilder<> d_builder;
 };
 
+Rewriter::~Rewriter() {}
+
 RewriteResponse identityRewrite(RewriteEnvironment* re, TNode n)
 {
   return RewriteResponse(REWRITE_DONE, n);
@@ -104,7 +117,12 @@ Node Rewriter::rewrite(TNode node) {
     // eagerly for the sake of efficiency here.
     return node;
   }
-  return getInstance()->rewriteTo(theoryOf(node), node);
+  Rewriter* rewriter = getInstance();
+  if (rewriter->d_persistentCache != nullptr)
+  {
+    return rewriter->rewriteWithPersistentCache(theoryOf(node), node);
+  }
+  return rewriter->rewriteTo(theoryOf(node), node);
 }
 
 TrustNode Rewriter::rewriteWithProof(TNode node,
@@ -139,6 +157,34 @@ void Rewriter::setProofNodeManager(ProofNodeManager* pnm)
   }
 }
 
+void Rewriter::openPersistentCache(const std::string& filename,
+                                   uint64_t maxSize)
+{
+  d_persistentCache.reset(new PersistentRewriteCache(filename, maxSize));
+}
+
+Node Rewriter::rewriteWithPersistentCache(theory::TheoryId theoryId,
+                                          TNode node)
+{
+  // nodes rewritten in this process are in the rewrite cache already
+  Node cached = getPostRewriteCache(theoryId, node);
+  if (!cached.isNull())
+  {
+    return cached;
+  }
+  cached = d_persistentCache->lookup(theoryId, node);
+  if (!cached.isNull())
+  {
+    Trace("rewriter") << "Rewriter::rewriteWithPersistentCache(" << theoryId
+                      << "," << node << ") hit: " << cached << std::endl;
+    setPostRewriteCache(theoryId, node, cached);
+    return cached;
+  }
+  Node ret = rewriteTo(theoryId, node);
+  d_persistentCache->store(theoryId, node, ret);
+  return ret;
+}
+
 Node Rewriter::rewriteEqualityExt(TNode node)
 {
   Assert(node.getKind() == kind::EQUAL);
@@ -193,11 +239,6 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
   RewriteWithProofsAttribute rpfa;
 #ifdef CVC4_ASSERTIONS
   bool isEquality = node.getKind() == kind::EQUAL && (!node[0].getType().isBoolean());
-
-  if (d_rewriteStack == nullptr)
-  {
-    d_rewriteStack.reset(new std::unordered_set<Node, NodeHashFunction>());
-  }
 #endif
 
   Trace("rewriter") << "Rewriter::rewriteTo(" << theoryId << "," << node << ")"<< std::endl;
@@ -328,16 +369,14 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
         {
           // In the post rewrite if we've changed theories, we must do a full rewrite
           Assert(response.d_node != rewriteStackTop.d_node);
-          //TODO: this is not thread-safe - should make this assertion dependent on sequential build
 #ifdef CVC4_ASSERTIONS
-          Assert(d_rewriteStack->find(response.d_node)
-                 == d_rewriteStack->end());
-          d_rewriteStack->insert(response.d_node);
+          Assert(s_rewriteStack.find(response.d_node) == s_rewriteStack.end());
+          s_rewriteStack.insert(response.d_node);
 #endif
           Node rewritten = rewriteTo(newTheoryId, response.d_node, tcpg);
           rewriteStackTop.d_node = rewritten;
 #ifdef CVC4_ASSERTIONS
-          d_rewriteStack->erase(response.d_node);
+          s_rewriteStack.erase(response.d_node);
 #endif
           break;
         }
@@ -505,7 +544,7 @@ void Rewriter::clearCaches() {
   Rewriter* rewriter = getInstance();
 
 #ifdef CVC4_ASSERTIONS
-  rewriter->d_rewriteStack.reset(nullptr);
+  s_rewriteStack.clear();
 #endif
 
   rewriter->clearCachesInternal();
@@ -28,6 +28,7 @@ class ProofNodeManager;
 
 namespace theory {
 
+class PersistentRewriteCache;
 class TrustNode;
 
 namespace builtin {
@@ -59,6 +60,7 @@ class Rewriter {
 
  public:
   Rewriter();
+  ~Rewriter();
 
   /**
    * Rewrites the node using theoryOf() to determine which rewriter to
@@ -95,6 +97,13 @@ class Rewriter {
   /** Set proof node manager */
   void setProofNodeManager(ProofNodeManager* pnm);
 
+  /**
+   * Consult and extend the persistent rewrite cache in the given file, which
+   * grows to at most maxSize bytes (see PersistentRewriteCache), when
+   * rewriting terms with rewrite().
+   */
+  void openPersistentCache(const std::string& filename, uint64_t maxSize);
+
   /**
    * Garbage collects the rewrite caches.
    */
@@ -169,6 +178,12 @@ class Rewriter {
   /** Sets the appropriate cache for a node */
   void setPostRewriteCache(theory::TheoryId theoryId, TNode node, TNode cache);
 
+  /**
+   * Rewrites the node using the given theory rewriter, consulting the
+   * persistent cache first.
+   */
+  Node rewriteWithPersistentCache(theory::TheoryId theoryId, TNode node);
+
   /**
    * Rewrites the node using the given theory rewriter.
    */
@@ -225,10 +240,8 @@ class Rewriter {
 
   /** The proof generator */
   std::unique_ptr<TConvProofGenerator> d_tpg;
-#ifdef CVC4_ASSERTIONS
-  std::unique_ptr<std::unordered_set<Node, NodeHashFunction>> d_rewriteStack =
-      nullptr;
-#endif /* CVC4_ASSERTIONS */
+  /** The persistent rewrite cache, if any */
+  std::unique_ptr<PersistentRewriteCache> d_persistentCache;
 };/* class Rewriter */
 
 }/* CVC4::theory namespace */
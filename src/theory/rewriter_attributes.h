@@ -26,6 +26,23 @@ namespace theory {
 template <bool pre, theory::TheoryId theoryId>
 struct RewriteCacheTag {};
 
+}/* CVC4::theory namespace */
+
+// The rewrite caches are consulted for every node that is rewritten, so they
+// are kept in dense tables.
+namespace expr {
+namespace attr {
+template <bool pre, theory::TheoryId theoryId>
+struct UseDenseStorage<
+    expr::Attribute<theory::RewriteCacheTag<pre, theoryId>, Node>>
+    : public std::true_type
+{
+};
+}/* CVC4::expr::attr namespace */
+}/* CVC4::expr namespace */
+
+namespace theory {
+
 template <theory::TheoryId theoryId>
 struct RewriteAttibute {
 
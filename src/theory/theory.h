@@ -26,6 +26,7 @@
 
 #include "context/cdlist.h"
 #include "context/cdo.h"
+#include "context/cdtrail.h"
 #include "context/context.h"
 #include "expr/node.h"
 #include "options/theory_options.h"
@@ -122,11 +123,14 @@ class Theory {
    */
   context::CDList<Assertion> d_facts;
 
-  /** Index into the head of the facts list */
-  context::CDO<unsigned> d_factsHead;
+  /**
+   * Index into the head of the facts list, updated on every fact and
+   * backtracked with the trail of the SAT context.
+   */
+  context::CDTrailValue<unsigned> d_factsHead;
 
   /** Indices for splitting on the shared terms. */
-  context::CDO<unsigned> d_sharedTermsIndex;
+  context::CDTrailValue<unsigned> d_sharedTermsIndex;
 
   /** The care graph the theory will use during combination. */
   CareGraph* d_careGraph;
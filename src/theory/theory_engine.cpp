@@ -16,6 +16,8 @@
 
 #include "theory/theory_engine.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 
 #include "base/map_util.h"
@@ -238,6 +240,10 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_propagatedLiteralsIndex(context, 0),
       d_atomRequests(context),
       d_combineTheoriesTime("TheoryEngine::combineTheoriesTime"),
+      d_fullCheckRounds("TheoryEngine::fullCheckRounds", 0),
+      d_fullCheckTime("TheoryEngine::fullCheckTime", 0),
+      d_fullCheckCriticalTime("TheoryEngine::fullCheckCriticalTime", 0),
+      d_fullCheckParallelism("TheoryEngine::fullCheckParallelism"),
       d_true(),
       d_false(),
       d_interrupted(false),
@@ -259,6 +265,10 @@ TheoryEngine::TheoryEngine(context::Context* context,
   }
 
   smtStatisticsRegistry()->registerStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->registerStat(&d_fullCheckRounds);
+  smtStatisticsRegistry()->registerStat(&d_fullCheckTime);
+  smtStatisticsRegistry()->registerStat(&d_fullCheckCriticalTime);
+  smtStatisticsRegistry()->registerStat(&d_fullCheckParallelism);
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
 }
@@ -274,6 +284,10 @@ TheoryEngine::~TheoryEngine() {
   }
 
   smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->unregisterStat(&d_fullCheckRounds);
+  smtStatisticsRegistry()->unregisterStat(&d_fullCheckTime);
+  smtStatisticsRegistry()->unregisterStat(&d_fullCheckCriticalTime);
+  smtStatisticsRegistry()->unregisterStat(&d_fullCheckParallelism);
 }
 
 void TheoryEngine::interrupt() { d_interrupted = true; }
@@ -414,10 +428,14 @@ void TheoryEngine::check(Theory::Effort effort) {
   if (theory::TheoryTraits<THEORY>::hasCheck                        \
       && d_logicInfo.isTheoryEnabled(THEORY))                       \
   {                                                                 \
-    theoryOf(THEORY)->check(effort);                                \
+    timedCheck(theoryOf(THEORY), effort, timed ? &round : nullptr); \
     if (d_inConflict)                                               \
     {                                                               \
       Debug("conflict") << THEORY << " in conflict. " << std::endl; \
+      if (timed)                                                    \
+      {                                                             \
+        recordFullCheckRound(round);                                \
+      }                                                             \
       break;                                                        \
     }                                                               \
   }
@@ -466,8 +484,14 @@ void TheoryEngine::check(Theory::Effort effort) {
       // Note that we've discharged all the facts
       d_factsAsserted = false;
 
-      // Do the checking
+      // Do the checking, timing the checks at full effort if asked to
+      bool timed = Theory::fullEffort(effort) && options::fullCheckTiming();
+      FullCheckRound round;
       CVC4_FOR_EACH_THEORY;
+      if (timed)
+      {
+        recordFullCheckRound(round);
+      }
 
       Debug("theory") << "TheoryEngine::check(" << effort << "): running propagation after the initial check" << endl;
 
@@ -552,6 +576,36 @@ void TheoryEngine::check(Theory::Effort effort) {
   }
 }
 
+void TheoryEngine::timedCheck(Theory* t,
+                              Theory::Effort effort,
+                              FullCheckRound* round)
+{
+  if (round == nullptr)
+  {
+    t->check(effort);
+    return;
+  }
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  t->check(effort);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  round->d_time += elapsed.count();
+  round->d_maxTime = std::max(round->d_maxTime, elapsed.count());
+}
+
+void TheoryEngine::recordFullCheckRound(const FullCheckRound& round)
+{
+  ++d_fullCheckRounds;
+  d_fullCheckTime.setData(d_fullCheckTime.getData() + round.d_time);
+  d_fullCheckCriticalTime.setData(d_fullCheckCriticalTime.getData()
+                                  + round.d_maxTime);
+  if (round.d_maxTime > 0)
+  {
+    d_fullCheckParallelism.addEntry(round.d_time / round.d_maxTime);
+  }
+}
+
 void TheoryEngine::propagate(Theory::Effort effort)
 {
   // Reset the interrupt flag
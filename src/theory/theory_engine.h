@@ -278,6 +278,41 @@ class TheoryEngine {
 
   /** Time spent in theory combination */
   TimerStat d_combineTheoriesTime;
+  /**
+   * Statistics on the full effort checks of the theories, recorded with
+   * --full-check-timing. For each round of checks at full effort, we record
+   * the time of the checks of all theories, the time of the longest one,
+   * which bounds what running the checks of the round concurrently could
+   * achieve.
+   */
+  /** Number of rounds of checks at full effort */
+  IntStat d_fullCheckRounds;
+  /** Total time of the checks at full effort, in seconds */
+  BackedStat<double> d_fullCheckTime;
+  /** Sum over the rounds of the time of their longest check, in seconds */
+  BackedStat<double> d_fullCheckCriticalTime;
+  /** Average over the rounds of their time divided by their longest check */
+  AverageStat d_fullCheckParallelism;
+
+  /** The timing of a round of checks at full effort */
+  struct FullCheckRound
+  {
+    /** The sum of the times of the checks of the round, in seconds */
+    double d_time = 0;
+    /** The time of the longest check of the round, in seconds */
+    double d_maxTime = 0;
+  };
+
+  /**
+   * Check theory t at the given effort, adding the time of the check to
+   * round if it is not null.
+   */
+  static void timedCheck(theory::Theory* t,
+                         theory::Theory::Effort effort,
+                         FullCheckRound* round);
+
+  /** Record the statistics of a round of checks at full effort. */
+  void recordFullCheckRound(const FullCheckRound& round);
 
   Node d_true;
   Node d_false;
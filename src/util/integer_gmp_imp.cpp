@@ -17,12 +17,14 @@
 #include "util/integer.h"
 
 #include <cmath>
+#include <numeric>
 #include <sstream>
 #include <string>
 
 #include "cvc4autoconfig.h"
 
 #include "base/check.h"
+#include "util/gmp_util.h"
 #include "util/rational.h"
 
 #ifndef CVC4_GMP_IMP
@@ -33,118 +35,305 @@ using namespace std;
 
 namespace CVC4 {
 
-Integer::Integer(const char* s, unsigned base)
-  : d_value(s, base)
-{}
+bool Integer::mpzToSmall(const mpz_t v, int64_t& r)
+{
+  // mpz_sizeinbase is exact in base 2, and 1 for 0
+  if (mpz_sizeinbase(v, 2) > 63)
+  {
+    return false;
+  }
+  uint64_t mag = 0;
+#if GMP_NUMB_BITS >= 64 && GMP_NAIL_BITS == 0
+  if (mpz_size(v) != 0)
+  {
+    mag = mpz_getlimbn(v, 0);
+  }
+#else
+  mpz_export(&mag, nullptr, -1, sizeof(mag), 0, 0, v);
+#endif
+  r = mpz_sgn(v) < 0 ? -static_cast<int64_t>(mag) : static_cast<int64_t>(mag);
+  return true;
+}
 
-Integer::Integer(const std::string& s, unsigned base)
-  : d_value(s, base)
-{}
+void Integer::smallToMpz(int64_t v, mpz_t r)
+{
+  Assert(isSmallValue(v));
+  if (sizeof(long) >= sizeof(int64_t))
+  {
+    mpz_set_si(r, static_cast<long>(v));
+  }
+  else
+  {
+    uint64_t mag = static_cast<uint64_t>(v < 0 ? -v : v);
+    mpz_import(r, 1, -1, sizeof(mag), 0, 0, &mag);
+    if (v < 0)
+    {
+      mpz_neg(r, r);
+    }
+  }
+}
 
-Integer& Integer::operator=(const Integer& x)
+mpz_srcptr Integer::smallView(int64_t v, mp_limb_t* limbs, mpz_ptr view)
 {
-  if (this == &x) return *this;
-  d_value = x.d_value;
-  return *this;
+  Assert(isSmallValue(v));
+  uint64_t mag = static_cast<uint64_t>(v < 0 ? -v : v);
+  mp_size_t size = 0;
+#if GMP_NUMB_BITS >= 64 && GMP_NAIL_BITS == 0
+  if (mag != 0)
+  {
+    limbs[size++] = static_cast<mp_limb_t>(mag);
+  }
+#else
+  static_assert(2 * GMP_NUMB_BITS >= 64, "a small value must fit in 2 limbs");
+  for (; mag != 0; mag >>= GMP_NUMB_BITS)
+  {
+    limbs[size++] = static_cast<mp_limb_t>(mag) & GMP_NUMB_MASK;
+  }
+#endif
+  return mpz_roinit_n(view, limbs, v < 0 ? -size : size);
 }
 
-bool Integer::operator==(const Integer& y) const
+void Integer::bigOp(void (*op)(mpz_ptr, mpz_srcptr, mpz_srcptr),
+                    const Integer& x,
+                    const Integer& y)
 {
-  return d_value == y.d_value;
+  mp_limb_t l1[2], l2[2];
+  mpz_t v1, v2;
+  mpz_srcptr a =
+      x.isSmall() ? smallView(x.d_small, l1, v1) : x.d_big->get_mpz_t();
+  mpz_srcptr b =
+      y.isSmall() ? smallView(y.d_small, l2, v2) : y.d_big->get_mpz_t();
+  if (d_big == nullptr)
+  {
+    d_big.reset(new mpz_class());
+  }
+  // GMP allows the result to alias the operands
+  op(d_big->get_mpz_t(), a, b);
+  if (mpzToSmall(d_big->get_mpz_t(), d_small))
+  {
+    d_big.reset();
+  }
 }
 
-Integer Integer::operator-() const { return Integer(-(d_value)); }
+void Integer::setValue(const mpz_class& v)
+{
+  if (mpzToSmall(v.get_mpz_t(), d_small))
+  {
+    d_big.reset();
+  }
+  else if (d_big == nullptr)
+  {
+    d_big.reset(new mpz_class(v));
+  }
+  else if (d_big.get() != &v)
+  {
+    *d_big = v;
+  }
+}
 
-bool Integer::operator!=(const Integer& y) const
+Integer::Integer(const char* s, unsigned base) : d_small(0)
 {
-  return d_value != y.d_value;
+  setValue(mpz_class(s, base));
 }
 
-bool Integer::operator<(const Integer& y) const { return d_value < y.d_value; }
+Integer::Integer(const std::string& s, unsigned base) : d_small(0)
+{
+  setValue(mpz_class(s, base));
+}
 
-bool Integer::operator<=(const Integer& y) const
+Integer& Integer::operator=(const Integer& x)
 {
-  return d_value <= y.d_value;
+  if (this == &x) return *this;
+  d_small = x.d_small;
+  if (x.d_big == nullptr)
+  {
+    d_big.reset();
+  }
+  else if (d_big == nullptr)
+  {
+    d_big.reset(new mpz_class(*x.d_big));
+  }
+  else
+  {
+    *d_big = *x.d_big;
+  }
+  return *this;
+}
+
+int Integer::compare(const Integer& y) const
+{
+  if (isSmall())
+  {
+    if (y.isSmall())
+    {
+      return (d_small > y.d_small) - (d_small < y.d_small);
+    }
+    // big values are larger in magnitude than small ones
+    return -mpz_sgn(y.d_big->get_mpz_t());
+  }
+  if (y.isSmall())
+  {
+    return mpz_sgn(d_big->get_mpz_t());
+  }
+  int c = mpz_cmp(d_big->get_mpz_t(), y.d_big->get_mpz_t());
+  return (c > 0) - (c < 0);
 }
 
-bool Integer::operator>(const Integer& y) const { return d_value > y.d_value; }
+bool Integer::operator==(const Integer& y) const
+{
+  if (isSmall() || y.isSmall())
+  {
+    return isSmall() && y.isSmall() && d_small == y.d_small;
+  }
+  return *d_big == *y.d_big;
+}
 
-bool Integer::operator>=(const Integer& y) const
+Integer Integer::operator-() const
 {
-  return d_value >= y.d_value;
+  if (isSmall())
+  {
+    return Integer(-d_small);
+  }
+  return Integer(-*d_big);
 }
 
+bool Integer::operator!=(const Integer& y) const { return !(*this == y); }
+
+bool Integer::operator<(const Integer& y) const { return compare(y) < 0; }
+
+bool Integer::operator<=(const Integer& y) const { return compare(y) <= 0; }
+
+bool Integer::operator>(const Integer& y) const { return compare(y) > 0; }
+
+bool Integer::operator>=(const Integer& y) const { return compare(y) >= 0; }
+
 Integer Integer::operator+(const Integer& y) const
 {
-  return Integer(d_value + y.d_value);
+  Integer res;
+  if (isSmall() && y.isSmall())
+  {
+    res.d_small = d_small;
+    res += y;
+  }
+  else
+  {
+    res.bigOp(mpz_add, *this, y);
+  }
+  return res;
 }
 
 Integer& Integer::operator+=(const Integer& y)
 {
-  d_value += y.d_value;
+  int64_t r;
+  if (isSmall() && y.isSmall() && !__builtin_add_overflow(d_small, y.d_small, &r)
+      && isSmallValue(r))
+  {
+    d_small = r;
+    return *this;
+  }
+  bigOp(mpz_add, *this, y);
   return *this;
 }
 
 Integer Integer::operator-(const Integer& y) const
 {
-  return Integer(d_value - y.d_value);
+  Integer res;
+  if (isSmall() && y.isSmall())
+  {
+    res.d_small = d_small;
+    res -= y;
+  }
+  else
+  {
+    res.bigOp(mpz_sub, *this, y);
+  }
+  return res;
 }
 
 Integer& Integer::operator-=(const Integer& y)
 {
-  d_value -= y.d_value;
+  int64_t r;
+  if (isSmall() && y.isSmall() && !__builtin_sub_overflow(d_small, y.d_small, &r)
+      && isSmallValue(r))
+  {
+    d_small = r;
+    return *this;
+  }
+  bigOp(mpz_sub, *this, y);
   return *this;
 }
 
 Integer Integer::operator*(const Integer& y) const
 {
-  return Integer(d_value * y.d_value);
+  Integer res;
+  if (isSmall() && y.isSmall())
+  {
+    res.d_small = d_small;
+    res *= y;
+  }
+  else
+  {
+    res.bigOp(mpz_mul, *this, y);
+  }
+  return res;
 }
 
 Integer& Integer::operator*=(const Integer& y)
 {
-  d_value *= y.d_value;
+  int64_t r;
+  if (isSmall() && y.isSmall() && !__builtin_mul_overflow(d_small, y.d_small, &r)
+      && isSmallValue(r))
+  {
+    d_small = r;
+    return *this;
+  }
+  bigOp(mpz_mul, *this, y);
   return *this;
 }
 
 Integer Integer::bitwiseOr(const Integer& y) const
 {
-  mpz_class result;
-  mpz_ior(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    // two's complement, as GMP; cannot leave the range of small values
+    return Integer(d_small | y.d_small);
+  }
+  mpz_class t1, t2, result;
+  mpz_ior(result.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::bitwiseAnd(const Integer& y) const
 {
-  mpz_class result;
-  mpz_and(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  mpz_class t1, t2, result;
+  mpz_and(result.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::bitwiseXor(const Integer& y) const
 {
-  mpz_class result;
-  mpz_xor(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  mpz_class t1, t2, result;
+  mpz_xor(result.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::bitwiseNot() const
 {
-  mpz_class result;
-  mpz_com(result.get_mpz_t(), d_value.get_mpz_t());
+  mpz_class t, result;
+  mpz_com(result.get_mpz_t(), mpz(t).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::multiplyByPow2(uint32_t pow) const
 {
-  mpz_class result;
-  mpz_mul_2exp(result.get_mpz_t(), d_value.get_mpz_t(), pow);
+  mpz_class t, result;
+  mpz_mul_2exp(result.get_mpz_t(), mpz(t).get_mpz_t(), pow);
   return Integer(result);
 }
 
 Integer Integer::setBit(uint32_t i, bool value) const
 {
-  mpz_class res = d_value;
+  mpz_class res = get_mpz();
   if (value)
   {
     mpz_setbit(res.get_mpz_t(), i);
@@ -165,7 +354,7 @@ Integer Integer::oneExtend(uint32_t size, uint32_t amount) const
 {
   // check that the size is accurate
   DebugCheckArgument((*this) < Integer(1).multiplyByPow2(size), size);
-  mpz_class res = d_value;
+  mpz_class res = get_mpz();
 
   for (unsigned i = size; i < size + amount; ++i)
   {
@@ -177,7 +366,8 @@ Integer Integer::oneExtend(uint32_t size, uint32_t amount) const
 
 uint32_t Integer::toUnsignedInt() const
 {
-  return mpz_get_ui(d_value.get_mpz_t());
+  mpz_class t;
+  return mpz_get_ui(mpz(t).get_mpz_t());
 }
 
 Integer Integer::extractBitRange(uint32_t bitCount, uint32_t low) const
@@ -185,8 +375,8 @@ Integer Integer::extractBitRange(uint32_t bitCount, uint32_t low) const
   // bitCount = high-low+1
   uint32_t high = low + bitCount - 1;
   //- Function: void mpz_fdiv_r_2exp (mpz_t r, mpz_t n, mp_bitcnt_t b)
-  mpz_class rem, div;
-  mpz_fdiv_r_2exp(rem.get_mpz_t(), d_value.get_mpz_t(), high + 1);
+  mpz_class t, rem, div;
+  mpz_fdiv_r_2exp(rem.get_mpz_t(), mpz(t).get_mpz_t(), high + 1);
   mpz_fdiv_q_2exp(div.get_mpz_t(), rem.get_mpz_t(), low);
 
   return Integer(div);
@@ -194,16 +384,16 @@ Integer Integer::extractBitRange(uint32_t bitCount, uint32_t low) const
 
 Integer Integer::floorDivideQuotient(const Integer& y) const
 {
-  mpz_class q;
-  mpz_fdiv_q(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  return Integer(q);
+  Integer q, r;
+  floorQR(q, r, *this, y);
+  return q;
 }
 
 Integer Integer::floorDivideRemainder(const Integer& y) const
 {
-  mpz_class r;
-  mpz_fdiv_r(r.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  return Integer(r);
+  Integer q, r;
+  floorQR(q, r, *this, y);
+  return r;
 }
 
 void Integer::floorQR(Integer& q,
@@ -211,23 +401,49 @@ void Integer::floorQR(Integer& q,
                       const Integer& x,
                       const Integer& y)
 {
-  mpz_fdiv_qr(q.d_value.get_mpz_t(),
-              r.d_value.get_mpz_t(),
-              x.d_value.get_mpz_t(),
-              y.d_value.get_mpz_t());
+  if (x.isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    // no overflow, as small values are symmetric
+    int64_t qs = x.d_small / y.d_small;
+    int64_t rs = x.d_small % y.d_small;
+    if (rs != 0 && ((rs < 0) != (y.d_small < 0)))
+    {
+      qs -= 1;
+      rs += y.d_small;
+    }
+    q = Integer(qs);
+    r = Integer(rs);
+    return;
+  }
+  mpz_class t1, t2, qv, rv;
+  mpz_fdiv_qr(qv.get_mpz_t(),
+              rv.get_mpz_t(),
+              x.mpz(t1).get_mpz_t(),
+              y.mpz(t2).get_mpz_t());
+  q.setValue(qv);
+  r.setValue(rv);
 }
 
 Integer Integer::ceilingDivideQuotient(const Integer& y) const
 {
-  mpz_class q;
-  mpz_cdiv_q(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    int64_t qs = d_small / y.d_small;
+    if (d_small % y.d_small != 0 && ((d_small < 0) == (y.d_small < 0)))
+    {
+      qs += 1;
+    }
+    return Integer(qs);
+  }
+  mpz_class t1, t2, q;
+  mpz_cdiv_q(q.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
   return Integer(q);
 }
 
 Integer Integer::ceilingDivideRemainder(const Integer& y) const
 {
-  mpz_class r;
-  mpz_cdiv_r(r.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  mpz_class t1, t2, r;
+  mpz_cdiv_r(r.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
   return Integer(r);
 }
 
@@ -282,82 +498,99 @@ Integer Integer::euclidianDivideRemainder(const Integer& y) const
 Integer Integer::exactQuotient(const Integer& y) const
 {
   DebugCheckArgument(y.divides(*this), y);
-  mpz_class q;
-  mpz_divexact(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    return Integer(d_small / y.d_small);
+  }
+  mpz_class t1, t2, q;
+  mpz_divexact(q.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
   return Integer(q);
 }
 
 Integer Integer::modByPow2(uint32_t exp) const
 {
-  mpz_class res;
-  mpz_fdiv_r_2exp(res.get_mpz_t(), d_value.get_mpz_t(), exp);
+  mpz_class t, res;
+  mpz_fdiv_r_2exp(res.get_mpz_t(), mpz(t).get_mpz_t(), exp);
   return Integer(res);
 }
 
 Integer Integer::divByPow2(uint32_t exp) const
 {
+  if (isSmall())
+  {
+    // arithmetic shift rounds towards negative infinity, as mpz_fdiv_q_2exp
+    return Integer(exp >= 63 ? (d_small < 0 ? -1 : 0) : d_small >> exp);
+  }
   mpz_class res;
-  mpz_fdiv_q_2exp(res.get_mpz_t(), d_value.get_mpz_t(), exp);
+  mpz_fdiv_q_2exp(res.get_mpz_t(), d_big->get_mpz_t(), exp);
   return Integer(res);
 }
 
-int Integer::sgn() const { return mpz_sgn(d_value.get_mpz_t()); }
+int Integer::sgn() const
+{
+  if (isSmall())
+  {
+    return (d_small > 0) - (d_small < 0);
+  }
+  return mpz_sgn(d_big->get_mpz_t());
+}
 
 bool Integer::strictlyPositive() const { return sgn() > 0; }
 
 bool Integer::strictlyNegative() const { return sgn() < 0; }
 
-bool Integer::isZero() const { return sgn() == 0; }
+bool Integer::isZero() const { return isSmall() && d_small == 0; }
 
-bool Integer::isOne() const { return mpz_cmp_si(d_value.get_mpz_t(), 1) == 0; }
+bool Integer::isOne() const { return isSmall() && d_small == 1; }
 
-bool Integer::isNegativeOne() const
-{
-  return mpz_cmp_si(d_value.get_mpz_t(), -1) == 0;
-}
+bool Integer::isNegativeOne() const { return isSmall() && d_small == -1; }
 
 Integer Integer::pow(unsigned long int exp) const
 {
-  mpz_class result;
-  mpz_pow_ui(result.get_mpz_t(), d_value.get_mpz_t(), exp);
+  mpz_class t, result;
+  mpz_pow_ui(result.get_mpz_t(), mpz(t).get_mpz_t(), exp);
   return Integer(result);
 }
 
 Integer Integer::gcd(const Integer& y) const
 {
-  mpz_class result;
-  mpz_gcd(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    return Integer(std::gcd(d_small, y.d_small));
+  }
+  mpz_class t1, t2, result;
+  mpz_gcd(result.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::lcm(const Integer& y) const
 {
-  mpz_class result;
-  mpz_lcm(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  mpz_class t1, t2, result;
+  mpz_lcm(result.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::modAdd(const Integer& y, const Integer& m) const
 {
-  mpz_class res;
-  mpz_add(res.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.d_value.get_mpz_t());
+  mpz_class t1, t2, t3, res;
+  mpz_add(res.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
+  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.mpz(t3).get_mpz_t());
   return Integer(res);
 }
 
 Integer Integer::modMultiply(const Integer& y, const Integer& m) const
 {
-  mpz_class res;
-  mpz_mul(res.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.d_value.get_mpz_t());
+  mpz_class t1, t2, t3, res;
+  mpz_mul(res.get_mpz_t(), mpz(t1).get_mpz_t(), y.mpz(t2).get_mpz_t());
+  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.mpz(t3).get_mpz_t());
   return Integer(res);
 }
 
 Integer Integer::modInverse(const Integer& m) const
 {
   PrettyCheckArgument(m > 0, m, "m must be greater than zero");
-  mpz_class res;
-  if (mpz_invert(res.get_mpz_t(), d_value.get_mpz_t(), m.d_value.get_mpz_t())
+  mpz_class t1, t2, res;
+  if (mpz_invert(res.get_mpz_t(), mpz(t1).get_mpz_t(), m.mpz(t2).get_mpz_t())
       == 0)
   {
     return Integer(-1);
@@ -367,99 +600,144 @@ Integer Integer::modInverse(const Integer& m) const
 
 bool Integer::divides(const Integer& y) const
 {
-  int res = mpz_divisible_p(y.d_value.get_mpz_t(), d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    // as mpz_divisible_p, 0 only divides 0
+    return d_small == 0 ? y.d_small == 0 : y.d_small % d_small == 0;
+  }
+  mpz_class t1, t2;
+  int res = mpz_divisible_p(y.mpz(t1).get_mpz_t(), mpz(t2).get_mpz_t());
   return res != 0;
 }
 
-Integer Integer::abs() const { return d_value >= 0 ? *this : -*this; }
+Integer Integer::abs() const { return sgn() >= 0 ? *this : -*this; }
 
-std::string Integer::toString(int base) const { return d_value.get_str(base); }
+std::string Integer::toString(int base) const
+{
+  if (isSmall() && base == 10)
+  {
+    return std::to_string(d_small);
+  }
+  mpz_class t;
+  return mpz(t).get_str(base);
+}
 
-bool Integer::fitsSignedInt() const { return d_value.fits_sint_p(); }
+bool Integer::fitsSignedInt() const
+{
+  return isSmall() && d_small <= std::numeric_limits<int>::max()
+         && d_small >= std::numeric_limits<int>::min();
+}
 
-bool Integer::fitsUnsignedInt() const { return d_value.fits_uint_p(); }
+bool Integer::fitsUnsignedInt() const
+{
+  return isSmall() && d_small >= 0
+         && static_cast<uint64_t>(d_small)
+                <= std::numeric_limits<unsigned int>::max();
+}
 
 signed int Integer::getSignedInt() const
 {
   // ensure there isn't overflow
-  CheckArgument(d_value <= std::numeric_limits<int>::max(),
-                this,
-                "Overflow detected in Integer::getSignedInt().");
-  CheckArgument(d_value >= std::numeric_limits<int>::min(),
-                this,
-                "Overflow detected in Integer::getSignedInt().");
   CheckArgument(
       fitsSignedInt(), this, "Overflow detected in Integer::getSignedInt().");
-  return (signed int)d_value.get_si();
+  return static_cast<signed int>(d_small);
 }
 
 unsigned int Integer::getUnsignedInt() const
 {
   // ensure there isn't overflow
-  CheckArgument(d_value <= std::numeric_limits<unsigned int>::max(),
-                this,
-                "Overflow detected in Integer::getUnsignedInt()");
-  CheckArgument(d_value >= std::numeric_limits<unsigned int>::min(),
-                this,
-                "Overflow detected in Integer::getUnsignedInt()");
   CheckArgument(
       fitsUnsignedInt(), this, "Overflow detected in Integer::getUnsignedInt()");
-  return (unsigned int)d_value.get_ui();
+  return static_cast<unsigned int>(d_small);
 }
 
-bool Integer::fitsSignedLong() const { return d_value.fits_slong_p(); }
+bool Integer::fitsSignedLong() const
+{
+  if (isSmall())
+  {
+    return d_small <= std::numeric_limits<long>::max()
+           && d_small >= std::numeric_limits<long>::min();
+  }
+  return d_big->fits_slong_p();
+}
 
-bool Integer::fitsUnsignedLong() const { return d_value.fits_ulong_p(); }
+bool Integer::fitsUnsignedLong() const
+{
+  if (isSmall())
+  {
+    return d_small >= 0
+           && static_cast<uint64_t>(d_small)
+                  <= std::numeric_limits<unsigned long>::max();
+  }
+  return d_big->fits_ulong_p();
+}
 
 long Integer::getLong() const
 {
-  long si = d_value.get_si();
-  // ensure there wasn't overflow
-  CheckArgument(mpz_cmp_si(d_value.get_mpz_t(), si) == 0,
-                this,
-                "Overflow detected in Integer::getLong().");
-  return si;
+  // ensure there isn't overflow
+  CheckArgument(
+      fitsSignedLong(), this, "Overflow detected in Integer::getLong().");
+  return isSmall() ? static_cast<long>(d_small) : d_big->get_si();
 }
 
 unsigned long Integer::getUnsignedLong() const
 {
-  unsigned long ui = d_value.get_ui();
-  // ensure there wasn't overflow
-  CheckArgument(mpz_cmp_ui(d_value.get_mpz_t(), ui) == 0,
+  // ensure there isn't overflow
+  CheckArgument(fitsUnsignedLong(),
                 this,
                 "Overflow detected in Integer::getUnsignedLong().");
-  return ui;
+  return isSmall() ? static_cast<unsigned long>(d_small) : d_big->get_ui();
 }
 
-size_t Integer::hash() const { return gmpz_hash(d_value.get_mpz_t()); }
+size_t Integer::hash() const
+{
+  if (isSmall())
+  {
+    return std::hash<int64_t>()(d_small);
+  }
+  return gmpz_hash(d_big->get_mpz_t());
+}
 
 bool Integer::testBit(unsigned n) const
 {
-  return mpz_tstbit(d_value.get_mpz_t(), n);
+  if (isSmall())
+  {
+    // two's complement, as mpz_tstbit
+    return n >= 63 ? d_small < 0 : ((d_small >> n) & 1) != 0;
+  }
+  return mpz_tstbit(d_big->get_mpz_t(), n);
 }
 
 unsigned Integer::isPow2() const
 {
-  if (d_value <= 0) return 0;
+  if (isSmall())
+  {
+    if (d_small <= 0 || (d_small & (d_small - 1)) != 0) return 0;
+    // return the index of the one plus 1
+    return __builtin_ctzll(static_cast<uint64_t>(d_small)) + 1;
+  }
+  if (mpz_sgn(d_big->get_mpz_t()) <= 0) return 0;
   // check that the number of ones in the binary representation is 1
-  if (mpz_popcount(d_value.get_mpz_t()) == 1)
+  if (mpz_popcount(d_big->get_mpz_t()) == 1)
   {
     // return the index of the first one plus 1
-    return mpz_scan1(d_value.get_mpz_t(), 0) + 1;
+    return mpz_scan1(d_big->get_mpz_t(), 0) + 1;
   }
   return 0;
 }
 
 size_t Integer::length() const
 {
-  if (sgn() == 0)
+  if (isSmall())
   {
-    return 1;
-  }
-  else
-  {
-    return mpz_sizeinbase(d_value.get_mpz_t(), 2);
+    if (d_small == 0)
+    {
+      return 1;
+    }
+    uint64_t mag = static_cast<uint64_t>(d_small < 0 ? -d_small : d_small);
+    return 64 - __builtin_clzll(mag);
   }
+  return mpz_sizeinbase(d_big->get_mpz_t(), 2);
 }
 
 void Integer::extendedGcd(
@@ -467,11 +745,15 @@ void Integer::extendedGcd(
 {
   // see the documentation for:
   // mpz_gcdext (mpz_t g, mpz_t s, mpz_t t, mpz_t a, mpz_t b);
-  mpz_gcdext(g.d_value.get_mpz_t(),
-             s.d_value.get_mpz_t(),
-             t.d_value.get_mpz_t(),
-             a.d_value.get_mpz_t(),
-             b.d_value.get_mpz_t());
+  mpz_class t1, t2, gv, sv, tv;
+  mpz_gcdext(gv.get_mpz_t(),
+             sv.get_mpz_t(),
+             tv.get_mpz_t(),
+             a.mpz(t1).get_mpz_t(),
+             b.mpz(t2).get_mpz_t());
+  g.setValue(gv);
+  s.setValue(sv);
+  t.setValue(tv);
 }
 
 const Integer& Integer::min(const Integer& a, const Integer& b)
@@ -13,6 +13,8 @@
  ** integer.
  **
  ** A multiprecision integer constant; wraps a GMP multiprecision integer.
+ ** Values that fit in 64 bits are kept inline, without a GMP integer, so
+ ** that arithmetic on them does not allocate.
  **/
 
 #include "cvc4_public.h"
@@ -22,7 +24,10 @@
 
 #include <gmpxx.h>
 
+#include <cstdint>
 #include <iosfwd>
+#include <limits>
+#include <memory>
 #include <string>
 
 namespace CVC4 {
@@ -37,10 +42,10 @@ class CVC4_PUBLIC Integer
   /**
    * Constructs an Integer by copying a GMP C++ primitive.
    */
-  Integer(const mpz_class& val) : d_value(val) {}
+  Integer(const mpz_class& val) : d_small(0) { setValue(val); }
 
   /** Constructs a rational with the value 0. */
-  Integer() : d_value(0) {}
+  Integer() : d_small(0) {}
 
   /**
    * Constructs a Integer from a C string.
@@ -51,26 +56,33 @@ class CVC4_PUBLIC Integer
   explicit Integer(const char* s, unsigned base = 10);
   explicit Integer(const std::string& s, unsigned base = 10);
 
-  Integer(const Integer& q) : d_value(q.d_value) {}
+  Integer(const Integer& q)
+      : d_small(q.d_small),
+        d_big(q.d_big == nullptr ? nullptr : new mpz_class(*q.d_big))
+  {
+  }
+  Integer(Integer&& q) = default;
 
-  Integer(signed int z) : d_value(z) {}
-  Integer(unsigned int z) : d_value(z) {}
-  Integer(signed long int z) : d_value(z) {}
-  Integer(unsigned long int z) : d_value(z) {}
+  Integer(signed int z) : d_small(z) {}
+  Integer(unsigned int z) : d_small(z) {}
+  Integer(signed long int z) : d_small(0) { setInt64(z); }
+  Integer(unsigned long int z) : d_small(0) { setUint64(z); }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Integer(int64_t z) : d_value(static_cast<long>(z)) {}
-  Integer(uint64_t z) : d_value(static_cast<unsigned long>(z)) {}
+  Integer(int64_t z) : d_small(0) { setInt64(z); }
+  Integer(uint64_t z) : d_small(0) { setUint64(z); }
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
   /** Destructor. */
   ~Integer() {}
 
-  /** Returns a copy of d_value to enable public access of GMP data. */
-  const mpz_class& getValue() const { return d_value; }
+  /** Returns a copy of the value as a GMP integer. */
+  mpz_class getValue() const { return get_mpz(); }
 
   /** Overload copy assignment operator. */
   Integer& operator=(const Integer& x);
+  /** Overload move assignment operator. */
+  Integer& operator=(Integer&& x) = default;
 
   /** Overload equality comparison operator. */
   bool operator==(const Integer& y) const;
@@ -317,16 +329,110 @@ class CVC4_PUBLIC Integer
 
  private:
   /**
-   * Gets a reference to the gmp data that backs up the integer.
+   * The largest magnitude of a small value. Small values are symmetric, so
+   * that negating them cannot overflow.
+   */
+  static constexpr int64_t s_smallMax = std::numeric_limits<int64_t>::max();
+
+  /** Returns true if v is in the range of small values. */
+  static bool isSmallValue(int64_t v) { return v >= -s_smallMax; }
+
+  /** Returns true and sets r to the value of v if it is small. */
+  static bool mpzToSmall(const mpz_t v, int64_t& r);
+
+  /** Sets r to the value v. */
+  static void smallToMpz(int64_t v, mpz_t r);
+
+  /**
+   * Makes view a read-only GMP integer with the small value v, whose limbs
+   * are stored in limbs (room for 2 limbs), and returns it. Unlike
+   * smallToMpz(), this does not allocate.
+   */
+  static mpz_srcptr smallView(int64_t v, mp_limb_t* limbs, mpz_ptr view);
+
+  /** Whether the value is in d_small, rather than in d_big. */
+  bool isSmall() const { return d_big == nullptr; }
+
+  /** Sets the value, in d_small if it is small. */
+  void setValue(const mpz_class& v);
+
+  /**
+   * Sets the value to op(x, y), computed by GMP in the big value of this,
+   * without temporaries. Used when the operands or the result are not small.
+   * x and y may be this.
+   */
+  void bigOp(void (*op)(mpz_ptr, mpz_srcptr, mpz_srcptr),
+             const Integer& x,
+             const Integer& y);
+
+  /** Sets the value from a 64-bit integer. */
+  void setInt64(int64_t v)
+  {
+    if (isSmallValue(v))
+    {
+      d_small = v;
+      d_big.reset();
+    }
+    else
+    {
+      d_big.reset(new mpz_class());
+      smallToMpz(v + 1, d_big->get_mpz_t());
+      mpz_sub_ui(d_big->get_mpz_t(), d_big->get_mpz_t(), 1);
+    }
+  }
+
+  /** Sets the value from an unsigned 64-bit integer. */
+  void setUint64(uint64_t v)
+  {
+    if (v <= static_cast<uint64_t>(s_smallMax))
+    {
+      d_small = static_cast<int64_t>(v);
+      d_big.reset();
+    }
+    else
+    {
+      d_big.reset(new mpz_class());
+      mpz_import(d_big->get_mpz_t(), 1, -1, sizeof(v), 0, 0, &v);
+    }
+  }
+
+  /**
+   * Returns the value as a GMP integer: the big value itself, or tmp set to
+   * the small value.
+   */
+  const mpz_class& mpz(mpz_class& tmp) const
+  {
+    if (d_big != nullptr)
+    {
+      return *d_big;
+    }
+    smallToMpz(d_small, tmp.get_mpz_t());
+    return tmp;
+  }
+
+  /**
+   * Gets a copy of the value as a GMP integer.
    * Only accessible to friend classes.
    */
-  const mpz_class& get_mpz() const { return d_value; }
+  mpz_class get_mpz() const
+  {
+    mpz_class tmp;
+    return mpz(tmp);
+  }
+
+  /** Compares with y, returning -1, 0 or 1. */
+  int compare(const Integer& y) const;
 
   /**
-   * The value of the rational is stored in a C++ GMP integer class.
-   * Using this instead of mpz_t allows for easier destruction.
+   * The value, if it is in [-s_smallMax, s_smallMax] (a small value).
+   * Meaningless otherwise.
+   */
+  int64_t d_small;
+  /**
+   * The value, if it is not small, and nullptr otherwise. Each value has a
+   * single representation, so values can be compared by representation.
    */
-  mpz_class d_value;
+  std::unique_ptr<mpz_class> d_big;
 }; /* class Integer */
 
 struct IntegerHashFunction
@@ -16,6 +16,7 @@
 #include "util/rational.h"
 
 #include <cmath>
+#include <numeric>
 #include <sstream>
 #include <string>
 
@@ -33,6 +34,386 @@ std::ostream& operator<<(std::ostream& os, const Rational& q){
   return os << q.toString();
 }
 
+Rational::Rational(const char* s, unsigned base) : d_num(0), d_den(1)
+{
+  mpq_class v(s, base);
+  v.canonicalize();
+  setValue(v);
+}
+
+Rational::Rational(const std::string& s, unsigned base) : d_num(0), d_den(1)
+{
+  mpq_class v(s, base);
+  v.canonicalize();
+  setValue(v);
+}
+
+Rational::Rational(const Integer& n, const Integer& d) : d_num(0), d_den(1)
+{
+  if (n.isSmall() && d.isSmall())
+  {
+    setFraction(n.d_small, d.d_small);
+    return;
+  }
+  mpq_class v(n.get_mpz(), d.get_mpz());
+  v.canonicalize();
+  setValue(v);
+}
+
+void Rational::setValue(const mpq_class& v)
+{
+  int64_t n, d;
+  if (Integer::mpzToSmall(v.get_num_mpz_t(), n)
+      && Integer::mpzToSmall(v.get_den_mpz_t(), d))
+  {
+    d_num = n;
+    d_den = d;
+    d_big.reset();
+  }
+  else if (d_big == nullptr)
+  {
+    d_big.reset(new mpq_class(v));
+  }
+  else if (d_big.get() != &v)
+  {
+    *d_big = v;
+  }
+}
+
+void Rational::setFraction(int64_t n, int64_t d)
+{
+  if (d != 0 && Integer::isSmallValue(n) && Integer::isSmallValue(d))
+  {
+    if (d < 0)
+    {
+      n = -n;
+      d = -d;
+    }
+    int64_t g = std::gcd(n, d);
+    d_num = n / g;
+    d_den = d / g;
+    d_big.reset();
+    return;
+  }
+  // leaves division by zero to GMP
+  mpq_class v(Integer(n).get_mpz(), Integer(d).get_mpz());
+  v.canonicalize();
+  setValue(v);
+}
+
+void Rational::setUnsignedFraction(uint64_t n, uint64_t d)
+{
+  if (n <= static_cast<uint64_t>(Integer::s_smallMax)
+      && d <= static_cast<uint64_t>(Integer::s_smallMax))
+  {
+    setFraction(static_cast<int64_t>(n), static_cast<int64_t>(d));
+    return;
+  }
+  mpq_class v(Integer(n).get_mpz(), Integer(d).get_mpz());
+  v.canonicalize();
+  setValue(v);
+}
+
+const mpq_class& Rational::mpq(mpq_class& tmp) const
+{
+  if (d_big != nullptr)
+  {
+    return *d_big;
+  }
+  Integer::smallToMpz(d_num, mpq_numref(tmp.get_mpq_t()));
+  Integer::smallToMpz(d_den, mpq_denref(tmp.get_mpq_t()));
+  return tmp;
+}
+
+mpq_srcptr Rational::mpqView(mp_limb_t* limbs, mpq_ptr view) const
+{
+  if (d_big != nullptr)
+  {
+    return d_big->get_mpq_t();
+  }
+  Integer::smallView(d_num, limbs, mpq_numref(view));
+  Integer::smallView(d_den, limbs + 2, mpq_denref(view));
+  return view;
+}
+
+void Rational::bigOp(void (*op)(mpq_ptr, mpq_srcptr, mpq_srcptr),
+                     const Rational& x,
+                     const Rational& y)
+{
+  mp_limb_t l1[4], l2[4];
+  mpq_t v1, v2;
+  mpq_srcptr a = x.mpqView(l1, v1);
+  mpq_srcptr b = y.mpqView(l2, v2);
+  if (d_big == nullptr)
+  {
+    d_big.reset(new mpq_class());
+  }
+  // GMP allows the result to alias the operands
+  op(d_big->get_mpq_t(), a, b);
+  setValue(*d_big);
+}
+
+bool Rational::smallAdd(
+    int64_t a, int64_t b, int64_t c, int64_t d, int64_t& n, int64_t& den)
+{
+  int64_t t, u;
+  if (b == 1 && d == 1)
+  {
+    if (__builtin_add_overflow(a, c, &t) || !Integer::isSmallValue(t))
+    {
+      return false;
+    }
+    n = t;
+    den = 1;
+    return true;
+  }
+  // a/b + c/d = (a*(d/g) + c*(b/g)) / (b*(d/g)) for g = gcd(b, d), see
+  // Knuth, TAOCP vol. 2, 4.5.1
+  int64_t g = std::gcd(b, d);
+  if (__builtin_mul_overflow(a, d / g, &t) || __builtin_mul_overflow(c, b / g, &u)
+      || __builtin_add_overflow(t, u, &t) || !Integer::isSmallValue(t))
+  {
+    return false;
+  }
+  if (t == 0)
+  {
+    n = 0;
+    den = 1;
+    return true;
+  }
+  // gcd(t, b*(d/g)) = gcd(t, g), as b/g and d/g are coprime with t
+  int64_t g2 = std::gcd(t, g);
+  if (__builtin_mul_overflow(b / g, d / g2, &u))
+  {
+    return false;
+  }
+  n = t / g2;
+  den = u;
+  return true;
+}
+
+bool Rational::smallMul(
+    int64_t a, int64_t b, int64_t c, int64_t d, int64_t& n, int64_t& den)
+{
+  if (a == 0 || c == 0)
+  {
+    n = 0;
+    den = 1;
+    return true;
+  }
+  // cross cancellation keeps the result canonical
+  int64_t g1 = std::gcd(a, d);
+  int64_t g2 = std::gcd(c, b);
+  int64_t t, u;
+  if (__builtin_mul_overflow(a / g1, c / g2, &t) || !Integer::isSmallValue(t)
+      || __builtin_mul_overflow(b / g2, d / g1, &u))
+  {
+    return false;
+  }
+  n = t;
+  den = u;
+  return true;
+}
+
+double Rational::getDouble() const
+{
+  // the division is exact, and so matches mpq_get_d, if the denominator is a
+  // power of two and the numerator is exactly representable
+  static constexpr int64_t exact = int64_t(1) << 53;
+  if (isSmall() && (d_den & (d_den - 1)) == 0 && d_num <= exact
+      && d_num >= -exact)
+  {
+    return static_cast<double>(d_num) / static_cast<double>(d_den);
+  }
+  mpq_class tmp;
+  return mpq(tmp).get_d();
+}
+
+int Rational::cmp(const Rational& x) const
+{
+  if (isSmall() && x.isSmall())
+  {
+    if (d_den == x.d_den)
+    {
+      return (d_num > x.d_num) - (d_num < x.d_num);
+    }
+    int s = sgn();
+    int xs = x.sgn();
+    if (s != xs)
+    {
+      return s < xs ? -1 : 1;
+    }
+    int64_t l, r;
+    if (!__builtin_mul_overflow(d_num, x.d_den, &l)
+        && !__builtin_mul_overflow(x.d_num, d_den, &r))
+    {
+      return (l > r) - (l < r);
+    }
+  }
+  // Don't use mpq_class's cmp() function.
+  // The name ends up conflicting with this function.
+  mp_limb_t l1[4], l2[4];
+  mpq_t v1, v2;
+  int c = mpq_cmp(mpqView(l1, v1), x.mpqView(l2, v2));
+  return (c > 0) - (c < 0);
+}
+
+Integer Rational::floor() const
+{
+  if (isSmall())
+  {
+    int64_t q = d_num / d_den;
+    if (d_num % d_den != 0 && d_num < 0)
+    {
+      q -= 1;
+    }
+    return Integer(q);
+  }
+  mpz_class q;
+  mpz_fdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
+  return Integer(q);
+}
+
+Integer Rational::ceiling() const
+{
+  if (isSmall())
+  {
+    int64_t q = d_num / d_den;
+    if (d_num % d_den != 0 && d_num > 0)
+    {
+      q += 1;
+    }
+    return Integer(q);
+  }
+  mpz_class q;
+  mpz_cdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
+  return Integer(q);
+}
+
+Rational& Rational::operator=(const Rational& x)
+{
+  if (this == &x) return *this;
+  d_num = x.d_num;
+  d_den = x.d_den;
+  if (x.d_big == nullptr)
+  {
+    d_big.reset();
+  }
+  else if (d_big == nullptr)
+  {
+    d_big.reset(new mpq_class(*x.d_big));
+  }
+  else
+  {
+    *d_big = *x.d_big;
+  }
+  return *this;
+}
+
+Rational Rational::operator-() const
+{
+  Rational res(*this);
+  if (isSmall())
+  {
+    // small values are symmetric
+    res.d_num = -d_num;
+  }
+  else
+  {
+    mpq_neg(res.d_big->get_mpq_t(), res.d_big->get_mpq_t());
+  }
+  return res;
+}
+
+Rational& Rational::operator+=(const Rational& y)
+{
+  int64_t n, d;
+  if (isSmall() && y.isSmall() && smallAdd(d_num, d_den, y.d_num, y.d_den, n, d))
+  {
+    d_num = n;
+    d_den = d;
+    return *this;
+  }
+  bigOp(mpq_add, *this, y);
+  return *this;
+}
+
+Rational& Rational::operator-=(const Rational& y)
+{
+  int64_t n, d;
+  if (isSmall() && y.isSmall()
+      && smallAdd(d_num, d_den, -y.d_num, y.d_den, n, d))
+  {
+    d_num = n;
+    d_den = d;
+    return *this;
+  }
+  bigOp(mpq_sub, *this, y);
+  return *this;
+}
+
+Rational& Rational::operator*=(const Rational& y)
+{
+  int64_t n, d;
+  if (isSmall() && y.isSmall() && smallMul(d_num, d_den, y.d_num, y.d_den, n, d))
+  {
+    d_num = n;
+    d_den = d;
+    return *this;
+  }
+  bigOp(mpq_mul, *this, y);
+  return *this;
+}
+
+Rational& Rational::operator/=(const Rational& y)
+{
+  int64_t n, d;
+  // multiplies by the canonical inverse of y, leaving division by zero to GMP
+  if (isSmall() && y.isSmall() && y.d_num != 0
+      && smallMul(d_num,
+                  d_den,
+                  y.d_num < 0 ? -y.d_den : y.d_den,
+                  y.d_num < 0 ? -y.d_num : y.d_num,
+                  n,
+                  d))
+  {
+    d_num = n;
+    d_den = d;
+    return *this;
+  }
+  bigOp(mpq_div, *this, y);
+  return *this;
+}
+
+std::string Rational::toString(int base) const
+{
+  if (isSmall() && base == 10)
+  {
+    std::string res = std::to_string(d_num);
+    if (d_den != 1)
+    {
+      res += '/';
+      res += std::to_string(d_den);
+    }
+    return res;
+  }
+  mpq_class tmp;
+  return mpq(tmp).get_str(base);
+}
+
+size_t Rational::hash() const
+{
+  if (isSmall())
+  {
+    std::hash<int64_t> h;
+    return h(d_num) xor h(d_den);
+  }
+  size_t numeratorHash = gmpz_hash(d_big->get_num_mpz_t());
+  size_t denominatorHash = gmpz_hash(d_big->get_den_mpz_t());
+
+  return numeratorHash xor denominatorHash;
+}
+
 
 /* Computes a rational given a decimal string. The rational
  * version of <code>xxx.yyy</code> is <code>xxxyyy/(10^3)</code>.
@@ -91,9 +472,9 @@ Maybe<Rational> Rational::fromDouble(double d)
 {
   using namespace std;
   if(isfinite(d)){
-    Rational q;
-    mpq_set_d(q.d_value.get_mpq_t(), d);
-    return q;
+    mpq_class v;
+    mpq_set_d(v.get_mpq_t(), d);
+    return Rational(v);
   }
   return Maybe<Rational>();
 }
@@ -13,6 +13,8 @@
  ** rational.
  **
  ** Multiprecision rational constants; wraps a GMP multiprecision rational.
+ ** Values whose numerator and denominator fit in 64 bits are kept inline,
+ ** without a GMP rational, so that arithmetic on them does not allocate.
  **/
 
 #include "cvc4_public.h"
@@ -22,6 +24,8 @@
 
 #include <gmp.h>
 
+#include <cstdint>
+#include <memory>
 #include <string>
 
 #include "util/gmp_util.h"
@@ -54,7 +58,7 @@ class CVC4_PUBLIC Rational
    * Assumes that the value is in canonical form, and thus does not
    * have to call canonicalize() on the value.
    */
-  Rational(const mpq_class& val) : d_value(val) {}
+  Rational(const mpq_class& val) : d_num(0), d_den(1) { setValue(val); }
 
   /**
    * Creates a rational from a decimal string (e.g., <code>"1.5"</code>).
@@ -65,7 +69,7 @@ class CVC4_PUBLIC Rational
   static Rational fromDecimal(const std::string& dec);
 
   /** Constructs a rational with the value 0/1. */
-  Rational() : d_value(0) { d_value.canonicalize(); }
+  Rational() : d_num(0), d_den(1) {}
 
   /**
    * Constructs a Rational from a C string in a given base (defaults to 10).
@@ -74,96 +78,100 @@ class CVC4_PUBLIC Rational
    * For more information about what is a valid rational string,
    * see GMP's documentation for mpq_set_str().
    */
-  explicit Rational(const char* s, unsigned base = 10) : d_value(s, base)
-  {
-    d_value.canonicalize();
-  }
-  Rational(const std::string& s, unsigned base = 10) : d_value(s, base)
-  {
-    d_value.canonicalize();
-  }
+  explicit Rational(const char* s, unsigned base = 10);
+  Rational(const std::string& s, unsigned base = 10);
 
   /**
    * Creates a Rational from another Rational, q, by performing a deep copy.
    */
-  Rational(const Rational& q) : d_value(q.d_value) { d_value.canonicalize(); }
+  Rational(const Rational& q)
+      : d_num(q.d_num),
+        d_den(q.d_den),
+        d_big(q.d_big == nullptr ? nullptr : new mpq_class(*q.d_big))
+  {
+  }
+  Rational(Rational&& q) = default;
 
   /**
    * Constructs a canonical Rational from a numerator.
    */
-  Rational(signed int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(signed long int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned long int n) : d_value(n, 1) { d_value.canonicalize(); }
-
-#ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n) : d_value(static_cast<long>(n), 1)
-  {
-    d_value.canonicalize();
-  }
-  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1)
+  Rational(signed int n) : d_num(n), d_den(1) {}
+  Rational(unsigned int n) : d_num(n), d_den(1) {}
+  Rational(signed long int n) : d_num(0), d_den(1) { setFraction(n, 1); }
+  Rational(unsigned long int n) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsignedFraction(n, 1);
   }
+
+#ifdef CVC4_NEED_INT64_T_OVERLOADS
+  Rational(int64_t n) : d_num(0), d_den(1) { setFraction(n, 1); }
+  Rational(uint64_t n) : d_num(0), d_den(1) { setUnsignedFraction(n, 1); }
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
   /**
    * Constructs a canonical Rational from a numerator and denominator.
    */
-  Rational(signed int n, signed int d) : d_value(n, d)
+  Rational(signed int n, signed int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(n, d);
   }
-  Rational(unsigned int n, unsigned int d) : d_value(n, d)
+  Rational(unsigned int n, unsigned int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(n, d);
   }
-  Rational(signed long int n, signed long int d) : d_value(n, d)
+  Rational(signed long int n, signed long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(n, d);
   }
-  Rational(unsigned long int n, unsigned long int d) : d_value(n, d)
+  Rational(unsigned long int n, unsigned long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsignedFraction(n, d);
   }
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n, int64_t d)
-      : d_value(static_cast<long>(n), static_cast<long>(d))
+  Rational(int64_t n, int64_t d) : d_num(0), d_den(1) { setFraction(n, d); }
+  Rational(uint64_t n, uint64_t d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
-  }
-  Rational(uint64_t n, uint64_t d)
-      : d_value(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
-  {
-    d_value.canonicalize();
+    setUnsignedFraction(n, d);
   }
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
-  Rational(const Integer& n, const Integer& d)
-      : d_value(n.get_mpz(), d.get_mpz())
+  Rational(const Integer& n, const Integer& d);
+  Rational(const Integer& n) : d_num(n.d_small), d_den(1)
   {
-    d_value.canonicalize();
+    if (!n.isSmall())
+    {
+      d_big.reset(new mpq_class(*n.d_big));
+    }
   }
-  Rational(const Integer& n) : d_value(n.get_mpz()) { d_value.canonicalize(); }
   ~Rational() {}
 
   /**
-   * Returns a copy of d_value to enable public access of GMP data.
+   * Returns a copy of the value as a GMP rational.
    */
-  const mpq_class& getValue() const { return d_value; }
+  mpq_class getValue() const
+  {
+    mpq_class tmp;
+    return mpq(tmp);
+  }
 
   /**
    * Returns the value of numerator of the Rational.
    * Note that this makes a deep copy of the numerator.
    */
-  Integer getNumerator() const { return Integer(d_value.get_num()); }
+  Integer getNumerator() const
+  {
+    return isSmall() ? Integer(d_num) : Integer(d_big->get_num());
+  }
 
   /**
    * Returns the value of denominator of the Rational.
    * Note that this makes a deep copy of the denominator.
    */
-  Integer getDenominator() const { return Integer(d_value.get_den()); }
+  Integer getDenominator() const
+  {
+    return isSmall() ? Integer(d_den) : Integer(d_big->get_den());
+  }
 
   static Maybe<Rational> fromDouble(double d);
 
@@ -172,30 +180,29 @@ class CVC4_PUBLIC Rational
    * approximate: truncation may occur, overflow may result in
    * infinity, and underflow may result in zero.
    */
-  double getDouble() const { return d_value.get_d(); }
+  double getDouble() const;
 
   Rational inverse() const
   {
     return Rational(getDenominator(), getNumerator());
   }
 
-  int cmp(const Rational& x) const
+  int cmp(const Rational& x) const;
+
+  int sgn() const
   {
-    // Don't use mpq_class's cmp() function.
-    // The name ends up conflicting with this function.
-    return mpq_cmp(d_value.get_mpq_t(), x.d_value.get_mpq_t());
+    if (isSmall())
+    {
+      return (d_num > 0) - (d_num < 0);
+    }
+    return mpq_sgn(d_big->get_mpq_t());
   }
 
-  int sgn() const { return mpq_sgn(d_value.get_mpq_t()); }
-
-  bool isZero() const { return sgn() == 0; }
+  bool isZero() const { return isSmall() && d_num == 0; }
 
-  bool isOne() const { return mpq_cmp_si(d_value.get_mpq_t(), 1, 1) == 0; }
+  bool isOne() const { return isSmall() && d_num == 1 && d_den == 1; }
 
-  bool isNegativeOne() const
-  {
-    return mpq_cmp_si(d_value.get_mpq_t(), -1, 1) == 0;
-  }
+  bool isNegativeOne() const { return isSmall() && d_num == -1 && d_den == 1; }
 
   Rational abs() const
   {
@@ -209,100 +216,118 @@ class CVC4_PUBLIC Rational
     }
   }
 
-  Integer floor() const
-  {
-    mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
-    return Integer(q);
-  }
+  Integer floor() const;
 
-  Integer ceiling() const
-  {
-    mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
-    return Integer(q);
-  }
+  Integer ceiling() const;
 
   Rational floor_frac() const { return (*this) - Rational(floor()); }
 
-  Rational& operator=(const Rational& x)
-  {
-    if (this == &x) return *this;
-    d_value = x.d_value;
-    return *this;
-  }
+  Rational& operator=(const Rational& x);
+  Rational& operator=(Rational&& x) = default;
 
-  Rational operator-() const { return Rational(-(d_value)); }
+  Rational operator-() const;
 
-  bool operator==(const Rational& y) const { return d_value == y.d_value; }
+  bool operator==(const Rational& y) const
+  {
+    if (isSmall() || y.isSmall())
+    {
+      return isSmall() && y.isSmall() && d_num == y.d_num && d_den == y.d_den;
+    }
+    return *d_big == *y.d_big;
+  }
 
-  bool operator!=(const Rational& y) const { return d_value != y.d_value; }
+  bool operator!=(const Rational& y) const { return !(*this == y); }
 
-  bool operator<(const Rational& y) const { return d_value < y.d_value; }
+  bool operator<(const Rational& y) const { return cmp(y) < 0; }
 
-  bool operator<=(const Rational& y) const { return d_value <= y.d_value; }
+  bool operator<=(const Rational& y) const { return cmp(y) <= 0; }
 
-  bool operator>(const Rational& y) const { return d_value > y.d_value; }
+  bool operator>(const Rational& y) const { return cmp(y) > 0; }
 
-  bool operator>=(const Rational& y) const { return d_value >= y.d_value; }
+  bool operator>=(const Rational& y) const { return cmp(y) >= 0; }
 
   Rational operator+(const Rational& y) const
   {
-    return Rational(d_value + y.d_value);
+    Rational res;
+    if (isSmall() && y.isSmall())
+    {
+      res = *this;
+      res += y;
+    }
+    else
+    {
+      res.bigOp(mpq_add, *this, y);
+    }
+    return res;
   }
   Rational operator-(const Rational& y) const
   {
-    return Rational(d_value - y.d_value);
+    Rational res;
+    if (isSmall() && y.isSmall())
+    {
+      res = *this;
+      res -= y;
+    }
+    else
+    {
+      res.bigOp(mpq_sub, *this, y);
+    }
+    return res;
   }
 
   Rational operator*(const Rational& y) const
   {
-    return Rational(d_value * y.d_value);
+    Rational res;
+    if (isSmall() && y.isSmall())
+    {
+      res = *this;
+      res *= y;
+    }
+    else
+    {
+      res.bigOp(mpq_mul, *this, y);
+    }
+    return res;
   }
   Rational operator/(const Rational& y) const
   {
-    return Rational(d_value / y.d_value);
+    Rational res;
+    if (isSmall() && y.isSmall())
+    {
+      res = *this;
+      res /= y;
+    }
+    else
+    {
+      res.bigOp(mpq_div, *this, y);
+    }
+    return res;
   }
 
-  Rational& operator+=(const Rational& y)
-  {
-    d_value += y.d_value;
-    return (*this);
-  }
-  Rational& operator-=(const Rational& y)
-  {
-    d_value -= y.d_value;
-    return (*this);
-  }
+  Rational& operator+=(const Rational& y);
+  Rational& operator-=(const Rational& y);
 
-  Rational& operator*=(const Rational& y)
-  {
-    d_value *= y.d_value;
-    return (*this);
-  }
+  Rational& operator*=(const Rational& y);
+
+  Rational& operator/=(const Rational& y);
 
-  Rational& operator/=(const Rational& y)
+  bool isIntegral() const
   {
-    d_value /= y.d_value;
-    return (*this);
+    if (isSmall())
+    {
+      return d_den == 1;
+    }
+    return mpz_cmp_ui(d_big->get_den_mpz_t(), 1) == 0;
   }
 
-  bool isIntegral() const { return getDenominator() == 1; }
-
   /** Returns a string representing the rational in the given base. */
-  std::string toString(int base = 10) const { return d_value.get_str(base); }
+  std::string toString(int base = 10) const;
 
   /**
    * Computes the hash of the rational from hashes of the numerator and the
    * denominator.
    */
-  size_t hash() const
-  {
-    size_t numeratorHash = gmpz_hash(d_value.get_num_mpz_t());
-    size_t denominatorHash = gmpz_hash(d_value.get_den_mpz_t());
-
-    return numeratorHash xor denominatorHash;
-  }
+  size_t hash() const;
 
   uint32_t complexity() const
   {
@@ -315,11 +340,60 @@ class CVC4_PUBLIC Rational
   int absCmp(const Rational& q) const;
 
  private:
+  /** Whether the value is in d_num and d_den, rather than in d_big. */
+  bool isSmall() const { return d_big == nullptr; }
+
+  /** Sets the value, which must be canonical, in d_num and d_den if small. */
+  void setValue(const mpq_class& v);
+
+  /** Sets the value to n/d, and canonicalizes it. */
+  void setFraction(int64_t n, int64_t d);
+  void setUnsignedFraction(uint64_t n, uint64_t d);
+
+  /**
+   * Returns the value as a GMP rational: the big value itself, or tmp set to
+   * the small value.
+   */
+  const mpq_class& mpq(mpq_class& tmp) const;
+
+  /**
+   * Returns the value as a read-only GMP rational: the big value itself, or
+   * view set to the small value, with its limbs in limbs (room for 4 limbs).
+   * Does not allocate.
+   */
+  mpq_srcptr mpqView(mp_limb_t* limbs, mpq_ptr view) const;
+
+  /**
+   * Sets the value to op(x, y), computed by GMP in the big value of this,
+   * without temporaries. Used when the operands or the result are not small.
+   * x and y may be this.
+   */
+  void bigOp(void (*op)(mpq_ptr, mpq_srcptr, mpq_srcptr),
+             const Rational& x,
+             const Rational& y);
+
+  /**
+   * Computes n/d = a/b + c/d on small canonical values. Returns false if the
+   * result, or an intermediate value, does not fit.
+   */
+  static bool smallAdd(
+      int64_t a, int64_t b, int64_t c, int64_t d, int64_t& n, int64_t& den);
+
+  /** As smallAdd, for n/d = a/b * c/d. */
+  static bool smallMul(
+      int64_t a, int64_t b, int64_t c, int64_t d, int64_t& n, int64_t& den);
+
+  /**
+   * The numerator and the (positive) denominator of the value, if both are
+   * small values of Integer. Meaningless otherwise.
+   */
+  int64_t d_num;
+  int64_t d_den;
   /**
-   * Stores the value of the rational is stored in a C++ GMP rational class.
-   * Using this instead of mpq_t allows for easier destruction.
+   * The value, if it is not small, and nullptr otherwise. Each value has a
+   * single representation, so values can be compared by representation.
    */
-  mpq_class d_value;
+  std::unique_ptr<mpq_class> d_big;
 
 }; /* class Rational */
 
@@ -19,6 +19,10 @@
 #include <algorithm>
 #include <ostream>
 
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <mutex>
+#endif /* CVC4_THREAD_SAFE_NODES */
+
 #include "base/check.h"
 #include "base/listener.h"
 #include "base/output.h"
@@ -90,6 +94,13 @@ struct ResourceManager::Statistics
   IntStat d_numRewriteStep;
   IntStat d_numSatConflictStep;
   IntStat d_numTheoryCheckStep;
+#ifdef CVC4_THREAD_SAFE_NODES
+  /**
+   * Guards spending resources, which threads simplifying assertions in
+   * parallel do concurrently.
+   */
+  std::mutex d_mutex;
+#endif /* CVC4_THREAD_SAFE_NODES */
   Statistics(StatisticsRegistry& stats);
   ~Statistics();
 
@@ -239,7 +250,7 @@ void ResourceManager::spendResource(unsigned amount)
 
   Debug("limit") << "ResourceManager::spendResource()" << std::endl;
   d_thisCallResourceUsed += amount;
-  if (out())
+  if (outOfResources() || outOfTime())
   {
     Trace("limit") << "ResourceManager::spendResource: interrupt!" << std::endl;
     Trace("limit") << "          on call "
@@ -259,6 +270,9 @@ void ResourceManager::spendResource(unsigned amount)
 
 void ResourceManager::spendResource(Resource r)
 {
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::mutex> guard(d_statistics->d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
   uint32_t amount = 0;
   switch (r)
   {
@@ -403,6 +417,14 @@ bool ResourceManager::outOfResources() const
   return false;
 }
 
+bool ResourceManager::out() const
+{
+#ifdef CVC4_THREAD_SAFE_NODES
+  std::lock_guard<std::mutex> guard(d_statistics->d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
+  return d_on && (outOfResources() || outOfTime());
+}
+
 bool ResourceManager::outOfTime() const
 {
   if (d_timeBudgetPerCall == 0) return false;
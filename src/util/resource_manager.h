@@ -122,8 +122,11 @@ class CVC4_PUBLIC ResourceManager
   bool outOfResources() const;
   /** Checks whether time has been exhausted. */
   bool outOfTime() const;
-  /** Checks whether any limit has been exhausted. */
-  bool out() const { return d_on && (outOfResources() || outOfTime()); }
+  /**
+   * Checks whether any limit has been exhausted. May be called while other
+   * threads spend resources.
+   */
+  bool out() const;
 
   /** Retrieves amount of resources used overall. */
   uint64_t getResourceUsage() const;
@@ -137,7 +140,8 @@ class CVC4_PUBLIC ResourceManager
 
   /**
    * Spends a given resources. Throws an UnsafeInterruptException if there are
-   * no remaining resources.
+   * no remaining resources. In builds with thread-safe nodes, it may be called
+   * from several threads at once.
    */
   void spendResource(Resource r);
 
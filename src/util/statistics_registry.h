@@ -42,6 +42,10 @@
 #include <sstream>
 #include <vector>
 
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <mutex>
+#endif /* CVC4_THREAD_SAFE_NODES */
+
 #include "base/exception.h"
 #include "util/safe_print.h"
 #include "util/statistics.h"
@@ -578,6 +582,13 @@ class HistogramStat : public Stat {
 private:
   typedef std::map<T, unsigned int> Histogram;
   Histogram d_hist;
+#ifdef CVC4_THREAD_SAFE_NODES
+  /**
+   * Guards the histogram, which may be extended by rewriters running in
+   * several threads.
+   */
+  std::mutex d_mutex;
+#endif /* CVC4_THREAD_SAFE_NODES */
 public:
 
   /** Construct a histogram of a stream of entries. */
@@ -628,6 +639,9 @@ public:
 
   HistogramStat& operator<<(const T& val){
     if(CVC4_USE_STATISTICS) {
+#ifdef CVC4_THREAD_SAFE_NODES
+      std::lock_guard<std::mutex> guard(d_mutex);
+#endif /* CVC4_THREAD_SAFE_NODES */
       if(d_hist.find(val) == d_hist.end()){
         d_hist.insert(std::make_pair(val,0));
       }
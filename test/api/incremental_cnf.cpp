@@ -0,0 +1,129 @@
+/*********************                                                        */
+/*! \file incremental_cnf.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A test for --incremental-cnf across push and pop
+ **
+ ** The scripts of regress0/push-pop/incremental-cnf.smt2 and
+ ** incremental-cnf-reuse.smt2, through the API, with and without
+ ** --incremental-cnf.  The CNF definitions of the atoms of a popped level
+ ** are kept with --incremental-cnf, and the SAT variables of the formulas
+ ** asserted again reused.
+ **/
+
+#include <iostream>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+
+using namespace CVC4::api;
+
+namespace {
+
+/** Check that r is sat (if sat is true) or unsat, return false otherwise */
+bool expect(const char* test, size_t& step, Result r, bool sat)
+{
+  ++step;
+  if (sat ? r.isSat() : r.isUnsat())
+  {
+    return true;
+  }
+  std::cerr << test << ": check-sat " << step << " returned " << r
+            << std::endl;
+  return false;
+}
+
+bool incrementalCnf(bool incrementalCnf)
+{
+  Solver slv;
+  slv.setOption("incremental", "true");
+  slv.setOption("incremental-cnf", incrementalCnf ? "true" : "false");
+  slv.setLogic("QF_LIA");
+  Sort intSort = slv.getIntegerSort();
+  Term x = slv.mkConst(intSort, "x");
+  Term y = slv.mkConst(intSort, "y");
+  Term p = slv.mkConst(slv.getBooleanSort(), "p");
+  Term q = slv.mkConst(slv.getBooleanSort(), "q");
+  Term disj = slv.mkTerm(
+      OR,
+      slv.mkTerm(AND, p, slv.mkTerm(LT, x, y)),
+      slv.mkTerm(AND, q, slv.mkTerm(GT, y, slv.mkInteger(10))));
+  size_t step = 0;
+  bool ok = true;
+
+  slv.assertFormula(slv.mkTerm(GT, x, slv.mkInteger(0)));
+  slv.push();
+  slv.assertFormula(disj);
+  slv.assertFormula(slv.mkTerm(DISTINCT, p, q));
+  ok &= expect("incremental_cnf", step, slv.checkSat(), true);
+  slv.pop();
+
+  slv.push();
+  slv.assertFormula(disj);
+  slv.assertFormula(p.notTerm());
+  slv.assertFormula(slv.mkTerm(LEQ, y, slv.mkInteger(10)));
+  ok &= expect("incremental_cnf", step, slv.checkSat(), false);
+  slv.pop();
+
+  slv.push();
+  slv.assertFormula(disj);
+  slv.assertFormula(p.notTerm());
+  ok &= expect("incremental_cnf", step, slv.checkSat(), true);
+  slv.assertFormula(slv.mkTerm(IMPLIES, q, slv.mkTerm(LT, y, x)));
+  ok &= expect("incremental_cnf", step, slv.checkSat(), true);
+  slv.assertFormula(slv.mkTerm(LT, x, slv.mkInteger(5)));
+  ok &= expect("incremental_cnf", step, slv.checkSat(), false);
+  slv.pop();
+
+  slv.assertFormula(slv.mkTerm(LT, x, y));
+  ok &= expect("incremental_cnf", step, slv.checkSat(), true);
+  return ok;
+}
+
+bool incrementalCnfReuse(bool incrementalCnf)
+{
+  Solver slv;
+  slv.setOption("incremental", "true");
+  slv.setOption("incremental-cnf", incrementalCnf ? "true" : "false");
+  slv.setLogic("QF_LIA");
+  Sort intSort = slv.getIntegerSort();
+  Term x = slv.mkConst(intSort, "x");
+  Term y = slv.mkConst(intSort, "y");
+  size_t step = 0;
+  bool ok = true;
+
+  // the same formula asserted at each level, with bounds on x and y that
+  // contradict it
+  for (int32_t i = 1; i <= 3; ++i)
+  {
+    slv.push();
+    slv.assertFormula(slv.mkTerm(DISTINCT, x, y));
+    ok &= expect("incremental_cnf_reuse", step, slv.checkSat(), true);
+    slv.assertFormula(slv.mkTerm(GT, x, slv.mkInteger(i)));
+    slv.assertFormula(
+        slv.mkTerm(LT, x, slv.mkInteger(i < 3 ? i + 2 : i + 3)));
+    slv.assertFormula(slv.mkTerm(EQUAL, y, slv.mkInteger(i + 1)));
+    ok &= expect("incremental_cnf_reuse", step, slv.checkSat(), i == 3);
+    slv.pop();
+  }
+  ok &= expect("incremental_cnf_reuse", step, slv.checkSat(), true);
+  return ok;
+}
+
+}  // namespace
+
+int main()
+{
+  bool ok = true;
+  for (bool incremental : {true, false})
+  {
+    ok &= incrementalCnf(incremental);
+    ok &= incrementalCnfReuse(incremental);
+  }
+  return ok ? 0 : 1;
+}
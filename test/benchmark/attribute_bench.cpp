@@ -0,0 +1,159 @@
+/*********************                                                        */
+/*! \file attribute_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of the attribute tables.
+ **
+ ** Times getting and setting attributes stored in the dense tables and in the
+ ** hash tables of the AttributeManager, and erasing the dense attributes of
+ ** nodes from a wide table.
+ **/
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark.h"
+#include "expr/attribute.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+
+using namespace CVC4;
+using namespace CVC4::benchmark;
+using namespace CVC4::expr;
+using namespace CVC4::expr::attr;
+
+namespace {
+
+struct DenseBench;
+struct HashBench;
+
+using DenseNodeAttr = Attribute<DenseBench, Node>;
+using DenseIntAttr = Attribute<DenseBench, uint64_t>;
+using DenseFlag = Attribute<DenseBench, bool>;
+using HashNodeAttr = Attribute<HashBench, Node>;
+using HashIntAttr = Attribute<HashBench, uint64_t>;
+using HashFlag = Attribute<HashBench, bool>;
+
+}  // namespace
+
+namespace CVC4 {
+namespace expr {
+namespace attr {
+template <>
+struct UseDenseStorage<DenseNodeAttr> : public std::true_type
+{
+};
+template <>
+struct UseDenseStorage<DenseIntAttr> : public std::true_type
+{
+};
+template <>
+struct UseDenseStorage<DenseFlag> : public std::true_type
+{
+};
+}  // namespace attr
+}  // namespace expr
+}  // namespace CVC4
+
+namespace {
+
+/** The number of nodes. */
+const size_t s_size = 200000;
+/** The number of columns of the wide table. */
+const uint64_t s_columns = 256;
+
+/**
+ * Times setting then getting an attribute of every node with set and get,
+ * and prints the time per operation under name.
+ */
+template <class Set, class Get>
+void runGetSet(const std::string& name,
+               std::vector<Node>& nodes,
+               Set set,
+               Get get)
+{
+  uint64_t round = 0;
+  run(name, 2 * nodes.size(), [&]() {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+      set(nodes[i], i + round);
+    }
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+      sum += get(nodes[i]);
+    }
+    ++round;
+    doNotOptimize(sum);
+  });
+}
+
+}  // namespace
+
+int main()
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  std::vector<Node> nodes;
+  TypeNode boolType = nm.booleanType();
+  for (size_t i = 0; i < s_size; ++i)
+  {
+    nodes.push_back(nm.mkVar(boolType));
+  }
+
+  runGetSet(
+      "get/set uint64_t, hash",
+      nodes,
+      [](Node& n, uint64_t v) { n.setAttribute(HashIntAttr(), v); },
+      [](const Node& n) { return n.getAttribute(HashIntAttr()); });
+  runGetSet(
+      "get/set uint64_t, dense",
+      nodes,
+      [](Node& n, uint64_t v) { n.setAttribute(DenseIntAttr(), v); },
+      [](const Node& n) { return n.getAttribute(DenseIntAttr()); });
+  runGetSet(
+      "get/set Node, hash",
+      nodes,
+      [&](Node& n, uint64_t v) {
+        n.setAttribute(HashNodeAttr(), nodes[v % s_size]);
+      },
+      [](const Node& n) { return n.getAttribute(HashNodeAttr()).getId(); });
+  runGetSet(
+      "get/set Node, dense",
+      nodes,
+      [&](Node& n, uint64_t v) {
+        n.setAttribute(DenseNodeAttr(), nodes[v % s_size]);
+      },
+      [](const Node& n) { return n.getAttribute(DenseNodeAttr()).getId(); });
+  runGetSet(
+      "get/set bool, hash",
+      nodes,
+      [](Node& n, uint64_t v) { n.setAttribute(HashFlag(), v % 3 == 0); },
+      [](const Node& n) { return n.getAttribute(HashFlag()) ? 1 : 0; });
+  runGetSet(
+      "get/set bool, dense",
+      nodes,
+      [](Node& n, uint64_t v) { n.setAttribute(DenseFlag(), v % 3 == 0); },
+      [](const Node& n) { return n.getAttribute(DenseFlag()) ? 1 : 0; });
+
+  // each node has one attribute among the columns of a wide table, so erase()
+  // should not depend on the width
+  run("set+erase 1 of 256 columns", s_size, [&]() {
+    DenseAttrTable<uint64_t> table;
+    for (size_t i = 0; i < s_size; ++i)
+    {
+      table.set(i % s_columns, nodes[i].d_nv, i);
+    }
+    for (size_t i = 0; i < s_size; ++i)
+    {
+      table.erase(nodes[i].d_nv);
+    }
+    doNotOptimize(table);
+  });
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*********************                                                        */
+/*! \file benchmark.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Timing helpers for the microbenchmarks.
+ **/
+
+#ifndef CVC4__TEST__BENCHMARK__BENCHMARK_H
+#define CVC4__TEST__BENCHMARK__BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace CVC4 {
+namespace benchmark {
+
+/** The number of times each benchmark is repeated; the median is reported. */
+constexpr size_t s_repetitions = 7;
+
+/**
+ * Prevents the compiler from optimizing away the computation of v.
+ */
+template <class T>
+inline void doNotOptimize(const T& v)
+{
+  asm volatile("" : : "g"(&v) : "memory");
+}
+
+/** Measures the wall time since its construction. */
+class Timer
+{
+ public:
+  Timer() : d_start(std::chrono::steady_clock::now()) {}
+  /** The time elapsed, in nanoseconds. */
+  double elapsed() const
+  {
+    std::chrono::duration<double, std::nano> d =
+        std::chrono::steady_clock::now() - d_start;
+    return d.count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point d_start;
+};
+
+/** Prints the median of the times per operation in nsPerOp under name. */
+inline void report(const std::string& name, std::vector<double> nsPerOp)
+{
+  std::sort(nsPerOp.begin(), nsPerOp.end());
+  std::cout << std::left << std::setw(40) << name << std::right << std::fixed
+            << std::setprecision(2) << std::setw(12)
+            << nsPerOp[nsPerOp.size() / 2] << " ns/op" << std::endl;
+}
+
+/**
+ * Times s_repetitions calls of f(), each of which performs ops operations,
+ * and prints the median time per operation under name.
+ */
+template <class F>
+void run(const std::string& name, size_t ops, F f)
+{
+  std::vector<double> times;
+  for (size_t r = 0; r < s_repetitions; ++r)
+  {
+    Timer t;
+    f();
+    times.push_back(t.elapsed() / ops);
+  }
+  report(name, times);
+}
+
+}  // namespace benchmark
+}  // namespace CVC4
+
+#endif /* CVC4__TEST__BENCHMARK__BENCHMARK_H */
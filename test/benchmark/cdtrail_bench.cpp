@@ -0,0 +1,103 @@
+/*********************                                                        */
+/*! \file cdtrail_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of the context trail.
+ **
+ ** Times popping levels at which many objects were modified, with the objects
+ ** saved by CDO and by CDTrailValue, and destroying many trailed objects.
+ **/
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "context/cdo.h"
+#include "context/cdtrail.h"
+#include "context/context.h"
+
+using namespace CVC4;
+using namespace CVC4::benchmark;
+using namespace CVC4::context;
+
+namespace {
+
+/** The number of objects. */
+const size_t s_size = 200000;
+
+/**
+ * Times popping a level at which all of objs were modified, and prints the
+ * time per modified object under name.
+ */
+template <class T>
+void runPop(const std::string& name, Context& c, std::deque<T>& objs)
+{
+  int round = 0;
+  std::vector<double> times;
+  for (size_t r = 0; r < s_repetitions; ++r)
+  {
+    c.push();
+    for (size_t i = 0; i < objs.size(); ++i)
+    {
+      objs[i] = static_cast<int>(i) + round;
+    }
+    ++round;
+    Timer t;
+    c.pop();
+    times.push_back(t.elapsed() / objs.size());
+  }
+  report(name, times);
+}
+
+}  // namespace
+
+int main()
+{
+  Context c;
+  {
+    // deques, as CDO objects cannot be allocated on the heap one by one
+    std::deque<CDO<int>> cdos;
+    std::deque<CDTrailValue<int>> trailed;
+    for (size_t i = 0; i < s_size; ++i)
+    {
+      cdos.emplace_back(&c, 0);
+      trailed.emplace_back(&c, 0);
+    }
+    runPop("pop, CDO", c, cdos);
+    runPop("pop, CDTrailValue", c, trailed);
+  }
+
+  // destroying a trailed object tombstones its own saves only, so the cost
+  // does not grow with the trail
+  std::vector<double> times;
+  for (size_t r = 0; r < s_repetitions; ++r)
+  {
+    std::deque<std::unique_ptr<CDTrailValue<int>>> values;
+    for (size_t i = 0; i < s_size; ++i)
+    {
+      values.emplace_back(new CDTrailValue<int>(&c, 0));
+    }
+    for (int level = 1; level <= 3; ++level)
+    {
+      c.push();
+      for (std::unique_ptr<CDTrailValue<int>>& v : values)
+      {
+        *v = level;
+      }
+    }
+    Timer t;
+    values.clear();
+    times.push_back(t.elapsed() / s_size);
+    c.popto(0);
+  }
+  report("destroy CDTrailValue saved at 3 levels", times);
+  return 0;
+}
@@ -0,0 +1,149 @@
+/*********************                                                        */
+/*! \file delta_rational_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of DeltaRational arithmetic.
+ **
+ ** Times addition, subtraction, multiplication by a Rational and comparison
+ ** of DeltaRationals, on values whose numerators and denominators fit in 64
+ ** bits (as most simplex coefficients and bounds do) and on values that do
+ ** not.
+ **/
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "theory/arith/delta_rational.h"
+#include "util/integer.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::benchmark;
+
+namespace {
+
+/** The number of operand pairs. */
+const size_t s_size = 4096;
+/** The number of passes over the operand pairs per repetition. */
+const size_t s_passes = 64;
+
+/** Returns a random fraction with a small numerator and denominator. */
+Rational smallFraction(std::mt19937_64& rng)
+{
+  long n = static_cast<long>(rng() % 2001) - 1000;
+  long d = static_cast<long>(rng() % 100) + 1;
+  return Rational(n, d);
+}
+
+/** Returns a random fraction whose numerator does not fit in 64 bits. */
+Rational bigFraction(std::mt19937_64& rng)
+{
+  static const Integer s_offset = Integer(1).multiplyByPow2(80);
+  Integer n = s_offset + Integer(static_cast<unsigned long>(rng() >> 1));
+  return Rational(rng() % 2 == 0 ? n : -n,
+                  Integer(static_cast<long>(rng() % 1000) + 1));
+}
+
+struct Operands
+{
+  std::vector<DeltaRational> d_left;
+  std::vector<DeltaRational> d_right;
+  std::vector<Rational> d_scalars;
+};
+
+/**
+ * Returns s_size operand pairs made by mk, with a nonzero infinitesimal part
+ * if withDelta.
+ */
+template <class Mk>
+Operands mkOperands(Mk mk, bool withDelta, std::mt19937_64& rng)
+{
+  Operands ops;
+  for (size_t i = 0; i < s_size; ++i)
+  {
+    Rational k = withDelta ? Rational(static_cast<long>(rng() % 7) + 1)
+                           : Rational(0);
+    ops.d_left.push_back(DeltaRational(mk(rng), k));
+    ops.d_right.push_back(DeltaRational(mk(rng), withDelta ? -k : k));
+    ops.d_scalars.push_back(mk(rng));
+  }
+  return ops;
+}
+
+void runAll(const std::string& prefix, const Operands& ops)
+{
+  const size_t n = s_size * s_passes;
+  std::vector<DeltaRational> out(s_size);
+  run(prefix + " add", n, [&]() {
+    for (size_t p = 0; p < s_passes; ++p)
+    {
+      for (size_t i = 0; i < s_size; ++i)
+      {
+        out[i] = ops.d_left[i] + ops.d_right[i];
+      }
+    }
+    doNotOptimize(out);
+  });
+  run(prefix + " sub", n, [&]() {
+    for (size_t p = 0; p < s_passes; ++p)
+    {
+      for (size_t i = 0; i < s_size; ++i)
+      {
+        out[i] = ops.d_left[i] - ops.d_right[i];
+      }
+    }
+    doNotOptimize(out);
+  });
+  run(prefix + " mul", n, [&]() {
+    for (size_t p = 0; p < s_passes; ++p)
+    {
+      for (size_t i = 0; i < s_size; ++i)
+      {
+        out[i] = ops.d_left[i] * ops.d_scalars[i];
+      }
+    }
+    doNotOptimize(out);
+  });
+  run(prefix + " copy, add-assign", n, [&]() {
+    for (size_t p = 0; p < s_passes; ++p)
+    {
+      out = ops.d_left;
+      for (size_t i = 0; i < s_size; ++i)
+      {
+        out[i] += ops.d_right[i];
+      }
+    }
+    doNotOptimize(out);
+  });
+  run(prefix + " cmp", n, [&]() {
+    size_t less = 0;
+    for (size_t p = 0; p < s_passes; ++p)
+    {
+      for (size_t i = 0; i < s_size; ++i)
+      {
+        less += ops.d_left[i] < ops.d_right[i];
+      }
+    }
+    doNotOptimize(less);
+  });
+}
+
+}  // namespace
+
+int main()
+{
+  std::mt19937_64 rng(42);
+  runAll("small", mkOperands(smallFraction, false, rng));
+  runAll("small+delta", mkOperands(smallFraction, true, rng));
+  runAll("big", mkOperands(bigFraction, false, rng));
+  runAll("big+delta", mkOperands(bigFraction, true, rng));
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file node_manager_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of making nodes.
+ **
+ ** Times making nodes of known arity with a NodeBuilder and with the direct
+ ** construction of NodeManager::mkNode(), for nodes already in the pool (as
+ ** when rewriting) and for new ones (as when parsing).
+ **/
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark.h"
+#include "expr/node.h"
+#include "expr/node_builder.h"
+#include "expr/node_manager.h"
+
+using namespace CVC4;
+using namespace CVC4::benchmark;
+
+namespace {
+
+/** The number of variables. */
+const size_t s_size = 1000;
+/** The number of passes over the variables per repetition. */
+const size_t s_passes = 20;
+
+Node mkBuilder(NodeManager* nm, TNode a, TNode b)
+{
+  NodeBuilder<2> nb(nm, kind::PLUS);
+  nb << a << b;
+  return nb.constructNode();
+}
+
+Node mkDirect(NodeManager* nm, TNode a, TNode b)
+{
+  return nm->mkNode(kind::PLUS, a, b);
+}
+
+/**
+ * Times making a node of every variable and another one with mk, and prints
+ * the time per node under name.
+ */
+template <class Mk>
+void runMk(const std::string& name,
+           NodeManager* nm,
+           const std::vector<Node>& vars,
+           Mk mk)
+{
+  run(name, s_size * s_passes, [&]() {
+    for (size_t p = 0; p < s_passes; ++p)
+    {
+      std::vector<Node> nodes;
+      nodes.reserve(s_size);
+      for (size_t i = 0; i < s_size; ++i)
+      {
+        nodes.push_back(mk(nm, vars[i], vars[(i + p + 1) % s_size]));
+      }
+      doNotOptimize(nodes);
+    }
+  });
+}
+
+}  // namespace
+
+int main()
+{
+  NodeManager nm(nullptr);
+  NodeManagerScope scope(&nm);
+  TypeNode intType = nm.integerType();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < s_size; ++i)
+  {
+    vars.push_back(nm.mkSkolem("x", intType));
+  }
+
+  {
+    // keep the nodes in the pool, so that they are only looked up
+    std::vector<Node> pool;
+    for (size_t p = 0; p < s_passes; ++p)
+    {
+      for (size_t i = 0; i < s_size; ++i)
+      {
+        pool.push_back(mkDirect(&nm, vars[i], vars[(i + p + 1) % s_size]));
+      }
+    }
+    runMk("mkNode in pool, NodeBuilder", &nm, vars, mkBuilder);
+    runMk("mkNode in pool, direct", &nm, vars, mkDirect);
+  }
+
+  // new nodes each time, whose zombies are reclaimed between the runs
+  nm.reclaimZombiesUntil(0);
+  runMk("mkNode new (2 per op), NodeBuilder",
+        &nm,
+        vars,
+        [](NodeManager* m, TNode a, TNode b) {
+          return mkBuilder(m, mkBuilder(m, a, b), a);
+        });
+  nm.reclaimZombiesUntil(0);
+  runMk("mkNode new (2 per op), direct",
+        &nm,
+        vars,
+        [](NodeManager* m, TNode a, TNode b) {
+          return mkDirect(m, mkDirect(m, a, b), b);
+        });
+  return 0;
+}
@@ -0,0 +1,152 @@
+/*********************                                                        */
+/*! \file tableau_pivot_bench.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Pivot throughput of the arithmetic tableau in both layouts.
+ **
+ ** Runs the same sequence of pivots on a sparse tableau with the linked and
+ ** with the packed layout (--tableau-layout), and times the pivots and full
+ ** sweeps over the rows, as the simplex does when it recomputes the values
+ ** of the basic variables.
+ **/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "options/arith_options.h"
+#include "options/options.h"
+#include "theory/arith/tableau.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::benchmark;
+using namespace CVC4::theory::arith;
+
+namespace {
+
+/** The number of structural (nonbasic at first) variables. */
+const size_t s_vars = 1500;
+/** The number of rows, each with a slack variable as its basic variable. */
+const size_t s_rows = 3000;
+/** The number of structural variables on a row. */
+const size_t s_rowLength = 6;
+/** The number of pivots. */
+const size_t s_pivots = 200;
+/** The number of sweeps over all rows after the pivots. */
+const size_t s_sweeps = 20;
+
+/** Builds the tableau, with rows drawn from a fixed seed. */
+std::unique_ptr<Tableau> mkTableau()
+{
+  std::unique_ptr<Tableau> t(new Tableau());
+  t->increaseSizeTo(s_vars + s_rows);
+  std::mt19937 rng(7);
+  for (size_t r = 0; r < s_rows; ++r)
+  {
+    std::vector<ArithVar> vars;
+    std::vector<Rational> coeffs;
+    while (vars.size() < s_rowLength)
+    {
+      ArithVar v = rng() % s_vars;
+      if (std::find(vars.begin(), vars.end(), v) == vars.end())
+      {
+        vars.push_back(v);
+        coeffs.push_back(Rational(rng() % 2 == 0 ? 1 : -1));
+      }
+    }
+    t->addRow(s_vars + r, coeffs, vars);
+  }
+  return t;
+}
+
+/**
+ * Pivots s_pivots times, each time on the first structural variable of a
+ * row chosen from a fixed seed.
+ */
+void pivot(Tableau& t)
+{
+  NoEffectCCCB cb;
+  std::mt19937 rng(11);
+  for (size_t p = 0; p < s_pivots; ++p)
+  {
+    ArithVar basic = t.rowIndexToBasic(rng() % s_rows);
+    ArithVar entering = ARITHVAR_SENTINEL;
+    for (Tableau::RowIterator i = t.basicRowIterator(basic); !i.atEnd(); ++i)
+    {
+      ArithVar v = (*i).getColVar();
+      if (v != basic && v < s_vars && !t.isBasic(v))
+      {
+        entering = v;
+        break;
+      }
+    }
+    if (entering != ARITHVAR_SENTINEL)
+    {
+      t.pivot(basic, entering, cb);
+    }
+  }
+}
+
+/** Sums the coefficients of all rows s_sweeps times. */
+size_t sweep(const Tableau& t)
+{
+  size_t entries = 0;
+  Rational sum;
+  for (size_t s = 0; s < s_sweeps; ++s)
+  {
+    for (RowIndex r = 0; r < s_rows; ++r)
+    {
+      for (Tableau::RowIterator i = t.getRow(r).begin(); !i.atEnd(); ++i)
+      {
+        sum += (*i).getCoefficient();
+        ++entries;
+      }
+    }
+  }
+  doNotOptimize(sum);
+  return entries;
+}
+
+void runLayout(const std::string& layout)
+{
+  Options opts;
+  opts.setOption("tableau-layout", layout);
+  Options::OptionsScope scope(&opts);
+
+  std::vector<double> pivots, sweeps;
+  size_t entries = 0;
+  for (size_t r = 0; r < s_repetitions; ++r)
+  {
+    std::unique_ptr<Tableau> t = mkTableau();
+    Timer pt;
+    pivot(*t);
+    pivots.push_back(pt.elapsed() / s_pivots);
+    Timer st;
+    size_t swept = sweep(*t);
+    sweeps.push_back(st.elapsed() / swept);
+    entries = t->getNumEntriesInTableau();
+  }
+  report(layout + " pivot", pivots);
+  report(layout + " row sweep (per entry)", sweeps);
+  std::cout << layout << ": " << entries << " entries after the pivots"
+            << std::endl;
+}
+
+}  // namespace
+
+int main()
+{
+  runLayout("linked");
+  runLayout("packed");
+  return 0;
+}
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+#####################
+## time_regressions.py
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+## in the top-level source directory and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.
+##
+"""
+Usage:
+
+    time_regressions.py [--logic LOGIC] [--repeat N] [--timeout SECONDS]
+        [--baseline cvc4-binary] cvc4-binary regress-dir
+
+Runs cvc4-binary on the SMT-LIB 2 regressions under regress-dir that set the
+given logic (QF_LRA by default), and reports the median wall time of each.
+With --baseline, also runs the baseline binary and reports the speedup of
+cvc4-binary over it.
+"""
+
+import argparse
+import math
+import os
+import re
+import shlex
+import statistics
+import subprocess
+import sys
+import time
+
+COMMAND_LINE = 'COMMAND-LINE:'
+REQUIRES = 'REQUIRES:'
+
+
+def find_benchmarks(regress_dir, logic):
+    """Returns the .smt2 files under regress_dir that set logic, with the
+    options of their first COMMAND-LINE directive. Files with requirements
+    are skipped, since the binary may not meet them."""
+    set_logic = re.compile(r'\(\s*set-logic\s+' + re.escape(logic) + r'\s*\)')
+    benchmarks = []
+    for root, _, files in os.walk(regress_dir):
+        for name in sorted(files):
+            if not name.endswith('.smt2'):
+                continue
+            path = os.path.join(root, name)
+            with open(path) as f:
+                content = f.read()
+            if not set_logic.search(content) or REQUIRES in content:
+                continue
+            args = []
+            for line in content.splitlines():
+                if COMMAND_LINE in line:
+                    args = shlex.split(line.split(COMMAND_LINE, 1)[1])
+                    break
+            benchmarks.append((path, args))
+    return sorted(benchmarks)
+
+
+def time_run(binary, path, args, repeat, timeout):
+    """Returns the median wall time of running binary on path, or None if it
+    timed out."""
+    times = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        try:
+            subprocess.run([binary] + args + [path],
+                           stdout=subprocess.DEVNULL,
+                           stderr=subprocess.DEVNULL,
+                           timeout=timeout)
+        except subprocess.TimeoutExpired:
+            return None
+        times.append(time.perf_counter() - start)
+    return statistics.median(times)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='time the regressions of a logic')
+    parser.add_argument('--logic', default='QF_LRA')
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--timeout', type=float, default=60.0)
+    parser.add_argument('--baseline')
+    parser.add_argument('binary')
+    parser.add_argument('regress_dir')
+    args = parser.parse_args()
+
+    benchmarks = find_benchmarks(args.regress_dir, args.logic)
+    if not benchmarks:
+        print('no {} regressions found'.format(args.logic))
+        return 1
+
+    total = 0.0
+    total_baseline = 0.0
+    log_ratios = []
+    for path, options in benchmarks:
+        name = os.path.relpath(path, args.regress_dir)
+        t = time_run(args.binary, path, options, args.repeat, args.timeout)
+        if args.baseline is None:
+            print('{:<60} {}'.format(
+                name, 'timeout' if t is None else '{:8.3f}s'.format(t)))
+            total += t or 0.0
+            continue
+        b = time_run(args.baseline, path, options, args.repeat, args.timeout)
+        if t is None or b is None:
+            print('{:<60} {:>9} {:>9}'.format(
+                name, 'timeout' if t is None else '{:8.3f}s'.format(t),
+                'timeout' if b is None else '{:8.3f}s'.format(b)))
+            continue
+        total += t
+        total_baseline += b
+        log_ratios.append(math.log(b / t))
+        print('{:<60} {:8.3f}s {:8.3f}s {:6.2f}x'.format(name, t, b, b / t))
+
+    print('{} regressions, total {:.3f}s'.format(len(benchmarks), total))
+    if log_ratios:
+        print('baseline total {:.3f}s, geometric mean speedup {:.2f}x'.format(
+            total_baseline, math.exp(statistics.mean(log_ratios))))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
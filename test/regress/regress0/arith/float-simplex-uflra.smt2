@@ -0,0 +1,32 @@
+; COMMAND-LINE: --float-simplex
+; COMMAND-LINE: --float-simplex --standard-effort-variable-order-pivots=0 --heuristic-pivots=0
+; EXPECT: sat
+(set-logic QF_UFLRA)
+(set-info :status sat)
+(declare-fun f (Real) Real)
+(declare-fun x0 () Real)
+(declare-fun x1 () Real)
+(declare-fun x2 () Real)
+(declare-fun x3 () Real)
+(declare-fun x4 () Real)
+(declare-fun x5 () Real)
+(declare-fun x6 () Real)
+(declare-fun x7 () Real)
+(declare-fun x8 () Real)
+(declare-fun x9 () Real)
+(assert (<= (+ (* 4 x0) (* (- 3) x1) (* (- 3) x2) (* 4 x3) (* (- 3) x4) (* (- 4) x7) (* 2 x8) (* (- 1) x9)) 53))
+(assert (<= (+ (* (- 2) x0) (* (- 2) x1) (* (- 2) x3) (* (- 1) x4) (* 4 x5) (* (- 1) x7) (* 4 x8) (* 1 x9)) (- 4)))
+(assert (<= (+ (* 3 x0) (* (- 1) x1) (* 1 x5) (* (- 3) x7) (* 2 x8) (* 1 x9)) 16))
+(assert (<= (+ (* (- 3) x1) (* 1 x3) (* 1 x4) (* 3 x5) (* (- 3) x6) (* (- 3) x8)) (- 9)))
+(assert (<= (+ (* 2 x0) (* 3 x2) (* (- 3) x3) (* (- 1) x4) (* (- 1) x6) (* 3 x7) (* 3 x8)) (- 21)))
+(assert (<= (+ (* 2 x2) (* (- 1) x5) (* (- 2) x6) (* (- 1) x7) (* (- 2) x8) (* (- 4) x9)) (- 11)))
+(assert (<= (+ (* 1 x0) (* (- 2) x2) (* (- 4) x4) (* 4 x5) (* 2 x6) (* 3 x7) (* (- 3) x9)) (- 15)))
+(assert (<= (+ (* (- 3) x0) (* (- 4) x1) (* (- 2) x2) (* 1 x3) (* (- 1) x5)) 22))
+(assert (<= (+ (* 3 x0) (* 3 x2) (* (- 2) x3) (* 1 x4) (* (- 2) x6) (* (- 1) x7) (* (- 2) x9)) (- 22)))
+(assert (<= (+ (* (- 3) x1) (* 1 x3) (* (- 1) x5) (* 4 x6) (* (- 1) x7)) 35))
+(assert (<= (+ (* 4 x3) (* (- 4) x4) (* (- 1) x7)) 47))
+(assert (<= (+ (* 1 x2) (* (- 3) x3) (* (- 1) x4) (* 3 x5) (* 1 x9)) (- 17)))
+(assert (<= (+ (* 2 x1) (* (- 2) x4) (* 1 x5) (* 2 x6) (* (- 3) x7) (* (- 2) x9)) 10))
+(assert (<= (+ (* 3 x0) (* 3 x2) (* 4 x4) (* (- 4) x5) (* (- 3) x6) (* (- 2) x7) (* (- 1) x8)) (- 1)))
+(assert (= (f x0) (+ x1 x2)))
+(check-sat)
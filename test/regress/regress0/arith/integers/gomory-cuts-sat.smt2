@@ -0,0 +1,19 @@
+; COMMAND-LINE: --incremental --gomory-cuts
+; COMMAND-LINE: --incremental --gomory-cuts --gomory-cuts-per-round=1
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (and (<= 0 x) (<= x 10) (<= 0 y) (<= y 10) (<= 0 z) (<= z 10)))
+(assert (= (+ (* 13 x) (* 17 y)) 47))
+(check-sat)
+(push 1)
+(assert (= (+ (* 2 x) (* 3 y) (* 5 z)) 17))
+(assert (<= (+ x y z) 3))
+(check-sat)
+(pop 1)
+(assert (>= (+ x y z) 3))
+(check-sat)
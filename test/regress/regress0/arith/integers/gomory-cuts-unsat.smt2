@@ -0,0 +1,12 @@
+; COMMAND-LINE: --gomory-cuts
+; COMMAND-LINE: --gomory-cuts --gomory-cuts-per-round=1 --cut-pool-age=0
+; EXPECT: unsat
+(set-logic QF_LIRA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun r () Real)
+(assert (and (<= 0 x) (<= x 10) (<= 0 y) (<= y 10)))
+(assert (and (<= 0 r) (<= r (/ 1 2))))
+(assert (<= 44 (+ (* 13 x) (* 17 y) r)))
+(assert (<= (+ (* 13 x) (* 17 y) r) (/ 93 2)))
+(check-sat)
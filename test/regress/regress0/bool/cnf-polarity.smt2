@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental --cnf-polarity
+; COMMAND-LINE: --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(define-fun A () Bool (and p (< x y)))
+(define-fun B () Bool (or q (> x 5)))
+(assert (or A B))
+(check-sat)
+(push 1)
+(assert (not B))
+(assert (=> A (> y 10)))
+(assert (not (> y 10)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not A))
+(check-sat)
+(assert (ite A q (not B)))
+(check-sat)
+(pop 1)
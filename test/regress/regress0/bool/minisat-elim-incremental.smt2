@@ -0,0 +1,33 @@
+; COMMAND-LINE: --incremental --minisat-elimination-incremental
+; COMMAND-LINE: --incremental --minisat-elimination-incremental --minisat-elimination-restarts=1
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+; the Tseitin variables of these conjunctions may be eliminated by the first
+; check-sat
+(assert (or (and (< x y) (< y z)) (and (> x 5) a)))
+(assert (or (and (< z x) b) (and (> y 8) c)))
+(check-sat)
+; the conjunctions are used again, their variables are restored
+(assert (or (and (< x y) (< y z)) (not a)))
+(check-sat)
+(push 1)
+(assert (or (and (< z x) b) (> y 10)))
+(check-sat)
+(assert (<= y 8))
+(check-sat)
+(pop 1)
+(check-sat)
+(assert (not (< x y)))
+(assert (or (not c) (< y 5)))
+(check-sat)
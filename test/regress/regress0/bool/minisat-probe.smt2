@@ -0,0 +1,37 @@
+; COMMAND-LINE: --incremental --minisat-probe
+; COMMAND-LINE: --incremental --minisat-probe --minisat-probe-limit=1
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(declare-fun r () Bool)
+; p is a failed literal: it implies both q and (not q)
+(assert (=> p (and q (< x y))))
+(assert (=> p (or (not q) r)))
+(assert (=> (and p r) (not q)))
+(assert (or p (> x 3)))
+(check-sat)
+; the variables created here are removed by the pop, after probing went over
+; them
+(push 1)
+(declare-fun s () Bool)
+(declare-fun t () Bool)
+(declare-fun u () Bool)
+(assert (=> s (and t (or u (< y x)))))
+(assert (=> s (and (not u) (> y x))))
+(assert (or s (and t (> x 5))))
+(check-sat)
+(assert (or (not t) (and u (> y 7)) (< x 0)))
+(check-sat)
+(pop 1)
+(check-sat)
+(assert (or p (< y 0)))
+(assert (or (not (< y 0)) (< x 3)))
+(assert (or (not (< x 3)) (not (> x 3))))
+(check-sat)
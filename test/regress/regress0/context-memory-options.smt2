@@ -0,0 +1,21 @@
+; COMMAND-LINE: --incremental --context-chunk-size=65536 --context-max-free-chunks=1
+; COMMAND-LINE: --incremental --context-max-free-chunks=0 --context-huge-pages
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-const x Int)
+(declare-const y Int)
+(assert (distinct (f x) (f y)))
+(assert (<= 0 x 3))
+(push 1)
+(assert (or (= y 1) (= y 2)))
+(check-sat)
+(push 1)
+(assert (= x y))
+(check-sat)
+(pop 1)
+(pop 1)
+(assert (< x y))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --full-check-timing
+; EXPECT: unsat
+(set-logic QF_BVLRA)
+(declare-const a (_ BitVec 16))
+(declare-const b (_ BitVec 16))
+(declare-const x Real)
+(declare-const y Real)
+(declare-const p Bool)
+; neither the bit-vector nor the arithmetic part is satisfiable
+(assert (= p (and (bvult a #x0010) (bvugt (bvmul a a) #x0100))))
+(assert (=> (not p) (and (> (+ x y) 3.5) (< x 1.0) (< y 2.0))))
+(assert (or (= b (bvadd a #x0001)) (> x y)))
+(check-sat)
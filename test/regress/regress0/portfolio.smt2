@@ -0,0 +1,9 @@
+; COMMAND-LINE: --portfolio=4
+; EXPECT: unsat
+(set-logic QF_LIA)
+(set-info :status unsat)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> (+ (* 2 x) (* 2 y)) 4))
+(assert (< (+ x y) 3))
+(check-sat)
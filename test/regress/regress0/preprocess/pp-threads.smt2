@@ -0,0 +1,610 @@
+; REQUIRES: thread-safe-nodes
+; COMMAND-LINE: --pp-threads=4
+; EXPECT: unsat
+(set-logic ALL)
+(declare-datatype Lst ((cons (head Int) (tail Lst)) (nil)))
+(declare-fun f (Int) Int)
+(declare-fun g (Int) Int)
+(declare-const p0 Bool)
+(declare-const p1 Bool)
+(declare-const p2 Bool)
+(declare-const p3 Bool)
+(declare-const p4 Bool)
+(declare-const p5 Bool)
+(declare-const p6 Bool)
+(declare-const p7 Bool)
+(declare-const p8 Bool)
+(declare-const p9 Bool)
+(declare-const p10 Bool)
+(declare-const p11 Bool)
+(declare-const p12 Bool)
+(declare-const p13 Bool)
+(declare-const p14 Bool)
+(declare-const p15 Bool)
+(declare-const p16 Bool)
+(declare-const p17 Bool)
+(declare-const p18 Bool)
+(declare-const p19 Bool)
+(declare-const p20 Bool)
+(declare-const p21 Bool)
+(declare-const p22 Bool)
+(declare-const p23 Bool)
+(declare-const p24 Bool)
+(declare-const p25 Bool)
+(declare-const p26 Bool)
+(declare-const p27 Bool)
+(declare-const p28 Bool)
+(declare-const p29 Bool)
+(declare-const p30 Bool)
+(declare-const p31 Bool)
+(declare-const p32 Bool)
+(declare-const p33 Bool)
+(declare-const p34 Bool)
+(declare-const p35 Bool)
+(declare-const p36 Bool)
+(declare-const p37 Bool)
+(declare-const p38 Bool)
+(declare-const p39 Bool)
+(declare-const p40 Bool)
+(declare-const p41 Bool)
+(declare-const p42 Bool)
+(declare-const p43 Bool)
+(declare-const p44 Bool)
+(declare-const p45 Bool)
+(declare-const p46 Bool)
+(declare-const p47 Bool)
+(declare-const p48 Bool)
+(declare-const p49 Bool)
+(declare-const p50 Bool)
+(declare-const p51 Bool)
+(declare-const p52 Bool)
+(declare-const p53 Bool)
+(declare-const p54 Bool)
+(declare-const p55 Bool)
+(declare-const p56 Bool)
+(declare-const p57 Bool)
+(declare-const p58 Bool)
+(declare-const p59 Bool)
+(declare-const p60 Bool)
+(declare-const p61 Bool)
+(declare-const p62 Bool)
+(declare-const p63 Bool)
+(declare-const p64 Bool)
+(declare-const p65 Bool)
+(declare-const p66 Bool)
+(declare-const p67 Bool)
+(declare-const p68 Bool)
+(declare-const p69 Bool)
+(declare-const p70 Bool)
+(declare-const p71 Bool)
+(declare-const p72 Bool)
+(declare-const p73 Bool)
+(declare-const p74 Bool)
+(declare-const p75 Bool)
+(declare-const p76 Bool)
+(declare-const p77 Bool)
+(declare-const p78 Bool)
+(declare-const p79 Bool)
+(declare-const p80 Bool)
+(declare-const p81 Bool)
+(declare-const p82 Bool)
+(declare-const p83 Bool)
+(declare-const p84 Bool)
+(declare-const p85 Bool)
+(declare-const p86 Bool)
+(declare-const p87 Bool)
+(declare-const p88 Bool)
+(declare-const p89 Bool)
+(declare-const p90 Bool)
+(declare-const p91 Bool)
+(declare-const p92 Bool)
+(declare-const p93 Bool)
+(declare-const p94 Bool)
+(declare-const p95 Bool)
+(declare-const p96 Bool)
+(declare-const p97 Bool)
+(declare-const p98 Bool)
+(declare-const p99 Bool)
+(declare-const p100 Bool)
+(declare-const p101 Bool)
+(declare-const p102 Bool)
+(declare-const p103 Bool)
+(declare-const p104 Bool)
+(declare-const p105 Bool)
+(declare-const p106 Bool)
+(declare-const p107 Bool)
+(declare-const p108 Bool)
+(declare-const p109 Bool)
+(declare-const p110 Bool)
+(declare-const p111 Bool)
+(declare-const p112 Bool)
+(declare-const p113 Bool)
+(declare-const p114 Bool)
+(declare-const p115 Bool)
+(declare-const p116 Bool)
+(declare-const p117 Bool)
+(declare-const p118 Bool)
+(declare-const p119 Bool)
+(declare-const p120 Bool)
+(declare-const p121 Bool)
+(declare-const p122 Bool)
+(declare-const p123 Bool)
+(declare-const p124 Bool)
+(declare-const p125 Bool)
+(declare-const p126 Bool)
+(declare-const p127 Bool)
+(declare-const p128 Bool)
+(declare-const p129 Bool)
+(declare-const p130 Bool)
+(declare-const p131 Bool)
+(declare-const p132 Bool)
+(declare-const p133 Bool)
+(declare-const p134 Bool)
+(declare-const p135 Bool)
+(declare-const p136 Bool)
+(declare-const p137 Bool)
+(declare-const p138 Bool)
+(declare-const p139 Bool)
+(declare-const p140 Bool)
+(declare-const p141 Bool)
+(declare-const p142 Bool)
+(declare-const p143 Bool)
+(declare-const p144 Bool)
+(declare-const p145 Bool)
+(declare-const p146 Bool)
+(declare-const p147 Bool)
+(declare-const p148 Bool)
+(declare-const p149 Bool)
+(declare-const a0 Int)
+(declare-const a1 Int)
+(declare-const a2 Int)
+(declare-const a3 Int)
+(declare-const a4 Int)
+(declare-const a5 Int)
+(declare-const a6 Int)
+(declare-const a7 Int)
+(declare-const a8 Int)
+(declare-const a9 Int)
+(declare-const a10 Int)
+(declare-const a11 Int)
+(declare-const a12 Int)
+(declare-const a13 Int)
+(declare-const a14 Int)
+(declare-const a15 Int)
+(declare-const a16 Int)
+(declare-const a17 Int)
+(declare-const a18 Int)
+(declare-const a19 Int)
+(declare-const a20 Int)
+(declare-const a21 Int)
+(declare-const a22 Int)
+(declare-const a23 Int)
+(declare-const a24 Int)
+(declare-const a25 Int)
+(declare-const a26 Int)
+(declare-const a27 Int)
+(declare-const a28 Int)
+(declare-const a29 Int)
+(declare-const a30 Int)
+(declare-const a31 Int)
+(declare-const a32 Int)
+(declare-const a33 Int)
+(declare-const a34 Int)
+(declare-const a35 Int)
+(declare-const a36 Int)
+(declare-const a37 Int)
+(declare-const a38 Int)
+(declare-const a39 Int)
+(declare-const a40 Int)
+(declare-const a41 Int)
+(declare-const a42 Int)
+(declare-const a43 Int)
+(declare-const a44 Int)
+(declare-const a45 Int)
+(declare-const a46 Int)
+(declare-const a47 Int)
+(declare-const a48 Int)
+(declare-const a49 Int)
+(declare-const a50 Int)
+(declare-const a51 Int)
+(declare-const a52 Int)
+(declare-const a53 Int)
+(declare-const a54 Int)
+(declare-const a55 Int)
+(declare-const a56 Int)
+(declare-const a57 Int)
+(declare-const a58 Int)
+(declare-const a59 Int)
+(declare-const a60 Int)
+(declare-const a61 Int)
+(declare-const a62 Int)
+(declare-const a63 Int)
+(declare-const a64 Int)
+(declare-const a65 Int)
+(declare-const a66 Int)
+(declare-const a67 Int)
+(declare-const a68 Int)
+(declare-const a69 Int)
+(declare-const a70 Int)
+(declare-const a71 Int)
+(declare-const a72 Int)
+(declare-const a73 Int)
+(declare-const a74 Int)
+(declare-const a75 Int)
+(declare-const a76 Int)
+(declare-const a77 Int)
+(declare-const a78 Int)
+(declare-const a79 Int)
+(declare-const a80 Int)
+(declare-const a81 Int)
+(declare-const a82 Int)
+(declare-const a83 Int)
+(declare-const a84 Int)
+(declare-const a85 Int)
+(declare-const a86 Int)
+(declare-const a87 Int)
+(declare-const a88 Int)
+(declare-const a89 Int)
+(declare-const a90 Int)
+(declare-const a91 Int)
+(declare-const a92 Int)
+(declare-const a93 Int)
+(declare-const a94 Int)
+(declare-const a95 Int)
+(declare-const a96 Int)
+(declare-const a97 Int)
+(declare-const a98 Int)
+(declare-const a99 Int)
+(declare-const a100 Int)
+(declare-const a101 Int)
+(declare-const a102 Int)
+(declare-const a103 Int)
+(declare-const a104 Int)
+(declare-const a105 Int)
+(declare-const a106 Int)
+(declare-const a107 Int)
+(declare-const a108 Int)
+(declare-const a109 Int)
+(declare-const a110 Int)
+(declare-const a111 Int)
+(declare-const a112 Int)
+(declare-const a113 Int)
+(declare-const a114 Int)
+(declare-const a115 Int)
+(declare-const a116 Int)
+(declare-const a117 Int)
+(declare-const a118 Int)
+(declare-const a119 Int)
+(declare-const a120 Int)
+(declare-const a121 Int)
+(declare-const a122 Int)
+(declare-const a123 Int)
+(declare-const a124 Int)
+(declare-const a125 Int)
+(declare-const a126 Int)
+(declare-const a127 Int)
+(declare-const a128 Int)
+(declare-const a129 Int)
+(declare-const a130 Int)
+(declare-const a131 Int)
+(declare-const a132 Int)
+(declare-const a133 Int)
+(declare-const a134 Int)
+(declare-const a135 Int)
+(declare-const a136 Int)
+(declare-const a137 Int)
+(declare-const a138 Int)
+(declare-const a139 Int)
+(declare-const a140 Int)
+(declare-const a141 Int)
+(declare-const a142 Int)
+(declare-const a143 Int)
+(declare-const a144 Int)
+(declare-const a145 Int)
+(declare-const a146 Int)
+(declare-const a147 Int)
+(declare-const a148 Int)
+(declare-const a149 Int)
+(assert (or p0 (forall ((x Int)) (and (> (f x) 0) (> (g x) 0)))))
+(assert (or p1 (forall ((x Int)) (and (> (f x) -1) (> (g x) 0)))))
+(assert (or p2 (forall ((x Int)) (and (> (f x) -2) (> (g x) 0)))))
+(assert (or p3 (forall ((x Int)) (and (> (f x) -3) (> (g x) 0)))))
+(assert (or p4 (forall ((x Int)) (and (> (f x) -4) (> (g x) 0)))))
+(assert (or p5 (forall ((x Int)) (and (> (f x) -5) (> (g x) 0)))))
+(assert (or p6 (forall ((x Int)) (and (> (f x) -6) (> (g x) 0)))))
+(assert (or p7 (forall ((x Int)) (and (> (f x) -7) (> (g x) 0)))))
+(assert (or p8 (forall ((x Int)) (and (> (f x) -8) (> (g x) 0)))))
+(assert (or p9 (forall ((x Int)) (and (> (f x) -9) (> (g x) 0)))))
+(assert (or p10 (forall ((x Int)) (and (> (f x) -10) (> (g x) 0)))))
+(assert (or p11 (forall ((x Int)) (and (> (f x) -11) (> (g x) 0)))))
+(assert (or p12 (forall ((x Int)) (and (> (f x) -12) (> (g x) 0)))))
+(assert (or p13 (forall ((x Int)) (and (> (f x) -13) (> (g x) 0)))))
+(assert (or p14 (forall ((x Int)) (and (> (f x) -14) (> (g x) 0)))))
+(assert (or p15 (forall ((x Int)) (and (> (f x) -15) (> (g x) 0)))))
+(assert (or p16 (forall ((x Int)) (and (> (f x) -16) (> (g x) 0)))))
+(assert (or p17 (forall ((x Int)) (and (> (f x) -17) (> (g x) 0)))))
+(assert (or p18 (forall ((x Int)) (and (> (f x) -18) (> (g x) 0)))))
+(assert (or p19 (forall ((x Int)) (and (> (f x) -19) (> (g x) 0)))))
+(assert (or p20 (forall ((x Int)) (and (> (f x) -20) (> (g x) 0)))))
+(assert (or p21 (forall ((x Int)) (and (> (f x) -21) (> (g x) 0)))))
+(assert (or p22 (forall ((x Int)) (and (> (f x) -22) (> (g x) 0)))))
+(assert (or p23 (forall ((x Int)) (and (> (f x) -23) (> (g x) 0)))))
+(assert (or p24 (forall ((x Int)) (and (> (f x) -24) (> (g x) 0)))))
+(assert (or p25 (forall ((x Int)) (and (> (f x) -25) (> (g x) 0)))))
+(assert (or p26 (forall ((x Int)) (and (> (f x) -26) (> (g x) 0)))))
+(assert (or p27 (forall ((x Int)) (and (> (f x) -27) (> (g x) 0)))))
+(assert (or p28 (forall ((x Int)) (and (> (f x) -28) (> (g x) 0)))))
+(assert (or p29 (forall ((x Int)) (and (> (f x) -29) (> (g x) 0)))))
+(assert (or p30 (forall ((x Int)) (and (> (f x) -30) (> (g x) 0)))))
+(assert (or p31 (forall ((x Int)) (and (> (f x) -31) (> (g x) 0)))))
+(assert (or p32 (forall ((x Int)) (and (> (f x) -32) (> (g x) 0)))))
+(assert (or p33 (forall ((x Int)) (and (> (f x) -33) (> (g x) 0)))))
+(assert (or p34 (forall ((x Int)) (and (> (f x) -34) (> (g x) 0)))))
+(assert (or p35 (forall ((x Int)) (and (> (f x) -35) (> (g x) 0)))))
+(assert (or p36 (forall ((x Int)) (and (> (f x) -36) (> (g x) 0)))))
+(assert (or p37 (forall ((x Int)) (and (> (f x) -37) (> (g x) 0)))))
+(assert (or p38 (forall ((x Int)) (and (> (f x) -38) (> (g x) 0)))))
+(assert (or p39 (forall ((x Int)) (and (> (f x) -39) (> (g x) 0)))))
+(assert (or p40 (forall ((x Int)) (and (> (f x) -40) (> (g x) 0)))))
+(assert (or p41 (forall ((x Int)) (and (> (f x) -41) (> (g x) 0)))))
+(assert (or p42 (forall ((x Int)) (and (> (f x) -42) (> (g x) 0)))))
+(assert (or p43 (forall ((x Int)) (and (> (f x) -43) (> (g x) 0)))))
+(assert (or p44 (forall ((x Int)) (and (> (f x) -44) (> (g x) 0)))))
+(assert (or p45 (forall ((x Int)) (and (> (f x) -45) (> (g x) 0)))))
+(assert (or p46 (forall ((x Int)) (and (> (f x) -46) (> (g x) 0)))))
+(assert (or p47 (forall ((x Int)) (and (> (f x) -47) (> (g x) 0)))))
+(assert (or p48 (forall ((x Int)) (and (> (f x) -48) (> (g x) 0)))))
+(assert (or p49 (forall ((x Int)) (and (> (f x) -49) (> (g x) 0)))))
+(assert (or p50 (forall ((x Int)) (and (> (f x) -50) (> (g x) 0)))))
+(assert (or p51 (forall ((x Int)) (and (> (f x) -51) (> (g x) 0)))))
+(assert (or p52 (forall ((x Int)) (and (> (f x) -52) (> (g x) 0)))))
+(assert (or p53 (forall ((x Int)) (and (> (f x) -53) (> (g x) 0)))))
+(assert (or p54 (forall ((x Int)) (and (> (f x) -54) (> (g x) 0)))))
+(assert (or p55 (forall ((x Int)) (and (> (f x) -55) (> (g x) 0)))))
+(assert (or p56 (forall ((x Int)) (and (> (f x) -56) (> (g x) 0)))))
+(assert (or p57 (forall ((x Int)) (and (> (f x) -57) (> (g x) 0)))))
+(assert (or p58 (forall ((x Int)) (and (> (f x) -58) (> (g x) 0)))))
+(assert (or p59 (forall ((x Int)) (and (> (f x) -59) (> (g x) 0)))))
+(assert (or p60 (forall ((x Int)) (and (> (f x) -60) (> (g x) 0)))))
+(assert (or p61 (forall ((x Int)) (and (> (f x) -61) (> (g x) 0)))))
+(assert (or p62 (forall ((x Int)) (and (> (f x) -62) (> (g x) 0)))))
+(assert (or p63 (forall ((x Int)) (and (> (f x) -63) (> (g x) 0)))))
+(assert (or p64 (forall ((x Int)) (and (> (f x) -64) (> (g x) 0)))))
+(assert (or p65 (forall ((x Int)) (and (> (f x) -65) (> (g x) 0)))))
+(assert (or p66 (forall ((x Int)) (and (> (f x) -66) (> (g x) 0)))))
+(assert (or p67 (forall ((x Int)) (and (> (f x) -67) (> (g x) 0)))))
+(assert (or p68 (forall ((x Int)) (and (> (f x) -68) (> (g x) 0)))))
+(assert (or p69 (forall ((x Int)) (and (> (f x) -69) (> (g x) 0)))))
+(assert (or p70 (forall ((x Int)) (and (> (f x) -70) (> (g x) 0)))))
+(assert (or p71 (forall ((x Int)) (and (> (f x) -71) (> (g x) 0)))))
+(assert (or p72 (forall ((x Int)) (and (> (f x) -72) (> (g x) 0)))))
+(assert (or p73 (forall ((x Int)) (and (> (f x) -73) (> (g x) 0)))))
+(assert (or p74 (forall ((x Int)) (and (> (f x) -74) (> (g x) 0)))))
+(assert (or p75 (forall ((x Int)) (and (> (f x) -75) (> (g x) 0)))))
+(assert (or p76 (forall ((x Int)) (and (> (f x) -76) (> (g x) 0)))))
+(assert (or p77 (forall ((x Int)) (and (> (f x) -77) (> (g x) 0)))))
+(assert (or p78 (forall ((x Int)) (and (> (f x) -78) (> (g x) 0)))))
+(assert (or p79 (forall ((x Int)) (and (> (f x) -79) (> (g x) 0)))))
+(assert (or p80 (forall ((x Int)) (and (> (f x) -80) (> (g x) 0)))))
+(assert (or p81 (forall ((x Int)) (and (> (f x) -81) (> (g x) 0)))))
+(assert (or p82 (forall ((x Int)) (and (> (f x) -82) (> (g x) 0)))))
+(assert (or p83 (forall ((x Int)) (and (> (f x) -83) (> (g x) 0)))))
+(assert (or p84 (forall ((x Int)) (and (> (f x) -84) (> (g x) 0)))))
+(assert (or p85 (forall ((x Int)) (and (> (f x) -85) (> (g x) 0)))))
+(assert (or p86 (forall ((x Int)) (and (> (f x) -86) (> (g x) 0)))))
+(assert (or p87 (forall ((x Int)) (and (> (f x) -87) (> (g x) 0)))))
+(assert (or p88 (forall ((x Int)) (and (> (f x) -88) (> (g x) 0)))))
+(assert (or p89 (forall ((x Int)) (and (> (f x) -89) (> (g x) 0)))))
+(assert (or p90 (forall ((x Int)) (and (> (f x) -90) (> (g x) 0)))))
+(assert (or p91 (forall ((x Int)) (and (> (f x) -91) (> (g x) 0)))))
+(assert (or p92 (forall ((x Int)) (and (> (f x) -92) (> (g x) 0)))))
+(assert (or p93 (forall ((x Int)) (and (> (f x) -93) (> (g x) 0)))))
+(assert (or p94 (forall ((x Int)) (and (> (f x) -94) (> (g x) 0)))))
+(assert (or p95 (forall ((x Int)) (and (> (f x) -95) (> (g x) 0)))))
+(assert (or p96 (forall ((x Int)) (and (> (f x) -96) (> (g x) 0)))))
+(assert (or p97 (forall ((x Int)) (and (> (f x) -97) (> (g x) 0)))))
+(assert (or p98 (forall ((x Int)) (and (> (f x) -98) (> (g x) 0)))))
+(assert (or p99 (forall ((x Int)) (and (> (f x) -99) (> (g x) 0)))))
+(assert (or p100 (forall ((x Int)) (and (> (f x) -100) (> (g x) 0)))))
+(assert (or p101 (forall ((x Int)) (and (> (f x) -101) (> (g x) 0)))))
+(assert (or p102 (forall ((x Int)) (and (> (f x) -102) (> (g x) 0)))))
+(assert (or p103 (forall ((x Int)) (and (> (f x) -103) (> (g x) 0)))))
+(assert (or p104 (forall ((x Int)) (and (> (f x) -104) (> (g x) 0)))))
+(assert (or p105 (forall ((x Int)) (and (> (f x) -105) (> (g x) 0)))))
+(assert (or p106 (forall ((x Int)) (and (> (f x) -106) (> (g x) 0)))))
+(assert (or p107 (forall ((x Int)) (and (> (f x) -107) (> (g x) 0)))))
+(assert (or p108 (forall ((x Int)) (and (> (f x) -108) (> (g x) 0)))))
+(assert (or p109 (forall ((x Int)) (and (> (f x) -109) (> (g x) 0)))))
+(assert (or p110 (forall ((x Int)) (and (> (f x) -110) (> (g x) 0)))))
+(assert (or p111 (forall ((x Int)) (and (> (f x) -111) (> (g x) 0)))))
+(assert (or p112 (forall ((x Int)) (and (> (f x) -112) (> (g x) 0)))))
+(assert (or p113 (forall ((x Int)) (and (> (f x) -113) (> (g x) 0)))))
+(assert (or p114 (forall ((x Int)) (and (> (f x) -114) (> (g x) 0)))))
+(assert (or p115 (forall ((x Int)) (and (> (f x) -115) (> (g x) 0)))))
+(assert (or p116 (forall ((x Int)) (and (> (f x) -116) (> (g x) 0)))))
+(assert (or p117 (forall ((x Int)) (and (> (f x) -117) (> (g x) 0)))))
+(assert (or p118 (forall ((x Int)) (and (> (f x) -118) (> (g x) 0)))))
+(assert (or p119 (forall ((x Int)) (and (> (f x) -119) (> (g x) 0)))))
+(assert (or p120 (forall ((x Int)) (and (> (f x) -120) (> (g x) 0)))))
+(assert (or p121 (forall ((x Int)) (and (> (f x) -121) (> (g x) 0)))))
+(assert (or p122 (forall ((x Int)) (and (> (f x) -122) (> (g x) 0)))))
+(assert (or p123 (forall ((x Int)) (and (> (f x) -123) (> (g x) 0)))))
+(assert (or p124 (forall ((x Int)) (and (> (f x) -124) (> (g x) 0)))))
+(assert (or p125 (forall ((x Int)) (and (> (f x) -125) (> (g x) 0)))))
+(assert (or p126 (forall ((x Int)) (and (> (f x) -126) (> (g x) 0)))))
+(assert (or p127 (forall ((x Int)) (and (> (f x) -127) (> (g x) 0)))))
+(assert (or p128 (forall ((x Int)) (and (> (f x) -128) (> (g x) 0)))))
+(assert (or p129 (forall ((x Int)) (and (> (f x) -129) (> (g x) 0)))))
+(assert (or p130 (forall ((x Int)) (and (> (f x) -130) (> (g x) 0)))))
+(assert (or p131 (forall ((x Int)) (and (> (f x) -131) (> (g x) 0)))))
+(assert (or p132 (forall ((x Int)) (and (> (f x) -132) (> (g x) 0)))))
+(assert (or p133 (forall ((x Int)) (and (> (f x) -133) (> (g x) 0)))))
+(assert (or p134 (forall ((x Int)) (and (> (f x) -134) (> (g x) 0)))))
+(assert (or p135 (forall ((x Int)) (and (> (f x) -135) (> (g x) 0)))))
+(assert (or p136 (forall ((x Int)) (and (> (f x) -136) (> (g x) 0)))))
+(assert (or p137 (forall ((x Int)) (and (> (f x) -137) (> (g x) 0)))))
+(assert (or p138 (forall ((x Int)) (and (> (f x) -138) (> (g x) 0)))))
+(assert (or p139 (forall ((x Int)) (and (> (f x) -139) (> (g x) 0)))))
+(assert (or p140 (forall ((x Int)) (and (> (f x) -140) (> (g x) 0)))))
+(assert (or p141 (forall ((x Int)) (and (> (f x) -141) (> (g x) 0)))))
+(assert (or p142 (forall ((x Int)) (and (> (f x) -142) (> (g x) 0)))))
+(assert (or p143 (forall ((x Int)) (and (> (f x) -143) (> (g x) 0)))))
+(assert (or p144 (forall ((x Int)) (and (> (f x) -144) (> (g x) 0)))))
+(assert (or p145 (forall ((x Int)) (and (> (f x) -145) (> (g x) 0)))))
+(assert (or p146 (forall ((x Int)) (and (> (f x) -146) (> (g x) 0)))))
+(assert (or p147 (forall ((x Int)) (and (> (f x) -147) (> (g x) 0)))))
+(assert (or p148 (forall ((x Int)) (and (> (f x) -148) (> (g x) 0)))))
+(assert (or p149 (forall ((x Int)) (and (> (f x) -149) (> (g x) 0)))))
+(assert (or p0 (and (= (head (cons a0 nil)) a0) ((_ is cons) (cons a0 nil)))))
+(assert (or p1 (and (= (head (cons a1 nil)) a1) ((_ is cons) (cons a1 nil)))))
+(assert (or p2 (and (= (head (cons a2 nil)) a2) ((_ is cons) (cons a2 nil)))))
+(assert (or p3 (and (= (head (cons a3 nil)) a3) ((_ is cons) (cons a3 nil)))))
+(assert (or p4 (and (= (head (cons a4 nil)) a4) ((_ is cons) (cons a4 nil)))))
+(assert (or p5 (and (= (head (cons a5 nil)) a5) ((_ is cons) (cons a5 nil)))))
+(assert (or p6 (and (= (head (cons a6 nil)) a6) ((_ is cons) (cons a6 nil)))))
+(assert (or p7 (and (= (head (cons a7 nil)) a7) ((_ is cons) (cons a7 nil)))))
+(assert (or p8 (and (= (head (cons a8 nil)) a8) ((_ is cons) (cons a8 nil)))))
+(assert (or p9 (and (= (head (cons a9 nil)) a9) ((_ is cons) (cons a9 nil)))))
+(assert (or p10 (and (= (head (cons a10 nil)) a10) ((_ is cons) (cons a10 nil)))))
+(assert (or p11 (and (= (head (cons a11 nil)) a11) ((_ is cons) (cons a11 nil)))))
+(assert (or p12 (and (= (head (cons a12 nil)) a12) ((_ is cons) (cons a12 nil)))))
+(assert (or p13 (and (= (head (cons a13 nil)) a13) ((_ is cons) (cons a13 nil)))))
+(assert (or p14 (and (= (head (cons a14 nil)) a14) ((_ is cons) (cons a14 nil)))))
+(assert (or p15 (and (= (head (cons a15 nil)) a15) ((_ is cons) (cons a15 nil)))))
+(assert (or p16 (and (= (head (cons a16 nil)) a16) ((_ is cons) (cons a16 nil)))))
+(assert (or p17 (and (= (head (cons a17 nil)) a17) ((_ is cons) (cons a17 nil)))))
+(assert (or p18 (and (= (head (cons a18 nil)) a18) ((_ is cons) (cons a18 nil)))))
+(assert (or p19 (and (= (head (cons a19 nil)) a19) ((_ is cons) (cons a19 nil)))))
+(assert (or p20 (and (= (head (cons a20 nil)) a20) ((_ is cons) (cons a20 nil)))))
+(assert (or p21 (and (= (head (cons a21 nil)) a21) ((_ is cons) (cons a21 nil)))))
+(assert (or p22 (and (= (head (cons a22 nil)) a22) ((_ is cons) (cons a22 nil)))))
+(assert (or p23 (and (= (head (cons a23 nil)) a23) ((_ is cons) (cons a23 nil)))))
+(assert (or p24 (and (= (head (cons a24 nil)) a24) ((_ is cons) (cons a24 nil)))))
+(assert (or p25 (and (= (head (cons a25 nil)) a25) ((_ is cons) (cons a25 nil)))))
+(assert (or p26 (and (= (head (cons a26 nil)) a26) ((_ is cons) (cons a26 nil)))))
+(assert (or p27 (and (= (head (cons a27 nil)) a27) ((_ is cons) (cons a27 nil)))))
+(assert (or p28 (and (= (head (cons a28 nil)) a28) ((_ is cons) (cons a28 nil)))))
+(assert (or p29 (and (= (head (cons a29 nil)) a29) ((_ is cons) (cons a29 nil)))))
+(assert (or p30 (and (= (head (cons a30 nil)) a30) ((_ is cons) (cons a30 nil)))))
+(assert (or p31 (and (= (head (cons a31 nil)) a31) ((_ is cons) (cons a31 nil)))))
+(assert (or p32 (and (= (head (cons a32 nil)) a32) ((_ is cons) (cons a32 nil)))))
+(assert (or p33 (and (= (head (cons a33 nil)) a33) ((_ is cons) (cons a33 nil)))))
+(assert (or p34 (and (= (head (cons a34 nil)) a34) ((_ is cons) (cons a34 nil)))))
+(assert (or p35 (and (= (head (cons a35 nil)) a35) ((_ is cons) (cons a35 nil)))))
+(assert (or p36 (and (= (head (cons a36 nil)) a36) ((_ is cons) (cons a36 nil)))))
+(assert (or p37 (and (= (head (cons a37 nil)) a37) ((_ is cons) (cons a37 nil)))))
+(assert (or p38 (and (= (head (cons a38 nil)) a38) ((_ is cons) (cons a38 nil)))))
+(assert (or p39 (and (= (head (cons a39 nil)) a39) ((_ is cons) (cons a39 nil)))))
+(assert (or p40 (and (= (head (cons a40 nil)) a40) ((_ is cons) (cons a40 nil)))))
+(assert (or p41 (and (= (head (cons a41 nil)) a41) ((_ is cons) (cons a41 nil)))))
+(assert (or p42 (and (= (head (cons a42 nil)) a42) ((_ is cons) (cons a42 nil)))))
+(assert (or p43 (and (= (head (cons a43 nil)) a43) ((_ is cons) (cons a43 nil)))))
+(assert (or p44 (and (= (head (cons a44 nil)) a44) ((_ is cons) (cons a44 nil)))))
+(assert (or p45 (and (= (head (cons a45 nil)) a45) ((_ is cons) (cons a45 nil)))))
+(assert (or p46 (and (= (head (cons a46 nil)) a46) ((_ is cons) (cons a46 nil)))))
+(assert (or p47 (and (= (head (cons a47 nil)) a47) ((_ is cons) (cons a47 nil)))))
+(assert (or p48 (and (= (head (cons a48 nil)) a48) ((_ is cons) (cons a48 nil)))))
+(assert (or p49 (and (= (head (cons a49 nil)) a49) ((_ is cons) (cons a49 nil)))))
+(assert (or p50 (and (= (head (cons a50 nil)) a50) ((_ is cons) (cons a50 nil)))))
+(assert (or p51 (and (= (head (cons a51 nil)) a51) ((_ is cons) (cons a51 nil)))))
+(assert (or p52 (and (= (head (cons a52 nil)) a52) ((_ is cons) (cons a52 nil)))))
+(assert (or p53 (and (= (head (cons a53 nil)) a53) ((_ is cons) (cons a53 nil)))))
+(assert (or p54 (and (= (head (cons a54 nil)) a54) ((_ is cons) (cons a54 nil)))))
+(assert (or p55 (and (= (head (cons a55 nil)) a55) ((_ is cons) (cons a55 nil)))))
+(assert (or p56 (and (= (head (cons a56 nil)) a56) ((_ is cons) (cons a56 nil)))))
+(assert (or p57 (and (= (head (cons a57 nil)) a57) ((_ is cons) (cons a57 nil)))))
+(assert (or p58 (and (= (head (cons a58 nil)) a58) ((_ is cons) (cons a58 nil)))))
+(assert (or p59 (and (= (head (cons a59 nil)) a59) ((_ is cons) (cons a59 nil)))))
+(assert (or p60 (and (= (head (cons a60 nil)) a60) ((_ is cons) (cons a60 nil)))))
+(assert (or p61 (and (= (head (cons a61 nil)) a61) ((_ is cons) (cons a61 nil)))))
+(assert (or p62 (and (= (head (cons a62 nil)) a62) ((_ is cons) (cons a62 nil)))))
+(assert (or p63 (and (= (head (cons a63 nil)) a63) ((_ is cons) (cons a63 nil)))))
+(assert (or p64 (and (= (head (cons a64 nil)) a64) ((_ is cons) (cons a64 nil)))))
+(assert (or p65 (and (= (head (cons a65 nil)) a65) ((_ is cons) (cons a65 nil)))))
+(assert (or p66 (and (= (head (cons a66 nil)) a66) ((_ is cons) (cons a66 nil)))))
+(assert (or p67 (and (= (head (cons a67 nil)) a67) ((_ is cons) (cons a67 nil)))))
+(assert (or p68 (and (= (head (cons a68 nil)) a68) ((_ is cons) (cons a68 nil)))))
+(assert (or p69 (and (= (head (cons a69 nil)) a69) ((_ is cons) (cons a69 nil)))))
+(assert (or p70 (and (= (head (cons a70 nil)) a70) ((_ is cons) (cons a70 nil)))))
+(assert (or p71 (and (= (head (cons a71 nil)) a71) ((_ is cons) (cons a71 nil)))))
+(assert (or p72 (and (= (head (cons a72 nil)) a72) ((_ is cons) (cons a72 nil)))))
+(assert (or p73 (and (= (head (cons a73 nil)) a73) ((_ is cons) (cons a73 nil)))))
+(assert (or p74 (and (= (head (cons a74 nil)) a74) ((_ is cons) (cons a74 nil)))))
+(assert (or p75 (and (= (head (cons a75 nil)) a75) ((_ is cons) (cons a75 nil)))))
+(assert (or p76 (and (= (head (cons a76 nil)) a76) ((_ is cons) (cons a76 nil)))))
+(assert (or p77 (and (= (head (cons a77 nil)) a77) ((_ is cons) (cons a77 nil)))))
+(assert (or p78 (and (= (head (cons a78 nil)) a78) ((_ is cons) (cons a78 nil)))))
+(assert (or p79 (and (= (head (cons a79 nil)) a79) ((_ is cons) (cons a79 nil)))))
+(assert (or p80 (and (= (head (cons a80 nil)) a80) ((_ is cons) (cons a80 nil)))))
+(assert (or p81 (and (= (head (cons a81 nil)) a81) ((_ is cons) (cons a81 nil)))))
+(assert (or p82 (and (= (head (cons a82 nil)) a82) ((_ is cons) (cons a82 nil)))))
+(assert (or p83 (and (= (head (cons a83 nil)) a83) ((_ is cons) (cons a83 nil)))))
+(assert (or p84 (and (= (head (cons a84 nil)) a84) ((_ is cons) (cons a84 nil)))))
+(assert (or p85 (and (= (head (cons a85 nil)) a85) ((_ is cons) (cons a85 nil)))))
+(assert (or p86 (and (= (head (cons a86 nil)) a86) ((_ is cons) (cons a86 nil)))))
+(assert (or p87 (and (= (head (cons a87 nil)) a87) ((_ is cons) (cons a87 nil)))))
+(assert (or p88 (and (= (head (cons a88 nil)) a88) ((_ is cons) (cons a88 nil)))))
+(assert (or p89 (and (= (head (cons a89 nil)) a89) ((_ is cons) (cons a89 nil)))))
+(assert (or p90 (and (= (head (cons a90 nil)) a90) ((_ is cons) (cons a90 nil)))))
+(assert (or p91 (and (= (head (cons a91 nil)) a91) ((_ is cons) (cons a91 nil)))))
+(assert (or p92 (and (= (head (cons a92 nil)) a92) ((_ is cons) (cons a92 nil)))))
+(assert (or p93 (and (= (head (cons a93 nil)) a93) ((_ is cons) (cons a93 nil)))))
+(assert (or p94 (and (= (head (cons a94 nil)) a94) ((_ is cons) (cons a94 nil)))))
+(assert (or p95 (and (= (head (cons a95 nil)) a95) ((_ is cons) (cons a95 nil)))))
+(assert (or p96 (and (= (head (cons a96 nil)) a96) ((_ is cons) (cons a96 nil)))))
+(assert (or p97 (and (= (head (cons a97 nil)) a97) ((_ is cons) (cons a97 nil)))))
+(assert (or p98 (and (= (head (cons a98 nil)) a98) ((_ is cons) (cons a98 nil)))))
+(assert (or p99 (and (= (head (cons a99 nil)) a99) ((_ is cons) (cons a99 nil)))))
+(assert (or p100 (and (= (head (cons a100 nil)) a100) ((_ is cons) (cons a100 nil)))))
+(assert (or p101 (and (= (head (cons a101 nil)) a101) ((_ is cons) (cons a101 nil)))))
+(assert (or p102 (and (= (head (cons a102 nil)) a102) ((_ is cons) (cons a102 nil)))))
+(assert (or p103 (and (= (head (cons a103 nil)) a103) ((_ is cons) (cons a103 nil)))))
+(assert (or p104 (and (= (head (cons a104 nil)) a104) ((_ is cons) (cons a104 nil)))))
+(assert (or p105 (and (= (head (cons a105 nil)) a105) ((_ is cons) (cons a105 nil)))))
+(assert (or p106 (and (= (head (cons a106 nil)) a106) ((_ is cons) (cons a106 nil)))))
+(assert (or p107 (and (= (head (cons a107 nil)) a107) ((_ is cons) (cons a107 nil)))))
+(assert (or p108 (and (= (head (cons a108 nil)) a108) ((_ is cons) (cons a108 nil)))))
+(assert (or p109 (and (= (head (cons a109 nil)) a109) ((_ is cons) (cons a109 nil)))))
+(assert (or p110 (and (= (head (cons a110 nil)) a110) ((_ is cons) (cons a110 nil)))))
+(assert (or p111 (and (= (head (cons a111 nil)) a111) ((_ is cons) (cons a111 nil)))))
+(assert (or p112 (and (= (head (cons a112 nil)) a112) ((_ is cons) (cons a112 nil)))))
+(assert (or p113 (and (= (head (cons a113 nil)) a113) ((_ is cons) (cons a113 nil)))))
+(assert (or p114 (and (= (head (cons a114 nil)) a114) ((_ is cons) (cons a114 nil)))))
+(assert (or p115 (and (= (head (cons a115 nil)) a115) ((_ is cons) (cons a115 nil)))))
+(assert (or p116 (and (= (head (cons a116 nil)) a116) ((_ is cons) (cons a116 nil)))))
+(assert (or p117 (and (= (head (cons a117 nil)) a117) ((_ is cons) (cons a117 nil)))))
+(assert (or p118 (and (= (head (cons a118 nil)) a118) ((_ is cons) (cons a118 nil)))))
+(assert (or p119 (and (= (head (cons a119 nil)) a119) ((_ is cons) (cons a119 nil)))))
+(assert (or p120 (and (= (head (cons a120 nil)) a120) ((_ is cons) (cons a120 nil)))))
+(assert (or p121 (and (= (head (cons a121 nil)) a121) ((_ is cons) (cons a121 nil)))))
+(assert (or p122 (and (= (head (cons a122 nil)) a122) ((_ is cons) (cons a122 nil)))))
+(assert (or p123 (and (= (head (cons a123 nil)) a123) ((_ is cons) (cons a123 nil)))))
+(assert (or p124 (and (= (head (cons a124 nil)) a124) ((_ is cons) (cons a124 nil)))))
+(assert (or p125 (and (= (head (cons a125 nil)) a125) ((_ is cons) (cons a125 nil)))))
+(assert (or p126 (and (= (head (cons a126 nil)) a126) ((_ is cons) (cons a126 nil)))))
+(assert (or p127 (and (= (head (cons a127 nil)) a127) ((_ is cons) (cons a127 nil)))))
+(assert (or p128 (and (= (head (cons a128 nil)) a128) ((_ is cons) (cons a128 nil)))))
+(assert (or p129 (and (= (head (cons a129 nil)) a129) ((_ is cons) (cons a129 nil)))))
+(assert (or p130 (and (= (head (cons a130 nil)) a130) ((_ is cons) (cons a130 nil)))))
+(assert (or p131 (and (= (head (cons a131 nil)) a131) ((_ is cons) (cons a131 nil)))))
+(assert (or p132 (and (= (head (cons a132 nil)) a132) ((_ is cons) (cons a132 nil)))))
+(assert (or p133 (and (= (head (cons a133 nil)) a133) ((_ is cons) (cons a133 nil)))))
+(assert (or p134 (and (= (head (cons a134 nil)) a134) ((_ is cons) (cons a134 nil)))))
+(assert (or p135 (and (= (head (cons a135 nil)) a135) ((_ is cons) (cons a135 nil)))))
+(assert (or p136 (and (= (head (cons a136 nil)) a136) ((_ is cons) (cons a136 nil)))))
+(assert (or p137 (and (= (head (cons a137 nil)) a137) ((_ is cons) (cons a137 nil)))))
+(assert (or p138 (and (= (head (cons a138 nil)) a138) ((_ is cons) (cons a138 nil)))))
+(assert (or p139 (and (= (head (cons a139 nil)) a139) ((_ is cons) (cons a139 nil)))))
+(assert (or p140 (and (= (head (cons a140 nil)) a140) ((_ is cons) (cons a140 nil)))))
+(assert (or p141 (and (= (head (cons a141 nil)) a141) ((_ is cons) (cons a141 nil)))))
+(assert (or p142 (and (= (head (cons a142 nil)) a142) ((_ is cons) (cons a142 nil)))))
+(assert (or p143 (and (= (head (cons a143 nil)) a143) ((_ is cons) (cons a143 nil)))))
+(assert (or p144 (and (= (head (cons a144 nil)) a144) ((_ is cons) (cons a144 nil)))))
+(assert (or p145 (and (= (head (cons a145 nil)) a145) ((_ is cons) (cons a145 nil)))))
+(assert (or p146 (and (= (head (cons a146 nil)) a146) ((_ is cons) (cons a146 nil)))))
+(assert (or p147 (and (= (head (cons a147 nil)) a147) ((_ is cons) (cons a147 nil)))))
+(assert (or p148 (and (= (head (cons a148 nil)) a148) ((_ is cons) (cons a148 nil)))))
+(assert (or p149 (and (= (head (cons a149 nil)) a149) ((_ is cons) (cons a149 nil)))))
+(assert (not p0))
+(assert (< (f 3) 0))
+(check-sat)
@@ -0,0 +1,55 @@
+; COMMAND-LINE: --incremental --arith-warm-start
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; Each query tightens a bound of x or y, which are nonbasic, past the value
+; they had in the last satisfying assignment.
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (<= (+ x y) 10))
+(assert (>= x 0))
+(assert (>= y 0))
+
+(push 1)
+(assert (>= x 7))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= x (/ 15 2)))
+(assert (>= y 3))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= x 8))
+(assert (<= x 9))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= x 11))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (<= x 1))
+(assert (>= y 9))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (<= y (- 1)))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (<= y (/ 1 2)))
+(assert (>= x (/ 19 2)))
+(check-sat)
+(pop 1)
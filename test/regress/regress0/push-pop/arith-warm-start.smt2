@@ -0,0 +1,63 @@
+; COMMAND-LINE: --incremental
+; COMMAND-LINE: --incremental --arith-warm-start
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (<= (+ x y) 10))
+(assert (<= (- x y) 4))
+(assert (<= y 6))
+(assert (>= x 0))
+(assert (>= y 0))
+
+(push 1)
+(assert (>= (+ x y) 5))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= (+ x y) 9))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= (+ x y) 11))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= (+ x y) 10))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= (+ x y) (/ 21 2)))
+(check-sat)
+(pop 1)
+
+(push 1)
+(declare-fun z () Real)
+(assert (< (+ x y) z))
+(assert (< z 3))
+(assert (>= (+ x y) 2))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= x 7))
+(assert (>= y 3))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (>= x (/ 15 2)))
+(assert (>= y 3))
+(check-sat)
+(pop 1)
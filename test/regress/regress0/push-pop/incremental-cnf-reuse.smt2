@@ -0,0 +1,37 @@
+; COMMAND-LINE: --incremental --incremental-cnf
+; COMMAND-LINE: --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(push 1)
+(assert (not (= x y)))
+(check-sat)
+(assert (> x 1))
+(assert (< x 3))
+(assert (= y 2))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not (= x y)))
+(check-sat)
+(assert (> x 2))
+(assert (< x 4))
+(assert (= y 3))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not (= x y)))
+(check-sat)
+(assert (> x 3))
+(assert (< x 6))
+(assert (= y 4))
+(check-sat)
+(pop 1)
+(check-sat)
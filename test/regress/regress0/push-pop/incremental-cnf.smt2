@@ -0,0 +1,36 @@
+; COMMAND-LINE: --incremental --incremental-cnf
+; COMMAND-LINE: --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(assert (> x 0))
+(push 1)
+(assert (or (and p (< x y)) (and q (> y 10))))
+(assert (not (= p q)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (or (and p (< x y)) (and q (> y 10))))
+(assert (not p))
+(assert (<= y 10))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (or (and p (< x y)) (and q (> y 10))))
+(assert (not p))
+(check-sat)
+(assert (=> q (< y x)))
+(check-sat)
+(assert (< x 5))
+(check-sat)
+(pop 1)
+(assert (< x y))
+(check-sat)
@@ -0,0 +1,203 @@
+; COMMAND-LINE: --incremental --tableau-layout=packed
+; COMMAND-LINE: --incremental --tableau-layout=linked
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; Over 1000 tableau entries, so that the packed layout repacks the rows.
+(set-logic QF_LRA)
+(declare-fun x0 () Real)
+(declare-fun x1 () Real)
+(declare-fun x2 () Real)
+(declare-fun x3 () Real)
+(declare-fun x4 () Real)
+(declare-fun x5 () Real)
+(declare-fun x6 () Real)
+(declare-fun x7 () Real)
+(declare-fun x8 () Real)
+(declare-fun x9 () Real)
+(declare-fun x10 () Real)
+(declare-fun x11 () Real)
+(declare-fun x12 () Real)
+(declare-fun x13 () Real)
+(declare-fun x14 () Real)
+(declare-fun x15 () Real)
+(declare-fun x16 () Real)
+(declare-fun x17 () Real)
+(declare-fun x18 () Real)
+(declare-fun x19 () Real)
+(declare-fun x20 () Real)
+(declare-fun x21 () Real)
+(declare-fun x22 () Real)
+(declare-fun x23 () Real)
+(declare-fun x24 () Real)
+(declare-fun x25 () Real)
+(declare-fun x26 () Real)
+(declare-fun x27 () Real)
+(declare-fun x28 () Real)
+(declare-fun x29 () Real)
+(declare-fun x30 () Real)
+(declare-fun x31 () Real)
+(declare-fun x32 () Real)
+(declare-fun x33 () Real)
+(declare-fun x34 () Real)
+(declare-fun x35 () Real)
+(declare-fun x36 () Real)
+(declare-fun x37 () Real)
+(declare-fun x38 () Real)
+(declare-fun x39 () Real)
+(declare-fun x40 () Real)
+(declare-fun x41 () Real)
+(declare-fun x42 () Real)
+(declare-fun x43 () Real)
+(declare-fun x44 () Real)
+(declare-fun x45 () Real)
+(declare-fun x46 () Real)
+(declare-fun x47 () Real)
+(declare-fun x48 () Real)
+(declare-fun x49 () Real)
+(assert (<= (+ (* (- 3) x10) (* (- 3) x11) (* (- 3) x12) (* 3 x20) (* (- 4) x33) (* 1 x34) (* 1 x41) (* 2 x43) (* (- 3) x47)) 34))
+(assert (<= (+ (* (- 3) x6) (* 4 x9) (* (- 1) x13) (* 2 x16) (* (- 2) x19) (* (- 3) x29) (* 3 x34) (* (- 2) x35)) 36))
+(assert (<= (+ (* (- 4) x1) (* (- 1) x3) (* (- 4) x10) (* 4 x14) (* (- 3) x25) (* 2 x26) (* (- 4) x40)) 16))
+(assert (<= (+ (* 1 x2) (* (- 1) x4) (* (- 3) x12) (* (- 3) x16) (* (- 2) x29) (* (- 1) x35) (* 1 x45) (* (- 3) x49)) (- 5)))
+(assert (<= (+ (* 3 x0) (* (- 3) x10) (* (- 1) x21) (* 1 x26) (* 3 x28) (* 3 x39) (* 1 x42)) 8))
+(assert (<= (+ (* (- 2) x1) (* (- 3) x6) (* 2 x8) (* (- 3) x15) (* (- 1) x21) (* 4 x27) (* 4 x35) (* 1 x40)) (- 37)))
+(assert (<= (+ (* 4 x1) (* 3 x9) (* (- 3) x11) (* 3 x13) (* 1 x24) (* 4 x25) (* (- 2) x43) (* 1 x48)) (- 30)))
+(assert (<= (+ (* 3 x1) (* 1 x3) (* 2 x14) (* 3 x24) (* 2 x29) (* 1 x31) (* 1 x43)) (- 1)))
+(assert (<= (+ (* 1 x2) (* (- 3) x16) (* 3 x24) (* (- 1) x26) (* 1 x30) (* (- 2) x35) (* 2 x42)) 12))
+(assert (<= (+ (* (- 1) x0) (* 4 x2) (* (- 4) x7) (* 3 x16) (* (- 3) x17) (* 1 x28) (* (- 1) x29) (* 2 x36) (* (- 2) x48)) (- 15)))
+(assert (<= (+ (* (- 3) x18) (* (- 2) x23) (* (- 4) x25) (* (- 3) x32) (* (- 2) x39) (* (- 4) x43) (* (- 2) x47)) (- 40)))
+(assert (<= (+ (* (- 3) x2) (* 2 x3) (* (- 4) x18) (* (- 2) x30) (* 2 x36) (* (- 3) x37) (* (- 2) x38) (* (- 1) x45) (* (- 1) x49)) 18))
+(assert (<= (+ (* (- 1) x14) (* 1 x23) (* 4 x27) (* (- 2) x34) (* 2 x37) (* 3 x39) (* 1 x42) (* (- 4) x48)) (- 16)))
+(assert (<= (+ (* 3 x10) (* 3 x13) (* (- 4) x20) (* (- 4) x22) (* 2 x34) (* 3 x41) (* 4 x46) (* (- 2) x47)) 1))
+(assert (<= (+ (* 2 x2) (* 4 x11) (* (- 4) x15) (* 3 x18) (* (- 2) x20) (* 4 x25) (* (- 1) x28) (* 3 x42)) (- 40)))
+(assert (<= (+ (* 3 x0) (* 2 x2) (* 1 x3) (* (- 2) x16) (* (- 2) x24) (* (- 3) x25) (* 4 x26) (* (- 3) x40)) (- 23)))
+(assert (<= (+ (* (- 1) x1) (* (- 1) x7) (* 2 x9) (* 1 x19) (* 1 x30) (* 1 x39) (* 3 x41) (* 4 x43)) 32))
+(assert (<= (+ (* (- 2) x1) (* (- 3) x4) (* 1 x9) (* 1 x14) (* (- 3) x35) (* (- 3) x36) (* (- 3) x42) (* (- 4) x47)) 7))
+(assert (<= (+ (* (- 4) x2) (* (- 1) x16) (* (- 3) x17) (* (- 2) x26) (* (- 2) x32) (* (- 1) x34) (* 4 x36) (* (- 4) x40) (* (- 2) x41)) 15))
+(assert (<= (+ (* (- 4) x2) (* (- 2) x24) (* (- 2) x26) (* (- 4) x36) (* 2 x38) (* 3 x46) (* (- 4) x47)) (- 4)))
+(assert (<= (+ (* (- 2) x2) (* (- 1) x18) (* 1 x20) (* (- 3) x29) (* (- 2) x39) (* (- 2) x42) (* (- 2) x45)) 19))
+(assert (<= (+ (* (- 1) x10) (* (- 3) x12) (* 1 x27) (* (- 3) x32) (* (- 2) x33) (* (- 3) x34) (* 3 x41) (* 2 x43) (* (- 3) x48)) (- 18)))
+(assert (<= (+ (* 3 x6) (* 4 x9) (* (- 1) x15) (* (- 2) x21) (* (- 1) x23) (* 2 x24) (* (- 4) x32) (* (- 3) x40) (* (- 2) x45)) (- 28)))
+(assert (<= (+ (* (- 2) x2) (* 1 x3) (* 2 x23) (* (- 1) x28) (* 4 x35) (* 2 x40) (* 1 x46)) 9))
+(assert (<= (+ (* (- 4) x6) (* (- 2) x24) (* (- 3) x25) (* (- 4) x30) (* (- 4) x34) (* 2 x41) (* (- 2) x42) (* (- 3) x44)) (- 25)))
+(assert (<= (+ (* 3 x8) (* (- 2) x9) (* 1 x17) (* 3 x19) (* 2 x26) (* (- 2) x33) (* (- 4) x40) (* 2 x44)) (- 7)))
+(assert (<= (+ (* 1 x3) (* (- 2) x5) (* (- 3) x22) (* (- 4) x26) (* (- 1) x30) (* 2 x31) (* 3 x42) (* (- 1) x45) (* (- 3) x49)) 7))
+(assert (<= (+ (* 3 x9) (* 2 x11) (* 2 x12) (* (- 1) x13) (* 3 x20) (* (- 4) x31) (* 3 x34) (* 2 x43)) 24))
+(assert (<= (+ (* (- 2) x3) (* 2 x7) (* (- 2) x8) (* (- 3) x11) (* 2 x18) (* 2 x27) (* 1 x47)) (- 12)))
+(assert (<= (+ (* (- 2) x2) (* (- 4) x13) (* 4 x18) (* 3 x25) (* (- 4) x32) (* (- 2) x36) (* 4 x38) (* (- 4) x39) (* 2 x45)) (- 12)))
+(assert (<= (+ (* (- 1) x2) (* (- 3) x9) (* 1 x12) (* 4 x17) (* (- 4) x34) (* 1 x42) (* 1 x45)) (- 15)))
+(assert (<= (+ (* (- 4) x7) (* 3 x11) (* (- 3) x12) (* 1 x13) (* (- 2) x24) (* 1 x26) (* (- 1) x27) (* (- 1) x30) (* (- 1) x39)) (- 39)))
+(assert (<= (+ (* (- 1) x5) (* (- 4) x11) (* (- 1) x12) (* (- 3) x18) (* (- 4) x26) (* (- 4) x32) (* (- 2) x43) (* 2 x45) (* (- 4) x46)) 1))
+(assert (<= (+ (* (- 4) x5) (* (- 2) x14) (* (- 4) x17) (* (- 3) x20) (* (- 4) x26) (* (- 1) x30) (* (- 3) x36) (* (- 3) x40) (* (- 1) x44)) 18))
+(assert (<= (+ (* (- 4) x17) (* (- 4) x28) (* (- 2) x31) (* (- 4) x32) (* 2 x33) (* 4 x44) (* (- 4) x45)) (- 19)))
+(assert (<= (+ (* (- 2) x2) (* 4 x20) (* 2 x21) (* (- 3) x33) (* (- 1) x37) (* 1 x38) (* 2 x42)) 27))
+(assert (<= (+ (* 2 x2) (* 3 x3) (* 3 x4) (* 3 x14) (* (- 1) x15) (* (- 3) x26) (* (- 2) x41) (* (- 1) x48)) (- 24)))
+(assert (<= (+ (* 4 x3) (* 1 x5) (* (- 3) x7) (* 3 x28) (* (- 3) x34) (* (- 1) x36) (* (- 4) x42) (* 2 x44)) (- 17)))
+(assert (<= (+ (* (- 2) x3) (* (- 2) x10) (* (- 2) x13) (* 2 x16) (* 4 x21) (* (- 2) x24) (* 3 x33) (* (- 4) x45) (* (- 4) x46)) 0))
+(assert (<= (+ (* 4 x1) (* (- 1) x9) (* (- 1) x13) (* 4 x14) (* 4 x22) (* (- 3) x27) (* (- 3) x29) (* 4 x36) (* 2 x37)) 5))
+(assert (<= (+ (* (- 1) x5) (* (- 4) x10) (* 2 x14) (* 4 x19) (* 1 x20) (* (- 1) x21) (* (- 1) x43) (* (- 3) x48)) (- 27)))
+(assert (<= (+ (* (- 1) x2) (* 3 x3) (* (- 3) x4) (* 2 x5) (* (- 1) x14) (* 2 x23) (* (- 3) x35) (* (- 1) x45) (* 2 x48)) 44))
+(assert (<= (+ (* (- 3) x9) (* 2 x15) (* 4 x17) (* (- 1) x19) (* (- 2) x29) (* 3 x36) (* 1 x44)) 8))
+(assert (<= (+ (* 1 x11) (* (- 2) x25) (* 3 x26) (* (- 4) x38) (* 4 x39) (* (- 3) x43) (* (- 3) x45) (* (- 3) x46) (* (- 4) x47)) (- 2)))
+(assert (<= (+ (* 2 x1) (* 3 x8) (* 1 x11) (* 2 x19) (* (- 1) x21) (* 3 x24) (* (- 2) x27) (* 3 x30) (* 2 x36)) 22))
+(assert (<= (+ (* (- 4) x7) (* 3 x8) (* 3 x9) (* (- 3) x22) (* (- 2) x26) (* (- 4) x44) (* 4 x45)) 20))
+(assert (<= (+ (* 1 x1) (* 2 x9) (* (- 3) x15) (* (- 1) x36) (* 4 x37) (* 1 x40) (* (- 3) x44)) 8))
+(assert (<= (+ (* 2 x0) (* 4 x12) (* (- 3) x26) (* (- 3) x29) (* (- 1) x31) (* 3 x42) (* (- 2) x47)) 17))
+(assert (<= (+ (* (- 4) x2) (* (- 3) x7) (* (- 1) x17) (* 2 x35) (* (- 1) x41) (* 4 x43) (* 2 x45) (* 2 x46)) 22))
+(assert (<= (+ (* (- 4) x0) (* 4 x14) (* (- 1) x19) (* (- 2) x23) (* (- 4) x24) (* (- 3) x37) (* 4 x44)) (- 53)))
+(assert (<= (+ (* (- 4) x4) (* (- 4) x14) (* 2 x18) (* (- 3) x21) (* 3 x25) (* 4 x27) (* (- 1) x28) (* (- 1) x43) (* (- 2) x46)) (- 11)))
+(assert (<= (+ (* (- 4) x6) (* (- 3) x16) (* (- 4) x18) (* 4 x28) (* 1 x31) (* 4 x32) (* 2 x45)) 24))
+(assert (<= (+ (* (- 3) x2) (* (- 4) x12) (* 3 x14) (* 3 x22) (* (- 4) x25) (* (- 3) x28) (* 4 x35) (* 2 x43) (* (- 2) x49)) (- 15)))
+(assert (<= (+ (* 4 x0) (* 2 x1) (* 2 x2) (* (- 4) x5) (* 4 x19) (* (- 4) x20) (* 1 x30) (* (- 1) x31) (* 2 x49)) (- 42)))
+(assert (<= (+ (* (- 1) x4) (* 1 x14) (* 3 x15) (* 1 x37) (* 4 x42) (* 4 x43) (* (- 4) x46)) 43))
+(assert (<= (+ (* (- 3) x6) (* 2 x9) (* 2 x15) (* 4 x19) (* (- 4) x21) (* (- 2) x38) (* 3 x47)) (- 13)))
+(assert (<= (+ (* (- 3) x4) (* 1 x8) (* (- 1) x11) (* 3 x15) (* 1 x16) (* (- 4) x26) (* 2 x36) (* 2 x46) (* 3 x47)) 20))
+(assert (<= (+ (* 4 x1) (* (- 2) x3) (* (- 4) x13) (* 4 x14) (* (- 3) x17) (* (- 2) x18) (* (- 2) x32)) 1))
+(assert (<= (+ (* 4 x18) (* 3 x23) (* 3 x26) (* 4 x28) (* 2 x32) (* 1 x40) (* 2 x44)) (- 11)))
+(assert (<= (+ (* (- 4) x3) (* 2 x7) (* (- 2) x16) (* 4 x17) (* 4 x22) (* 1 x23) (* 2 x40)) (- 51)))
+(assert (<= (+ (* (- 2) x5) (* 1 x10) (* 4 x11) (* (- 2) x19) (* (- 2) x27) (* 2 x35) (* 2 x38) (* 3 x41) (* 3 x44)) 10))
+(assert (<= (+ (* 4 x2) (* (- 1) x6) (* (- 2) x8) (* 4 x11) (* 4 x17) (* 4 x22) (* (- 4) x32) (* 3 x35) (* (- 2) x45)) (- 95)))
+(assert (<= (+ (* (- 2) x0) (* 1 x1) (* 1 x6) (* (- 4) x7) (* 1 x15) (* 4 x21) (* 3 x29)) (- 20)))
+(assert (<= (+ (* 2 x4) (* 2 x7) (* 1 x8) (* (- 3) x10) (* 2 x13) (* (- 4) x17) (* (- 2) x36) (* 1 x37) (* (- 2) x41)) 16))
+(assert (<= (+ (* 3 x1) (* 2 x7) (* 1 x15) (* 2 x21) (* 2 x30) (* 2 x44) (* 1 x45) (* (- 1) x47) (* (- 2) x49)) (- 3)))
+(assert (<= (+ (* (- 2) x1) (* 4 x5) (* (- 1) x6) (* 3 x12) (* 2 x13) (* (- 3) x22) (* (- 3) x27) (* (- 2) x43) (* 2 x49)) 35))
+(assert (<= (+ (* (- 4) x0) (* (- 2) x5) (* 3 x10) (* (- 4) x20) (* (- 2) x23) (* (- 2) x24) (* 3 x41) (* (- 2) x44) (* 4 x45)) 4))
+(assert (<= (+ (* 3 x3) (* 4 x4) (* (- 1) x10) (* 3 x16) (* 2 x27) (* 1 x28) (* 1 x41) (* (- 3) x48)) (- 3)))
+(assert (<= (+ (* 4 x0) (* 2 x10) (* 1 x25) (* 2 x37) (* 2 x38) (* (- 1) x45) (* (- 4) x46)) 12))
+(assert (<= (+ (* 1 x1) (* 4 x4) (* (- 2) x5) (* (- 2) x8) (* (- 2) x33) (* (- 1) x37) (* (- 3) x45) (* 4 x46) (* (- 3) x47)) (- 32)))
+(assert (<= (+ (* (- 4) x2) (* (- 2) x12) (* (- 4) x32) (* 2 x36) (* (- 2) x43) (* 3 x48) (* (- 2) x49)) (- 2)))
+(assert (<= (+ (* 4 x2) (* 3 x9) (* (- 4) x10) (* 2 x13) (* (- 1) x17) (* 4 x21) (* 4 x31) (* 4 x33)) (- 32)))
+(assert (<= (+ (* 2 x9) (* 1 x21) (* (- 4) x24) (* 3 x30) (* 1 x34) (* 3 x39) (* 3 x41)) 21))
+(assert (<= (+ (* (- 4) x0) (* (- 4) x1) (* (- 3) x3) (* 4 x6) (* 2 x16) (* (- 2) x29) (* 4 x43)) 44))
+(assert (<= (+ (* (- 1) x0) (* (- 3) x1) (* (- 1) x7) (* (- 3) x16) (* (- 4) x31) (* (- 1) x33) (* (- 3) x34) (* (- 4) x42) (* 1 x44)) (- 6)))
+(assert (<= (+ (* (- 2) x3) (* 3 x17) (* 1 x20) (* (- 3) x30) (* (- 3) x32) (* (- 3) x33) (* (- 4) x37)) (- 55)))
+(assert (<= (+ (* 3 x10) (* 4 x17) (* 2 x23) (* (- 3) x25) (* 1 x30) (* (- 2) x32) (* (- 1) x36) (* 4 x38) (* 4 x49)) (- 21)))
+(assert (<= (+ (* 3 x5) (* (- 2) x8) (* 2 x12) (* 4 x13) (* 1 x43) (* 4 x46) (* 3 x49)) (- 14)))
+(assert (<= (+ (* (- 1) x3) (* (- 1) x18) (* (- 2) x22) (* 2 x24) (* 2 x31) (* 3 x34) (* (- 4) x44) (* 4 x45)) 59))
+(assert (<= (+ (* 4 x0) (* 2 x26) (* 3 x32) (* 3 x37) (* 4 x40) (* 3 x44) (* 4 x45) (* 2 x49)) 22))
+(assert (<= (+ (* (- 3) x4) (* 4 x18) (* (- 2) x20) (* (- 3) x24) (* (- 2) x28) (* 2 x29) (* (- 2) x30) (* 3 x32)) (- 31)))
+(assert (<= (+ (* 2 x0) (* 1 x5) (* (- 2) x8) (* (- 2) x30) (* 2 x37) (* 4 x38) (* (- 4) x40) (* (- 3) x41) (* 3 x48)) 0))
+(assert (<= (+ (* 4 x1) (* (- 3) x14) (* 3 x17) (* 4 x19) (* (- 1) x24) (* (- 1) x34) (* (- 1) x44)) (- 44)))
+(assert (<= (+ (* 1 x1) (* (- 4) x3) (* 2 x4) (* (- 2) x6) (* 1 x9) (* 4 x30) (* 1 x35) (* (- 1) x36)) (- 13)))
+(assert (<= (+ (* 3 x0) (* (- 1) x18) (* (- 4) x22) (* (- 1) x25) (* 2 x30) (* 2 x33) (* (- 4) x34) (* 1 x44)) 2))
+(assert (<= (+ (* (- 2) x0) (* 3 x15) (* (- 3) x19) (* (- 3) x31) (* 1 x37) (* 1 x38) (* (- 2) x44) (* (- 4) x47)) 30))
+(assert (<= (+ (* (- 1) x0) (* 4 x9) (* 1 x11) (* 3 x14) (* 2 x18) (* 2 x19) (* 3 x21) (* (- 4) x23) (* 3 x49)) (- 36)))
+(assert (<= (+ (* (- 2) x13) (* (- 1) x14) (* 2 x19) (* (- 3) x22) (* (- 2) x23) (* 4 x27) (* 1 x29) (* 4 x39) (* 1 x49)) 6))
+(assert (<= (+ (* (- 1) x1) (* (- 2) x7) (* 2 x15) (* 1 x19) (* 2 x25) (* (- 2) x29) (* 4 x32) (* 3 x46) (* (- 2) x48)) 17))
+(assert (<= (+ (* (- 4) x4) (* 3 x6) (* (- 2) x8) (* (- 4) x12) (* 3 x16) (* (- 3) x25) (* (- 3) x39)) (- 7)))
+(assert (<= (+ (* (- 4) x6) (* (- 1) x15) (* (- 2) x26) (* 3 x29) (* 2 x32) (* (- 3) x43) (* 1 x44) (* (- 1) x49)) (- 30)))
+(assert (<= (+ (* 2 x14) (* 4 x18) (* (- 4) x20) (* 4 x21) (* 4 x24) (* (- 1) x32) (* 1 x39) (* 3 x47)) 2))
+(assert (<= (+ (* 2 x3) (* 2 x5) (* (- 3) x18) (* 3 x22) (* 2 x33) (* 3 x42) (* (- 3) x47) (* 4 x49)) 6))
+(assert (<= (+ (* (- 3) x4) (* (- 2) x13) (* (- 4) x16) (* 1 x33) (* 2 x37) (* 1 x40) (* 1 x46)) 8))
+(assert (<= (+ (* 2 x0) (* (- 4) x3) (* 1 x4) (* (- 2) x8) (* 1 x11) (* 4 x23) (* (- 4) x28) (* (- 2) x40) (* (- 1) x47)) 1))
+(assert (<= (+ (* 2 x3) (* (- 2) x7) (* 4 x22) (* 1 x23) (* (- 2) x34) (* (- 2) x35) (* (- 2) x37) (* (- 2) x38) (* 1 x49)) (- 25)))
+(assert (<= (+ (* 4 x0) (* 2 x19) (* (- 4) x21) (* 2 x26) (* 1 x28) (* (- 2) x30) (* 1 x32)) (- 18)))
+(assert (<= (+ (* (- 4) x8) (* 1 x17) (* 4 x22) (* (- 4) x27) (* (- 1) x33) (* 4 x35) (* (- 2) x42) (* 3 x49)) (- 1)))
+(assert (<= (+ (* 1 x0) (* 4 x15) (* (- 4) x23) (* (- 1) x28) (* 3 x34) (* 2 x41) (* 2 x44)) 20))
+(assert (<= (+ (* 3 x2) (* 1 x9) (* (- 1) x10) (* 3 x11) (* 4 x27) (* 2 x28) (* (- 4) x38) (* (- 3) x47)) (- 48)))
+(assert (<= (+ (* (- 3) x8) (* (- 3) x9) (* 3 x11) (* (- 1) x26) (* 3 x28) (* 4 x36) (* (- 2) x37) (* 2 x43) (* (- 2) x47)) (- 3)))
+(assert (<= (+ (* (- 3) x0) (* 4 x3) (* (- 3) x5) (* 4 x10) (* 4 x15) (* (- 1) x22) (* 1 x35) (* (- 1) x40) (* (- 4) x45)) 22))
+(assert (<= (+ (* 4 x2) (* (- 4) x6) (* 2 x24) (* 4 x27) (* 3 x29) (* (- 4) x31) (* (- 4) x39) (* (- 4) x43)) (- 79)))
+(assert (<= (+ (* 2 x11) (* 2 x16) (* 4 x21) (* (- 3) x23) (* (- 2) x28) (* (- 3) x37) (* (- 1) x46) (* 1 x49)) (- 5)))
+(assert (<= (+ (* (- 1) x0) (* (- 2) x1) (* 2 x5) (* 1 x15) (* 3 x29) (* (- 3) x35) (* 3 x37) (* (- 4) x44)) 37))
+(assert (<= (+ (* (- 3) x7) (* 1 x11) (* 1 x14) (* (- 2) x25) (* 2 x30) (* (- 3) x34) (* 3 x40) (* (- 2) x43)) (- 29)))
+(assert (<= (+ (* 1 x2) (* (- 3) x4) (* 2 x12) (* (- 2) x17) (* (- 4) x26) (* (- 2) x27) (* 3 x41) (* 2 x44) (* (- 3) x48)) 20))
+(assert (<= (+ (* (- 3) x3) (* 4 x17) (* 2 x20) (* 2 x26) (* (- 2) x31) (* 3 x36) (* (- 3) x49)) (- 33)))
+(assert (<= (+ (* 2 x9) (* 2 x11) (* 3 x15) (* 2 x17) (* 3 x33) (* 1 x35) (* 2 x37) (* (- 4) x43)) (- 22)))
+(assert (<= (+ (* 1 x12) (* 2 x20) (* 2 x27) (* 1 x34) (* 1 x35) (* 3 x42) (* 4 x46)) (- 11)))
+(assert (<= (+ (* (- 3) x8) (* 3 x13) (* (- 4) x38) (* (- 4) x41) (* (- 4) x42) (* (- 2) x43) (* (- 2) x45) (* (- 2) x47)) (- 50)))
+(assert (<= (+ (* 2 x19) (* 2 x20) (* 1 x21) (* 1 x22) (* 3 x34) (* (- 3) x35) (* (- 4) x38) (* 2 x41) (* (- 2) x48)) 14))
+(assert (<= (+ (* (- 3) x3) (* 1 x4) (* 2 x10) (* (- 4) x11) (* (- 1) x17) (* (- 2) x33) (* 2 x39) (* (- 1) x40)) 8))
+(assert (<= (+ (* 4 x0) (* (- 4) x3) (* 2 x10) (* (- 2) x20) (* 4 x26) (* 1 x28) (* (- 4) x37) (* (- 2) x44)) (- 35)))
+(assert (<= (+ (* 1 x1) (* 1 x9) (* (- 1) x18) (* (- 2) x23) (* (- 2) x42) (* (- 1) x48) (* 1 x49)) (- 9)))
+(assert (<= (+ (* (- 2) x6) (* 4 x9) (* 2 x10) (* 4 x16) (* (- 1) x24) (* 2 x32) (* 2 x39)) 6))
+(assert (<= (+ (* 4 x2) (* 1 x5) (* 2 x7) (* (- 1) x13) (* (- 3) x41) (* (- 3) x42) (* 3 x45) (* 3 x47)) (- 8)))
+(assert (<= (+ (* (- 4) x5) (* (- 1) x20) (* 2 x24) (* (- 4) x27) (* 4 x33) (* 2 x44) (* (- 4) x47)) (- 1)))
+(assert (<= (+ (* 3 x9) (* (- 4) x10) (* 3 x18) (* (- 4) x21) (* (- 1) x33) (* (- 2) x35) (* 2 x42) (* 1 x48)) (- 4)))
+(assert (<= (+ (* (- 4) x5) (* (- 3) x9) (* 3 x27) (* (- 4) x31) (* (- 4) x41) (* 3 x42) (* 4 x43) (* (- 3) x45) (* (- 3) x48)) (- 31)))
+(assert (<= (+ (* (- 2) x14) (* 3 x19) (* 4 x20) (* (- 3) x21) (* (- 4) x26) (* (- 4) x29) (* (- 4) x36) (* (- 2) x37) (* 4 x44)) (- 6)))
+(assert (<= (+ (* 1 x7) (* 1 x20) (* 2 x33) (* 4 x34) (* 4 x45) (* 2 x47) (* 2 x48)) 35))
+(assert (<= (+ (* (- 1) x5) (* (- 2) x17) (* 3 x21) (* 4 x26) (* 3 x29) (* (- 4) x41) (* 3 x45) (* 4 x47)) (- 7)))
+(assert (<= (+ (* (- 3) x0) (* (- 3) x11) (* 2 x13) (* (- 4) x16) (* 2 x28) (* 3 x29) (* (- 2) x38) (* (- 3) x48)) (- 40)))
+(assert (<= (+ (* 1 x7) (* (- 3) x13) (* (- 1) x14) (* 4 x22) (* 2 x30) (* (- 1) x36) (* (- 2) x49)) 4))
+(assert (<= (+ (* 2 x2) (* (- 3) x6) (* (- 2) x18) (* 1 x25) (* (- 2) x27) (* 3 x29) (* (- 3) x37) (* (- 3) x49)) (- 24)))
+(assert (<= (+ (* (- 1) x6) (* (- 3) x8) (* (- 4) x9) (* 2 x20) (* (- 3) x27) (* 3 x39) (* (- 3) x42) (* (- 1) x46) (* 2 x47)) 51))
+(assert (<= (+ (* (- 3) x1) (* (- 4) x39) (* 4 x40) (* (- 3) x41) (* (- 4) x43) (* 2 x48) (* (- 3) x49)) (- 37)))
+(assert (<= (+ (* 2 x8) (* (- 2) x9) (* (- 2) x12) (* (- 1) x24) (* (- 4) x27) (* (- 4) x31) (* (- 1) x36) (* (- 2) x39)) 10))
+(assert (<= (+ (* 3 x3) (* 1 x6) (* (- 2) x12) (* 1 x26) (* 1 x28) (* (- 3) x30) (* (- 2) x36) (* 3 x39)) 7))
+(assert (<= (+ (* 1 x1) (* (- 2) x2) (* 4 x11) (* 4 x28) (* 3 x43) (* (- 4) x44) (* (- 4) x49)) 16))
+(assert (<= (+ (* 4 x0) (* (- 1) x3) (* (- 2) x15) (* (- 3) x25) (* 1 x33) (* (- 3) x36) (* (- 1) x38) (* 3 x41)) (- 6)))
+(assert (<= (+ (* 3 x2) (* 1 x3) (* (- 4) x11) (* (- 3) x22) (* 3 x33) (* (- 3) x34) (* (- 4) x39)) (- 29)))
+(assert (<= (+ (* (- 3) x6) (* (- 4) x17) (* (- 3) x25) (* (- 3) x30) (* (- 2) x31) (* 3 x34) (* (- 4) x45) (* (- 1) x46) (* (- 3) x47)) 5))
+(assert (<= (+ (* (- 4) x2) (* (- 1) x10) (* (- 2) x11) (* (- 3) x12) (* 2 x18) (* 3 x22) (* (- 1) x31) (* (- 1) x37)) (- 8)))
+(assert (<= (+ (* (- 3) x2) (* (- 2) x4) (* (- 2) x20) (* (- 3) x32) (* (- 2) x34) (* 2 x37) (* (- 4) x40) (* (- 3) x47) (* 4 x48)) 15))
+(assert (<= (+ (* (- 2) x1) (* 3 x3) (* 4 x4) (* (- 3) x10) (* 1 x11) (* 4 x18) (* 3 x20) (* 2 x35) (* 4 x37)) 23))
+(assert (<= (+ (* (- 2) x2) (* (- 4) x9) (* (- 3) x17) (* (- 4) x25) (* (- 3) x27) (* 3 x34) (* (- 1) x42) (* 1 x47)) 64))
+(assert (<= (+ (* (- 2) x0) (* 4 x2) (* (- 2) x3) (* (- 1) x5) (* 1 x8) (* (- 4) x14) (* 4 x30)) (- 2)))
+(assert (<= (+ (* 1 x2) (* (- 3) x13) (* 4 x22) (* 1 x23) (* 2 x30) (* 3 x37) (* (- 1) x43)) 10))
+(check-sat)
+(push 1)
+(assert (>= (+ (* 6 x0) (* (- 4) x2) (* (- 9) x3) (* (- 6) x4) (* (- 1) x5) (* (- 15) x6) (* 1 x8) (* 18 x9) (* 12 x10) (* (- 13) x11) (* 4 x12) (* (- 12) x13) (* 8 x14) (* 17 x15) (* 13 x16) (* (- 9) x17) (* 12 x18) (* 16 x19) (* (- 21) x21) (* (- 12) x23) (* (- 11) x24) (* 9 x25) (* (- 2) x26) (* (- 4) x27) (* 1 x28) (* 3 x29) (* (- 6) x30) (* (- 3) x32) (* (- 6) x33) (* 6 x34) (* (- 4) x36) (* (- 6) x37) (* 6 x38) (* (- 3) x40) (* 6 x41) (* 16 x44) (* 9 x45) (* 2 x46) (* 16 x47) (* (- 6) x48)) (- 99)))
+(check-sat)
+(pop 1)
+(check-sat)
@@ -0,0 +1,125 @@
+/*********************                                                        */
+/*! \file cdtrail_black.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::context::CDTrailValue and CDTrailList.
+ **
+ ** Black box testing of CVC4::context::CDTrailValue and CDTrailList.
+ **/
+
+#include <memory>
+#include <vector>
+
+#include "context/cdtrail.h"
+#include "test_context.h"
+
+namespace CVC4 {
+
+using namespace context;
+
+namespace test {
+
+class TestContextCDTrailBlack : public TestContext
+{
+};
+
+TEST_F(TestContextCDTrailBlack, value)
+{
+  CDTrailValue<int> a(d_context.get(), 5);
+  d_context->push();
+  a = 10;
+  a = 11;
+  ASSERT_EQ(a, 11);
+  d_context->push();
+  ASSERT_EQ(a, 11);
+  a = 12;
+  d_context->pop();
+  ASSERT_EQ(a, 11);
+  d_context->push();
+  a = 13;
+  d_context->pop();
+  ASSERT_EQ(a, 11);
+  a = 14;
+  d_context->pop();
+  ASSERT_EQ(a, 5);
+  ASSERT_EQ(d_context->getTrail()->size(), 0);
+}
+
+TEST_F(TestContextCDTrailBlack, created_at_level)
+{
+  d_context->push();
+  // like a CDO, a value created at a level keeps it when popping that level
+  CDTrailValue<bool> b(d_context.get(), true);
+  b = false;
+  d_context->push();
+  b = true;
+  d_context->pop();
+  ASSERT_FALSE(b);
+  d_context->pop();
+  ASSERT_FALSE(b);
+}
+
+TEST_F(TestContextCDTrailBlack, destroyed_before_pop)
+{
+  CDTrailValue<uint64_t> keep(d_context.get(), 1);
+  d_context->push();
+  {
+    std::unique_ptr<CDTrailValue<uint64_t>> gone(
+        new CDTrailValue<uint64_t>(d_context.get(), 2));
+    d_context->push();
+    *gone = 3;
+    keep = 4;
+  }
+  d_context->pop();
+  ASSERT_EQ(keep, 1);
+  d_context->pop();
+}
+
+TEST_F(TestContextCDTrailBlack, list)
+{
+  CDTrailList<int> list(d_context.get());
+  list.push_back(1);
+  d_context->push();
+  list.push_back(2);
+  list.push_back(3);
+  ASSERT_EQ(list.size(), 3);
+  ASSERT_EQ(list.back(), 3);
+  d_context->pop();
+  ASSERT_EQ(list.size(), 1);
+  ASSERT_EQ(list.back(), 1);
+  list.push_back(4);
+  std::vector<int> elems(list.begin(), list.end());
+  ASSERT_EQ(elems, std::vector<int>({1, 4}));
+  ASSERT_DEATH(list[2], "index out of bounds");
+}
+
+TEST_F(TestContextCDTrailBlack, destroyed_after_levels)
+{
+  CDTrailValue<int> keep(d_context.get(), 0);
+  std::unique_ptr<CDTrailValue<int>> gone(
+      new CDTrailValue<int>(d_context.get(), 0));
+  for (int i = 1; i <= 3; ++i)
+  {
+    d_context->push();
+    *gone = i;
+    keep = i;
+  }
+  // its saves at the three levels are dropped, those of keep are not
+  gone.reset();
+  ASSERT_EQ(d_context->getTrail()->size(), 18);
+  d_context->pop();
+  ASSERT_EQ(keep, 2);
+  d_context->pop();
+  ASSERT_EQ(keep, 1);
+  d_context->pop();
+  ASSERT_EQ(keep, 0);
+  ASSERT_EQ(d_context->getTrail()->size(), 0);
+}
+
+}  // namespace test
+}  // namespace CVC4
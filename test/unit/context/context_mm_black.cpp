@@ -18,7 +18,13 @@
 #include <iostream>
 #include <vector>
 
+#include "base/configuration.h"
+#include "context/context.h"
 #include "context/context_mm.h"
+#include "expr/node_manager.h"
+#include "options/option_exception.h"
+#include "options/options.h"
+#include "smt/smt_engine.h"
 #include "test.h"
 
 namespace CVC4 {
@@ -99,7 +105,94 @@ TEST_F(TestContextMMBlack, push_pop)
   }
 
   // Try popping out of scope
-  ASSERT_DEATH(d_cmm->pop(), "d_nextFreeStack.size\\(\\) > 0");
+  ASSERT_DEATH(d_cmm->pop(), "d_regionStack.size\\(\\) > 0");
+#endif
+}
+
+TEST_F(TestContextMMBlack, config_stats)
+{
+#ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
+  for (bool hugePages : {false, true})
+  {
+    ContextMemoryManager::Config config;
+    config.d_chunkSizeBytes = 4 * ContextMemoryManager::defaultChunkSizeBytes;
+    config.d_maxFreeChunks = 2;
+    config.d_hugePages = hugePages;
+    ContextMemoryManager cmm(config);
+    const ContextMemoryManager::Statistics& stats = cmm.getStatistics();
+    size_t len = ContextMemoryManager::getMaxAllocationSize();
+
+    cmm.newData(100);
+    cmm.push();
+    ASSERT_EQ(cmm.getLevel(), 1);
+    // fills the rest of the first chunk and four more
+    for (uint32_t i = 0; i < 19; ++i)
+    {
+      memset(cmm.newData(len), 'a', len);
+    }
+    ASSERT_EQ(cmm.getNumChunks(), 5);
+    ASSERT_EQ(cmm.getPeakBytes(1), 19 * len);
+    cmm.pop();
+    ASSERT_EQ(cmm.getLevel(), 0);
+    ASSERT_EQ(cmm.getNumChunks(), 1);
+    ASSERT_EQ(cmm.getPeakBytes(0), 100);
+    ASSERT_EQ(cmm.getPeakBytes(1), 19 * len);
+    ASSERT_EQ(cmm.getNumPeakLevels(), 2);
+    ASSERT_EQ(stats.d_peakChunks, 5);
+    ASSERT_EQ(stats.d_chunksAllocated, 5);
+    // chunks of huge page arenas are all kept
+    ASSERT_EQ(cmm.getNumFreeChunks(), hugePages ? 4 : 2);
+    ASSERT_EQ(stats.d_chunksReleased, hugePages ? 0 : 2);
+
+    // a smaller level reuses the free chunks
+    cmm.push();
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+      memset(cmm.newData(len), 'b', len);
+    }
+    ASSERT_EQ(stats.d_chunksReused, 2);
+    ASSERT_EQ(cmm.getPeakBytes(1), 19 * len);
+    cmm.pop();
+  }
+#endif
+}
+
+TEST_F(TestContextMMBlack, default_config)
+{
+  ContextMemoryManager::Config config;
+  ASSERT_EQ(config.d_chunkSizeBytes,
+            ContextMemoryManager::defaultChunkSizeBytes);
+  ASSERT_EQ(config.d_maxFreeChunks, 100);
+  ASSERT_FALSE(config.d_hugePages);
+}
+
+TEST_F(TestContextMMBlack, smt_engine_options)
+{
+#ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
+  Options opts;
+  opts.setOption("context-chunk-size", "65536");
+  opts.setOption("context-max-free-chunks", "3");
+  NodeManager nm(nullptr);
+  SmtEngine smt(&nm, &opts);
+  for (Context* c : {static_cast<Context*>(smt.getContext()),
+                     static_cast<Context*>(smt.getUserContext())})
+  {
+    const ContextMemoryManager::Config& config = c->getCMM()->getConfig();
+    ASSERT_EQ(config.d_chunkSizeBytes, 65536);
+    ASSERT_EQ(config.d_maxFreeChunks, 3);
+    ASSERT_FALSE(config.d_hugePages);
+  }
+  // the contexts exist already
+  ASSERT_THROW(smt.setOption("context-max-free-chunks", "4"), OptionException);
+  ASSERT_THROW(opts.setOption("context-chunk-size", "1024"), OptionException);
+  if (Configuration::isStatisticsBuild())
+  {
+    ASSERT_GE(smt.getStatistic("context::sat::peakChunks").getIntegerValue(),
+              Integer(1));
+    // one entry per level reached
+    ASSERT_GE(smt.getStatistic("context::user::peakBytes").getChildren().size(),
+              1);
+  }
 #endif
 }
 
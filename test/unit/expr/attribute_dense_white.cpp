@@ -0,0 +1,179 @@
+/*********************                                                        */
+/*! \file attribute_dense_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of dense attribute tables.
+ **/
+
+#include <vector>
+
+#include "expr/attribute.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "test_node.h"
+
+namespace CVC4 {
+
+using namespace expr;
+using namespace expr::attr;
+
+namespace test {
+
+struct DenseTest1;
+struct DenseTest2;
+struct HashTest1;
+
+using DenseNodeAttr = Attribute<DenseTest1, Node>;
+using DenseIntAttr = Attribute<DenseTest1, uint64_t>;
+using DenseFlag1 = Attribute<DenseTest1, bool>;
+using DenseFlag2 = Attribute<DenseTest2, bool>;
+using HashNodeAttr = Attribute<HashTest1, Node>;
+using HashIntAttr = Attribute<HashTest1, uint64_t>;
+using HashFlag1 = Attribute<HashTest1, bool>;
+
+}  // namespace test
+
+namespace expr {
+namespace attr {
+template <>
+struct UseDenseStorage<test::DenseNodeAttr> : public std::true_type
+{
+};
+template <>
+struct UseDenseStorage<test::DenseIntAttr> : public std::true_type
+{
+};
+template <>
+struct UseDenseStorage<test::DenseFlag1> : public std::true_type
+{
+};
+template <>
+struct UseDenseStorage<test::DenseFlag2> : public std::true_type
+{
+};
+}  // namespace attr
+}  // namespace expr
+
+namespace test {
+
+class TestExprWhiteAttributeDense : public TestNode
+{
+ protected:
+  std::vector<Node> mkVars(size_t n)
+  {
+    std::vector<Node> vars;
+    TypeNode boolType = d_nodeManager->booleanType();
+    for (size_t i = 0; i < n; ++i)
+    {
+      vars.push_back(d_nodeManager->mkVar(boolType));
+    }
+    return vars;
+  }
+};
+
+TEST_F(TestExprWhiteAttributeDense, set_get)
+{
+  std::vector<Node> vars = mkVars(2000);
+  AttributeManager* am = d_nodeManager->d_attrManager;
+  size_t hashed = am->d_nodes.size();
+  for (size_t i = 0; i < vars.size(); i += 3)
+  {
+    vars[i].setAttribute(DenseNodeAttr(), vars[(i + 1) % vars.size()]);
+    vars[i].setAttribute(DenseIntAttr(), i);
+    vars[i].setAttribute(DenseFlag1(), i % 2 == 0);
+    vars[i].setAttribute(DenseFlag2(), true);
+  }
+  ASSERT_EQ(am->d_nodes.size(), hashed);
+  ASSERT_EQ(am->d_denseNodes.size(), (vars.size() + 2) / 3);
+  for (size_t i = 0; i < vars.size(); ++i)
+  {
+    bool set = i % 3 == 0;
+    ASSERT_EQ(vars[i].hasAttribute(DenseNodeAttr()), set);
+    ASSERT_EQ(vars[i].hasAttribute(DenseIntAttr()), set);
+    // flags have a default value
+    ASSERT_TRUE(vars[i].hasAttribute(DenseFlag1()));
+    ASSERT_EQ(vars[i].getAttribute(DenseFlag1()), set && i % 2 == 0);
+    ASSERT_EQ(vars[i].getAttribute(DenseFlag2()), set);
+    uint64_t v = 0;
+    ASSERT_EQ(vars[i].getAttribute(DenseIntAttr(), v), set);
+    ASSERT_EQ(v, set ? i : 0);
+    ASSERT_EQ(vars[i].getAttribute(DenseNodeAttr()),
+              set ? vars[(i + 1) % vars.size()] : Node::null());
+  }
+  vars[0].setAttribute(DenseIntAttr(), 42);
+  ASSERT_EQ(vars[0].getAttribute(DenseIntAttr()), 42);
+  vars[0].setAttribute(DenseFlag1(), false);
+  ASSERT_FALSE(vars[0].getAttribute(DenseFlag1()));
+  ASSERT_TRUE(vars[0].getAttribute(DenseFlag2()));
+}
+
+TEST_F(TestExprWhiteAttributeDense, delete_node)
+{
+  AttributeManager* am = d_nodeManager->d_attrManager;
+  Node value = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  ASSERT_EQ(value.d_nv->getRefCount(), 1);
+  {
+    std::vector<Node> vars = mkVars(100);
+    for (Node& v : vars)
+    {
+      v.setAttribute(DenseNodeAttr(), value);
+    }
+    ASSERT_EQ(value.d_nv->getRefCount(), 101);
+  }
+  d_nodeManager->reclaimZombiesUntil(0);
+  ASSERT_EQ(value.d_nv->getRefCount(), 1);
+  ASSERT_TRUE(am->d_denseNodes.empty());
+}
+
+TEST_F(TestExprWhiteAttributeDense, delete_attributes)
+{
+  AttributeManager* am = d_nodeManager->d_attrManager;
+  std::vector<Node> vars = mkVars(10);
+  for (Node& v : vars)
+  {
+    v.setAttribute(DenseIntAttr(), 1);
+    v.setAttribute(HashIntAttr(), 2);
+  }
+  AttributeUniqueId id = AttributeManager::getAttributeId(DenseIntAttr());
+  AttributeManager::AttrIdVec ids(1, &id);
+  am->deleteAttributes(ids);
+  for (Node& v : vars)
+  {
+    ASSERT_FALSE(v.hasAttribute(DenseIntAttr()));
+    ASSERT_EQ(v.getAttribute(HashIntAttr()), 2);
+  }
+  ASSERT_TRUE(am->d_denseInts.empty());
+}
+
+TEST_F(TestExprWhiteAttributeDense, erase_shared_mask_bit)
+{
+  // ids 3 and 67 share a bit of the per-node mask
+  DenseAttrTable<uint64_t> table;
+  std::vector<Node> vars = mkVars(2);
+  table.set(3, vars[0].d_nv, 1);
+  table.set(67, vars[0].d_nv, 2);
+  table.set(67, vars[1].d_nv, 3);
+  ASSERT_EQ(table.size(), 3);
+  table.erase(vars[0].d_nv);
+  ASSERT_FALSE(table.contains(3, vars[0].d_nv));
+  ASSERT_FALSE(table.contains(67, vars[0].d_nv));
+  ASSERT_TRUE(table.contains(67, vars[1].d_nv));
+  ASSERT_EQ(table.size(), 1);
+
+  // a stale mask bit, left by eraseAttributes(), is harmless
+  table.eraseAttributes(std::vector<uint64_t>(1, 67));
+  ASSERT_TRUE(table.empty());
+  table.set(3, vars[1].d_nv, 4);
+  table.erase(vars[1].d_nv);
+  ASSERT_TRUE(table.empty());
+  table.erase(vars[0].d_nv);
+  ASSERT_TRUE(table.empty());
+}
+
+}  // namespace test
+}  // namespace CVC4
@@ -15,9 +15,14 @@
  **/
 
 #include <string>
+#include <vector>
+#ifdef CVC4_THREAD_SAFE_NODES
+#include <thread>
+#endif /* CVC4_THREAD_SAFE_NODES */
 
 #include "expr/node_manager.h"
 #include "test_node.h"
+#include "util/bitvector.h"
 #include "util/integer.h"
 #include "util/rational.h"
 
@@ -80,5 +85,198 @@ TEST_F(TestNodeWhiteNodeManager, topological_sort)
     ASSERT_EQ(NodeManager::TopologicalSort(roots), result);
   }
 }
+
+TEST_F(TestNodeWhiteNodeManager, incremental_reclaim)
+{
+  TypeNode boolType = d_nodeManager->booleanType();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 20; ++i)
+  {
+    vars.push_back(d_nodeManager->mkSkolem("x", boolType));
+  }
+  d_nodeManager->reclaimAllZombies();
+
+  // each reclamation step examines at most 4 zombies
+  d_nodeManager->setZombieReclaimPolicy(10, 4, false);
+  for (size_t i = 0; i < vars.size(); ++i)
+  {
+    for (size_t j = 0; j < vars.size(); ++j)
+    {
+      Node n = d_nodeManager->mkNode(kind::AND, vars[i], vars[j]);
+      ASSERT_LE(d_nodeManager->d_zombies.size(), 11u);
+    }
+  }
+  ASSERT_FALSE(d_nodeManager->d_zombies.empty());
+  d_nodeManager->reclaimAllZombies();
+  ASSERT_TRUE(d_nodeManager->d_zombies.empty());
+
+  // nothing is reclaimed outside of safe points
+  d_nodeManager->setZombieReclaimPolicy(10, 0, true);
+  for (size_t i = 0; i < vars.size(); ++i)
+  {
+    for (size_t j = 0; j < vars.size(); ++j)
+    {
+      Node n = d_nodeManager->mkNode(kind::OR, vars[i], vars[j]);
+    }
+  }
+  ASSERT_EQ(d_nodeManager->d_zombies.size(), vars.size() * vars.size());
+  d_nodeManager->reclaimZombiesAtSafePoint();
+  ASSERT_TRUE(d_nodeManager->d_zombies.empty());
+}
+
+TEST_F(TestNodeWhiteNodeManager, pool_reserve)
+{
+  TypeNode boolType = d_nodeManager->booleanType();
+  Node x = d_nodeManager->mkSkolem("x", boolType);
+  Node y = d_nodeManager->mkSkolem("y", boolType);
+  Node n = d_nodeManager->mkNode(kind::AND, x, y);
+  size_t size = d_nodeManager->poolSize();
+  d_nodeManager->reservePool(100000);
+  ASSERT_EQ(d_nodeManager->poolSize(), size);
+  ASSERT_EQ(d_nodeManager->mkNode(kind::AND, x, y), n);
+  Node zero = d_nodeManager->mkConst(Rational(0));
+  std::vector<Node> nodes;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    Node eq = d_nodeManager->mkConst(Rational(i)).eqNode(zero);
+    nodes.push_back(d_nodeManager->mkNode(kind::AND, n, eq));
+  }
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    Node eq = d_nodeManager->mkConst(Rational(i)).eqNode(zero);
+    ASSERT_EQ(d_nodeManager->mkNode(kind::AND, n, eq), nodes[i]);
+  }
+}
+
+TEST_F(TestNodeWhiteNodeManager, direct_construction)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 12; ++i)
+  {
+    vars.push_back(d_nodeManager->mkSkolem("x", intType));
+  }
+  for (size_t n = 2; n <= vars.size(); ++n)
+  {
+    std::vector<Node> children(vars.begin(), vars.begin() + n);
+    NodeBuilder<> nb(d_nodeManager.get(), kind::PLUS);
+    nb.append(children);
+    Node built = nb;
+    ASSERT_EQ(d_nodeManager->mkNode(kind::PLUS, children), built);
+    // a node already in the pool does not touch the reference counts of
+    // its children
+    uint32_t rc = vars[0].d_nv->getRefCount();
+    Node again = d_nodeManager->mkNode(kind::PLUS, children);
+    ASSERT_EQ(vars[0].d_nv->getRefCount(), rc);
+    ASSERT_EQ(again.d_nv, built.d_nv);
+  }
+  Node sum = d_nodeManager->mkNode(kind::PLUS, vars[0], vars[1], vars[2]);
+  ASSERT_EQ(sum.getNumChildren(), 3);
+  ASSERT_EQ(sum[2], vars[2]);
+  uint32_t rc = vars[3].d_nv->getRefCount();
+  {
+    Node fresh = d_nodeManager->mkNode(kind::MULT, vars[3], vars[4]);
+    ASSERT_EQ(vars[3].d_nv->getRefCount(), rc + 1);
+    ASSERT_EQ(fresh.d_nv->getRefCount(), 1);
+  }
+}
+
+TEST_F(TestNodeWhiteNodeManager, direct_construction_builtin)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  Node x = d_nodeManager->mkSkolem("x", intType);
+  Node y = d_nodeManager->mkSkolem("y", intType);
+  Node op = d_nodeManager->operatorOf(kind::MULT);
+  ASSERT_EQ(op.getKind(), kind::BUILTIN);
+#ifdef CVC4_ASSERTIONS
+  // as with a NodeBuilder, the kind cannot be redefined by an operator
+  ASSERT_DEATH(d_nodeManager->mkNode(kind::PLUS, op, x, y),
+               "can't redefine the Kind");
+#else
+  NodeBuilder<> nb(d_nodeManager.get(), kind::PLUS);
+  nb << op << x << y;
+  Node built = nb;
+  ASSERT_EQ(d_nodeManager->mkNode(kind::PLUS, op, x, y), built);
+#endif /* CVC4_ASSERTIONS */
+}
+
+TEST_F(TestNodeWhiteNodeManager, direct_construction_parameterized)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  Node x = d_nodeManager->mkSkolem("x", intType);
+  Node f = d_nodeManager->mkSkolem(
+      "f", d_nodeManager->mkFunctionType(intType, intType));
+  // the operator of a parameterized kind does not count towards its arity
+  Node fx = d_nodeManager->mkNode(kind::APPLY_UF, f, x);
+  ASSERT_EQ(fx.getNumChildren(), 1);
+  ASSERT_EQ(fx.getOperator(), f);
+  ASSERT_EQ(fx[0], x);
+
+  Node bv = d_nodeManager->mkSkolem("bv", d_nodeManager->mkBitVectorType(8));
+  Node extractOp = d_nodeManager->mkConst(BitVectorExtract(3, 0));
+  Node extract = d_nodeManager->mkNode(kind::BITVECTOR_EXTRACT, extractOp, bv);
+  ASSERT_EQ(extract.getNumChildren(), 1);
+  ASSERT_EQ(d_nodeManager->mkNode(extractOp, bv), extract);
+#ifdef CVC4_ASSERTIONS
+  ASSERT_DEATH(d_nodeManager->mkNode(kind::APPLY_UF, f),
+               "must have at least 1 children");
+  ASSERT_DEATH(d_nodeManager->mkNode(kind::BITVECTOR_EXTRACT, extractOp, bv, bv),
+               "must have at most 1 children");
+#endif /* CVC4_ASSERTIONS */
+}
+
+#ifdef CVC4_THREAD_SAFE_NODES
+TEST_F(TestNodeWhiteNodeManager, concurrent_construction)
+{
+  const size_t nthreads = 4;
+  const size_t nterms = 500;
+  const size_t rounds = 20;
+  // reclaim eagerly, so that threads resurrect zombies and race with
+  // their reclamation
+  d_nodeManager->setZombieReclaimPolicy(50, 0, false);
+  TypeNode boolType = d_nodeManager->booleanType();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < nterms; ++i)
+  {
+    vars.push_back(d_nodeManager->mkSkolem("x", boolType));
+  }
+  std::vector<std::vector<Node>> results(nthreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nthreads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      NodeManagerScope nms(d_nodeManager.get());
+      Node zero = d_nodeManager->mkConst(Rational(0));
+      for (size_t r = 0; r < rounds; ++r)
+      {
+        std::vector<Node> terms;
+        for (size_t i = 0; i < nterms; ++i)
+        {
+          Node eq = d_nodeManager->mkConst(Rational(i + r)).eqNode(zero);
+          terms.push_back(d_nodeManager->mkNode(kind::AND, vars[i], eq));
+        }
+        results[t].swap(terms);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  Node zero = d_nodeManager->mkConst(Rational(0));
+  for (size_t i = 0; i < nterms; ++i)
+  {
+    Node eq = d_nodeManager->mkConst(Rational(i + rounds - 1)).eqNode(zero);
+    Node n = d_nodeManager->mkNode(kind::AND, vars[i], eq);
+    for (size_t t = 0; t < nthreads; ++t)
+    {
+      ASSERT_EQ(results[t][i].d_nv, n.d_nv);
+    }
+  }
+  results.clear();
+  d_nodeManager->reclaimZombiesUntil(0);
+  ASSERT_TRUE(d_nodeManager->d_zombies.empty());
+}
+#endif /* CVC4_THREAD_SAFE_NODES */
 }  // namespace test
 }  // namespace CVC4
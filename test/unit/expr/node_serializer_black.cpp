@@ -0,0 +1,328 @@
+/*********************                                                        */
+/*! \file node_serializer_black.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the binary serialization of node DAGs.
+ **
+ ** Black box testing of the binary serialization of node DAGs.
+ **/
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/exception.h"
+#include "expr/node_manager.h"
+#include "expr/node_serializer.h"
+#include "smt/smt_engine.h"
+#include "test_node.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+#include "util/string.h"
+
+namespace CVC4 {
+
+using namespace expr;
+using namespace kind;
+
+namespace test {
+
+class TestNodeBlackNodeSerializer : public TestNode
+{
+ protected:
+  void SetUp() override
+  {
+    TestNode::SetUp();
+    // setup an SMT engine so that options are in scope for printing
+    d_smt.reset(new SmtEngine(d_nodeManager.get()));
+  }
+
+  std::unique_ptr<SmtEngine> d_smt;
+
+  Node mkSkolem(const std::string& name, const TypeNode& type)
+  {
+    return d_nodeManager->mkSkolem(
+        name, type, "", NodeManager::SKOLEM_EXACT_NAME);
+  }
+
+  /** Some terms covering the supported kinds of entries */
+  std::vector<Node> mkTerms()
+  {
+    NodeManager* nm = d_nodeManager.get();
+    TypeNode u = nm->mkSort("U");
+    TypeNode list = nm->mkSortConstructor("List", 1);
+    TypeNode listU = nm->mkSort(list, {u});
+    Node f = mkSkolem("f", nm->mkFunctionType(u, listU));
+    Node a = mkSkolem("a", u);
+    Node x = mkSkolem("x", *d_intTypeNode);
+    Node bv = mkSkolem("bv", nm->mkBitVectorType(8));
+    Node s = mkSkolem("s", nm->stringType());
+    Node fa = nm->mkNode(APPLY_UF, f, a);
+    Node sum = nm->mkNode(PLUS, x, nm->mkConst(Rational(-7, 3)));
+    Node b = nm->mkBoundVar("b", *d_intTypeNode);
+    return {
+        nm->mkNode(EQUAL, fa, fa),
+        nm->mkNode(AND,
+                   nm->mkNode(GEQ, sum, nm->mkConst(Rational(0))),
+                   nm->mkNode(LEQ, sum, nm->mkConst(Rational(100)))),
+        nm->mkNode(EQUAL,
+                   nm->mkNode(nm->mkConst(BitVectorExtract(3, 0)), bv),
+                   nm->mkConst(BitVector(4, 5u))),
+        nm->mkNode(STRING_PREFIX, nm->mkConst(String("ab")), s),
+        nm->mkNode(FORALL,
+                   nm->mkNode(BOUND_VAR_LIST, b),
+                   nm->mkNode(GT, b, x)),
+        Node::null(),
+    };
+  }
+
+  /** Append an unsigned value to buf, as the serializer writes it */
+  static void append(std::string& buf, uint64_t v)
+  {
+    while (v >= 0x80)
+    {
+      buf.push_back(static_cast<char>((v & 0x7f) | 0x80));
+      v >>= 7;
+    }
+    buf.push_back(static_cast<char>(v));
+  }
+
+  /** Append a string to buf, as the serializer writes it */
+  static void append(std::string& buf, const std::string& str)
+  {
+    append(buf, str.size());
+    buf += str;
+  }
+
+  /**
+   * Make a serialization of the given entries, with the last entry as its
+   * only root.
+   */
+  static std::string mkSerialization(const std::vector<std::string>& entries)
+  {
+    std::string buf("CVC4NDAG");
+    append(buf, 1);
+    append(buf, LAST_KIND);
+    append(buf, entries.size());
+    for (const std::string& entry : entries)
+    {
+      buf += entry;
+    }
+    append(buf, 1);
+    append(buf, entries.size());
+    return buf;
+  }
+
+  /** A node entry of kind k with the given children */
+  static std::string mkNodeEntry(Kind k, const std::vector<uint64_t>& children)
+  {
+    // ENTRY_NODE
+    std::string entry(1, 0);
+    append(entry, k);
+    append(entry, children.size());
+    for (uint64_t child : children)
+    {
+      append(entry, child);
+    }
+    return entry;
+  }
+
+  /** A constant entry of kind k with the given payload */
+  static std::string mkConstantEntry(Kind k, const std::string& payload)
+  {
+    // ENTRY_CONSTANT
+    std::string entry(1, 2);
+    append(entry, k);
+    return entry + payload;
+  }
+
+  std::string serialize(const std::vector<Node>& nodes)
+  {
+    std::ostringstream out;
+    serializeNodes(nodes, out);
+    return out.str();
+  }
+};
+
+TEST_F(TestNodeBlackNodeSerializer, round_trip)
+{
+  std::vector<Node> terms = mkTerms();
+  std::string buf = serialize(terms);
+  NodeDeserializer d(d_nodeManager.get());
+  std::vector<Node> loaded = d.deserialize(buf.data(), buf.size());
+  ASSERT_EQ(loaded.size(), terms.size());
+  for (size_t i = 0; i < terms.size(); ++i)
+  {
+    ASSERT_EQ(loaded[i].isNull(), terms[i].isNull());
+    ASSERT_EQ(loaded[i].toString(), terms[i].toString());
+  }
+  // shared subterms are loaded as shared nodes
+  ASSERT_EQ(loaded[0][0], loaded[0][1]);
+  ASSERT_EQ(loaded[1][0][0], loaded[1][1][0]);
+  // variables and sorts are created fresh
+  ASSERT_NE(loaded[0], terms[0]);
+  ASSERT_NE(loaded[0][0].getType(), terms[0][0].getType());
+}
+
+TEST_F(TestNodeBlackNodeSerializer, other_node_manager)
+{
+  std::vector<Node> terms = mkTerms();
+  std::string buf = serialize(terms);
+  std::vector<std::string> printed;
+  for (const Node& n : terms)
+  {
+    printed.push_back(n.toString());
+  }
+  NodeManager nm(nullptr);
+  NodeManagerScope nms(&nm);
+  std::istringstream in(buf);
+  std::vector<Node> loaded = NodeDeserializer(&nm).deserialize(in);
+  ASSERT_EQ(loaded.size(), printed.size());
+  for (size_t i = 0; i < printed.size(); ++i)
+  {
+    ASSERT_EQ(loaded[i].toString(), printed[i]);
+    if (!loaded[i].isNull())
+    {
+      // type checks in the other node manager
+      loaded[i].getType(true);
+    }
+  }
+}
+
+TEST_F(TestNodeBlackNodeSerializer, variables_remembered)
+{
+  Node x = mkSkolem("x", *d_intTypeNode);
+  Node y = mkSkolem("y", *d_intTypeNode);
+  std::string buf1 = serialize({d_nodeManager->mkNode(PLUS, x, y)});
+  std::string buf2 = serialize({d_nodeManager->mkNode(MULT, y, x)});
+  NodeDeserializer d(d_nodeManager.get());
+  Node n1 = d.deserialize(buf1.data(), buf1.size())[0];
+  Node n2 = d.deserialize(buf2.data(), buf2.size())[0];
+  ASSERT_EQ(n1[0], n2[1]);
+  ASSERT_EQ(n1[1], n2[0]);
+  ASSERT_NE(n1[0], x);
+  NodeDeserializer other(d_nodeManager.get());
+  Node n3 = other.deserialize(buf1.data(), buf1.size())[0];
+  ASSERT_NE(n3, n1);
+}
+
+TEST_F(TestNodeBlackNodeSerializer, canonical)
+{
+  Node x = mkSkolem("x", *d_intTypeNode);
+  Node y = mkSkolem("y", *d_intTypeNode);
+  Node z = mkSkolem("x", *d_intTypeNode);
+  Node w = mkSkolem("y", *d_intTypeNode);
+  // terms of the same structure over different, equally named variables
+  // serialize the same
+  std::vector<Node> vars1, vars2;
+  std::vector<TypeNode> sorts1, sorts2;
+  std::ostringstream out1, out2;
+  serializeNodesCanonical(
+      {d_nodeManager->mkNode(PLUS, x, y)}, out1, vars1, sorts1);
+  serializeNodesCanonical(
+      {d_nodeManager->mkNode(PLUS, z, w)}, out2, vars2, sorts2);
+  ASSERT_EQ(out1.str(), out2.str());
+  ASSERT_EQ(vars1, std::vector<Node>({x, y}));
+  ASSERT_EQ(vars2, std::vector<Node>({z, w}));
+  ASSERT_TRUE(sorts1.empty());
+  // loading with bound variables yields terms over those variables
+  std::string buf = out1.str();
+  NodeDeserializer d(d_nodeManager.get());
+  d.bind(vars2, sorts2);
+  Node n = d.deserialize(buf.data(), buf.size())[0];
+  ASSERT_EQ(n, d_nodeManager->mkNode(PLUS, z, w));
+}
+
+TEST_F(TestNodeBlackNodeSerializer, malformed)
+{
+  std::string buf = serialize(mkTerms());
+  NodeDeserializer d(d_nodeManager.get());
+  for (size_t size = 0; size < buf.size(); size += 7)
+  {
+    ASSERT_THROW(d.deserialize(buf.data(), size), Exception);
+  }
+  std::string trailing = buf + "x";
+  ASSERT_THROW(d.deserialize(trailing.data(), trailing.size()), Exception);
+  std::string magic = buf;
+  magic[0] = 'X';
+  ASSERT_THROW(d.deserialize(magic.data(), magic.size()), Exception);
+}
+
+TEST_F(TestNodeBlackNodeSerializer, malformed_entries)
+{
+  NodeDeserializer d(d_nodeManager.get());
+  std::string one;
+  append(one, "1");
+  std::string bvExtract;
+  append(bvExtract, 3);
+  append(bvExtract, 0);
+  std::string bool1;
+  append(bool1, 1);
+  std::vector<std::vector<std::string>> malformed = {
+      // numerals that are not hexadecimal, and a zero denominator
+      {mkConstantEntry(CONST_RATIONAL, "\x02zz")},
+      {mkConstantEntry(CONST_RATIONAL, "\x03" "1/0")},
+      {mkConstantEntry(CONST_RATIONAL, "\x01-")},
+      {mkConstantEntry(CONST_BITVECTOR, "\x04\x02" "1/")},
+      // a bit-vector of width 0
+      {mkConstantEntry(CONST_BITVECTOR, std::string(1, 0) + one)},
+      // arities out of the bounds of the kind
+      {mkConstantEntry(CONST_BOOLEAN, bool1), mkNodeEntry(NOT, {0, 0})},
+      {mkConstantEntry(CONST_BOOLEAN, bool1), mkNodeEntry(AND, {0})},
+      // the operator of a parameterized kind is not counted
+      {mkConstantEntry(BITVECTOR_EXTRACT_OP, bvExtract),
+       mkNodeEntry(BITVECTOR_EXTRACT, {0})},
+      // an operator of another kind
+      {mkConstantEntry(BITVECTOR_EXTRACT_OP, bvExtract),
+       mkConstantEntry(CONST_BITVECTOR, "\x08" + one),
+       mkNodeEntry(BITVECTOR_REPEAT, {0, 1})},
+      // kinds that are not made from children
+      {mkNodeEntry(NULL_EXPR, {})},
+      {mkConstantEntry(CONST_BOOLEAN, bool1), mkNodeEntry(CONST_BOOLEAN, {0})},
+      // the kind of a type
+      {mkConstantEntry(CONST_BOOLEAN, bool1),
+       mkNodeEntry(FUNCTION_TYPE, {0, 0})},
+      // ill-typed
+      {mkConstantEntry(CONST_RATIONAL, one), mkNodeEntry(NOT, {0})},
+  };
+  for (const std::vector<std::string>& entries : malformed)
+  {
+    std::string buf = mkSerialization(entries);
+    ASSERT_THROW(d.deserialize(buf.data(), buf.size()), Exception);
+  }
+
+  std::string buf = mkSerialization({mkConstantEntry(CONST_BOOLEAN, bool1),
+                                     mkNodeEntry(NOT, {0})});
+  ASSERT_EQ(d.deserialize(buf.data(), buf.size())[0],
+            d_nodeManager->mkConst(true).notNode());
+}
+
+TEST_F(TestNodeBlackNodeSerializer, corrupted)
+{
+  std::string buf = serialize(mkTerms());
+  NodeDeserializer d(d_nodeManager.get());
+  for (size_t i = 0; i < buf.size(); ++i)
+  {
+    for (char flip : {0x01, 0x10, 0x7f})
+    {
+      std::string corrupted = buf;
+      corrupted[i] ^= flip;
+      // either another valid serialization or an Exception
+      try
+      {
+        d.deserialize(corrupted.data(), corrupted.size());
+      }
+      catch (const Exception&)
+      {
+      }
+    }
+  }
+}
+}  // namespace test
+}  // namespace CVC4
@@ -0,0 +1,119 @@
+/*********************                                                        */
+/*! \file node_value_allocator_black.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::expr::NodeValueAllocator.
+ **
+ ** Black box testing of CVC4::expr::NodeValueAllocator.
+ **/
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "expr/node_manager.h"
+#include "expr/node_value_allocator.h"
+#include "test_node.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+
+using namespace CVC4::expr;
+
+namespace test {
+
+class TestNodeBlackNodeValueAllocator : public TestNode
+{
+};
+
+TEST_F(TestNodeBlackNodeValueAllocator, distinct_cells)
+{
+  StatisticsRegistry reg;
+  NodeValueAllocator alloc(&reg);
+  std::vector<std::pair<NodeValue*, size_t>> nvs;
+  for (size_t i = 0; i < 20000; ++i)
+  {
+    size_t nchildren = i % (NodeValueAllocator::MAX_POOLED_CHILDREN + 3);
+    nvs.emplace_back(alloc.allocate(nchildren), nchildren);
+  }
+  std::set<NodeValue*> distinct;
+  for (const std::pair<NodeValue*, size_t>& p : nvs)
+  {
+    distinct.insert(p.first);
+  }
+  ASSERT_EQ(distinct.size(), nvs.size());
+  for (const std::pair<NodeValue*, size_t>& p : nvs)
+  {
+    alloc.deallocate(p.first, p.second);
+  }
+}
+
+TEST_F(TestNodeBlackNodeValueAllocator, reuse_freed_cells)
+{
+  StatisticsRegistry reg;
+  NodeValueAllocator alloc(&reg);
+  NodeValue* a = alloc.allocate(2);
+  NodeValue* b = alloc.allocate(2);
+  ASSERT_NE(a, b);
+  alloc.deallocate(a, 2);
+  // freed cells are only handed out again for the same number of children
+  NodeValue* c = alloc.allocate(3);
+  ASSERT_NE(a, c);
+  ASSERT_EQ(alloc.allocate(2), a);
+  alloc.deallocate(a, 2);
+  alloc.deallocate(b, 2);
+  alloc.deallocate(c, 3);
+}
+
+TEST_F(TestNodeBlackNodeValueAllocator, deallocate_all)
+{
+  StatisticsRegistry reg;
+  NodeValueAllocator alloc(&reg);
+  std::vector<std::pair<NodeValue*, size_t>> nvs;
+  std::set<NodeValue*> freed;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    size_t nchildren = i % (NodeValueAllocator::MAX_POOLED_CHILDREN + 3);
+    NodeValue* nv = alloc.allocate(nchildren);
+    nvs.emplace_back(nv, nchildren);
+    if (nchildren == 2)
+    {
+      freed.insert(nv);
+    }
+  }
+  alloc.deallocateAll(nvs);
+  // all freed cells of a size class are handed out again before its page
+  // is extended
+  for (size_t i = 0; i < freed.size(); ++i)
+  {
+    ASSERT_EQ(freed.count(alloc.allocate(2)), 1);
+  }
+  ASSERT_EQ(freed.count(alloc.allocate(2)), 0);
+}
+
+TEST_F(TestNodeBlackNodeValueAllocator, reclaim_zombies)
+{
+  TypeNode boolType = d_nodeManager->booleanType();
+  Node x = d_nodeManager->mkSkolem("x", boolType);
+  Node y = d_nodeManager->mkSkolem("y", boolType);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    std::vector<Node> children(i % 12 + 2, x);
+    children.back() = y;
+    Node n = d_nodeManager->mkNode(kind::AND, children);
+    ASSERT_EQ(n.getNumChildren(), children.size());
+    ASSERT_EQ(n[n.getNumChildren() - 1], y);
+  }
+  ASSERT_NO_THROW(d_nodeManager->reclaimZombiesUntil(0));
+  Node n = d_nodeManager->mkNode(kind::OR, x, y);
+  ASSERT_EQ(n.getKind(), kind::OR);
+  ASSERT_EQ(n[0], x);
+  ASSERT_EQ(n[1], y);
+}
+}  // namespace test
+}  // namespace CVC4
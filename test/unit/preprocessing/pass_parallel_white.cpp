@@ -0,0 +1,242 @@
+/*********************                                                        */
+/*! \file pass_parallel_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the parallel per-assertion preprocessing
+ **
+ ** White box testing of preprocessing passes running on several threads
+ ** (--pp-threads), and of the shared state they touch.
+ **/
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/exception.h"
+#include "expr/bound_var_manager.h"
+#include "expr/dtype.h"
+#include "expr/dtype_cons.h"
+#include "expr/node_manager.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "smt/preprocessor.h"
+#include "smt/process_assertions.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "util/rational.h"
+#include "util/resource_manager.h"
+
+namespace CVC4 {
+
+using namespace preprocessing;
+
+namespace test {
+
+class TestPPWhiteParallel : public TestSmtNoFinishInit
+{
+ protected:
+  /** Returns the pass of the SmtEngine with the given name. */
+  PreprocessingPass* getPass(const std::string& name)
+  {
+    return d_smtEngine->d_pp->d_processor.d_passes[name].get();
+  }
+
+  /** Returns n assertions (not (not p)) over fresh Boolean variables p. */
+  std::vector<Node> mkDoubleNegations(size_t n)
+  {
+    TypeNode boolType = d_nodeManager->booleanType();
+    std::vector<Node> assertions;
+    for (size_t i = 0; i < n; ++i)
+    {
+      Node p = d_nodeManager->mkSkolem("p", boolType);
+      assertions.push_back(p.notNode().notNode());
+    }
+    return assertions;
+  }
+};
+
+#ifdef CVC4_THREAD_SAFE_NODES
+
+TEST_F(TestPPWhiteParallel, rewrite_in_order)
+{
+  d_smtEngine->setOption("pp-threads", "4");
+  d_smtEngine->finishInit();
+  smt::SmtScope scope(d_smtEngine.get());
+  PreprocessingPass* pass = getPass("rewrite");
+
+  std::vector<Node> assertions = mkDoubleNegations(1024);
+  AssertionPipeline ap;
+  for (const Node& a : assertions)
+  {
+    ap.push_back(a);
+  }
+  pass->apply(&ap);
+  ASSERT_EQ(ap.size(), assertions.size());
+  for (size_t i = 0, size = assertions.size(); i < size; ++i)
+  {
+    ASSERT_EQ(ap[i], assertions[i][0][0]);
+  }
+}
+
+TEST_F(TestPPWhiteParallel, resource_limit)
+{
+  d_smtEngine->setOption("pp-threads", "4");
+  d_smtEngine->finishInit();
+  smt::SmtScope scope(d_smtEngine.get());
+  PreprocessingPass* pass = getPass("rewrite");
+
+  std::vector<Node> assertions = mkDoubleNegations(4096);
+  AssertionPipeline ap;
+  for (const Node& a : assertions)
+  {
+    ap.push_back(a);
+  }
+  ResourceManager* rm = d_smtEngine->getResourceManager();
+  d_smtEngine->setResourceLimit(64, true);
+  pass->apply(&ap);
+  ASSERT_TRUE(rm->out());
+
+  // Reaching the limit does not stop the workers, as it does not stop the
+  // sequential loop, so all assertions are simplified.
+  for (size_t i = 0, size = assertions.size(); i < size; ++i)
+  {
+    ASSERT_EQ(ap[i], assertions[i][0][0]);
+  }
+}
+
+TEST_F(TestPPWhiteParallel, rewrite_theory_change)
+{
+  d_smtEngine->setOption("pp-threads", "4");
+  d_smtEngine->finishInit();
+  smt::SmtScope scope(d_smtEngine.get());
+  PreprocessingPass* pass = getPass("rewrite");
+
+  // Each (<= x (+ x 1)) is post-rewritten by arithmetic to true, a Boolean
+  // constant, so its full rewrite goes through the rewrite loop check of the
+  // thread rewriting it.
+  TypeNode intType = d_nodeManager->integerType();
+  Node one = d_nodeManager->mkConst(Rational(1));
+  AssertionPipeline ap;
+  for (size_t i = 0; i < 1024; ++i)
+  {
+    Node x = d_nodeManager->mkSkolem("x", intType);
+    ap.push_back(d_nodeManager->mkNode(
+        kind::LEQ, x, d_nodeManager->mkNode(kind::PLUS, x, one)));
+  }
+  pass->apply(&ap);
+  Node t = d_nodeManager->mkConst(true);
+  for (size_t i = 0, size = ap.size(); i < size; ++i)
+  {
+    ASSERT_EQ(ap[i], t);
+  }
+}
+
+TEST_F(TestPPWhiteParallel, bound_var_manager)
+{
+  typedef expr::Attribute<struct TestParallelBoundVarAttributeId, Node>
+      TestParallelBoundVarAttribute;
+  const size_t nthreads = 4;
+  const size_t nkeys = 2000;
+  d_smtEngine->finishInit();
+  BoundVarManager* bvm = d_nodeManager->getBoundVarManager();
+  TypeNode intType = d_nodeManager->integerType();
+  std::vector<Node> keys;
+  for (size_t i = 0; i < nkeys; ++i)
+  {
+    keys.push_back(BoundVarManager::getCacheValue(i));
+  }
+  std::vector<std::vector<Node>> results(nthreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nthreads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      NodeManagerScope nms(d_nodeManager.get());
+      for (const Node& k : keys)
+      {
+        results[t].push_back(
+            bvm->mkBoundVar<TestParallelBoundVarAttribute>(k, intType));
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  for (size_t i = 0; i < nkeys; ++i)
+  {
+    Node v = keys[i].getAttribute(TestParallelBoundVarAttribute());
+    for (size_t t = 0; t < nthreads; ++t)
+    {
+      ASSERT_EQ(results[t][i], v);
+    }
+  }
+}
+
+TEST_F(TestPPWhiteParallel, dtype_caches)
+{
+  const size_t nthreads = 4;
+  const size_t ntypes = 50;
+  d_smtEngine->finishInit();
+  TypeNode intType = d_nodeManager->integerType();
+  std::vector<TypeNode> types;
+  for (size_t i = 0; i < ntypes; ++i)
+  {
+    std::string name = "list" + std::to_string(i);
+    DType list(name);
+    std::shared_ptr<DTypeConstructor> cons =
+        std::make_shared<DTypeConstructor>("cons" + std::to_string(i));
+    cons->addArg("head" + std::to_string(i), intType);
+    cons->addArgSelf("tail" + std::to_string(i));
+    list.addConstructor(cons);
+    list.addConstructor(
+        std::make_shared<DTypeConstructor>("nil" + std::to_string(i)));
+    types.push_back(d_nodeManager->mkDatatypeType(list));
+  }
+  std::vector<std::vector<Node>> results(nthreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nthreads; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      smt::SmtScope scope(d_smtEngine.get());
+      for (const TypeNode& tn : types)
+      {
+        const DType& dt = tn.getDType();
+        EXPECT_TRUE(dt.isWellFounded());
+        EXPECT_FALSE(dt.isFinite());
+        EXPECT_FALSE(dt.hasNestedRecursion());
+        EXPECT_EQ(dt.getCardinality().compare(Cardinality::INTEGERS),
+                  Cardinality::EQUAL);
+        results[t].push_back(dt.mkGroundTerm(tn));
+        results[t].push_back(dt[0].getSelectorInternal(tn, 1));
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  for (size_t t = 1; t < nthreads; ++t)
+  {
+    ASSERT_EQ(results[t], results[0]);
+  }
+}
+
+#else /* CVC4_THREAD_SAFE_NODES */
+
+TEST_F(TestPPWhiteParallel, requires_thread_safe_nodes)
+{
+  d_smtEngine->setOption("pp-threads", "4");
+  ASSERT_THROW(d_smtEngine->finishInit(), OptionException);
+}
+
+#endif /* CVC4_THREAD_SAFE_NODES */
+
+}  // namespace test
+}  // namespace CVC4
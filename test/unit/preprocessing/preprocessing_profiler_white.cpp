@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file preprocessing_profiler_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the preprocessing profiler
+ **
+ ** White box testing of the preprocessing profiler.
+ **/
+
+#include <limits>
+#include <sstream>
+
+#include "expr/node_manager.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_profiler.h"
+#include "test_smt.h"
+
+namespace CVC4 {
+
+using namespace preprocessing;
+
+namespace test {
+
+class TestPPWhiteProfiler : public TestSmt
+{
+};
+
+TEST_F(TestPPWhiteProfiler, measure)
+{
+  Node x = d_nodeManager->mkVar("x", d_nodeManager->booleanType());
+  Node notx = d_nodeManager->mkNode(kind::NOT, x);
+  AssertionPipeline ap;
+  ap.push_back(d_nodeManager->mkNode(kind::AND, x, notx));
+  ap.push_back(notx);
+
+  PreprocessingProfiler::ProblemSize size = PreprocessingProfiler::measure(ap);
+  ASSERT_EQ(size.d_assertions, 2);
+  // x, (not x) and (and x (not x))
+  ASSERT_EQ(size.d_dagSize, 3);
+  // 4 subterms in the first assertion, 2 in the second
+  ASSERT_EQ(size.d_treeSize, 6);
+  ASSERT_EQ(size.d_kinds, 3);
+}
+
+TEST_F(TestPPWhiteProfiler, treeSizeSaturates)
+{
+  // a DAG of depth 70 whose tree size is above 2^70
+  Node n = d_nodeManager->mkVar("x", d_nodeManager->booleanType());
+  for (unsigned i = 0; i < 70; ++i)
+  {
+    n = d_nodeManager->mkNode(kind::AND, n, n);
+  }
+  AssertionPipeline ap;
+  ap.push_back(n);
+  ap.push_back(n);
+
+  PreprocessingProfiler::ProblemSize size = PreprocessingProfiler::measure(ap);
+  ASSERT_EQ(size.d_dagSize, 71);
+  ASSERT_EQ(size.d_treeSize, std::numeric_limits<uint64_t>::max());
+}
+
+TEST_F(TestPPWhiteProfiler, write)
+{
+  Node x = d_nodeManager->mkVar("x", d_nodeManager->booleanType());
+  AssertionPipeline ap;
+  ap.push_back(d_nodeManager->mkNode(kind::NOT, x));
+
+  PreprocessingProfiler profiler("");
+  profiler.beginPass("outer", ap);
+  profiler.beginPass("inner", ap);
+  ap.replace(0, x);
+  profiler.endPass(ap);
+  profiler.endPass(ap);
+
+  ASSERT_EQ(profiler.d_invocations.size(), 2);
+  ASSERT_EQ(profiler.d_invocations[0].d_pass, "inner");
+  ASSERT_EQ(profiler.d_invocations[0].d_depth, 1);
+  ASSERT_EQ(profiler.d_invocations[0].d_before.d_dagSize, 2);
+  ASSERT_EQ(profiler.d_invocations[0].d_after.d_dagSize, 1);
+  ASSERT_EQ(profiler.d_invocations[1].d_pass, "outer");
+  ASSERT_EQ(profiler.d_invocations[1].d_depth, 0);
+
+  std::stringstream ss;
+  profiler.write(ss);
+  std::string json = ss.str();
+  ASSERT_EQ(json.compare(0, 13, "{ \"passes\": ["), 0);
+  ASSERT_NE(json.find("\"pass\": \"inner\", \"depth\": 1"), std::string::npos);
+  ASSERT_NE(json.find("\"after\": { \"assertions\": 1, \"dagSize\": 1, "
+                      "\"treeSize\": 1, \"kinds\": 1 }"),
+            std::string::npos);
+}
+
+}  // namespace test
+}  // namespace CVC4
@@ -0,0 +1,110 @@
+/*********************                                                        */
+/*! \file clause_exchange_black.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::prop::ClauseExchange.
+ **
+ ** Black box testing of CVC4::prop::ClauseExchange.
+ **/
+
+#include <memory>
+#include <vector>
+
+#include "prop/clause_exchange.h"
+#include "test_node.h"
+
+namespace CVC4 {
+
+using namespace prop;
+
+namespace test {
+
+class TestPropBlackClauseExchange : public TestNode
+{
+};
+
+TEST_F(TestPropBlackClauseExchange, get)
+{
+  std::shared_ptr<ClauseExchange> a = ClauseExchange::get("a");
+  std::shared_ptr<ClauseExchange> b = ClauseExchange::get("b");
+  ASSERT_EQ(a, ClauseExchange::get("a"));
+  ASSERT_NE(a, b);
+}
+
+TEST_F(TestPropBlackClauseExchange, exchange)
+{
+  std::shared_ptr<ClauseExchange> exchange = ClauseExchange::get("exchange");
+  Node x = d_nodeManager->mkSkolem("x", *d_boolTypeNode);
+  Node y = d_nodeManager->mkSkolem("y", *d_boolTypeNode);
+  ClauseExchange::Clause unit = {x};
+  ClauseExchange::Clause binary = {x.notNode(), y};
+
+  size_t p0 = exchange->registerParticipant();
+  size_t p1 = exchange->registerParticipant();
+  exchange->exportClause(p0, unit);
+  exchange->exportClause(p1, binary);
+  ASSERT_EQ(exchange->size(), 2);
+
+  // the clauses of the other participants only
+  std::vector<ClauseExchange::Clause> clauses;
+  exchange->importClauses(p0, clauses);
+  ASSERT_EQ(clauses, std::vector<ClauseExchange::Clause>({binary}));
+  clauses.clear();
+  exchange->importClauses(p1, clauses);
+  ASSERT_EQ(clauses, std::vector<ClauseExchange::Clause>({unit}));
+
+  // only once
+  clauses.clear();
+  exchange->importClauses(p0, clauses);
+  ASSERT_TRUE(clauses.empty());
+
+  // the clauses imported by all participants are removed
+  ASSERT_EQ(exchange->size(), 0);
+
+  // a late participant gets the clauses still in the pool
+  ClauseExchange::Clause late = {y};
+  exchange->exportClause(p0, late);
+  size_t p2 = exchange->registerParticipant();
+  exchange->importClauses(p2, clauses);
+  ASSERT_EQ(clauses, std::vector<ClauseExchange::Clause>({late}));
+  ASSERT_EQ(exchange->size(), 1);
+
+  // unregistered participants do not hold clauses in the pool
+  exchange->unregisterParticipant(p1);
+  ASSERT_EQ(exchange->size(), 0);
+}
+
+TEST_F(TestPropBlackClauseExchange, trim)
+{
+  std::shared_ptr<ClauseExchange> exchange = ClauseExchange::get("trim");
+  Node x = d_nodeManager->mkSkolem("x", *d_boolTypeNode);
+  size_t p0 = exchange->registerParticipant();
+  size_t p1 = exchange->registerParticipant();
+  std::vector<ClauseExchange::Clause> clauses;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    exchange->exportClause(p0, {x});
+    exchange->exportClause(p1, {x.notNode()});
+    if (i % 10 == 0)
+    {
+      exchange->importClauses(p0, clauses);
+      exchange->importClauses(p1, clauses);
+      // every clause is imported by the participant that did not export it
+      ASSERT_EQ(exchange->size(), 0);
+    }
+  }
+  ASSERT_EQ(exchange->size(), 18);
+  exchange->importClauses(p0, clauses);
+  ASSERT_EQ(exchange->size(), 18);
+  exchange->importClauses(p1, clauses);
+  ASSERT_EQ(exchange->size(), 0);
+  ASSERT_EQ(clauses.size(), 2000);
+}
+
+}  // namespace test
+}  // namespace CVC4
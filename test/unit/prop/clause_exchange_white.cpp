@@ -0,0 +1,205 @@
+/*********************                                                        */
+/*! \file clause_exchange_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the sharing of learned clauses.
+ **
+ ** White box testing of two SmtEngines exchanging learned clauses through
+ ** Minisat's exportLearnt() and importClauses(), their TheoryProxy and a
+ ** ClauseExchange (--share-clauses).
+ **/
+
+#include <memory>
+#include <string>
+
+#include "prop/clause_exchange.h"
+#include "prop/cnf_stream.h"
+#include "prop/minisat/core/Solver.h"
+#include "prop/minisat/minisat.h"
+#include "prop/prop_engine.h"
+#include "prop/theory_proxy.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "util/result.h"
+
+namespace CVC4 {
+
+using namespace prop;
+
+namespace test {
+
+class TestPropWhiteClauseExchange : public TestSmtNoFinishInit
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmtNoFinishInit::SetUp();
+    d_smtEngine2.reset(new SmtEngine(d_nodeManager.get()));
+    d_a = d_nodeManager->mkVar("a", d_nodeManager->booleanType());
+    d_b = d_nodeManager->mkVar("b", d_nodeManager->booleanType());
+    d_c = d_nodeManager->mkVar("c", d_nodeManager->booleanType());
+  }
+
+  void TearDown() override
+  {
+    d_smtEngine2.reset();
+    TestSmtNoFinishInit::TearDown();
+  }
+
+  /**
+   * Sets up smt to share its clauses on channel, and asserts (or a b c),
+   * (or (not c) a) and (or (not c) b), which imply (or a b).
+   */
+  void setUpEngine(SmtEngine* smt, const std::string& channel)
+  {
+    smt->setOption("incremental", "true");
+    smt->setOption("produce-models", "true");
+    smt->setOption("share-clauses", channel);
+    {
+      // the theories register their rewriters with the SmtEngine in scope,
+      // which is the last one created otherwise
+      smt::SmtScope scope(smt);
+      smt->finishInit();
+    }
+    smt->assertFormula(d_nodeManager->mkNode(kind::OR, d_a, d_b, d_c));
+    smt->assertFormula(d_nodeManager->mkNode(kind::OR, d_c.notNode(), d_a));
+    smt->assertFormula(d_nodeManager->mkNode(kind::OR, d_c.notNode(), d_b));
+    ASSERT_EQ(smt->checkSat().isSat(), Result::SAT);
+  }
+
+  static PropEngine* getPropEngine(SmtEngine* smt)
+  {
+    return smt->getPropEngine();
+  }
+
+  static Minisat::SimpSolver* getMinisat(SmtEngine* smt)
+  {
+    return static_cast<MinisatSatSolver*>(getPropEngine(smt)->d_satSolver)
+        ->getSolver();
+  }
+
+  /** Returns the Minisat literal of the atom of smt. */
+  static Minisat::Lit getLit(SmtEngine* smt, TNode atom)
+  {
+    return MinisatSatSolver::toMinisatLit(
+        getPropEngine(smt)->d_cnfStream->getLiteral(atom));
+  }
+
+  std::unique_ptr<SmtEngine> d_smtEngine2;
+  Node d_a, d_b, d_c;
+};
+
+TEST_F(TestPropWhiteClauseExchange, export_import)
+{
+  SmtEngine* exporter = d_smtEngine.get();
+  SmtEngine* importer = d_smtEngine2.get();
+  setUpEngine(exporter, "export_import");
+  setUpEngine(importer, "export_import");
+  std::shared_ptr<ClauseExchange> exchange =
+      ClauseExchange::get("export_import");
+  TheoryProxy* exporterProxy = getPropEngine(exporter)->d_theoryProxy;
+  TheoryProxy* importerProxy = getPropEngine(importer)->d_theoryProxy;
+  ASSERT_TRUE(exporterProxy->isSharingClauses());
+  ASSERT_TRUE(importerProxy->isSharingClauses());
+
+  {
+    smt::SmtScope scope(exporter);
+    Minisat::SimpSolver* minisat = getMinisat(exporter);
+    minisat->cancelUntil(0);
+    Minisat::vec<Minisat::Lit> learnt;
+    learnt.push(getLit(exporter, d_a));
+    learnt.push(getLit(exporter, d_b));
+    minisat->exportLearnt(learnt);
+    // too long to be shared by default
+    learnt.push(getLit(exporter, d_c));
+    minisat->exportLearnt(learnt);
+  }
+  ASSERT_EQ(exporterProxy->d_exported.getData(), 1);
+  ASSERT_EQ(exchange->size(), 1u);
+
+  {
+    smt::SmtScope scope(importer);
+    Minisat::SimpSolver* minisat = getMinisat(importer);
+    minisat->cancelUntil(0);
+    int learnts = minisat->nLearnts();
+    // clauses are imported during the search, as lemmas added on the next
+    // propagation
+    minisat->minisat_busy = true;
+    minisat->importClauses();
+    ASSERT_EQ(minisat->lemmas.size(), 1);
+    ASSERT_EQ(minisat->updateLemmas(), Minisat::CRef_Undef);
+    minisat->minisat_busy = false;
+    // added as a removable clause over the literals of the importer
+    ASSERT_EQ(minisat->nLearnts(), learnts + 1);
+    Minisat::Clause& c = minisat->ca[minisat->clauses_removable.last()];
+    ASSERT_EQ(c.size(), 2);
+    Minisat::Lit a = getLit(importer, d_a);
+    Minisat::Lit b = getLit(importer, d_b);
+    ASSERT_TRUE((c[0] == a && c[1] == b) || (c[0] == b && c[1] == a));
+    // only once
+    minisat->minisat_busy = true;
+    minisat->importClauses();
+    ASSERT_EQ(minisat->lemmas.size(), 0);
+    minisat->minisat_busy = false;
+  }
+  ASSERT_EQ(importerProxy->d_imported.getData(), 1);
+  ASSERT_EQ(importerProxy->d_dropped.getData(), 0);
+
+  // the exporter does not get its own clause back
+  {
+    smt::SmtScope scope(exporter);
+    getMinisat(exporter)->importClauses();
+  }
+  ASSERT_EQ(exporterProxy->d_imported.getData(), 0);
+
+  // the shared clause is sound: (or a b) holds in every model
+  importer->assertFormula(
+      d_nodeManager->mkNode(kind::AND, d_a.notNode(), d_c.notNode()));
+  ASSERT_EQ(importer->checkSat().isSat(), Result::SAT);
+  ASSERT_EQ(importer->getValue(d_b), d_nodeManager->mkConst(true));
+  importer->assertFormula(d_b.notNode());
+  ASSERT_EQ(importer->checkSat().isSat(), Result::UNSAT);
+}
+
+TEST_F(TestPropWhiteClauseExchange, unknown_atom)
+{
+  SmtEngine* exporter = d_smtEngine.get();
+  SmtEngine* importer = d_smtEngine2.get();
+  setUpEngine(exporter, "unknown_atom");
+  setUpEngine(importer, "unknown_atom");
+  Node d = d_nodeManager->mkVar("d", d_nodeManager->booleanType());
+  exporter->assertFormula(d_nodeManager->mkNode(kind::OR, d_a, d));
+  ASSERT_EQ(exporter->checkSat().isSat(), Result::SAT);
+
+  {
+    smt::SmtScope scope(exporter);
+    Minisat::SimpSolver* minisat = getMinisat(exporter);
+    minisat->cancelUntil(0);
+    Minisat::vec<Minisat::Lit> learnt;
+    learnt.push(getLit(exporter, d_a));
+    learnt.push(getLit(exporter, d));
+    minisat->exportLearnt(learnt);
+  }
+
+  // the importer has no literal for d, and drops the clause
+  TheoryProxy* importerProxy = getPropEngine(importer)->d_theoryProxy;
+  {
+    smt::SmtScope scope(importer);
+    Minisat::SimpSolver* minisat = getMinisat(importer);
+    minisat->cancelUntil(0);
+    int learnts = minisat->nLearnts();
+    minisat->importClauses();
+    ASSERT_EQ(minisat->nLearnts(), learnts);
+  }
+  ASSERT_EQ(importerProxy->d_imported.getData(), 0);
+  ASSERT_EQ(importerProxy->d_dropped.getData(), 1);
+}
+
+}  // namespace test
+}  // namespace CVC4
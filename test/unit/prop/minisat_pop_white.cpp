@@ -0,0 +1,133 @@
+/*********************                                                        */
+/*! \file minisat_pop_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the user pops of Minisat.
+ **
+ ** White box testing of the variables of Minisat across user pops with
+ ** persistent variables (--incremental-cnf).
+ **/
+
+#include <memory>
+
+#include "prop/minisat/core/Solver.h"
+#include "prop/minisat/minisat.h"
+#include "prop/prop_engine.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+
+namespace CVC4 {
+
+using namespace prop;
+
+namespace test {
+
+class TestPropWhiteMinisatPop : public TestSmtNoFinishInit
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmtNoFinishInit::SetUp();
+    d_smtEngine->setOption("incremental", "true");
+    d_smtEngine->setOption("incremental-cnf", "true");
+    d_smtEngine->finishInit();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+    d_minisat = static_cast<MinisatSatSolver*>(
+                    d_smtEngine->getPropEngine()->d_satSolver)
+                    ->getSolver();
+  }
+
+  void TearDown() override
+  {
+    d_scope.reset();
+    TestSmtNoFinishInit::TearDown();
+  }
+
+  /** Returns a new persistent variable. */
+  Minisat::Var newPersistentVar()
+  {
+    Minisat::Var v = d_minisat->newVar();
+    d_minisat->makePersistent(v);
+    return v;
+  }
+
+  std::unique_ptr<smt::SmtScope> d_scope;
+  Minisat::SimpSolver* d_minisat;
+};
+
+TEST_F(TestPropWhiteMinisatPop, reuse_scoped_vars)
+{
+  int vars = d_minisat->nVars();
+  d_minisat->push();
+  Minisat::Var scoped = d_minisat->newVar();
+  Minisat::Var persistent = newPersistentVar();
+  d_minisat->pop();
+  // the scoped variable is disabled, as the persistent one is kept
+  ASSERT_EQ(d_minisat->nVars(), vars + 2);
+  ASSERT_FALSE(d_minisat->decision[scoped]);
+  ASSERT_TRUE(d_minisat->decision[persistent]);
+
+  // and the next variable takes its slot
+  d_minisat->push();
+  ASSERT_EQ(d_minisat->newVar(), scoped);
+  ASSERT_TRUE(d_minisat->decision[scoped]);
+  ASSERT_EQ(d_minisat->intro_level(scoped), 1);
+  ASSERT_EQ(MinisatSatSolver::toSatLiteralValue(d_minisat->value(scoped)),
+            SAT_VALUE_UNKNOWN);
+  ASSERT_EQ(d_minisat->newVar(), vars + 2);
+  d_minisat->pop();
+  ASSERT_EQ(d_minisat->nVars(), vars + 2);
+  ASSERT_FALSE(d_minisat->decision[scoped]);
+  ASSERT_EQ(d_minisat->free_vars.size(), 1);
+}
+
+TEST_F(TestPropWhiteMinisatPop, bounded_vars)
+{
+  // each round keeps one persistent variable, and creates a scoped one
+  // below and above it
+  int vars = d_minisat->nVars();
+  for (int i = 0; i < 100; ++i)
+  {
+    d_minisat->push();
+    d_minisat->newVar();
+    newPersistentVar();
+    d_minisat->newVar();
+    d_minisat->pop();
+  }
+  ASSERT_EQ(d_minisat->nVars(), vars + 101);
+  ASSERT_EQ(d_minisat->free_vars.size(), 1);
+}
+
+TEST_F(TestPropWhiteMinisatPop, nested_levels)
+{
+  int vars = d_minisat->nVars();
+  d_minisat->push();
+  d_minisat->push();
+  Minisat::Var scoped = d_minisat->newVar();
+  newPersistentVar();
+  d_minisat->pop();
+
+  // reused at level one, the slot is freed once when level one is popped
+  ASSERT_EQ(d_minisat->newVar(), scoped);
+  ASSERT_EQ(d_minisat->intro_level(scoped), 1);
+  d_minisat->pop();
+  ASSERT_EQ(d_minisat->nVars(), vars + 2);
+  ASSERT_EQ(d_minisat->free_vars.size(), 1);
+
+  // a reused slot made persistent is kept
+  d_minisat->push();
+  ASSERT_EQ(d_minisat->newVar(), scoped);
+  d_minisat->makePersistent(scoped);
+  d_minisat->pop();
+  ASSERT_TRUE(d_minisat->decision[scoped]);
+  ASSERT_EQ(d_minisat->free_vars.size(), 0);
+}
+
+}  // namespace test
+}  // namespace CVC4
@@ -0,0 +1,274 @@
+/*********************                                                        */
+/*! \file persistent_rewrite_cache_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the persistent rewrite cache.
+ **
+ ** White box testing of the persistent rewrite cache: reopening a file,
+ ** fingerprint mismatches, the size cap and torn records.
+ **/
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "options/options.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/persistent_rewrite_cache.h"
+
+namespace CVC4 {
+
+using namespace theory;
+
+namespace test {
+
+class TestTheoryWhitePersistentRewriteCache : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+    char filename[] = "rewrite_cacheXXXXXX";
+    int fd = mkstemp(filename);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    d_filename = filename;
+
+    TypeNode intType = d_nodeManager->integerType();
+    Node x = d_nodeManager->mkVar("x", intType);
+    Node y = d_nodeManager->mkVar("y", intType);
+    Node one = d_nodeManager->mkConst(Rational(1));
+    d_terms.push_back(d_nodeManager->mkNode(kind::PLUS, x, one));
+    d_rewritten.push_back(d_nodeManager->mkNode(kind::PLUS, one, x));
+    d_terms.push_back(d_nodeManager->mkNode(kind::MULT, x, y));
+    d_rewritten.push_back(d_nodeManager->mkNode(kind::MULT, y, x));
+  }
+
+  void TearDown() override
+  {
+    std::remove(d_filename.c_str());
+    d_scope.reset();
+    TestSmt::TearDown();
+  }
+
+  /** Open the cache in the file of the test */
+  std::unique_ptr<PersistentRewriteCache> open(uint64_t maxSize = 1 << 20)
+  {
+    return std::unique_ptr<PersistentRewriteCache>(
+        new PersistentRewriteCache(d_filename, maxSize));
+  }
+
+  /** Store the first n terms in a fresh cache of the file */
+  void storeTerms(size_t n)
+  {
+    std::unique_ptr<PersistentRewriteCache> cache = open();
+    for (size_t i = 0; i < n; ++i)
+    {
+      cache->store(THEORY_ARITH, d_terms[i], d_rewritten[i]);
+    }
+  }
+
+  /** The size of the file */
+  off_t fileSize()
+  {
+    struct stat st;
+    EXPECT_EQ(stat(d_filename.c_str(), &st), 0);
+    return st.st_size;
+  }
+
+  std::unique_ptr<smt::SmtScope> d_scope;
+  std::string d_filename;
+  std::vector<Node> d_terms;
+  std::vector<Node> d_rewritten;
+};
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, reopen)
+{
+  {
+    std::unique_ptr<PersistentRewriteCache> cache = open();
+    cache->store(THEORY_ARITH, d_terms[0], d_rewritten[0]);
+    ASSERT_EQ(cache->d_stores.getData(), 1);
+    // the entries of this process are not looked up again
+    ASSERT_TRUE(cache->lookup(THEORY_ARITH, d_terms[0]).isNull());
+  }
+  std::unique_ptr<PersistentRewriteCache> cache = open();
+  ASSERT_EQ(cache->lookup(THEORY_ARITH, d_terms[0]), d_rewritten[0]);
+  ASSERT_EQ(cache->d_hits.getData(), 1);
+  // the theory is part of the key
+  ASSERT_TRUE(cache->lookup(THEORY_BV, d_terms[0]).isNull());
+  ASSERT_TRUE(cache->lookup(THEORY_ARITH, d_terms[1]).isNull());
+  ASSERT_EQ(cache->d_misses.getData(), 2);
+  // the variables are matched by name
+  Node z = d_nodeManager->mkVar("z", d_nodeManager->integerType());
+  Node one = d_nodeManager->mkConst(Rational(1));
+  ASSERT_TRUE(
+      cache->lookup(THEORY_ARITH, d_nodeManager->mkNode(kind::PLUS, z, one))
+          .isNull());
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, fingerprint_mismatch)
+{
+  storeTerms(1);
+  off_t size = fileSize();
+  Options* opts = Options::current();
+  std::string value = opts->getOption("ag-miniscope-quant");
+  opts->setOption("ag-miniscope-quant", value == "true" ? "false" : "true");
+  {
+    // neither read nor added to
+    std::unique_ptr<PersistentRewriteCache> cache = open();
+    ASSERT_TRUE(cache->lookup(THEORY_ARITH, d_terms[0]).isNull());
+    cache->store(THEORY_ARITH, d_terms[1], d_rewritten[1]);
+    ASSERT_EQ(cache->d_stores.getData(), 0);
+    ASSERT_EQ(cache->d_rejected.getData(), 1);
+  }
+  ASSERT_EQ(fileSize(), size);
+  // the file is still valid for the options it was written with
+  opts->setOption("ag-miniscope-quant", value);
+  std::unique_ptr<PersistentRewriteCache> cache = open();
+  ASSERT_EQ(cache->lookup(THEORY_ARITH, d_terms[0]), d_rewritten[0]);
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, rewriter_options)
+{
+  Options* opts = Options::current();
+  // the options read by the rewriters change the fingerprint, without being
+  // listed anywhere
+  for (const char* opt : {"ag-miniscope-quant",
+                          "bv-extract-arith",
+                          "miniscope-quant",
+                          "strings-exp",
+                          "uf-ho"})
+  {
+    uint64_t fp = PersistentRewriteCache::fingerprint();
+    std::string value = opts->getOption(opt);
+    opts->setOption(opt, value == "true" ? "false" : "true");
+    ASSERT_NE(PersistentRewriteCache::fingerprint(), fp) << opt;
+    opts->setOption(opt, value);
+    ASSERT_EQ(PersistentRewriteCache::fingerprint(), fp) << opt;
+  }
+  // the ignored options exist, and do not
+  std::vector<std::string> names;
+  for (const std::vector<std::string>& opt : opts->getOptions())
+  {
+    names.push_back(opt[0].substr(0, opt[0].find('=')));
+  }
+  for (const char* const* opt = PersistentRewriteCache::s_ignoredOptions;
+       *opt != nullptr;
+       ++opt)
+  {
+    ASSERT_NE(std::find(names.begin(), names.end(), *opt), names.end())
+        << *opt;
+  }
+  uint64_t fp = PersistentRewriteCache::fingerprint();
+  opts->setOption("verbosity", "3");
+  opts->setOption("rewrite-step", "7");
+  ASSERT_EQ(PersistentRewriteCache::fingerprint(), fp);
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, size_cap)
+{
+  storeTerms(1);
+  off_t size = fileSize();
+  {
+    // the file is full
+    std::unique_ptr<PersistentRewriteCache> cache = open(size);
+    cache->store(THEORY_ARITH, d_terms[1], d_rewritten[1]);
+    ASSERT_EQ(cache->d_stores.getData(), 0);
+    ASSERT_EQ(cache->d_rejected.getData(), 1);
+    // but can be read
+    ASSERT_EQ(cache->lookup(THEORY_ARITH, d_terms[0]), d_rewritten[0]);
+  }
+  ASSERT_EQ(fileSize(), size);
+  {
+    std::unique_ptr<PersistentRewriteCache> cache = open();
+    cache->store(THEORY_ARITH, d_terms[1], d_rewritten[1]);
+    ASSERT_EQ(cache->d_stores.getData(), 1);
+  }
+  ASSERT_GT(fileSize(), size);
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, torn_record)
+{
+  storeTerms(2);
+  off_t size = fileSize();
+  // a write torn at the end of the file
+  ASSERT_EQ(truncate(d_filename.c_str(), size - 3), 0);
+  {
+    std::unique_ptr<PersistentRewriteCache> cache = open();
+    ASSERT_EQ(cache->lookup(THEORY_ARITH, d_terms[0]), d_rewritten[0]);
+    ASSERT_TRUE(cache->lookup(THEORY_ARITH, d_terms[1]).isNull());
+  }
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, corrupt_record)
+{
+  storeTerms(2);
+  {
+    // corrupt the key of the first record
+    std::unique_ptr<PersistentRewriteCache> cache = open();
+    ASSERT_EQ(cache->d_index.size(), 2u);
+    uint64_t pos = 0;
+    for (const auto& e : cache->d_index)
+    {
+      uint64_t keyPos = e.second.d_key - cache->d_map;
+      if (pos == 0 || keyPos < pos)
+      {
+        pos = keyPos;
+      }
+    }
+    FILE* f = std::fopen(d_filename.c_str(), "r+b");
+    ASSERT_NE(f, nullptr);
+    ASSERT_EQ(std::fseek(f, pos, SEEK_SET), 0);
+    int c = std::fgetc(f);
+    ASSERT_EQ(std::fseek(f, pos, SEEK_SET), 0);
+    std::fputc(c ^ 0xff, f);
+    std::fclose(f);
+  }
+  // the records after it are still read
+  std::unique_ptr<PersistentRewriteCache> cache = open();
+  ASSERT_EQ(cache->d_index.size(), 1u);
+  ASSERT_TRUE(cache->lookup(THEORY_ARITH, d_terms[0]).isNull());
+  ASSERT_EQ(cache->lookup(THEORY_ARITH, d_terms[1]), d_rewritten[1]);
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, malformed_value)
+{
+  storeTerms(1);
+  std::unique_ptr<PersistentRewriteCache> cache = open();
+  ASSERT_EQ(cache->d_index.size(), 1u);
+  PersistentRewriteCache::Entry& e = cache->d_index.begin()->second;
+  std::string value(e.d_value, e.d_valueSize);
+  // a value with a valid checksum is still decoded as untrusted input, and
+  // an unreadable one is a miss
+  for (size_t i = 0; i < value.size(); ++i)
+  {
+    for (char flip : {0x01, 0x08, 0x7f})
+    {
+      std::string corrupted = value;
+      corrupted[i] ^= flip;
+      e.d_value = corrupted.data();
+      ASSERT_NO_THROW(cache->lookup(THEORY_ARITH, d_terms[0]));
+    }
+  }
+  e.d_value = value.data();
+  ASSERT_EQ(cache->lookup(THEORY_ARITH, d_terms[0]), d_rewritten[0]);
+}
+
+}  // namespace test
+}  // namespace CVC4
@@ -0,0 +1,137 @@
+/*********************                                                        */
+/*! \file theory_arith_float_simplex_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the double precision simplex of arithmetic.
+ **/
+
+#include <string>
+#include <vector>
+
+#include "base/configuration.h"
+#include "options/option_exception.h"
+#include "test_smt.h"
+#include "util/rational.h"
+#include "util/result.h"
+#include "util/sexpr.h"
+
+namespace CVC4 {
+namespace test {
+
+class TestTheoryWhiteArithFloatSimplex : public TestSmtNoFinishInit
+{
+ protected:
+  /**
+   * Asserts a system of inequalities over 6 real variables, in which row i
+   * bounds x_i + 2 x_{i+1} - x_{i+2} from above by rhs[i], and every
+   * variable is at least 1.
+   */
+  void assertSystem(const std::vector<long>& rhs)
+  {
+    NodeManager* nm = d_nodeManager.get();
+    std::vector<Node> x;
+    for (size_t i = 0; i < 6; ++i)
+    {
+      x.push_back(nm->mkVar("x" + std::to_string(i), nm->realType()));
+      d_smtEngine->assertFormula(
+          nm->mkNode(kind::GEQ, x.back(), nm->mkConst(Rational(1))));
+    }
+    Node two = nm->mkConst(Rational(2));
+    Node minusOne = nm->mkConst(Rational(-1));
+    for (size_t i = 0; i < rhs.size(); ++i)
+    {
+      Node sum = nm->mkNode(kind::PLUS,
+                            x[i % 6],
+                            nm->mkNode(kind::MULT, two, x[(i + 1) % 6]),
+                            nm->mkNode(kind::MULT, minusOne, x[(i + 2) % 6]));
+      d_smtEngine->assertFormula(
+          nm->mkNode(kind::LEQ, sum, nm->mkConst(Rational(rhs[i]))));
+    }
+  }
+
+  /** Returns the value of the integer statistic name. */
+  Integer getStat(const std::string& name)
+  {
+    return d_smtEngine->getStatistic(name).getIntegerValue();
+  }
+
+  /** Sets the options that make every relaxation go through the float path. */
+  void forceFloatSimplex()
+  {
+    d_smtEngine->setLogic("QF_LRA");
+    d_smtEngine->setOption("float-simplex", "true");
+    d_smtEngine->setOption("standard-effort-variable-order-pivots", "0");
+    d_smtEngine->setOption("heuristic-pivots", "0");
+    d_smtEngine->finishInit();
+  }
+};
+
+TEST_F(TestTheoryWhiteArithFloatSimplex, sat)
+{
+  if (!Configuration::isStatisticsBuild())
+  {
+    return;
+  }
+  forceFloatSimplex();
+  assertSystem({2, 2, 2, 2, 2, 2});
+  ASSERT_EQ(d_smtEngine->checkSat().isSat(), Result::SAT);
+  ASSERT_GT(getStat("theory::arith::float::calls"), Integer(0));
+  ASSERT_GT(getStat("theory::arith::float::feasible"), Integer(0));
+}
+
+TEST_F(TestTheoryWhiteArithFloatSimplex, unsat)
+{
+  if (!Configuration::isStatisticsBuild())
+  {
+    return;
+  }
+  forceFloatSimplex();
+  // the rows sum to 2 (x_0 + ... + x_5) <= 11, against x_i >= 1
+  assertSystem({2, 2, 2, 2, 2, 1});
+  ASSERT_EQ(d_smtEngine->checkSat().isSat(), Result::UNSAT);
+  ASSERT_GT(getStat("theory::arith::float::calls"), Integer(0));
+}
+
+TEST_F(TestTheoryWhiteArithFloatSimplex, non_pure_logic)
+{
+  // outside of pure arithmetic, the exact simplex has no pivot limit by
+  // default, and the float path would never run; --float-simplex sets one
+  d_smtEngine->setLogic("QF_UFLRA");
+  d_smtEngine->setOption("float-simplex", "true");
+  d_smtEngine->finishInit();
+  ASSERT_EQ(d_smtEngine->getOption("standard-effort-variable-order-pivots")
+                .getValue(),
+            "200");
+}
+
+TEST_F(TestTheoryWhiteArithFloatSimplex, non_pure_logic_sat)
+{
+  if (!Configuration::isStatisticsBuild())
+  {
+    return;
+  }
+  d_smtEngine->setLogic("QF_UFLRA");
+  d_smtEngine->setOption("float-simplex", "true");
+  d_smtEngine->setOption("standard-effort-variable-order-pivots", "0");
+  d_smtEngine->setOption("heuristic-pivots", "0");
+  d_smtEngine->finishInit();
+  assertSystem({2, 2, 2, 2, 2, 2});
+  ASSERT_EQ(d_smtEngine->checkSat().isSat(), Result::SAT);
+  ASSERT_GT(getStat("theory::arith::float::calls"), Integer(0));
+}
+
+TEST_F(TestTheoryWhiteArithFloatSimplex, no_pivot_limit)
+{
+  d_smtEngine->setLogic("QF_UFLRA");
+  d_smtEngine->setOption("float-simplex", "true");
+  d_smtEngine->setOption("standard-effort-variable-order-pivots", "-1");
+  ASSERT_THROW(d_smtEngine->finishInit(), OptionException);
+}
+
+}  // namespace test
+}  // namespace CVC4
@@ -0,0 +1,286 @@
+/*********************                                                        */
+/*! \file theory_arith_gomory_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the Gomory cuts of arithmetic and their pool.
+ **/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "context/context.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/arith/constraint.h"
+#include "theory/arith/gomory_cuts.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/tableau.h"
+#include "theory/arith/theory_arith.h"
+#include "theory/theory_engine.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+
+using namespace theory;
+using namespace theory::arith;
+
+namespace test {
+
+class TestTheoryWhiteArithGomory : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+    TheoryArith* arith = static_cast<TheoryArith*>(
+        d_smtEngine->getTheoryEngine()->d_theoryTable[THEORY_ARITH]);
+    d_context.reset(new context::Context());
+    d_vars.reset(new ArithVariables(d_context.get(),
+                                    DeltaComputeCallback(*arith->d_internal)));
+    d_tableau.reset(new Tableau());
+  }
+
+  void TearDown() override
+  {
+    d_tableau.reset();
+    d_vars.reset();
+    d_context.reset();
+    for (std::unique_ptr<Constraint>& c : d_constraints)
+    {
+      // set by makeTrue, and must be unset before the constraint goes away
+      c->d_crid = ConstraintRuleIdSentinel;
+    }
+    d_constraints.clear();
+    d_scope.reset();
+    TestSmt::TearDown();
+  }
+
+  /** Returns a fresh variable, integer or real, with assignment value. */
+  ArithVar mkVar(const std::string& name, bool integer, const Rational& value)
+  {
+    TypeNode type = integer ? d_nodeManager->integerType()
+                            : d_nodeManager->realType();
+    ArithVar x = d_vars->allocate(d_nodeManager->mkVar(name, type), false);
+    d_tableau->increaseSizeTo(d_vars->getNumberOfVariables());
+    d_vars->setAssignment(x, DeltaRational(value));
+    return x;
+  }
+
+  /** Sets a lower or upper bound on x. */
+  void setBound(ArithVar x, ConstraintType t, const Rational& value)
+  {
+    d_constraints.emplace_back(new Constraint(x, t, DeltaRational(value)));
+    if (t == LowerBound)
+    {
+      d_vars->setLowerBoundConstraint(d_constraints.back().get());
+    }
+    else
+    {
+      d_vars->setUpperBoundConstraint(d_constraints.back().get());
+    }
+  }
+
+  /** Makes every bound constraint count as true. */
+  void makeTrue()
+  {
+    for (std::unique_ptr<Constraint>& c : d_constraints)
+    {
+      c->d_crid = 0;
+    }
+  }
+
+  /** Returns the value of the left-hand side of cut at the point values. */
+  static Rational lhsAt(const GomoryCut& cut,
+                        const std::vector<ArithVar>& vars,
+                        const std::vector<Rational>& values)
+  {
+    Rational sum;
+    for (size_t i = 0; i < vars.size(); ++i)
+    {
+      if (cut.d_lhs.isKey(vars[i]))
+      {
+        sum += cut.d_lhs[vars[i]] * values[i];
+      }
+    }
+    return sum;
+  }
+
+  /**
+   * Builds the row b = 1/2 x0 + 1/3 x1 + 1/2 y0 - 1/4 y1 with integers b,
+   * x0, x1 and reals y0, y1, where x0 >= 0, x1 <= 2, y0 >= 1 and y1 <= 1
+   * hold, and every nonbasic variable sits at its bound. Then b is 11/12.
+   */
+  void mkRow()
+  {
+    d_x0 = mkVar("x0", true, Rational(0));
+    d_x1 = mkVar("x1", true, Rational(2));
+    d_y0 = mkVar("y0", false, Rational(1));
+    d_y1 = mkVar("y1", false, Rational(1));
+    d_b = mkVar("b", true, Rational(11, 12));
+    setBound(d_x0, LowerBound, Rational(0));
+    setBound(d_x1, UpperBound, Rational(2));
+    setBound(d_y0, LowerBound, Rational(1));
+    setBound(d_y1, UpperBound, Rational(1));
+    d_tableau->addRow(
+        d_b,
+        {Rational(1, 2), Rational(1, 3), Rational(1, 2), Rational(-1, 4)},
+        {d_x0, d_x1, d_y0, d_y1});
+  }
+
+  std::unique_ptr<smt::SmtScope> d_scope;
+  std::unique_ptr<context::Context> d_context;
+  std::unique_ptr<ArithVariables> d_vars;
+  std::unique_ptr<Tableau> d_tableau;
+  std::vector<std::unique_ptr<Constraint>> d_constraints;
+  ArithVar d_x0, d_x1, d_y0, d_y1, d_b;
+};
+
+TEST_F(TestTheoryWhiteArithGomory, cut_of_row)
+{
+  mkRow();
+  GomoryCutGenerator generator(*d_vars, *d_tableau);
+  GomoryCut cut;
+  ASSERT_TRUE(generator.derive(d_b, cut));
+  ASSERT_EQ(cut.d_basic, d_b);
+  ASSERT_GT(cut.d_score, 0.0);
+  ASSERT_EQ(cut.d_explanation.size(), 4u);
+
+  // variables at a lower bound come in positively, at an upper bound
+  // negatively, and the basic variable does not appear
+  ASSERT_FALSE(cut.d_lhs.isKey(d_b));
+  ASSERT_GT(cut.d_lhs[d_x0].sgn(), 0);
+  ASSERT_LT(cut.d_lhs[d_x1].sgn(), 0);
+  ASSERT_GT(cut.d_lhs[d_y0].sgn(), 0);
+  ASSERT_LT(cut.d_lhs[d_y1].sgn(), 0);
+
+  std::vector<ArithVar> vars = {d_x0, d_x1, d_y0, d_y1};
+  // the current assignment violates the cut
+  ASSERT_LT(lhsAt(cut,
+                  vars,
+                  {Rational(0), Rational(2), Rational(1), Rational(1)}),
+            cut.d_rhs);
+
+  // every point within the bounds at which b is an integer satisfies it; the
+  // reals range over a grid fine enough to hit all fractional parts of b
+  size_t integral = 0;
+  for (long x0 = 0; x0 <= 6; ++x0)
+  {
+    for (long x1 = -4; x1 <= 2; ++x1)
+    {
+      for (long y0 = 12; y0 <= 36; ++y0)
+      {
+        for (long y1 = -12; y1 <= 12; ++y1)
+        {
+          std::vector<Rational> point = {Rational(x0),
+                                         Rational(x1),
+                                         Rational(y0, 12L),
+                                         Rational(y1, 12L)};
+          Rational b = Rational(1, 2) * point[0] + Rational(1, 3) * point[1]
+                       + Rational(1, 2) * point[2] - Rational(1, 4) * point[3];
+          if (!b.isIntegral())
+          {
+            continue;
+          }
+          ++integral;
+          ASSERT_GE(lhsAt(cut, vars, point), cut.d_rhs);
+        }
+      }
+    }
+  }
+  ASSERT_GT(integral, 0u);
+}
+
+TEST_F(TestTheoryWhiteArithGomory, no_cut)
+{
+  mkRow();
+  GomoryCutGenerator generator(*d_vars, *d_tableau);
+  GomoryCut cut;
+
+  // x0 strictly above its bound
+  d_vars->setAssignment(d_x0, DeltaRational(Rational(1)));
+  d_vars->setAssignment(d_b, DeltaRational(Rational(17, 12)));
+  ASSERT_FALSE(generator.derive(d_b, cut));
+
+  // b integral, or with an infinitesimal part
+  d_vars->setAssignment(d_x0, DeltaRational(Rational(0)));
+  d_vars->setAssignment(d_b, DeltaRational(Rational(1)));
+  ASSERT_FALSE(generator.derive(d_b, cut));
+  d_vars->setAssignment(d_b, DeltaRational(Rational(11, 12), Rational(1)));
+  ASSERT_FALSE(generator.derive(d_b, cut));
+
+  d_vars->setAssignment(d_b, DeltaRational(Rational(11, 12)));
+  ASSERT_TRUE(generator.derive(d_b, cut));
+}
+
+TEST_F(TestTheoryWhiteArithGomory, pool_sat_context)
+{
+  mkRow();
+  GomoryCutGenerator generator(*d_vars, *d_tableau);
+  GomoryCut cut;
+  ASSERT_TRUE(generator.derive(d_b, cut));
+  makeTrue();
+  Node lemma = d_nodeManager->mkVar("cut", d_nodeManager->booleanType());
+  CutPool pool(d_context.get(), 2);
+  std::vector<TrustNode> out;
+
+  d_context->push();
+  pool.add(cut, TrustNode::mkTrustLemma(lemma, nullptr), 0);
+  ASSERT_TRUE(pool.wasSent(lemma));
+  // sent on this branch already
+  ASSERT_EQ(pool.collect(*d_vars, 0, out), 0u);
+  ASSERT_TRUE(out.empty());
+  d_context->pop();
+
+  // resent once on the next branch
+  ASSERT_FALSE(pool.wasSent(lemma));
+  d_context->push();
+  ASSERT_EQ(pool.collect(*d_vars, 0, out), 0u);
+  ASSERT_EQ(out.size(), 1u);
+  ASSERT_EQ(out[0].getNode(), lemma);
+  out.clear();
+  ASSERT_EQ(pool.collect(*d_vars, 0, out), 0u);
+  ASSERT_TRUE(out.empty());
+  d_context->pop();
+  ASSERT_EQ(pool.size(), 1u);
+
+  // a pooled cut that is satisfied ages, and goes past the maximum age
+  d_vars->setAssignment(d_x0, DeltaRational(Rational(6)));
+  ASSERT_EQ(pool.collect(*d_vars, 0, out), 0u);
+  ASSERT_EQ(pool.collect(*d_vars, 0, out), 0u);
+  ASSERT_EQ(pool.collect(*d_vars, 0, out), 1u);
+  ASSERT_TRUE(out.empty());
+  ASSERT_EQ(pool.size(), 0u);
+}
+
+TEST_F(TestTheoryWhiteArithGomory, pool_user_context)
+{
+  mkRow();
+  GomoryCutGenerator generator(*d_vars, *d_tableau);
+  GomoryCut cut;
+  ASSERT_TRUE(generator.derive(d_b, cut));
+  Node lemma = d_nodeManager->mkVar("cut", d_nodeManager->booleanType());
+  CutPool pool(d_context.get(), 2);
+  std::vector<TrustNode> out;
+
+  pool.add(cut, TrustNode::mkTrustLemma(lemma, nullptr), 1);
+  ASSERT_EQ(pool.collect(*d_vars, 1, out), 0u);
+  ASSERT_EQ(pool.size(), 1u);
+  // popping the user level of the cut drops it
+  ASSERT_EQ(pool.collect(*d_vars, 0, out), 1u);
+  ASSERT_EQ(pool.size(), 0u);
+
+  pool.add(cut, TrustNode::mkTrustLemma(lemma, nullptr), 0);
+  pool.removeVariable(d_y0);
+  ASSERT_EQ(pool.size(), 0u);
+  ASSERT_TRUE(out.empty());
+}
+
+}  // namespace test
+}  // namespace CVC4
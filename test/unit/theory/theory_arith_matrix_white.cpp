@@ -0,0 +1,175 @@
+/*********************                                                        */
+/*! \file theory_arith_matrix_white.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the sparse matrix of the arithmetic solver.
+ **/
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "test.h"
+#include "theory/arith/matrix.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+
+using namespace theory::arith;
+
+namespace test {
+
+class TestTheoryWhiteArithMatrix : public TestInternal
+{
+ protected:
+  typedef Matrix<Rational> RatMatrix;
+  typedef std::vector<std::pair<ArithVar, Rational> > Line;
+
+  /** The entries of row r, in the order they are traversed. */
+  static Line rowOf(const RatMatrix& m, RowIndex r)
+  {
+    Line line;
+    for (RatMatrix::RowIterator i = m.getRow(r).begin(); !i.atEnd(); ++i)
+    {
+      line.push_back(std::make_pair((*i).getColVar(), (*i).getCoefficient()));
+    }
+    return line;
+  }
+
+  /** The entries of column v, in the order they are traversed. */
+  static Line columnOf(const RatMatrix& m, ArithVar v)
+  {
+    Line line;
+    for (RatMatrix::ColIterator i = m.getColumn(v).begin(); !i.atEnd(); ++i)
+    {
+      line.push_back(std::make_pair(static_cast<ArithVar>((*i).getRowIndex()),
+                                    (*i).getCoefficient()));
+    }
+    return line;
+  }
+
+  /** Checks that the rows and columns of m are those of the dense matrix d. */
+  static void checkAgainst(const RatMatrix& m,
+                           const std::vector<std::map<ArithVar, Rational> >& d)
+  {
+    for (RowIndex r = 0; r < d.size(); ++r)
+    {
+      Line row = rowOf(m, r);
+      ASSERT_EQ(row.size(), d[r].size());
+      for (const std::pair<ArithVar, Rational>& e : row)
+      {
+        ASSERT_TRUE(d[r].find(e.first) != d[r].end());
+        ASSERT_EQ(d[r].find(e.first)->second, e.second);
+      }
+    }
+    for (ArithVar v = 0; v < m.getNumColumns(); ++v)
+    {
+      Line col = columnOf(m, v);
+      for (const std::pair<ArithVar, Rational>& e : col)
+      {
+        ASSERT_TRUE(d[e.first].find(v) != d[e.first].end());
+        ASSERT_EQ(d[e.first].find(v)->second, e.second);
+      }
+    }
+  }
+};
+
+TEST_F(TestTheoryWhiteArithMatrix, repack)
+{
+  const size_t rows = 40;
+  const size_t cols = 60;
+  RatMatrix m(Rational(0));
+  m.increaseSizeTo(cols);
+
+  std::vector<std::map<ArithVar, Rational> > dense(rows);
+  uint32_t seed = 7;
+  for (RowIndex r = 0; r < rows; ++r)
+  {
+    std::vector<Rational> coeffs;
+    std::vector<ArithVar> vars;
+    for (ArithVar v = 0; v < cols; ++v)
+    {
+      seed = seed * 1103515245 + 12345;
+      if ((seed >> 16) % 4 == 0)
+      {
+        Rational c(static_cast<long>((seed >> 8) % 19) - 9,
+                   static_cast<long>(1 + (seed >> 4) % 5));
+        if (c.sgn() == 0)
+        {
+          continue;
+        }
+        coeffs.push_back(c);
+        vars.push_back(v);
+        dense[r][v] = c;
+      }
+    }
+    ASSERT_EQ(m.addRow(coeffs, vars), r);
+  }
+
+  for (unsigned round = 0; round < 3; ++round)
+  {
+    // Scatter the rows by adding multiples of rows to each other.
+    for (RowIndex r = 0; r < rows; ++r)
+    {
+      RowIndex from = (r * 7 + round + 1) % rows;
+      if (from == r)
+      {
+        continue;
+      }
+      Rational mult(static_cast<long>(round + 1), 3L);
+      m.rowPlusRowTimesConstant(r, from, mult);
+      for (const std::pair<const ArithVar, Rational>& e : dense[from])
+      {
+        Rational c = dense[r][e.first] + mult * e.second;
+        if (c.sgn() == 0)
+        {
+          dense[r].erase(e.first);
+        }
+        else
+        {
+          dense[r][e.first] = c;
+        }
+      }
+    }
+    checkAgainst(m, dense);
+
+    std::vector<Line> rowsBefore, colsBefore;
+    for (RowIndex r = 0; r < rows; ++r)
+    {
+      rowsBefore.push_back(rowOf(m, r));
+    }
+    for (ArithVar v = 0; v < cols; ++v)
+    {
+      colsBefore.push_back(columnOf(m, v));
+    }
+
+    m.repack();
+
+    // The traversal orders are unchanged, and the entries are packed row by
+    // row.
+    EntryID next = 0;
+    for (RowIndex r = 0; r < rows; ++r)
+    {
+      ASSERT_EQ(rowOf(m, r), rowsBefore[r]);
+      for (RatMatrix::RowIterator i = m.getRow(r).begin(); !i.atEnd(); ++i)
+      {
+        ASSERT_EQ(i.getID(), next);
+        ++next;
+      }
+    }
+    for (ArithVar v = 0; v < cols; ++v)
+    {
+      ASSERT_EQ(columnOf(m, v), colsBefore[v]);
+    }
+    ASSERT_FALSE(m.shouldRepack());
+  }
+  checkAgainst(m, dense);
+}
+
+}  // namespace test
+}  // namespace CVC4
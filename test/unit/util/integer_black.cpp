@@ -334,6 +334,45 @@ TEST_F(TestUtilBlackInteger, pow)
   ASSERT_EQ(Integer(-1000), Integer(-10).pow(3));
 }
 
+TEST_F(TestUtilBlackInteger, int64_boundaries)
+{
+  int64_t max = std::numeric_limits<int64_t>::max();
+  int64_t min = std::numeric_limits<int64_t>::min();
+  Integer imax(max);
+  Integer imin(min);
+  Integer one(1);
+
+  ASSERT_EQ(imax.toString(), "9223372036854775807");
+  ASSERT_EQ(imin.toString(), "-9223372036854775808");
+  ASSERT_EQ(Integer("9223372036854775808"), imax + one);
+  ASSERT_EQ(Integer("-9223372036854775809"), imin - one);
+  ASSERT_EQ(imax + one - one, imax);
+  ASSERT_EQ(imin - one + one, imin);
+  ASSERT_EQ(imin + one, -imax);
+  ASSERT_EQ(-imin, imax + one);
+  ASSERT_EQ(imin.abs(), imax + one);
+  ASSERT_EQ(Integer("85070591730234615847396907784232501249"), imax * imax);
+  ASSERT_EQ((imax * imax).exactQuotient(imax), imax);
+  ASSERT_EQ(Integer(std::numeric_limits<uint64_t>::max()),
+            Integer("18446744073709551615"));
+
+  ASSERT_TRUE(imax < imax + one);
+  ASSERT_TRUE(imin > imin - one);
+  ASSERT_TRUE(imin - one < imax);
+  ASSERT_EQ((imax + one).hash(), Integer("9223372036854775808").hash());
+  ASSERT_EQ((imax + one - one).hash(), imax.hash());
+  ASSERT_EQ(imax.getLong(), max);
+  ASSERT_EQ(imin.getLong(), min);
+  ASSERT_EQ((imin - one).floorDivideQuotient(Integer(2)), Integer(min / 2) - one);
+  ASSERT_EQ(imin.floorDivideQuotient(Integer(-1)), imax + one);
+  ASSERT_EQ(imin.length(), 64);
+  ASSERT_EQ(imax.length(), 63);
+  ASSERT_EQ((imax + one).isPow2(), 64);
+  ASSERT_TRUE(imin.testBit(63));
+  ASSERT_TRUE(imin.testBit(100));
+  ASSERT_FALSE(imax.testBit(63));
+}
+
 TEST_F(TestUtilBlackInteger, overly_long)
 {
   uint64_t ul = std::numeric_limits<uint64_t>::max();
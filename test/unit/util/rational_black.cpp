@@ -14,6 +14,7 @@
  ** Black box testing of CVC4::Rational.
  **/
 
+#include <limits>
 #include <sstream>
 
 #include "test.h"
@@ -43,5 +44,36 @@ TEST_F(TestUtilBlackRational, fromDecimal)
   ASSERT_THROW(Rational::fromDecimal("1.2/3");, std::invalid_argument);
   ASSERT_THROW(Rational::fromDecimal("Hello, world!");, std::invalid_argument);
 }
+
+TEST_F(TestUtilBlackRational, int64_boundaries)
+{
+  int64_t max = std::numeric_limits<int64_t>::max();
+  int64_t min = std::numeric_limits<int64_t>::min();
+  Rational rmax(max);
+  Rational rmin(min);
+  Rational one(1);
+
+  ASSERT_EQ(Rational(min, int64_t(-1)).toString(), "9223372036854775808");
+  ASSERT_EQ(Rational(int64_t(2), min).toString(), "-1/4611686018427387904");
+  ASSERT_EQ(Rational("9223372036854775808"), rmax + one);
+  ASSERT_EQ(rmax + one - one, rmax);
+  ASSERT_EQ(rmin - one + one, rmin);
+  ASSERT_EQ(-rmin, rmax + one);
+
+  Rational q(int64_t(1), max);
+  Rational r(int64_t(1), max - 1);
+  ASSERT_EQ(q + r - r, q);
+  ASSERT_EQ((q * r) / r, q);
+  ASSERT_EQ((q * r).getDenominator(), Integer(max) * Integer(max - 1));
+  ASSERT_TRUE(q < r);
+  ASSERT_TRUE(-r < -q);
+  ASSERT_EQ((q + r).hash(), Rational((q + r).toString()).hash());
+  ASSERT_EQ(Rational(max, max - 1).floor(), Integer(1));
+  ASSERT_EQ(Rational(max, max - 1).ceiling(), Integer(2));
+  ASSERT_EQ(Rational(-max, max - 1).floor(), Integer(-2));
+  ASSERT_EQ(Rational(-max, max - 1).ceiling(), Integer(-1));
+  ASSERT_TRUE((rmax * rmax / rmax).isIntegral());
+  ASSERT_EQ(rmax * rmax / rmax, rmax);
+}
 }  // namespace test
 }  // namespace CVC4